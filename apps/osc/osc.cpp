@@ -1,25 +1,146 @@
+#include <OpenSimCreator/Documents/MeshWarper/BatchMeshWarper.h>
+#include <OpenSimCreator/Documents/Model/BasicModelStatePair.h>
+#include <OpenSimCreator/Documents/Simulation/ForwardDynamicSimulation.h>
+#include <OpenSimCreator/Documents/Simulation/ForwardDynamicSimulatorParams.h>
+#include <OpenSimCreator/Documents/Simulation/StoFileSimulation.h>
+#include <OpenSimCreator/Graphics/SimulationFrameRenderer.h>
 #include <OpenSimCreator/Platform/OpenSimCreatorApp.h>
 #include <OpenSimCreator/UI/MainUIScreen.h>
+#include <OpenSimCreator/Utils/OpenSimHelpers.h>
 
+#include <OpenSim/Simulation/Model/Model.h>
+#include <oscar/Platform/AppMetadata.h>
+#include <oscar/Utils/StringHelpers.h>
+
+#include <cmath>
+#include <cstddef>
 #include <cstdlib>
+#include <exception>
+#include <filesystem>
 #include <iostream>
 #include <memory>
+#include <optional>
+#include <string>
 #include <string_view>
 #include <vector>
 
 namespace
 {
-    constexpr std::string_view c_Usage = "usage: osc [--help] [fd] MODEL.osim\n";
+    constexpr std::string_view c_Usage = "usage: osc [--help] [--render-frames DIR MODEL.osim [MOTION.sto]] [--warp-meshes DIR [--error-tolerance E] SOURCE.csv DESTINATION.csv MESHES...] [fd] MODEL.osim\n";
 
     constexpr std::string_view c_Help = R"(OPTIONS
     --help
         Show this help
+    --render-frames DIR
+        Render each frame of a simulation of MODEL.osim to DIR as a PNG sequence
+        (without showing the UI) and print per-stage frames-per-second figures. If
+        MOTION.sto is provided, its frames are rendered. Otherwise, the model is
+        forward-simulated with the default simulation parameters. Works with a software
+        OpenGL implementation, e.g. on a headless Linux machine:
+
+            LIBGL_ALWAYS_SOFTWARE=1 xvfb-run osc --render-frames out/ model.osim
+
+    --warp-meshes DIR
+        Warp each mesh in MESHES with the Thin-Plate Spline (TPS) warp defined by the
+        landmarks in SOURCE.csv and DESTINATION.csv (the mesh warper's landmark CSV
+        format), write the results to DIR as OBJ files (without showing the UI), and
+        print per-stage throughput figures. Each element of MESHES may be a mesh file,
+        a directory of mesh files, or a pattern with wildcards in its filename (e.g.
+        'Geometry/*.vtp'). The TPS coefficients are solved once, and meshes are loaded,
+        warped, and written in parallel.
+    --error-tolerance E
+        With --warp-meshes: approximate the warp with an error tolerance of E (the
+        measured error is typically well within E), which is faster when there are
+        many landmarks
 )";
+
+    int RenderFrames(
+        std::filesystem::path const& outputDirectory,
+        std::vector<std::string_view> const& unnamedArgs)
+    {
+        if (unnamedArgs.empty() or unnamedArgs.size() > 2)
+        {
+            std::cerr << c_Usage;
+            return EXIT_FAILURE;
+        }
+
+        // init top-level application state (required for the graphics context)
+        osc::OpenSimCreatorApp app;
+
+        try
+        {
+            std::filesystem::path const modelPath{unnamedArgs.at(0)};
+
+            osc::SimulationFrameRendererParams params;
+            params.outputDirectory = outputDirectory;
+
+            if (unnamedArgs.size() == 2)
+            {
+                auto model = std::make_unique<OpenSim::Model>(modelPath.string());
+                osc::InitializeModel(*model);
+                osc::InitializeState(*model);
+                osc::StoFileSimulation const simulation{std::move(model), std::filesystem::path{unnamedArgs.at(1)}, 1.0f};
+                std::cout << osc::RenderSimulationFramesToPNGs(simulation, params);
+            }
+            else
+            {
+                osc::ForwardDynamicSimulation simulation{osc::BasicModelStatePair{modelPath}, osc::ForwardDynamicSimulatorParams{}};
+                simulation.join();
+                std::cout << osc::RenderSimulationFramesToPNGs(simulation, params);
+            }
+        }
+        catch (std::exception const& ex)
+        {
+            std::cerr << "osc: error rendering frames: " << ex.what() << '\n';
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
+
+    int WarpMeshes(
+        std::filesystem::path const& outputDirectory,
+        std::optional<float> errorTolerance,
+        std::vector<std::string_view> const& unnamedArgs)
+    {
+        if (unnamedArgs.size() < 3)
+        {
+            std::cerr << c_Usage;
+            return EXIT_FAILURE;
+        }
+
+        try
+        {
+            osc::BatchMeshWarperParams params;
+            params.sourceLandmarksCSV = unnamedArgs.at(0);
+            params.destinationLandmarksCSV = unnamedArgs.at(1);
+            for (size_t i = 2; i < unnamedArgs.size(); ++i)
+            {
+                for (auto&& meshPath : osc::FindMeshFilesForBatchWarping(std::filesystem::path{unnamedArgs[i]}))
+                {
+                    params.inputMeshes.push_back(std::move(meshPath));
+                }
+            }
+            params.outputDirectory = outputDirectory;
+            params.authoringTool = osc::calc_full_application_name_with_version_and_build_id(osc::GetOpenSimCreatorAppMetadata());
+            params.errorTolerance = errorTolerance;
+
+            std::cout << osc::WarpMeshesInBatch(params);
+        }
+        catch (std::exception const& ex)
+        {
+            std::cerr << "osc: error warping meshes: " << ex.what() << '\n';
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
 }
 
 int main(int argc, char* argv[])
 {
     std::vector<std::string_view> unnamedArgs;
+    std::optional<std::filesystem::path> renderFramesDirectory;
+    std::optional<std::filesystem::path> warpMeshesDirectory;
+    std::optional<float> errorTolerance;
     for (int i = 1; i < argc; ++i)
     {
         std::string_view const arg{argv[i]};  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
@@ -37,6 +158,60 @@ int main(int argc, char* argv[])
             std::cout << c_Usage << '\n' << c_Help << '\n';
             return EXIT_SUCCESS;
         }
+        else if (arg == "--render-frames")
+        {
+            if (i + 1 >= argc)
+            {
+                std::cerr << c_Usage;
+                return EXIT_FAILURE;
+            }
+            renderFramesDirectory = argv[++i];  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+        else if (arg == "--warp-meshes")
+        {
+            if (i + 1 >= argc)
+            {
+                std::cerr << c_Usage;
+                return EXIT_FAILURE;
+            }
+            warpMeshesDirectory = argv[++i];  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+        else if (arg == "--error-tolerance")
+        {
+            if (i + 1 >= argc)
+            {
+                std::cerr << c_Usage;
+                return EXIT_FAILURE;
+            }
+            errorTolerance = osc::from_chars_strip_whitespace(argv[++i]);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            if (not errorTolerance or not std::isfinite(*errorTolerance) or *errorTolerance < 0.0f)
+            {
+                std::cerr << "osc: --error-tolerance must be a finite, non-negative number\n" << c_Usage;
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    if (errorTolerance and not warpMeshesDirectory)
+    {
+        std::cerr << "osc: --error-tolerance can only be used with --warp-meshes\n" << c_Usage;
+        return EXIT_FAILURE;
+    }
+
+    if (renderFramesDirectory and warpMeshesDirectory)
+    {
+        std::cerr << "osc: --render-frames and --warp-meshes cannot be used together\n" << c_Usage;
+        return EXIT_FAILURE;
+    }
+
+    if (renderFramesDirectory)
+    {
+        return RenderFrames(*renderFramesDirectory, unnamedArgs);
+    }
+
+    if (warpMeshesDirectory)
+    {
+        return WarpMeshes(*warpMeshesDirectory, errorTolerance, unnamedArgs);
     }
 
     // init top-level application state
@@ -0,0 +1,67 @@
+#include <OpenSimCreator/Documents/MeshImporter/Body.h>
+#include <OpenSimCreator/Documents/MeshImporter/Document.h>
+#include <OpenSimCreator/Documents/MeshImporter/UndoableDocument.h>
+
+#include <benchmark/benchmark.h>
+#include <oscar/Maths/Transform.h>
+#include <oscar/Maths/Vec3.h>
+#include <oscar/Utils/UID.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct UndoableDocumentWithBodies {
+        osc::mi::UndoableDocument document;
+        std::vector<osc::UID> bodyIDs;
+    };
+}
+
+// returns an undoable document that contains `numBodies` bodies
+static UndoableDocumentWithBodies GenerateDocumentWithBodies(size_t numBodies)
+{
+    UndoableDocumentWithBodies rv;
+    rv.bodyIDs.reserve(numBodies);
+    for (size_t i = 0; i < numBodies; ++i)
+    {
+        osc::Transform const xform = {.position = {static_cast<float>(i), 0.0f, 0.0f}};
+        rv.bodyIDs.push_back(rv.document.upd_scratch().emplace<osc::mi::Body>(osc::UID{}, "body_" + std::to_string(i), xform).getID());
+    }
+    rv.document.commit_scratch("added bodies");
+    return rv;
+}
+
+// measures the cost of one "drag" frame, which updates one object and commits the document
+static void BM_MeshImporterDocumentCommitAfterMovingOneObject(benchmark::State& state)
+{
+    UndoableDocumentWithBodies d = GenerateDocumentWithBodies(static_cast<size_t>(state.range(0)));
+    size_t i = 0;
+    for ([[maybe_unused]] auto _ : state)
+    {
+        if (i % 1000 == 999)
+        {
+            // periodically drop the undo history, so that memory usage doesn't grow with the iteration count
+            state.PauseTiming();
+            d.document = osc::mi::UndoableDocument{d.document.scratch()};
+            state.ResumeTiming();
+        }
+
+        osc::mi::Document& doc = d.document.upd_scratch();
+        doc.updByID(d.bodyIDs[i++ % d.bodyIDs.size()]).applyTranslation(doc, osc::Vec3{0.0f, 0.01f, 0.0f});
+        d.document.commit_scratch("moved body");
+    }
+}
+BENCHMARK(BM_MeshImporterDocumentCommitAfterMovingOneObject)->RangeMultiplier(10)->Range(10, 10000);
+
+static void BM_MeshImporterDocumentCopy(benchmark::State& state)
+{
+    UndoableDocumentWithBodies const d = GenerateDocumentWithBodies(static_cast<size_t>(state.range(0)));
+    for ([[maybe_unused]] auto _ : state)
+    {
+        osc::mi::Document copy = d.document.scratch();
+        benchmark::DoNotOptimize(copy);
+    }
+}
+BENCHMARK(BM_MeshImporterDocumentCopy)->RangeMultiplier(10)->Range(10, 10000);
@@ -0,0 +1,173 @@
+#include <OpenSimCreator/Documents/OutputExtractors/ComponentOutputExtractor.h>
+#include <OpenSimCreator/Documents/OutputExtractors/ConcatenatingOutputExtractor.h>
+#include <OpenSimCreator/Documents/OutputExtractors/IntegratorOutputExtractor.h>
+#include <OpenSimCreator/Documents/OutputExtractors/OutputExtractor.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
+#include <OpenSimCreator/Utils/OpenSimHelpers.h>
+
+#include <benchmark/benchmark.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/SimbodyEngine/Body.h>
+#include <OpenSim/Simulation/SimbodyEngine/Coordinate.h>
+#include <OpenSim/Simulation/SimbodyEngine/PinJoint.h>
+#include <oscar/Maths/Vec2.h>
+
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    constexpr size_t c_NumReports = 100000;
+    constexpr size_t c_NumDistinctStates = 100;  // reports are refcounted, so most of them share a state
+
+    struct ModelWithReports {
+        std::unique_ptr<OpenSim::Model> model;
+        OpenSim::Coordinate const* coordinate = nullptr;
+        std::vector<osc::SimulationReport> reports;
+    };
+}
+
+// returns a single-pendulum model and `c_NumReports` reports of it (with auxiliary integrator values)
+static ModelWithReports GeneratePendulumReports()
+{
+    auto model = std::make_unique<OpenSim::Model>();
+
+    auto body = std::make_unique<OpenSim::Body>("body", 1.0, SimTK::Vec3{0.0}, SimTK::Inertia{1.0});
+    auto joint = std::make_unique<OpenSim::PinJoint>("joint", model->getGround(), *body);
+    OpenSim::Coordinate const* coordinate = &joint->getCoordinate();
+    model->addBody(body.release());
+    model->addJoint(joint.release());
+    osc::InitializeModel(*model);
+    osc::InitializeState(*model);
+
+    osc::UID const auxID = osc::GetIntegratorOutputExtractor(0).getAuxiliaryDataID();
+
+    std::vector<osc::SimulationReport> distinct;
+    distinct.reserve(c_NumDistinctStates);
+    for (size_t i = 0; i < c_NumDistinctStates; ++i)
+    {
+        SimTK::State state = model->getWorkingState();
+        coordinate->setValue(state, 0.01 * static_cast<double>(i));
+        model->realizeReport(state);
+        distinct.emplace_back(std::move(state), std::unordered_map<osc::UID, float>{{auxID, static_cast<float>(i)}});
+    }
+
+    std::vector<osc::SimulationReport> reports;
+    reports.reserve(c_NumReports);
+    for (size_t i = 0; i < c_NumReports; ++i)
+    {
+        reports.push_back(distinct[i % distinct.size()]);
+    }
+
+    return ModelWithReports{std::move(model), coordinate, std::move(reports)};
+}
+
+static osc::OutputExtractor CoordinateValueExtractor(ModelWithReports const& m)
+{
+    return osc::OutputExtractor{osc::ComponentOutputExtractor{m.coordinate->getOutput("value")}};
+}
+
+static void BM_ComponentOutputPerReport(benchmark::State& state)
+{
+    ModelWithReports const m = GeneratePendulumReports();
+    osc::OutputExtractor const extractor = CoordinateValueExtractor(m);
+    std::vector<float> out(m.reports.size());
+    for ([[maybe_unused]] auto _ : state)
+    {
+        for (size_t i = 0; i < m.reports.size(); ++i)
+        {
+            out[i] = extractor.getValueFloat(*m.model, m.reports[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+BENCHMARK(BM_ComponentOutputPerReport);
+
+static void BM_ComponentOutputConsumer(benchmark::State& state)
+{
+    ModelWithReports const m = GeneratePendulumReports();
+    osc::OutputExtractor const extractor = CoordinateValueExtractor(m);
+    std::vector<float> out;
+    out.reserve(m.reports.size());
+    for ([[maybe_unused]] auto _ : state)
+    {
+        out.clear();
+        extractor.getValuesFloat(*m.model, m.reports, [&out](float v) { out.push_back(v); });
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+BENCHMARK(BM_ComponentOutputConsumer);
+
+static void BM_ComponentOutputBatch(benchmark::State& state)
+{
+    ModelWithReports const m = GeneratePendulumReports();
+    osc::OutputExtractor const extractor = CoordinateValueExtractor(m);
+    std::vector<float> out(m.reports.size());
+    for ([[maybe_unused]] auto _ : state)
+    {
+        extractor.getValuesFloat(*m.model, m.reports, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+BENCHMARK(BM_ComponentOutputBatch);
+
+static void BM_IntegratorOutputPerReport(benchmark::State& state)
+{
+    ModelWithReports const m = GeneratePendulumReports();
+    osc::OutputExtractor const extractor = osc::GetIntegratorOutputExtractorDynamic(0);
+    std::vector<float> out(m.reports.size());
+    for ([[maybe_unused]] auto _ : state)
+    {
+        for (size_t i = 0; i < m.reports.size(); ++i)
+        {
+            out[i] = extractor.getValueFloat(*m.model, m.reports[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+BENCHMARK(BM_IntegratorOutputPerReport);
+
+static void BM_IntegratorOutputBatch(benchmark::State& state)
+{
+    ModelWithReports const m = GeneratePendulumReports();
+    osc::OutputExtractor const extractor = osc::GetIntegratorOutputExtractorDynamic(0);
+    std::vector<float> out(m.reports.size());
+    for ([[maybe_unused]] auto _ : state)
+    {
+        extractor.getValuesFloat(*m.model, m.reports, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+BENCHMARK(BM_IntegratorOutputBatch);
+
+static void BM_ConcatenatingOutputPerReport(benchmark::State& state)
+{
+    ModelWithReports const m = GeneratePendulumReports();
+    osc::OutputExtractor const extractor{osc::ConcatenatingOutputExtractor{osc::GetIntegratorOutputExtractorDynamic(0), CoordinateValueExtractor(m)}};
+    std::vector<osc::Vec2> out(m.reports.size());
+    for ([[maybe_unused]] auto _ : state)
+    {
+        for (size_t i = 0; i < m.reports.size(); ++i)
+        {
+            out[i] = extractor.getValueVec2(*m.model, m.reports[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+BENCHMARK(BM_ConcatenatingOutputPerReport);
+
+static void BM_ConcatenatingOutputBatch(benchmark::State& state)
+{
+    ModelWithReports const m = GeneratePendulumReports();
+    osc::OutputExtractor const extractor{osc::ConcatenatingOutputExtractor{osc::GetIntegratorOutputExtractorDynamic(0), CoordinateValueExtractor(m)}};
+    std::vector<osc::Vec2> out(m.reports.size());
+    for ([[maybe_unused]] auto _ : state)
+    {
+        extractor.getValuesVec2(*m.model, m.reports, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+BENCHMARK(BM_ConcatenatingOutputBatch);
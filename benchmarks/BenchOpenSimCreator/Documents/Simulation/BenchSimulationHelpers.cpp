@@ -0,0 +1,164 @@
+#include <OpenSimCreator/Documents/OutputExtractors/ComponentOutputExtractor.h>
+#include <OpenSimCreator/Documents/OutputExtractors/ConcatenatingOutputExtractor.h>
+#include <OpenSimCreator/Documents/OutputExtractors/IntegratorOutputExtractor.h>
+#include <OpenSimCreator/Documents/OutputExtractors/OutputExtractor.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationHelpers.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
+#include <OpenSimCreator/Utils/OpenSimHelpers.h>
+
+#include <benchmark/benchmark.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/SimbodyEngine/Body.h>
+#include <OpenSim/Simulation/SimbodyEngine/Coordinate.h>
+#include <OpenSim/Simulation/SimbodyEngine/PinJoint.h>
+#include <oscar/Formats/BinaryColumns.h>
+#include <oscar/Formats/CSV.h>
+#include <oscar/Utils/StringHelpers.h>
+
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    constexpr size_t c_NumReports = 100000;
+
+    struct ModelWithOutputs {
+        std::unique_ptr<OpenSim::Model> model;
+        std::vector<osc::OutputExtractor> outputs;
+        std::vector<osc::SimulationReport> reports;
+    };
+}
+
+// returns a single-pendulum model, `c_NumReports` reports of it swinging, and a few outputs
+// (a component output, an integrator output, and a `Vec2` output) that would typically be exported
+static ModelWithOutputs GeneratePendulumOutputs()
+{
+    auto model = std::make_unique<OpenSim::Model>();
+
+    auto body = std::make_unique<OpenSim::Body>("body", 1.0, SimTK::Vec3{0.0}, SimTK::Inertia{1.0});
+    auto joint = std::make_unique<OpenSim::PinJoint>("joint", model->getGround(), *body);
+    OpenSim::Coordinate const* coordinate = &joint->getCoordinate();
+    model->addBody(body.release());
+    model->addJoint(joint.release());
+    osc::InitializeModel(*model);
+    osc::InitializeState(*model);
+
+    osc::OutputExtractor const coordinateValue{osc::ComponentOutputExtractor{coordinate->getOutput("value")}};
+    osc::OutputExtractor const integratorOutput = osc::GetIntegratorOutputExtractorDynamic(0);
+    std::vector<osc::OutputExtractor> outputs = {
+        coordinateValue,
+        integratorOutput,
+        osc::OutputExtractor{osc::ConcatenatingOutputExtractor{integratorOutput, coordinateValue}},
+    };
+
+    osc::UID const auxID = osc::GetIntegratorOutputExtractor(0).getAuxiliaryDataID();
+
+    std::vector<osc::SimulationReport> reports;
+    reports.reserve(c_NumReports);
+    for (size_t i = 0; i < c_NumReports; ++i)
+    {
+        SimTK::State state = model->getWorkingState();
+        state.setTime(0.001 * static_cast<double>(i));
+        coordinate->setValue(state, std::sin(0.001 * static_cast<double>(i)));
+        model->realizeReport(state);
+        reports.emplace_back(std::move(state), std::unordered_map<osc::UID, float>{{auxID, 0.1f * static_cast<float>(i)}});
+    }
+
+    return ModelWithOutputs{std::move(model), std::move(outputs), std::move(reports)};
+}
+
+static std::string ExportAsCSV(ModelWithOutputs const& m)
+{
+    std::stringstream out;
+    osc::WriteOutputsAsCSV(*m.model, m.outputs, m.reports, out);
+    return std::move(out).str();
+}
+
+static std::string ExportAsBinaryColumns(ModelWithOutputs const& m, osc::BinaryColumnsWriterFlags flags)
+{
+    std::stringstream out;
+    osc::WriteOutputsAsBinaryColumns(*m.model, m.outputs, m.reports, out, flags);
+    return std::move(out).str();
+}
+
+static void BM_ExportOutputsAsCSV(benchmark::State& state)
+{
+    ModelWithOutputs const m = GeneratePendulumOutputs();
+    size_t numBytes = 0;
+    for ([[maybe_unused]] auto _ : state)
+    {
+        std::string const content = ExportAsCSV(m);
+        numBytes = content.size();
+        benchmark::DoNotOptimize(content.data());
+    }
+    state.counters["bytes"] = static_cast<double>(numBytes);
+}
+BENCHMARK(BM_ExportOutputsAsCSV);
+
+static void BM_ExportOutputsAsBinaryColumns(benchmark::State& state)
+{
+    ModelWithOutputs const m = GeneratePendulumOutputs();
+    size_t numBytes = 0;
+    for ([[maybe_unused]] auto _ : state)
+    {
+        std::string const content = ExportAsBinaryColumns(m, osc::BinaryColumnsWriterFlags::None);
+        numBytes = content.size();
+        benchmark::DoNotOptimize(content.data());
+    }
+    state.counters["bytes"] = static_cast<double>(numBytes);
+}
+BENCHMARK(BM_ExportOutputsAsBinaryColumns);
+
+static void BM_ExportOutputsAsCompressedBinaryColumns(benchmark::State& state)
+{
+    ModelWithOutputs const m = GeneratePendulumOutputs();
+    size_t numBytes = 0;
+    for ([[maybe_unused]] auto _ : state)
+    {
+        std::string const content = ExportAsBinaryColumns(m, osc::BinaryColumnsWriterFlags::Compress);
+        numBytes = content.size();
+        benchmark::DoNotOptimize(content.data());
+    }
+    state.counters["bytes"] = static_cast<double>(numBytes);
+}
+BENCHMARK(BM_ExportOutputsAsCompressedBinaryColumns);
+
+static void BM_ImportOutputsFromCSV(benchmark::State& state)
+{
+    std::string const content = ExportAsCSV(GeneratePendulumOutputs());
+    for ([[maybe_unused]] auto _ : state)
+    {
+        // parse the cells as numbers, because that's what a plot importer would have to do
+        osc::CSVReader reader{content};
+        std::vector<float> values;
+        reader.next_row();  // header
+        while (auto row = reader.next_row())
+        {
+            for (std::string_view const cell : *row)
+            {
+                values.push_back(osc::from_chars_strip_whitespace(cell).value_or(0.0f));
+            }
+        }
+        benchmark::DoNotOptimize(values.data());
+    }
+}
+BENCHMARK(BM_ImportOutputsFromCSV);
+
+static void BM_ImportOutputsFromCompressedBinaryColumns(benchmark::State& state)
+{
+    std::string const content = ExportAsBinaryColumns(GeneratePendulumOutputs(), osc::BinaryColumnsWriterFlags::Compress);
+    for ([[maybe_unused]] auto _ : state)
+    {
+        std::stringstream in{content};
+        std::vector<osc::BinaryColumn> const columns = osc::read_binary_columns(in);
+        benchmark::DoNotOptimize(columns.data());
+    }
+}
+BENCHMARK(BM_ImportOutputsFromCompressedBinaryColumns);
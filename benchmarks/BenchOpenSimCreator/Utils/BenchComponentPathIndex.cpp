@@ -0,0 +1,129 @@
+#include <OpenSimCreator/Utils/ComponentPathIndex.h>
+#include <OpenSimCreator/Utils/OpenSimHelpers.h>
+
+#include <benchmark/benchmark.h>
+#include <OpenSim/Common/ComponentPath.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/Model/PhysicalOffsetFrame.h>
+
+#include <memory>
+#include <string>
+
+struct ModelWithLookupTarget {
+    std::unique_ptr<OpenSim::Model> model;
+    OpenSim::ComponentPath target;
+};
+
+// returns a model containing a chain of `depth` nested frames, where the target is the deepest one
+static ModelWithLookupTarget GenerateDeepModel(int depth)
+{
+    auto model = std::make_unique<OpenSim::Model>();
+
+    OpenSim::Component* parent = model.get();
+    for (int i = 0; i < depth; ++i)
+    {
+        auto frame = std::make_unique<OpenSim::PhysicalOffsetFrame>();
+        frame->setName("frame_" + std::to_string(i));
+        OpenSim::Component* framePtr = frame.get();
+        parent->addComponent(frame.release());
+        parent = framePtr;
+    }
+    model->finalizeFromProperties();
+
+    return ModelWithLookupTarget{std::move(model), parent->getAbsolutePath()};
+}
+
+// returns a model containing `width` sibling frames, where the target is the last one
+static ModelWithLookupTarget GenerateWideModel(int width)
+{
+    auto model = std::make_unique<OpenSim::Model>();
+
+    OpenSim::Component* last = model.get();
+    for (int i = 0; i < width; ++i)
+    {
+        auto frame = std::make_unique<OpenSim::PhysicalOffsetFrame>();
+        frame->setName("frame_" + std::to_string(i));
+        last = frame.get();
+        model->addComponent(frame.release());
+    }
+    model->finalizeFromProperties();
+
+    return ModelWithLookupTarget{std::move(model), last->getAbsolutePath()};
+}
+
+static void BM_FindComponentInDeepModel(benchmark::State& state)
+{
+    ModelWithLookupTarget m = GenerateDeepModel(static_cast<int>(state.range(0)));
+    for ([[maybe_unused]] auto _ : state)
+    {
+        benchmark::DoNotOptimize(osc::FindComponent(*m.model, m.target));
+    }
+}
+BENCHMARK(BM_FindComponentInDeepModel)->RangeMultiplier(4)->Range(4, 256);
+
+static void BM_ComponentPathIndexFindInDeepModel(benchmark::State& state)
+{
+    ModelWithLookupTarget m = GenerateDeepModel(static_cast<int>(state.range(0)));
+    osc::ComponentPathIndex const index{*m.model};
+    for ([[maybe_unused]] auto _ : state)
+    {
+        benchmark::DoNotOptimize(index.find(m.target));
+    }
+}
+BENCHMARK(BM_ComponentPathIndexFindInDeepModel)->RangeMultiplier(4)->Range(4, 256);
+
+static void BM_FindComponentInWideModel(benchmark::State& state)
+{
+    ModelWithLookupTarget m = GenerateWideModel(static_cast<int>(state.range(0)));
+    for ([[maybe_unused]] auto _ : state)
+    {
+        benchmark::DoNotOptimize(osc::FindComponent(*m.model, m.target));
+    }
+}
+BENCHMARK(BM_FindComponentInWideModel)->RangeMultiplier(8)->Range(8, 4096);
+
+static void BM_ComponentPathIndexFindInWideModel(benchmark::State& state)
+{
+    ModelWithLookupTarget m = GenerateWideModel(static_cast<int>(state.range(0)));
+    osc::ComponentPathIndex const index{*m.model};
+    for ([[maybe_unused]] auto _ : state)
+    {
+        benchmark::DoNotOptimize(index.find(m.target));
+    }
+}
+BENCHMARK(BM_ComponentPathIndexFindInWideModel)->RangeMultiplier(8)->Range(8, 4096);
+
+// lookups of paths that don't exist (e.g. a stale selection) are the worst case for
+// `FindComponent`, because OpenSim throws (and `FindComponent` catches) an exception
+static void BM_FindComponentMissInWideModel(benchmark::State& state)
+{
+    ModelWithLookupTarget m = GenerateWideModel(static_cast<int>(state.range(0)));
+    OpenSim::ComponentPath const missing{"/frame_does_not_exist"};
+    for ([[maybe_unused]] auto _ : state)
+    {
+        benchmark::DoNotOptimize(osc::FindComponent(*m.model, missing));
+    }
+}
+BENCHMARK(BM_FindComponentMissInWideModel)->RangeMultiplier(8)->Range(8, 4096);
+
+static void BM_ComponentPathIndexFindMissInWideModel(benchmark::State& state)
+{
+    ModelWithLookupTarget m = GenerateWideModel(static_cast<int>(state.range(0)));
+    osc::ComponentPathIndex const index{*m.model};
+    OpenSim::ComponentPath const missing{"/frame_does_not_exist"};
+    for ([[maybe_unused]] auto _ : state)
+    {
+        benchmark::DoNotOptimize(index.find(missing));
+    }
+}
+BENCHMARK(BM_ComponentPathIndexFindMissInWideModel)->RangeMultiplier(8)->Range(8, 4096);
+
+static void BM_ComponentPathIndexBuildWideModel(benchmark::State& state)
+{
+    ModelWithLookupTarget m = GenerateWideModel(static_cast<int>(state.range(0)));
+    for ([[maybe_unused]] auto _ : state)
+    {
+        benchmark::DoNotOptimize(osc::ComponentPathIndex{*m.model});
+    }
+}
+BENCHMARK(BM_ComponentPathIndexBuildWideModel)->RangeMultiplier(8)->Range(8, 4096);
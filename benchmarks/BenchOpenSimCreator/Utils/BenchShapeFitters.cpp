@@ -0,0 +1,84 @@
+#include <OpenSimCreator/Utils/ShapeFitters.h>
+
+#include <benchmark/benchmark.h>
+#include <oscar/Graphics/Geometries/SphereGeometry.h>
+#include <oscar/Graphics/Mesh.h>
+#include <oscar/Maths/Transform.h>
+
+// returns a (transformed) high-resolution sphere mesh, which is roughly the size of a dense scan
+static osc::Mesh GenerateHighResolutionSphereMesh()
+{
+    osc::Mesh rv = osc::SphereGeometry{1.0f, 512, 512};
+    rv.transform_vertices(osc::Transform{.scale = {2.0f, 2.0f, 2.0f}, .position = {1.0f, -3.0f, 0.5f}});
+    return rv;
+}
+
+static void BM_FitSphere(benchmark::State& state)
+{
+    osc::Mesh const mesh = GenerateHighResolutionSphereMesh();
+    for ([[maybe_unused]] auto _ : state)
+    {
+        benchmark::DoNotOptimize(osc::FitSphere(mesh));
+    }
+}
+BENCHMARK(BM_FitSphere);
+
+static void BM_FitSphereAreaWeighted(benchmark::State& state)
+{
+    osc::Mesh const mesh = GenerateHighResolutionSphereMesh();
+    for ([[maybe_unused]] auto _ : state)
+    {
+        benchmark::DoNotOptimize(osc::FitSphere(mesh, osc::ShapeFitWeighting::Area));
+    }
+}
+BENCHMARK(BM_FitSphereAreaWeighted);
+
+static void BM_FitSphereReference(benchmark::State& state)
+{
+    osc::Mesh const mesh = GenerateHighResolutionSphereMesh();
+    for ([[maybe_unused]] auto _ : state)
+    {
+        benchmark::DoNotOptimize(osc::FitSphereReference(mesh));
+    }
+}
+BENCHMARK(BM_FitSphereReference);
+
+static void BM_FitPlane(benchmark::State& state)
+{
+    osc::Mesh const mesh = GenerateHighResolutionSphereMesh();
+    for ([[maybe_unused]] auto _ : state)
+    {
+        benchmark::DoNotOptimize(osc::FitPlane(mesh));
+    }
+}
+BENCHMARK(BM_FitPlane);
+
+static void BM_FitPlaneReference(benchmark::State& state)
+{
+    osc::Mesh const mesh = GenerateHighResolutionSphereMesh();
+    for ([[maybe_unused]] auto _ : state)
+    {
+        benchmark::DoNotOptimize(osc::FitPlaneReference(mesh));
+    }
+}
+BENCHMARK(BM_FitPlaneReference);
+
+static void BM_FitEllipsoid(benchmark::State& state)
+{
+    osc::Mesh const mesh = GenerateHighResolutionSphereMesh();
+    for ([[maybe_unused]] auto _ : state)
+    {
+        benchmark::DoNotOptimize(osc::FitEllipsoid(mesh));
+    }
+}
+BENCHMARK(BM_FitEllipsoid);
+
+static void BM_FitEllipsoidReference(benchmark::State& state)
+{
+    osc::Mesh const mesh = GenerateHighResolutionSphereMesh();
+    for ([[maybe_unused]] auto _ : state)
+    {
+        benchmark::DoNotOptimize(osc::FitEllipsoidReference(mesh));
+    }
+}
+BENCHMARK(BM_FitEllipsoidReference);
@@ -0,0 +1,54 @@
+#include <OpenSimCreator/Utils/TPS.h>
+
+#include <benchmark/benchmark.h>
+#include <oscar/Maths/Vec3.h>
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+// returns `n` (deterministic) landmark pairs that are spread over roughly the same volume
+static std::vector<osc::TPSLandmarkPair<3>> GenerateLandmarkPairs(size_t n)
+{
+    std::vector<osc::TPSLandmarkPair<3>> rv;
+    rv.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        float const t = static_cast<float>(i);
+        osc::Vec3 const source = {std::sin(1.7f*t), std::cos(2.3f*t), std::sin(0.7f*t + 1.0f)};
+        rv.push_back({source, source + osc::Vec3{0.05f*std::cos(t), 0.05f*std::sin(t), 0.0f}});
+    }
+    return rv;
+}
+
+// emulates the user dragging a destination landmark around in the mesh warper, which
+// only requires re-solving the (already factorized) system
+static void BM_TPSSolveAfterDestinationEdit(benchmark::State& state)
+{
+    std::vector<osc::TPSLandmarkPair<3>> landmarks = GenerateLandmarkPairs(static_cast<size_t>(state.range(0)));
+    osc::TPSCoefficientSolver<3> solver;
+    solver.solve(landmarks);
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        landmarks.front().destination.x += 0.001f;
+        benchmark::DoNotOptimize(solver.solve(landmarks));
+    }
+}
+BENCHMARK(BM_TPSSolveAfterDestinationEdit)->Arg(16)->Arg(64)->Arg(256)->Arg(1024);
+
+// emulates the user dragging a source landmark around in the mesh warper, which requires
+// refactorizing the system
+static void BM_TPSSolveAfterSourceEdit(benchmark::State& state)
+{
+    std::vector<osc::TPSLandmarkPair<3>> landmarks = GenerateLandmarkPairs(static_cast<size_t>(state.range(0)));
+    osc::TPSCoefficientSolver<3> solver;
+    solver.solve(landmarks);
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        landmarks.front().source.x += 0.001f;
+        benchmark::DoNotOptimize(solver.solve(landmarks));
+    }
+}
+BENCHMARK(BM_TPSSolveAfterSourceEdit)->Arg(16)->Arg(64)->Arg(256)->Arg(1024);
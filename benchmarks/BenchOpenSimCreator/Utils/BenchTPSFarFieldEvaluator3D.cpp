@@ -0,0 +1,102 @@
+#include <OpenSimCreator/Utils/TPSFarFieldEvaluator3D.h>
+
+#include <OpenSimCreator/Utils/TPS3D.h>
+#include <benchmark/benchmark.h>
+#include <oscar/Maths/CommonFunctions.h>
+#include <oscar/Maths/GeometricFunctions.h>
+#include <oscar/Maths/Vec3.h>
+
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+// returns (deterministic) coefficients with `n` non-affine terms, which roughly resemble
+// the coefficients of a dense (e.g. semi-landmark) warp
+//
+// (the weights shrink as `n` grows, so that the magnitude of the warp is roughly independent of `n`)
+static osc::TPSCoefficients3D GenerateCoefficients(size_t n)
+{
+    std::default_random_engine rng{42};
+    std::uniform_real_distribution<float> controlPointDist{-1.0f, 1.0f};
+    float const maxWeight = 80.0f / static_cast<float>(n);
+    std::uniform_real_distribution<float> weightDist{-maxWeight, maxWeight};
+
+    osc::TPSCoefficients3D rv;
+    rv.nonAffineTerms.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        osc::Vec3 const weight = {weightDist(rng), weightDist(rng), weightDist(rng)};
+        osc::Vec3 const controlPoint = {controlPointDist(rng), controlPointDist(rng), controlPointDist(rng)};
+        rv.nonAffineTerms.emplace_back(weight, controlPoint);
+    }
+    return rv;
+}
+
+// returns (deterministic) points that are (e.g.) vertices of a mesh that surrounds the control points
+static std::vector<osc::Vec3> GenerateEvaluationPoints(size_t n)
+{
+    std::default_random_engine rng{7};
+    std::uniform_real_distribution<float> dist{-1.5f, 1.5f};
+
+    std::vector<osc::Vec3> rv;
+    rv.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        rv.emplace_back(dist(rng), dist(rng), dist(rng));
+    }
+    return rv;
+}
+
+static constexpr size_t c_NumLandmarks = 65536;
+static constexpr size_t c_NumPoints = 4096;
+
+static void BM_TPSWarpPointsExact(benchmark::State& state)
+{
+    osc::TPSCoefficients3D const coefs = GenerateCoefficients(c_NumLandmarks);
+    std::vector<osc::Vec3> const points = GenerateEvaluationPoints(c_NumPoints);
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        std::vector<osc::Vec3> warped = points;
+        osc::ApplyThinPlateWarpToPointsInPlace(coefs, warped, 1.0f);
+        benchmark::DoNotOptimize(warped);
+    }
+}
+BENCHMARK(BM_TPSWarpPointsExact);
+
+// the argument is the (negated) exponent of the error tolerance (e.g. 3 --> 1e-3)
+static void BM_TPSWarpPointsFarField(benchmark::State& state)
+{
+    osc::TPSCoefficients3D const coefs = GenerateCoefficients(c_NumLandmarks);
+    std::vector<osc::Vec3> const points = GenerateEvaluationPoints(c_NumPoints);
+    float const errorTolerance = std::pow(10.0f, -static_cast<float>(state.range(0)));
+    osc::TPSFarFieldEvaluator3D const evaluator{coefs, errorTolerance};
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        std::vector<osc::Vec3> warped = points;
+        evaluator.applyWarpToPointsInPlace(warped, 1.0f);
+        benchmark::DoNotOptimize(warped);
+    }
+
+    // measure the error against the exact path
+    std::vector<osc::Vec3> exact = points;
+    std::vector<osc::Vec3> approximate = points;
+    osc::ApplyThinPlateWarpToPointsInPlace(coefs, exact, 1.0f);
+    evaluator.applyWarpToPointsInPlace(approximate, 1.0f);
+
+    double maxError = 0.0;
+    double sumOfSquaredErrors = 0.0;
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        double const error = osc::length(approximate[i] - exact[i]);
+        maxError = osc::max(maxError, error);
+        sumOfSquaredErrors += error * error;
+    }
+    state.counters["errorTolerance"] = errorTolerance;
+    state.counters["maxError"] = maxError;
+    state.counters["rmsError"] = std::sqrt(sumOfSquaredErrors / static_cast<double>(points.size()));
+    state.counters["clusters"] = static_cast<double>(evaluator.getNumClusters());
+}
+BENCHMARK(BM_TPSWarpPointsFarField)->Arg(2)->Arg(3)->Arg(4)->Arg(5);
@@ -0,0 +1,93 @@
+#include <oscar/Graphics/Mesh.h>
+
+#include <benchmark/benchmark.h>
+#include <oscar/Maths/Vec3.h>
+#include <oscar/Utils/StridedSpan.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    constexpr size_t c_NumVertices = 1'000'000;
+
+    // returns a mesh with an interleaved (position + normal) vertex buffer, which is
+    // what (e.g.) the mesh loaders typically produce
+    Mesh GenerateLargeMesh()
+    {
+        std::vector<Vec3> vertices;
+        vertices.reserve(c_NumVertices);
+        for (size_t i = 0; i < c_NumVertices; ++i) {
+            const auto v = static_cast<float>(i);
+            vertices.emplace_back(v, 2.0f*v, 3.0f*v);
+        }
+
+        std::vector<uint32_t> indices(c_NumVertices - (c_NumVertices % 3));
+        std::iota(indices.begin(), indices.end(), uint32_t{0});
+
+        Mesh rv;
+        rv.set_vertices(vertices);
+        rv.set_normals(std::vector<Vec3>(c_NumVertices, Vec3{0.0f, 1.0f, 0.0f}));
+        rv.set_indices(indices);
+        return rv;
+    }
+}
+
+static void BM_MeshReadVerticesViaCopy(benchmark::State& state)
+{
+    const Mesh mesh = GenerateLargeMesh();
+    for ([[maybe_unused]] auto _ : state) {
+        Vec3 sum{};
+        for (const Vec3& v : mesh.vertices()) {
+            sum += v;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_MeshReadVerticesViaCopy);
+
+static void BM_MeshReadVerticesViaView(benchmark::State& state)
+{
+    const Mesh mesh = GenerateLargeMesh();
+    for ([[maybe_unused]] auto _ : state) {
+        Vec3 sum{};
+        for (const Vec3& v : *mesh.try_view_vertices()) {
+            sum += v;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_MeshReadVerticesViaView);
+
+static void BM_MeshModifyVerticesViaCopy(benchmark::State& state)
+{
+    Mesh mesh = GenerateLargeMesh();
+    for ([[maybe_unused]] auto _ : state) {
+        auto vertices = mesh.vertices();
+        for (Vec3& v : vertices) {
+            v *= 1.0001f;
+        }
+        mesh.set_vertices(vertices);
+        benchmark::DoNotOptimize(mesh.bounds());
+    }
+}
+BENCHMARK(BM_MeshModifyVerticesViaCopy);
+
+static void BM_MeshModifyVerticesInPlace(benchmark::State& state)
+{
+    Mesh mesh = GenerateLargeMesh();
+    for ([[maybe_unused]] auto _ : state) {
+        mesh.modify_vertices([](StridedSpan<Vec3> vertices)
+        {
+            for (Vec3& v : vertices) {
+                v *= 1.0001f;
+            }
+        });
+        benchmark::DoNotOptimize(mesh.bounds());
+    }
+}
+BENCHMARK(BM_MeshModifyVerticesInPlace);
@@ -9,6 +9,7 @@
 #include <span>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <unordered_set>
 #include <utility>
 #include <variant>
@@ -25,7 +26,7 @@ namespace
 
     using ParseResult = std::variant<Landmark, CSVParseWarning, SkipRow>;
 
-    ParseResult ParseRow(size_t lineNum, std::span<std::string const> cols)
+    ParseResult ParseRow(size_t lineNum, std::span<std::string_view const> cols)
     {
         if (cols.empty() || (cols.size() == 1 && strip_whitespace(cols.front()).empty()))
         {
@@ -38,10 +39,10 @@ namespace
 
         // >=4 columns implies that the first column is a label column
         std::optional<std::string> maybeName;
-        std::span<std::string const> data = cols;
+        std::span<std::string_view const> data = cols;
         if (cols.size() >= 4)
         {
-            maybeName = cols.front();
+            maybeName = std::string{cols.front()};
             data = data.subspan(1);
         }
 
@@ -99,15 +100,24 @@ void osc::lm::ReadLandmarksFromCSV(
     std::function<void(Landmark&&)> const& landmarkConsumer,
     std::function<void(CSVParseWarning)> const& warningConsumer)
 {
-    std::vector<std::string> cols;
-    for (size_t line = 0; read_csv_row_into_vector(in, cols); ++line)
+    CSVReader reader{in};
+    ReadLandmarksFromCSV(reader, landmarkConsumer, warningConsumer);
+}
+
+void osc::lm::ReadLandmarksFromCSV(
+    CSVReader& reader,
+    std::function<void(Landmark&&)> const& landmarkConsumer,
+    std::function<void(CSVParseWarning)> const& warningConsumer)
+{
+    size_t line = 0;
+    for (auto cols = reader.next_row(); cols; cols = reader.next_row(), ++line)
     {
         std::visit(Overload
         {
             [&landmarkConsumer](Landmark&& lm) { landmarkConsumer(std::move(lm)); },
             [&warningConsumer](CSVParseWarning&& warning) { warningConsumer(std::move(warning)); },
             [](SkipRow) {}
-        }, ParseRow(line, cols));
+        }, ParseRow(line, *cols));
     }
 }
 
@@ -13,6 +13,8 @@
 #include <string_view>
 #include <vector>
 
+namespace osc { class CSVReader; }
+
 namespace osc::lm
 {
     struct CSVParseWarning final {
@@ -28,6 +30,14 @@ namespace osc::lm
         std::function<void(CSVParseWarning)> const& warningConsumer = [](auto){}
     );
 
+    // as above, but reads the rows from an already-constructed reader (e.g. one that
+    // memory-maps a large landmarks file)
+    void ReadLandmarksFromCSV(
+        CSVReader&,
+        std::function<void(Landmark&&)> const& landmarkConsumer,
+        std::function<void(CSVParseWarning)> const& warningConsumer = [](auto){}
+    );
+
     void WriteLandmarksToCSV(
         std::ostream&,
         std::function<std::optional<Landmark>()> const& landmarkProducer,
@@ -3,8 +3,8 @@
 #include <OpenSimCreator/Documents/MeshImporter/Ground.h>
 #include <OpenSimCreator/Documents/MeshImporter/MIIDs.h>
 
-#include <oscar/Utils/ClonePtr.h>
+#include <memory>
 
 osc::mi::Document::Document() :
-    m_Objects{{MIIDs::Ground(), make_cloneable<Ground>()}}
+    m_Objects{{MIIDs::Ground(), std::make_shared<Ground>()}}
 {}
@@ -3,13 +3,12 @@
 #include <OpenSimCreator/Documents/MeshImporter/IObjectFinder.h>
 #include <OpenSimCreator/Documents/MeshImporter/MIObject.h>
 
-#include <oscar/Utils/ClonePtr.h>
+#include <oscar/Utils/PersistentMap.h>
 #include <oscar/Utils/UID.h>
 
 #include <concepts>
 #include <cstddef>
 #include <iterator>
-#include <map>
 #include <memory>
 #include <sstream>
 #include <stdexcept>
@@ -33,9 +32,16 @@ namespace osc::mi
     // - Must have value semantics, so that other code such as the undo/redo buffer can
     //   copy an entire document somewhere else in memory without having to worry about
     //   aliased mutations
+    //
+    // - Must be cheap to copy, because the undo/redo buffer copies the document on each
+    //   commit. Objects are therefore held in a persistent map, and are shared between
+    //   copies until they're updated (`upd*`), which copies the object (and the map's path
+    //   to it). This means that a mutable reference to an object shouldn't be held across a
+    //   copy of the document (it might refer to an object in the copy too), and that a
+    //   reference that was obtained before an `upd*` call might refer to the pre-update object
     class Document final : public IObjectFinder {
 
-        using ObjectLookup = std::map<UID, ClonePtr<MIObject>>;
+        using ObjectLookup = PersistentMap<UID, std::shared_ptr<MIObject>>;
 
         // helper class for iterating over document objects
         template<std::derived_from<MIObject> T>
@@ -49,11 +55,7 @@ namespace osc::mi
             using iterator_category = std::forward_iterator_tag;
 
             // caller-provided iterator
-            using InternalIterator = std::conditional_t<
-                std::is_const_v<T>,
-                ObjectLookup::const_iterator,
-                ObjectLookup::iterator
-            >;
+            using InternalIterator = ObjectLookup::const_iterator;
 
             Iterator() = default;
 
@@ -125,9 +127,7 @@ namespace osc::mi
         template<std::derived_from<MIObject> T>
         class Iterable final {
         public:
-            using MapRef = std::conditional_t<std::is_const_v<T>, ObjectLookup const&, ObjectLookup&>;
-
-            explicit Iterable(MapRef objects) :
+            explicit Iterable(ObjectLookup const& objects) :
                 m_Begin{objects.begin(), objects.end()},
                 m_End{objects.end(), objects.end()}
             {
@@ -148,25 +148,30 @@ namespace osc::mi
         template<std::derived_from<MIObject> T = MIObject>
         T* tryUpdByID(UID id)
         {
-            return findByID<T>(m_Objects, id);
+            if (!tryGetByID<T>(id))
+            {
+                return nullptr;  // don't un-share anything if there's nothing to update
+            }
+            return downcast<T>(updUnshared(*m_Objects.try_upd(id)));
         }
 
         template<std::derived_from<MIObject> T = MIObject>
         T const* tryGetByID(UID id) const
         {
-            return findByID<T>(m_Objects, id);
+            std::shared_ptr<MIObject> const* const ptr = m_Objects.try_get(id);
+            return ptr ? downcast<T const>(ptr->get()) : nullptr;
         }
 
         template<std::derived_from<MIObject> T = MIObject>
         T& updByID(UID id)
         {
-            return findByIDOrThrow<T>(m_Objects, id);
+            return derefOrThrow<T>(tryUpdByID<T>(id), id);
         }
 
         template<std::derived_from<MIObject> T = MIObject>
         T const& getByID(UID id) const
         {
-            return findByIDOrThrow<T>(m_Objects, id);
+            return derefOrThrow<T const>(tryGetByID<T>(id), id);
         }
 
         CStringView getLabelByID(UID id) const
@@ -196,12 +201,6 @@ namespace osc::mi
             return contains<T>(e.getID());
         }
 
-        template<std::derived_from<MIObject> T = MIObject>
-        Iterable<T> iter()
-        {
-            return Iterable<T>{m_Objects};
-        }
-
         template<std::derived_from<MIObject> T = MIObject>
         Iterable<T const> iter() const
         {
@@ -221,7 +220,8 @@ namespace osc::mi
                 }
             }
 
-            return *m_Objects.emplace(obj->getID(), std::move(obj)).first->second;
+            UID const id = obj->getID();
+            return *updUnshared(*m_Objects.try_emplace(id, std::move(obj)).first);
         }
 
         template<std::derived_from<MIObject> T, typename... Args>
@@ -251,10 +251,10 @@ namespace osc::mi
                 // move object into deletion set, rather than deleting it immediately,
                 // so that code that relies on references to the to-be-deleted object
                 // still works until an explicit `.GarbageCollect()` call
-                if (auto const it = m_Objects.find(deletedID); it != m_Objects.end())
+                if (std::shared_ptr<MIObject> const* const ptr = m_Objects.try_get(deletedID))
                 {
-                    m_DeletedObjects.push_back(std::move(it->second));
-                    m_Objects.erase(it);
+                    m_DeletedObjects.push_back(*ptr);
+                    m_Objects.erase(deletedID);
                 }
             }
 
@@ -349,36 +349,22 @@ namespace osc::mi
             deSelectAll();
         }
     private:
-        template<
-            std::derived_from<MIObject> T = MIObject,
-            typename AssociativeContainer
-        >
-        static T* findByID(AssociativeContainer& container, UID id)
+        template<typename T, typename Object>
+        static T* downcast(Object* obj)
         {
-            auto const it = container.find(id);
-
-            if (it == container.end())
+            if constexpr (std::is_same_v<std::remove_const_t<T>, MIObject>)
             {
-                return nullptr;
-            }
-
-            if constexpr (std::is_same_v<T, MIObject>)
-            {
-                return it->second.get();
+                return obj;
             }
             else
             {
-                return dynamic_cast<T*>(it->second.get());
+                return dynamic_cast<T*>(obj);
             }
         }
 
-        template<
-            std::derived_from<MIObject> T = MIObject,
-            typename AssociativeContainer
-        >
-        static T& findByIDOrThrow(AssociativeContainer& container, UID id)
+        template<typename T>
+        static T& derefOrThrow(T* ptr, UID id)
         {
-            T* ptr = findByID<T>(container, id);
             if (!ptr)
             {
                 std::stringstream msg;
@@ -389,9 +375,19 @@ namespace osc::mi
             return *ptr;
         }
 
+        // returns a mutable pointer to the object, copying it first if it's shared with another document
+        static MIObject* updUnshared(std::shared_ptr<MIObject>& ptr)
+        {
+            if (ptr.use_count() > 1)
+            {
+                ptr = ptr->clone();
+            }
+            return ptr.get();
+        }
+
         MIObject const* implFind(UID id) const final
         {
-            return findByID(m_Objects, id);
+            return tryGetByID(id);
         }
 
         void populateDeletionSet(MIObject const& deletionTarget, std::unordered_set<UID>& out)
@@ -421,6 +417,6 @@ namespace osc::mi
 
         ObjectLookup m_Objects;
         std::unordered_set<UID> m_SelectedObjectIDs;
-        std::vector<ClonePtr<MIObject>> m_DeletedObjects;
+        std::vector<std::shared_ptr<MIObject>> m_DeletedObjects;
     };
 }
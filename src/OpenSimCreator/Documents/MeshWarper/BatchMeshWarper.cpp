@@ -0,0 +1,419 @@
+#include "BatchMeshWarper.h"
+
+#include <OpenSimCreator/Documents/Landmarks/LandmarkHelpers.h>
+#include <OpenSimCreator/Documents/MeshWarper/TPSDocument.h>
+#include <OpenSimCreator/Documents/MeshWarper/TPSDocumentHelpers.h>
+#include <OpenSimCreator/Documents/MeshWarper/TPSDocumentInputIdentifier.h>
+#include <OpenSimCreator/Graphics/SimTKMeshLoader.h>
+#include <OpenSimCreator/Utils/TPS3D.h>
+#include <OpenSimCreator/Utils/TPSFarFieldEvaluator3D.h>
+
+#include <oscar/Formats/OBJ.h>
+#include <oscar/Graphics/Mesh.h>
+#include <oscar/Shims/Cpp20/stop_token.h>
+#include <oscar/Shims/Cpp20/thread.h>
+#include <oscar/Utils/Perf.h>
+#include <oscar/Utils/StringHelpers.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+using namespace osc;
+namespace rgs = std::ranges;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    // a mesh that's moving through the pipeline, along with where it will be written to
+    struct PipelinedMesh final {
+        std::filesystem::path outputPath;
+        Mesh mesh;
+    };
+
+    // a bounded queue of meshes that connects two stages of the pipeline
+    //
+    // the queue is closed once all of its producers are done, and the first failure of
+    // any stage is rethrown in every stage that subsequently uses the queue
+    class PipelinedMeshQueue final {
+    public:
+        PipelinedMeshQueue(size_t capacity, size_t numProducers) :
+            m_Capacity{std::max<size_t>(capacity, 1)},
+            m_NumActiveProducers{numProducers}
+        {}
+
+        // called by a producer: blocks while the queue is full
+        void push(PipelinedMesh&& mesh)
+        {
+            {
+                std::unique_lock lock{m_Mutex};
+                m_Condition.wait(lock, [this]() { return m_Failure or m_Meshes.size() < m_Capacity; });
+
+                if (m_Failure) {
+                    std::rethrow_exception(m_Failure);
+                }
+                m_Meshes.push_back(std::move(mesh));
+            }
+            m_Condition.notify_all();
+        }
+
+        // called by a producer once it won't push any more meshes
+        void producerDone()
+        {
+            {
+                std::lock_guard lock{m_Mutex};
+                --m_NumActiveProducers;
+            }
+            m_Condition.notify_all();
+        }
+
+        // called by the consumer: blocks until a mesh is available, or returns `std::nullopt`
+        // once all producers are done and the queue is drained
+        std::optional<PipelinedMesh> pop()
+        {
+            std::optional<PipelinedMesh> rv;
+            {
+                std::unique_lock lock{m_Mutex};
+                m_Condition.wait(lock, [this]() { return m_Failure or m_NumActiveProducers == 0 or not m_Meshes.empty(); });
+
+                if (m_Failure) {
+                    std::rethrow_exception(m_Failure);
+                }
+                if (m_Meshes.empty()) {
+                    return std::nullopt;
+                }
+                rv = std::move(m_Meshes.front());
+                m_Meshes.pop_front();
+            }
+            m_Condition.notify_all();
+            return rv;
+        }
+
+        // called by any stage if it fails: unblocks (and rethrows the error in) all other users of the queue
+        void fail(std::exception_ptr ex)
+        {
+            {
+                std::lock_guard lock{m_Mutex};
+                if (not m_Failure) {
+                    m_Failure = std::move(ex);
+                }
+                m_Meshes.clear();
+            }
+            m_Condition.notify_all();
+        }
+
+        void rethrowIfFailed()
+        {
+            std::lock_guard lock{m_Mutex};
+            if (m_Failure) {
+                std::rethrow_exception(m_Failure);
+            }
+        }
+
+    private:
+        std::mutex m_Mutex;
+        std::condition_variable m_Condition;
+        std::deque<PipelinedMesh> m_Meshes;
+        size_t m_Capacity;
+        size_t m_NumActiveProducers;
+        std::exception_ptr m_Failure;
+    };
+
+    bool IsSupportedMeshFile(std::filesystem::path const& p)
+    {
+        std::string const extension = p.extension().string();
+        if (extension.empty()) {
+            return false;
+        }
+        return rgs::any_of(GetSupportedSimTKMeshFormats(), [ext = std::string_view{extension}.substr(1)](std::string_view format)
+        {
+            return is_equal_case_insensitive(ext, format);
+        });
+    }
+
+    // returns `true` if `s` matches `pattern`, where `*` matches any sequence of characters and
+    // `?` matches any single character
+    bool MatchesWildcardPattern(std::string_view s, std::string_view pattern)
+    {
+        size_t si = 0;
+        size_t pi = 0;
+        std::optional<size_t> lastStar;
+        size_t lastStarMatch = 0;
+        while (si < s.size()) {
+            if (pi < pattern.size() and (pattern[pi] == '?' or pattern[pi] == s[si])) {
+                ++si;
+                ++pi;
+            }
+            else if (pi < pattern.size() and pattern[pi] == '*') {
+                lastStar = pi++;
+                lastStarMatch = si;
+            }
+            else if (lastStar) {
+                pi = *lastStar + 1;
+                si = ++lastStarMatch;
+            }
+            else {
+                return false;
+            }
+        }
+        while (pi < pattern.size() and pattern[pi] == '*') {
+            ++pi;
+        }
+        return pi == pattern.size();
+    }
+
+    void ReadLandmarksInto(TPSDocument& doc, TPSDocumentInputIdentifier which, std::filesystem::path const& csvPath)
+    {
+        std::ifstream fin{csvPath};
+        if (not fin) {
+            throw std::runtime_error{csvPath.string() + ": cannot open for reading"};
+        }
+        lm::ReadLandmarksFromCSV(fin, [&doc, which](auto&& landmark)
+        {
+            AddLandmarkToInput(doc, which, landmark.position, std::move(landmark.maybeName));
+        });
+    }
+
+    std::vector<std::filesystem::path> CalcOutputPaths(BatchMeshWarperParams const& params)
+    {
+        std::vector<std::filesystem::path> rv;
+        rv.reserve(params.inputMeshes.size());
+        std::unordered_set<std::string> filenames;
+        for (std::filesystem::path const& inputMesh : params.inputMeshes) {
+            std::string filename = inputMesh.stem().string() + ".obj";
+            if (not filenames.insert(filename).second) {
+                throw std::runtime_error{inputMesh.string() + ": another input mesh would also be written to " + filename};
+            }
+            rv.push_back(params.outputDirectory / filename);
+        }
+        return rv;
+    }
+
+    // top-level "main" function that each loader executes
+    void LoaderMain(
+        cpp20::stop_token const&,
+        std::span<std::filesystem::path const> inputPaths,
+        std::span<std::filesystem::path const> outputPaths,
+        std::atomic<size_t>& nextInput,
+        PipelinedMeshQueue& loaded,
+        BatchMeshWarperStageStats& stats)
+    {
+        try {
+            for (size_t i = nextInput++; i < inputPaths.size(); i = nextInput++) {
+                auto const start = Clock::now();
+                Mesh mesh;
+                {
+                    OSC_PERF("BatchMeshWarper/load");
+                    if (not std::filesystem::exists(inputPaths[i])) {
+                        throw std::runtime_error{inputPaths[i].string() + ": no such file"};
+                    }
+                    mesh = LoadMeshViaSimTK(inputPaths[i]);
+                }
+                stats.busyTime += Clock::now() - start;
+                stats.numVertices += mesh.num_vertices();
+                ++stats.numMeshes;
+
+                loaded.push(PipelinedMesh{outputPaths[i], std::move(mesh)});
+            }
+        }
+        catch (...) {
+            loaded.fail(std::current_exception());
+        }
+        loaded.producerDone();
+    }
+
+    // top-level "main" function that the writer executes
+    void WriterMain(
+        cpp20::stop_token const&,
+        BatchMeshWarperParams const& params,
+        PipelinedMeshQueue& warped,
+        BatchMeshWarperStageStats& stats)
+    {
+        try {
+            ObjMetadata const metadata{params.authoringTool};
+            while (std::optional<PipelinedMesh> mesh = warped.pop()) {
+                OSC_PERF("BatchMeshWarper/write");
+                auto const start = Clock::now();
+
+                std::ofstream fout{mesh->outputPath, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary};
+                if (not fout) {
+                    throw std::runtime_error{mesh->outputPath.string() + ": cannot open for writing"};
+                }
+                write_as_obj(fout, mesh->mesh, metadata);
+
+                stats.busyTime += Clock::now() - start;
+                stats.numVertices += mesh->mesh.num_vertices();
+                ++stats.numMeshes;
+            }
+        }
+        catch (...) {
+            warped.fail(std::current_exception());
+        }
+    }
+
+    void PrintStageStats(std::ostream& o, char const* label, BatchMeshWarperStageStats const& stats)
+    {
+        o << "    " << label << ": " << stats.numMeshes << " meshes (" << stats.numVertices << " vertices) on "
+          << stats.numThreads << " thread(s), " << stats.busyTime.count() << " s busy, "
+          << stats.meshesPerSecondPerThread() << " meshes/s (" << stats.verticesPerSecondPerThread() << " vertices/s) per thread\n";
+    }
+}
+
+std::ostream& osc::operator<<(std::ostream& o, BatchMeshWarperReport const& report)
+{
+    o << "BatchMeshWarperReport:\n";
+    o << "    solved " << report.numLandmarkPairs << " landmark pairs in " << report.solveTime.count() << " s\n";
+    o << "    wrote " << report.numMeshesWritten << " meshes in " << report.pipelineTime.count() << " s (" << report.meshesPerSecond() << " meshes/s end-to-end)\n";
+    PrintStageStats(o, "loading", report.loading);
+    PrintStageStats(o, "warping", report.warping);
+    PrintStageStats(o, "writing", report.writing);
+    return o;
+}
+
+std::vector<std::filesystem::path> osc::FindMeshFilesForBatchWarping(std::filesystem::path const& p)
+{
+    std::vector<std::filesystem::path> rv;
+
+    std::string const filename = p.filename().string();
+    if (std::filesystem::is_directory(p)) {
+        for (std::filesystem::directory_entry const& entry : std::filesystem::directory_iterator{p}) {
+            if (entry.is_regular_file() and IsSupportedMeshFile(entry.path())) {
+                rv.push_back(entry.path());
+            }
+        }
+    }
+    else if (filename.find_first_of("*?") != std::string::npos) {
+        std::filesystem::path const directory = p.has_parent_path() ? p.parent_path() : std::filesystem::path{"."};
+        if (not std::filesystem::is_directory(directory)) {
+            throw std::runtime_error{directory.string() + ": no such directory"};
+        }
+        for (std::filesystem::directory_entry const& entry : std::filesystem::directory_iterator{directory}) {
+            if (entry.is_regular_file() and IsSupportedMeshFile(entry.path()) and MatchesWildcardPattern(entry.path().filename().string(), filename)) {
+                rv.push_back(entry.path());
+            }
+        }
+    }
+    else {
+        rv.push_back(p);  // (assumed to be a mesh file: loading it reports any errors)
+    }
+
+    rgs::sort(rv);
+    return rv;
+}
+
+BatchMeshWarperReport osc::WarpMeshesInBatch(BatchMeshWarperParams const& params)
+{
+    OSC_PERF("WarpMeshesInBatch");
+
+    BatchMeshWarperReport rv;
+    rv.loading.numThreads = std::max<size_t>(params.numLoaderThreads, 1);
+    rv.warping.numThreads = 1;
+    rv.writing.numThreads = 1;
+
+    // solve the coefficients once, up-front
+    auto const solveStart = Clock::now();
+    TPSDocument doc;
+    ReadLandmarksInto(doc, TPSDocumentInputIdentifier::Source, params.sourceLandmarksCSV);
+    ReadLandmarksInto(doc, TPSDocumentInputIdentifier::Destination, params.destinationLandmarksCSV);
+    TPSCoefficientSolverInputs3D const inputs{GetLandmarkPairs(doc)};
+    if (inputs.landmarks.empty()) {
+        throw std::runtime_error{"the source/destination landmarks don't contain any pairs"};
+    }
+    TPSCoefficients3D const coefficients = CalcCoefficients(inputs);
+    std::optional<TPSFarFieldEvaluator3D> farFieldEvaluator;
+    if (params.errorTolerance) {
+        farFieldEvaluator.emplace(coefficients, *params.errorTolerance);
+    }
+    rv.numLandmarkPairs = inputs.landmarks.size();
+    rv.solveTime = Clock::now() - solveStart;
+
+    std::vector<std::filesystem::path> const outputPaths = CalcOutputPaths(params);
+    if (outputPaths.empty()) {
+        return rv;
+    }
+    std::filesystem::create_directories(params.outputDirectory);
+
+    auto const pipelineStart = Clock::now();
+    PipelinedMeshQueue loaded{params.maxMeshesInFlight, rv.loading.numThreads};
+    PipelinedMeshQueue warped{params.maxMeshesInFlight, 1};
+    std::atomic<size_t> nextInput = 0;
+    std::vector<BatchMeshWarperStageStats> loaderStats(rv.loading.numThreads);
+
+    // note: declared outside of the `try` block, so that the threads are only joined
+    //       after the pipeline has been failed (otherwise, they could deadlock)
+    std::vector<cpp20::jthread> loaders;
+    cpp20::jthread writer;
+    try {
+        loaders.reserve(loaderStats.size());
+        for (BatchMeshWarperStageStats& stats : loaderStats) {
+            loaders.emplace_back(
+                LoaderMain,
+                std::span<std::filesystem::path const>{params.inputMeshes},
+                std::span<std::filesystem::path const>{outputPaths},
+                std::ref(nextInput),
+                std::ref(loaded),
+                std::ref(stats)
+            );
+        }
+        writer = cpp20::jthread{WriterMain, std::cref(params), std::ref(warped), std::ref(rv.writing)};
+
+        // warp each mesh on this thread (the warp itself is parallelized over the mesh's vertices)
+        while (std::optional<PipelinedMesh> mesh = loaded.pop()) {
+            OSC_PERF("BatchMeshWarper/warp");
+            auto const start = Clock::now();
+
+            Mesh result = farFieldEvaluator ?
+                farFieldEvaluator->applyWarpToMesh(mesh->mesh, params.blendingFactor) :
+                ApplyThinPlateWarpToMesh(coefficients, mesh->mesh, params.blendingFactor);
+            if (params.recalculateNormals) {
+                result.recalculate_normals();
+            }
+
+            rv.warping.busyTime += Clock::now() - start;
+            rv.warping.numVertices += result.num_vertices();
+            ++rv.warping.numMeshes;
+
+            warped.push(PipelinedMesh{std::move(mesh->outputPath), std::move(result)});
+        }
+        warped.producerDone();
+    }
+    catch (...) {
+        loaded.fail(std::current_exception());
+        warped.fail(std::current_exception());
+        throw;
+    }
+
+    // drain the writer
+    writer.join();
+    for (cpp20::jthread& loader : loaders) {
+        loader.join();
+    }
+    warped.rethrowIfFailed();
+
+    for (BatchMeshWarperStageStats const& stats : loaderStats) {
+        rv.loading.numMeshes += stats.numMeshes;
+        rv.loading.numVertices += stats.numVertices;
+        rv.loading.busyTime += stats.busyTime;
+    }
+    rv.numMeshesWritten = rv.writing.numMeshes;
+    rv.pipelineTime = Clock::now() - pipelineStart;
+    return rv;
+}
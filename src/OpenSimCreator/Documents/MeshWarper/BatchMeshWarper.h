@@ -0,0 +1,111 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace osc
+{
+    // parameters for warping many meshes with the same landmark pairs
+    struct BatchMeshWarperParams final {
+
+        // CSV files containing the source/destination landmarks (same format as the mesh
+        // warper's "load landmarks from CSV" action: landmarks are paired by name, or
+        // in-order if they're unnamed)
+        std::filesystem::path sourceLandmarksCSV;
+        std::filesystem::path destinationLandmarksCSV;
+
+        // meshes that should be warped (see: `FindMeshFilesForBatchWarping`)
+        std::vector<std::filesystem::path> inputMeshes;
+
+        // directory that the warped meshes are written to (created if it doesn't exist)
+        //
+        // each warped mesh is written as `{outputDirectory}/{inputMesh.stem()}.obj`
+        std::filesystem::path outputDirectory;
+
+        // written into the header of each warped mesh file
+        std::string authoringTool = "OpenSim Creator";
+
+        float blendingFactor = 1.0f;
+
+        // if provided, the meshes are warped with `TPSFarFieldEvaluator3D` (i.e. approximately,
+        // but faster when there are many landmarks), rather than exactly
+        std::optional<float> errorTolerance;
+
+        // if `true`, the warped meshes' normals are recalculated from their (warped) triangles
+        bool recalculateNormals = true;
+
+        // how many background threads load meshes for the warping stage
+        size_t numLoaderThreads = 2;
+
+        // how many meshes the loading/writing stages may run ahead of/behind the warping stage
+        size_t maxMeshesInFlight = 4;
+    };
+
+    // throughput of one stage of the batch warping pipeline
+    struct BatchMeshWarperStageStats final {
+
+        // meshes per second that each thread in the stage achieved while busy (`busyTime` is
+        // summed over the stage's threads, so this is the average thread's throughput)
+        double meshesPerSecondPerThread() const
+        {
+            return busyTime.count() > 0.0 ? static_cast<double>(numMeshes) / busyTime.count() : 0.0;
+        }
+
+        // vertices per second that each thread in the stage achieved while busy
+        double verticesPerSecondPerThread() const
+        {
+            return busyTime.count() > 0.0 ? static_cast<double>(numVertices) / busyTime.count() : 0.0;
+        }
+
+        size_t numThreads = 1;
+        size_t numMeshes = 0;
+        size_t numVertices = 0;
+        std::chrono::duration<double> busyTime{};  // summed over all threads in the stage
+    };
+
+    // a summary of a (completed) batch warping run
+    struct BatchMeshWarperReport final {
+
+        // end-to-end meshes per second of the whole pipeline (excl. solving the coefficients)
+        double meshesPerSecond() const
+        {
+            return pipelineTime.count() > 0.0 ? static_cast<double>(numMeshesWritten) / pipelineTime.count() : 0.0;
+        }
+
+        size_t numLandmarkPairs = 0;
+        size_t numMeshesWritten = 0;
+        std::chrono::duration<double> solveTime{};
+        std::chrono::duration<double> pipelineTime{};
+        BatchMeshWarperStageStats loading;
+        BatchMeshWarperStageStats warping;
+        BatchMeshWarperStageStats writing;
+    };
+
+    std::ostream& operator<<(std::ostream&, BatchMeshWarperReport const&);
+
+    // returns the (sorted) mesh files that the given path refers to, which may be:
+    //
+    // - a mesh file
+    // - a directory, in which case all mesh files in it are returned (non-recursively)
+    // - a glob-like pattern, where the filename part may contain `*` and `?` wildcards
+    //   (e.g. `Geometry/*.vtp`), in which case all matching mesh files are returned
+    //
+    // throws if the path's directory doesn't exist
+    std::vector<std::filesystem::path> FindMeshFilesForBatchWarping(std::filesystem::path const&);
+
+    // warps each input mesh with the TPS warp defined by the source/destination landmarks
+    // and writes the results to the output directory without any UI
+    //
+    // the TPS coefficients are solved once, up-front. After that, the work is pipelined:
+    // meshes are loaded on background threads while previously loaded meshes are warped
+    // (in parallel) on the calling thread, and warped meshes are written on a writer thread
+    //
+    // - throws if the landmarks don't contain any pairs, if two inputs would be written
+    //   to the same output file, or if any stage of the pipeline fails
+    BatchMeshWarperReport WarpMeshesInBatch(BatchMeshWarperParams const&);
+}
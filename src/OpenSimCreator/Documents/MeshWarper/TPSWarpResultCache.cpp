@@ -0,0 +1,329 @@
+#include "TPSWarpResultCache.h"
+
+#include <OpenSimCreator/Documents/MeshWarper/TPSDocument.h>
+#include <OpenSimCreator/Documents/MeshWarper/TPSDocumentHelpers.h>
+#include <OpenSimCreator/Documents/MeshWarper/TPSDocumentNonParticipatingLandmark.h>
+#include <OpenSimCreator/Utils/TPS.h>
+#include <OpenSimCreator/Utils/TPS3D.h>
+
+#include <oscar/Graphics/Mesh.h>
+#include <oscar/Graphics/MeshFunctions.h>
+#include <oscar/Maths/Vec3.h>
+#include <oscar/Utils/Algorithms.h>
+#include <oscar/Utils/LatestRequestWorker.h>
+#include <oscar/Utils/Perf.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <utility>
+#include <vector>
+
+using namespace osc;
+namespace rgs = std::ranges;
+
+namespace
+{
+    // everything the worker needs in order to warp the full-resolution mesh
+    struct MeshWarpRequest final {
+        TPSCoefficients3D coefficients;
+        Mesh sourceMesh;
+        float blendingFactor = 1.0f;
+    };
+
+    // warps the request's mesh in chunks, so that the warp can be cancelled part-way through
+    std::optional<Mesh> WarpMeshInChunks(MeshWarpRequest const& request, LatestRequestCancellation const& cancellation)
+    {
+        OSC_PERF("TPSResultCache/WarpMeshInChunks");
+
+        constexpr size_t c_ChunkSize = 1<<16;
+        std::vector<Vec3> vertices = request.sourceMesh.vertices();
+        for (size_t offset = 0; offset < vertices.size(); offset += c_ChunkSize) {
+            cancellation.throw_if_cancelled();
+            std::span<Vec3> const chunk = std::span{vertices}.subspan(offset, min(c_ChunkSize, vertices.size() - offset));
+            ApplyThinPlateWarpToPointsInPlace(request.coefficients, chunk, request.blendingFactor);
+        }
+        cancellation.throw_if_cancelled();
+
+        Mesh rv = request.sourceMesh;
+        rv.set_vertices(vertices);
+        return rv;
+    }
+}
+
+class osc::TPSResultCache::Impl final {
+public:
+    Impl(size_t maxSynchronouslyWarpedVertices, std::function<void()> onBackgroundWarpCompleted) :
+        m_MaxSynchronouslyWarpedVertices{maxSynchronouslyWarpedVertices},
+        m_Worker{"TPSResultCache", WarpMeshInChunks, std::move(onBackgroundWarpCompleted)}
+    {}
+
+    Impl(Impl const&) = delete;
+    Impl(Impl&&) noexcept = delete;
+    Impl& operator=(Impl const&) = delete;
+    Impl& operator=(Impl&&) noexcept = delete;
+
+    ~Impl() noexcept = default;
+
+    Mesh const& getWarpedMesh(TPSDocument const& doc)
+    {
+        updateAll(doc);
+        poll();
+        return m_CachedResultMesh;
+    }
+
+    Mesh const& getFullResolutionWarpedMesh(TPSDocument const& doc)
+    {
+        updateAll(doc);
+        wait();
+
+        if (m_CachedResultMeshIsPreview)
+        {
+            // the worker processed the latest request, but didn't produce a result, because
+            // the background warp failed (the worker logs why), so retry it on the caller's
+            // thread, which propagates the error to the caller if it fails again
+            OSC_PERF("TPSResultCache/synchronousFullResolutionWarp");
+            m_CachedResultMesh = ApplyThinPlateWarpToMesh(m_CachedCoefficients, m_CachedSourceMesh, m_CachedBlendingFactor);
+            m_CachedResultMeshIsPreview = false;
+        }
+        return m_CachedResultMesh;
+    }
+
+    bool isWarpedMeshAPreview() const
+    {
+        return m_CachedResultMeshIsPreview;
+    }
+
+    std::span<Vec3 const> getWarpedNonParticipatingLandmarkLocations(TPSDocument const& doc)
+    {
+        updateAll(doc);
+        return m_CachedResultNonParticipatingLandmarks;
+    }
+
+private:
+    using Worker = LatestRequestWorker<MeshWarpRequest, Mesh>;
+
+    void updateAll(TPSDocument const& doc)
+    {
+        bool const updatedCoefficients = updateCoefficients(doc);
+        bool const updatedNonParticipatingLandmarks = updateSourceNonParticipatingLandmarks(doc);
+        bool const updatedMesh = updateInputMesh(doc);
+        bool const updatedBlendingFactor = updateBlendingFactor(doc);
+
+        if (updatedCoefficients || updatedMesh || updatedBlendingFactor)
+        {
+            requestMeshWarp();
+        }
+
+        if (updatedCoefficients || updatedNonParticipatingLandmarks || updatedBlendingFactor)
+        {
+            m_CachedResultNonParticipatingLandmarks = ApplyThinPlateWarpToPoints(m_CachedCoefficients, m_CachedSourceNonParticipatingLandmarks, m_CachedBlendingFactor);
+        }
+    }
+
+    // (re)warps the mesh: small meshes are warped immediately, large meshes are previewed
+    // immediately and warped at full-resolution in the background
+    void requestMeshWarp()
+    {
+        if (m_CachedSourceMesh.num_vertices() <= m_MaxSynchronouslyWarpedVertices)
+        {
+            m_Worker.supersede();  // cancels any in-flight work
+
+            m_CachedResultMesh = ApplyThinPlateWarpToMesh(m_CachedCoefficients, m_CachedSourceMesh, m_CachedBlendingFactor);
+            m_CachedResultMeshIsPreview = false;
+        }
+        else
+        {
+            m_Worker.request(MeshWarpRequest{  // replaces (cancels) any stale request
+                .coefficients = m_CachedCoefficients,
+                .sourceMesh = m_CachedSourceMesh,
+                .blendingFactor = m_CachedBlendingFactor,
+            });
+
+            m_CachedResultMesh = ApplyThinPlateWarpToMesh(m_CachedCoefficients, m_CachedPreviewSourceMesh, m_CachedBlendingFactor);
+            m_CachedResultMeshIsPreview = true;
+        }
+    }
+
+    // swaps the worker's full-resolution result into the cache, if it's the latest one
+    void poll()
+    {
+        swapIntoCache(m_Worker.poll());
+    }
+
+    // blocks until the worker has processed the latest request, then `poll`s
+    void wait()
+    {
+        swapIntoCache(m_Worker.wait());
+    }
+
+    void swapIntoCache(std::optional<Worker::Completed> completed)
+    {
+        // (stale results, e.g. of a warp that finished just as it was superseded, are dropped)
+        if (completed and completed->request_id == m_Worker.latest_request_id())
+        {
+            m_CachedResultMesh = std::move(completed->result);
+            m_CachedResultMeshIsPreview = false;
+        }
+    }
+
+    // returns `true` if cached inputs were updated; otherwise, returns the cached inputs
+    bool updateInputs(TPSDocument const& doc)
+    {
+        TPSCoefficientSolverInputs3D newInputs
+        {
+            GetLandmarkPairs(doc),
+        };
+
+        if (newInputs != m_CachedInputs)
+        {
+            m_CachedInputs = std::move(newInputs);
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    // returns `true` if cached coefficients were updated
+    bool updateCoefficients(TPSDocument const& doc)
+    {
+        if (!updateInputs(doc))
+        {
+            // cache: the inputs have not been updated, so the coefficients will not change
+            return false;
+        }
+
+        // (the solver only refactorizes if the source landmarks changed, so the most common
+        // edit, dragging a destination landmark around, only costs a back-substitution)
+        TPSCoefficients3D newCoefficients = CalcCoefficients(m_CachedInputs, m_CoefficientSolver);
+
+        if (newCoefficients != m_CachedCoefficients)
+        {
+            m_CachedCoefficients = std::move(newCoefficients);
+            return true;
+        }
+        else
+        {
+            return false;  // no change in the coefficients
+        }
+    }
+
+    bool updateSourceNonParticipatingLandmarks(TPSDocument const& doc)
+    {
+        auto const& docLandmarks = doc.nonParticipatingLandmarks;
+
+        bool const samePositions = rgs::equal(
+            docLandmarks,
+            m_CachedSourceNonParticipatingLandmarks,
+            [](TPSDocumentNonParticipatingLandmark const& lm, Vec3 const& pos)
+            {
+                return lm.location == pos;
+            }
+        );
+
+        if (!samePositions)
+        {
+            m_CachedSourceNonParticipatingLandmarks.clear();
+            rgs::transform(
+                docLandmarks,
+                std::back_inserter(m_CachedSourceNonParticipatingLandmarks),
+                [](auto const& lm) { return lm.location; }
+            );
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    // returns `true` if `m_CachedSourceMesh` is updated
+    bool updateInputMesh(TPSDocument const& doc)
+    {
+        if (m_CachedSourceMesh != doc.sourceMesh)
+        {
+            m_CachedSourceMesh = doc.sourceMesh;
+            if (m_CachedSourceMesh.num_vertices() > m_MaxSynchronouslyWarpedVertices)
+            {
+                OSC_PERF("TPSResultCache/decimate_by_vertex_clustering");
+                m_CachedPreviewSourceMesh = decimate_by_vertex_clustering(m_CachedSourceMesh, m_MaxSynchronouslyWarpedVertices);
+            }
+            else
+            {
+                m_CachedPreviewSourceMesh.clear();
+            }
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    bool updateBlendingFactor(TPSDocument const& doc)
+    {
+        if (m_CachedBlendingFactor != doc.blendingFactor) {
+            m_CachedBlendingFactor = doc.blendingFactor;
+            return true;
+        }
+        else {
+            return false;
+        }
+    }
+
+    // caller-side state
+    size_t m_MaxSynchronouslyWarpedVertices;
+    TPSCoefficientSolverInputs3D m_CachedInputs;
+    TPSCoefficientSolver<3> m_CoefficientSolver;
+    TPSCoefficients3D m_CachedCoefficients;
+    Mesh m_CachedSourceMesh;
+    Mesh m_CachedPreviewSourceMesh;
+    float m_CachedBlendingFactor = 1.0f;
+    Mesh m_CachedResultMesh;
+    bool m_CachedResultMeshIsPreview = false;
+    std::vector<Vec3> m_CachedSourceNonParticipatingLandmarks;
+    std::vector<Vec3> m_CachedResultNonParticipatingLandmarks;
+
+    // worker (joined on destruction, so must be declared last)
+    Worker m_Worker;
+};
+
+
+// public API (PIMPL)
+
+osc::TPSResultCache::TPSResultCache(
+    size_t maxSynchronouslyWarpedVertices,
+    std::function<void()> onBackgroundWarpCompleted) :
+
+    m_Impl{std::make_unique<Impl>(maxSynchronouslyWarpedVertices, std::move(onBackgroundWarpCompleted))}
+{}
+osc::TPSResultCache::TPSResultCache(TPSResultCache&&) noexcept = default;
+osc::TPSResultCache& osc::TPSResultCache::operator=(TPSResultCache&&) noexcept = default;
+osc::TPSResultCache::~TPSResultCache() noexcept = default;
+
+Mesh const& osc::TPSResultCache::getWarpedMesh(TPSDocument const& doc)
+{
+    return m_Impl->getWarpedMesh(doc);
+}
+
+Mesh const& osc::TPSResultCache::getFullResolutionWarpedMesh(TPSDocument const& doc)
+{
+    return m_Impl->getFullResolutionWarpedMesh(doc);
+}
+
+bool osc::TPSResultCache::isWarpedMeshAPreview() const
+{
+    return m_Impl->isWarpedMeshAPreview();
+}
+
+std::span<Vec3 const> osc::TPSResultCache::getWarpedNonParticipatingLandmarkLocations(TPSDocument const& doc)
+{
+    return m_Impl->getWarpedNonParticipatingLandmarkLocations(doc);
+}
@@ -1,19 +1,14 @@
 #pragma once
 
-#include <OpenSimCreator/Documents/MeshWarper/TPSDocument.h>
-#include <OpenSimCreator/Documents/MeshWarper/TPSDocumentHelpers.h>
-#include <OpenSimCreator/Utils/TPS3D.h>
-
-#include <oscar/Graphics/Mesh.h>
 #include <oscar/Maths/Vec3.h>
 
-#include <algorithm>
-#include <ranges>
+#include <cstddef>
+#include <functional>
+#include <memory>
 #include <span>
-#include <utility>
-#include <vector>
 
-namespace rgs = std::ranges;
+namespace osc { class Mesh; }
+namespace osc { struct TPSDocument; }
 
 namespace osc
 {
@@ -21,137 +16,49 @@ namespace osc
     //
     // caches the result of an (expensive) TPS warp of the mesh by checking
     // whether the warping parameters have changed
+    //
+    // large meshes are warped progressively, so that (e.g.) dragging a landmark around doesn't
+    // block the caller for a time that's proportional to the size of the mesh:
+    //
+    // - a decimated preview of the mesh is warped immediately (on the caller's thread)
+    // - the full-resolution mesh is then warped on a background worker
+    // - newer warping parameters cancel any stale (in-progress) background warp
+    // - `getWarpedMesh` always returns the most recently completed warp
     class TPSResultCache final {
     public:
-        Mesh const& getWarpedMesh(TPSDocument const& doc)
-        {
-            updateAll(doc);
-            return m_CachedResultMesh;
-        }
-
-        std::span<Vec3 const> getWarpedNonParticipatingLandmarkLocations(TPSDocument const& doc)
-        {
-            updateAll(doc);
-            return m_CachedResultNonParticipatingLandmarks;
-        }
+        // meshes that have more vertices than this are warped progressively (by default)
+        static constexpr size_t c_DefaultMaxSynchronouslyWarpedVertices = 16384;
+
+        // `onBackgroundWarpCompleted` is called (on the background worker's thread) whenever a
+        // full-resolution warp completes, so that the UI can (e.g.) request a redraw
+        explicit TPSResultCache(
+            size_t maxSynchronouslyWarpedVertices = c_DefaultMaxSynchronouslyWarpedVertices,
+            std::function<void()> onBackgroundWarpCompleted = []() {}
+        );
+        TPSResultCache(TPSResultCache const&) = delete;
+        TPSResultCache(TPSResultCache&&) noexcept;
+        TPSResultCache& operator=(TPSResultCache const&) = delete;
+        TPSResultCache& operator=(TPSResultCache&&) noexcept;
+        ~TPSResultCache() noexcept;
+
+        // returns the most recently completed warp of the document's source mesh, which may be a
+        // (decimated) preview while the full-resolution mesh is being warped in the background
+        Mesh const& getWarpedMesh(TPSDocument const&);
+
+        // returns the full-resolution warp of the document's source mesh, blocking until any
+        // background warping has completed (e.g. because the caller wants to export the mesh)
+        //
+        // never returns a preview: if the background warp failed, the mesh is warped on the
+        // calling thread instead (and any error from that is thrown to the caller)
+        Mesh const& getFullResolutionWarpedMesh(TPSDocument const&);
+
+        // returns `true` if the most recently returned warped mesh is a (decimated) preview
+        bool isWarpedMeshAPreview() const;
+
+        std::span<Vec3 const> getWarpedNonParticipatingLandmarkLocations(TPSDocument const&);
 
     private:
-        void updateAll(TPSDocument const& doc)
-        {
-            bool const updatedCoefficients = updateCoefficients(doc);
-            bool const updatedNonParticipatingLandmarks = updateSourceNonParticipatingLandmarks(doc);
-            bool const updatedMesh = updateInputMesh(doc);
-            bool const updatedBlendingFactor = updateBlendingFactor(doc);
-
-            if (updatedCoefficients || updatedNonParticipatingLandmarks || updatedMesh || updatedBlendingFactor)
-            {
-                m_CachedResultMesh = ApplyThinPlateWarpToMesh(m_CachedCoefficients, m_CachedSourceMesh, m_CachedBlendingFactor);
-                m_CachedResultNonParticipatingLandmarks = ApplyThinPlateWarpToPoints(m_CachedCoefficients, m_CachedSourceNonParticipatingLandmarks, m_CachedBlendingFactor);
-            }
-        }
-
-        // returns `true` if cached inputs were updated; otherwise, returns the cached inputs
-        bool updateInputs(TPSDocument const& doc)
-        {
-            TPSCoefficientSolverInputs3D newInputs
-            {
-                GetLandmarkPairs(doc),
-            };
-
-            if (newInputs != m_CachedInputs)
-            {
-                m_CachedInputs = std::move(newInputs);
-                return true;
-            }
-            else
-            {
-                return false;
-            }
-        }
-
-        // returns `true` if cached coefficients were updated
-        bool updateCoefficients(TPSDocument const& doc)
-        {
-            if (!updateInputs(doc))
-            {
-                // cache: the inputs have not been updated, so the coefficients will not change
-                return false;
-            }
-
-            TPSCoefficients3D newCoefficients = CalcCoefficients(m_CachedInputs);
-
-            if (newCoefficients != m_CachedCoefficients)
-            {
-                m_CachedCoefficients = std::move(newCoefficients);
-                return true;
-            }
-            else
-            {
-                return false;  // no change in the coefficients
-            }
-        }
-
-
-        bool updateSourceNonParticipatingLandmarks(TPSDocument const& doc)
-        {
-            auto const& docLandmarks = doc.nonParticipatingLandmarks;
-
-            bool const samePositions = rgs::equal(
-                docLandmarks,
-                m_CachedSourceNonParticipatingLandmarks,
-                [](TPSDocumentNonParticipatingLandmark const& lm, Vec3 const& pos)
-                {
-                    return lm.location == pos;
-                }
-            );
-
-            if (!samePositions)
-            {
-                m_CachedSourceNonParticipatingLandmarks.clear();
-                rgs::transform(
-                    docLandmarks,
-                    std::back_inserter(m_CachedSourceNonParticipatingLandmarks),
-                    [](auto const& lm) { return lm.location; }
-                );
-                return true;
-            }
-            else
-            {
-                return false;
-            }
-        }
-
-        // returns `true` if `m_CachedSourceMesh` is updated
-        bool updateInputMesh(TPSDocument const& doc)
-        {
-            if (m_CachedSourceMesh != doc.sourceMesh)
-            {
-                m_CachedSourceMesh = doc.sourceMesh;
-                return true;
-            }
-            else
-            {
-                return false;
-            }
-        }
-
-        bool updateBlendingFactor(TPSDocument const& doc)
-        {
-            if (m_CachedBlendingFactor != doc.blendingFactor) {
-                m_CachedBlendingFactor = doc.blendingFactor;
-                return true;
-            }
-            else {
-                return false;
-            }
-        }
-
-        TPSCoefficientSolverInputs3D m_CachedInputs;
-        TPSCoefficients3D m_CachedCoefficients;
-        Mesh m_CachedSourceMesh;
-        float m_CachedBlendingFactor = 1.0f;
-        Mesh m_CachedResultMesh;
-        std::vector<Vec3> m_CachedSourceNonParticipatingLandmarks;
-        std::vector<Vec3> m_CachedResultNonParticipatingLandmarks;
+        class Impl;
+        std::unique_ptr<Impl> m_Impl;
     };
 }
@@ -0,0 +1,12 @@
+#include "IConstModelStatePair.h"
+
+#include <OpenSimCreator/Utils/OpenSimHelpers.h>
+
+#include <OpenSim/Common/Component.h>
+#include <OpenSim/Common/ComponentPath.h>
+#include <OpenSim/Simulation/Model/Model.h>
+
+OpenSim::Component const* osc::IConstModelStatePair::implFindComponent(OpenSim::ComponentPath const& path) const
+{
+    return FindComponent(getModel(), path);
+}
@@ -2,7 +2,10 @@
 
 #include <oscar/Utils/UID.h>
 
+#include <concepts>
+
 namespace OpenSim { class Component; }
+namespace OpenSim { class ComponentPath; }
 namespace OpenSim { class Model; }
 namespace SimTK { class State; }
 
@@ -38,6 +41,22 @@ namespace osc
             return implGetStateVersion();
         }
 
+        // returns the component at `path` in the model, or `nullptr` if it doesn't exist
+        //
+        // equivalent to `FindComponent(getModel(), path)`, but implementations may
+        // accelerate it (e.g. with a path index that's rebuilt per model version), so
+        // prefer this when repeatedly looking up components in a model-state pair
+        OpenSim::Component const* findComponent(OpenSim::ComponentPath const& path) const
+        {
+            return implFindComponent(path);
+        }
+
+        template<std::derived_from<OpenSim::Component> T>
+        T const* findComponentAs(OpenSim::ComponentPath const& path) const
+        {
+            return dynamic_cast<T const*>(findComponent(path));
+        }
+
         OpenSim::Component const* getSelected() const
         {
             return implGetSelected();
@@ -77,6 +96,8 @@ namespace osc
             return UID{};
         }
 
+        virtual OpenSim::Component const* implFindComponent(OpenSim::ComponentPath const&) const;
+
         virtual OpenSim::Component const* implGetSelected() const
         {
             return nullptr;
@@ -3,19 +3,145 @@
 #include <OpenSimCreator/Documents/Model/IConstModelStatePair.h>
 #include <OpenSimCreator/Utils/OpenSimHelpers.h>
 
+#include <OpenSim/Common/ModelDisplayHints.h>
+#include <OpenSim/Common/XMLDocument.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <oscar/Utils/CStringView.h>
+#include <oscar/Utils/Perf.h>
 #include <oscar/Utils/SynchronizedValueGuard.h>
 #include <oscar/Utils/UID.h>
+#include <SimTKcommon/internal/Xml.h>
 
+#include <algorithm>
 #include <chrono>
+#include <cstddef>
 #include <memory>
 #include <mutex>
+#include <stdexcept>
 #include <string>
 #include <string_view>
+#include <utility>
 
 using namespace osc;
 
+namespace
+{
+    // maximum number of consecutive delta commits before a new keyframe is stored
+    //
+    // (keeps the lifetime of a keyframe, which is shared by its deltas, bounded)
+    inline constexpr size_t c_MaxDeltasPerKeyframe = 32;
+
+    // returns the serialized (.osim) representation of the model
+    std::string SerializeModel(OpenSim::Model const& model)
+    {
+        OSC_PERF("ModelStateCommit/SerializeModel");
+
+        OpenSim::XMLDocument doc;
+        model.updateXMLNode(doc.getRootElement());
+
+        SimTK::String rv;
+        doc.writeToString(rv, true);  // compact: it's never read by a human
+        return std::move(rv);
+    }
+
+    // returns a new (uninitialized) model that is deserialized from its (.osim) representation
+    std::unique_ptr<OpenSim::Model> DeserializeModel(std::string const& serialized)
+    {
+        OSC_PERF("ModelStateCommit/DeserializeModel");
+
+        OpenSim::XMLDocument doc;
+        doc.readFromString(serialized);
+
+        SimTK::Xml::Element root = doc.getRootElement();
+        auto const it = root.element_begin("Model");
+        if (it == root.element_end()) {
+            throw std::runtime_error{"cannot find a <Model> element in a serialized model commit: this is a bug"};
+        }
+
+        auto rv = std::make_unique<OpenSim::Model>();
+        rv->updateFromXMLNode(*it, OpenSim::XMLDocument::getLatestVersion());
+        return rv;
+    }
+
+    // storage for a serialized model, which is either a full "keyframe" or a delta against
+    // a keyframe that's shared with other commits
+    class SerializedModel final {
+    public:
+        // stores `serialized` as a keyframe
+        explicit SerializedModel(std::string serialized) :
+            m_Keyframe{std::make_shared<std::string const>(std::move(serialized))}
+        {}
+
+        // stores `serialized` as a delta against `parent`'s keyframe, or as a new keyframe
+        // if a delta would be too large (or the delta chain is too long)
+        SerializedModel(std::string serialized, SerializedModel const& parent) :
+            m_Keyframe{parent.m_Keyframe},
+            m_NumDeltasSinceKeyframe{parent.m_NumDeltasSinceKeyframe + 1}
+        {
+            std::string const& keyframe = *m_Keyframe;
+
+            // most commits edit one region of the model (e.g. a single property), so a
+            // (common prefix, replacement, common suffix) delta is small in practice
+            size_t const maxCommon = std::min(keyframe.size(), serialized.size());
+            size_t const prefixLength = std::mismatch(
+                keyframe.begin(),
+                keyframe.begin() + static_cast<ptrdiff_t>(maxCommon),
+                serialized.begin()
+            ).first - keyframe.begin();
+            size_t const suffixLength = std::mismatch(
+                keyframe.rbegin(),
+                keyframe.rbegin() + static_cast<ptrdiff_t>(maxCommon - prefixLength),
+                serialized.rbegin()
+            ).first - keyframe.rbegin();
+            size_t const replacementLength = serialized.size() - prefixLength - suffixLength;
+
+            if (m_NumDeltasSinceKeyframe > c_MaxDeltasPerKeyframe or 2*replacementLength > keyframe.size()) {
+                *this = SerializedModel{std::move(serialized)};
+                return;
+            }
+
+            m_PrefixLength = prefixLength;
+            m_SuffixLength = suffixLength;
+            m_Replacement = serialized.substr(prefixLength, replacementLength);
+            m_IsDelta = true;
+        }
+
+        bool isKeyframe() const
+        {
+            return not m_IsDelta;
+        }
+
+        size_t getStorageSizeInBytes() const
+        {
+            return m_IsDelta ? m_Replacement.capacity() : m_Keyframe->capacity();
+        }
+
+        // returns the full serialized model
+        std::string reconstruct() const
+        {
+            if (not m_IsDelta) {
+                return *m_Keyframe;
+            }
+
+            std::string const& keyframe = *m_Keyframe;
+            std::string rv;
+            rv.reserve(m_PrefixLength + m_Replacement.size() + m_SuffixLength);
+            rv.append(keyframe, 0, m_PrefixLength);
+            rv.append(m_Replacement);
+            rv.append(keyframe, keyframe.size() - m_SuffixLength, m_SuffixLength);
+            return rv;
+        }
+
+    private:
+        std::shared_ptr<std::string const> m_Keyframe;
+        size_t m_NumDeltasSinceKeyframe = 0;
+        size_t m_PrefixLength = 0;
+        size_t m_SuffixLength = 0;
+        std::string m_Replacement;
+        bool m_IsDelta = false;
+    };
+}
+
 class osc::ModelStateCommit::Impl final {
 public:
     Impl(IConstModelStatePair const& msp, std::string_view message) :
@@ -26,13 +152,20 @@ public:
     Impl(IConstModelStatePair const& msp, std::string_view message, UID parent) :
         m_MaybeParentID{parent},
         m_CommitTime{std::chrono::system_clock::now()},
-        m_Model{std::make_unique<OpenSim::Model>(msp.getModel())},
+        m_SerializedModel{SerializeModel(msp.getModel())},
+        m_InputFileName{msp.getModel().getInputFileName()},
+        m_DisplayHints{msp.getModel().getDisplayHints()},
         m_ModelVersion{msp.getModelVersion()},
         m_FixupScaleFactor{msp.getFixupScaleFactor()},
         m_CommitMessage{message}
     {
-        InitializeModel(*m_Model);
-        InitializeState(*m_Model);
+    }
+
+    Impl(IConstModelStatePair const& msp, std::string_view message, std::shared_ptr<Impl const> parent) :
+        Impl{msp, message, parent->getID()}
+    {
+        // the delta-encoding is deferred until `compactStorage` is called
+        m_MaybeUncompactedParent = std::move(parent);
     }
 
     UID getID() const
@@ -62,7 +195,79 @@ public:
 
     SynchronizedValueGuard<OpenSim::Model const> getModel() const
     {
-        return {m_AccessMutex, *m_Model};
+        std::unique_lock lock{m_ModelMutex};
+        if (not m_MaybePreparedModel) {
+            m_MaybePreparedModel = instantiateInitializedModel();
+        }
+        lock.release();  // ownership of the lock is transferred to the guard
+        return {m_ModelMutex, std::adopt_lock, *m_MaybePreparedModel};
+    }
+
+    std::unique_ptr<OpenSim::Model> instantiateModel() const
+    {
+        OSC_PERF("ModelStateCommit/instantiateModel");
+
+        // restore the parts of the model that aren't properties (and, therefore, aren't serialized)
+        auto rv = DeserializeModel(getSerializedModel().reconstruct());
+        rv->setInputFileName(m_InputFileName);
+        rv->updDisplayHints() = m_DisplayHints;
+        return rv;
+    }
+
+    std::unique_ptr<OpenSim::Model> checkoutModel() const
+    {
+        {
+            std::lock_guard lock{m_ModelMutex};  // blocks while another thread prepares the model
+            if (m_MaybePreparedModel) {
+                return std::move(m_MaybePreparedModel);
+            }
+        }
+        return instantiateInitializedModel();
+    }
+
+    void prepareModel() const
+    {
+        std::lock_guard lock{m_ModelMutex};
+        if (not m_MaybePreparedModel) {
+            m_MaybePreparedModel = instantiateInitializedModel();
+        }
+    }
+
+    bool hasPreparedModel() const
+    {
+        std::lock_guard lock{m_ModelMutex};
+        return m_MaybePreparedModel != nullptr;
+    }
+
+    void releasePreparedModel() const
+    {
+        std::unique_ptr<OpenSim::Model> released;
+        {
+            std::lock_guard lock{m_ModelMutex};
+            released = std::move(m_MaybePreparedModel);
+        }
+        // `released` is destructed outside of the lock
+    }
+
+    void compactStorage() const
+    {
+        std::shared_ptr<Impl const> parent;
+        {
+            std::lock_guard lock{m_StorageMutex};
+            parent = std::move(m_MaybeUncompactedParent);
+        }
+        if (not parent) {
+            return;  // already compacted (or has no parent to compact against)
+        }
+
+        // compact the parent first, so that this commit shares the parent's keyframe rather
+        // than (e.g.) the parent's uncompacted text
+        parent->compactStorage();
+
+        OSC_PERF("ModelStateCommit/compactStorage");
+        SerializedModel const parentStorage = parent->getSerializedModel();
+        std::lock_guard lock{m_StorageMutex};
+        m_SerializedModel = SerializedModel{m_SerializedModel.reconstruct(), parentStorage};
     }
 
     UID getModelVersion() const
@@ -75,12 +280,46 @@ public:
         return m_FixupScaleFactor;
     }
 
+    bool isKeyframe() const
+    {
+        return getSerializedModel().isKeyframe();
+    }
+
+    size_t getStorageSizeInBytes() const
+    {
+        return sizeof(*this) + getSerializedModel().getStorageSizeInBytes() + m_InputFileName.capacity() + m_CommitMessage.capacity();
+    }
+
 private:
-    mutable std::mutex m_AccessMutex;
+    SerializedModel getSerializedModel() const
+    {
+        std::lock_guard lock{m_StorageMutex};
+        return m_SerializedModel;
+    }
+
+    std::unique_ptr<OpenSim::Model> instantiateInitializedModel() const
+    {
+        auto rv = instantiateModel();
+        InitializeModel(*rv);
+        InitializeState(*rv);
+        return rv;
+    }
+
     UID m_ID;
     UID m_MaybeParentID;
     std::chrono::system_clock::time_point m_CommitTime;
-    std::unique_ptr<OpenSim::Model> m_Model;
+
+    // storage (may be compacted at any time, from any thread)
+    mutable std::mutex m_StorageMutex;
+    mutable SerializedModel m_SerializedModel;
+    mutable std::shared_ptr<Impl const> m_MaybeUncompactedParent;
+    std::string m_InputFileName;
+    OpenSim::ModelDisplayHints m_DisplayHints;
+
+    // (maybe) a rebuilt + initialized model (may be prepared/released at any time, from any thread)
+    mutable std::mutex m_ModelMutex;
+    mutable std::unique_ptr<OpenSim::Model> m_MaybePreparedModel;
+
     UID m_ModelVersion;
     float m_FixupScaleFactor;
     std::string m_CommitMessage;
@@ -99,6 +338,11 @@ osc::ModelStateCommit::ModelStateCommit(IConstModelStatePair const& p, std::stri
 {
 }
 
+osc::ModelStateCommit::ModelStateCommit(IConstModelStatePair const& p, std::string_view message, ModelStateCommit const& parent) :
+    m_Impl{std::make_shared<Impl>(p, message, parent.m_Impl)}
+{
+}
+
 osc::ModelStateCommit::ModelStateCommit(ModelStateCommit const&) = default;
 osc::ModelStateCommit::ModelStateCommit(ModelStateCommit&&) noexcept = default;
 osc::ModelStateCommit& osc::ModelStateCommit::operator=(ModelStateCommit const&) = default;
@@ -135,6 +379,36 @@ SynchronizedValueGuard<OpenSim::Model const> osc::ModelStateCommit::getModel() c
     return m_Impl->getModel();
 }
 
+std::unique_ptr<OpenSim::Model> osc::ModelStateCommit::instantiateModel() const
+{
+    return m_Impl->instantiateModel();
+}
+
+std::unique_ptr<OpenSim::Model> osc::ModelStateCommit::checkoutModel() const
+{
+    return m_Impl->checkoutModel();
+}
+
+void osc::ModelStateCommit::prepareModel() const
+{
+    m_Impl->prepareModel();
+}
+
+bool osc::ModelStateCommit::hasPreparedModel() const
+{
+    return m_Impl->hasPreparedModel();
+}
+
+void osc::ModelStateCommit::releasePreparedModel() const
+{
+    m_Impl->releasePreparedModel();
+}
+
+void osc::ModelStateCommit::compactStorage() const
+{
+    m_Impl->compactStorage();
+}
+
 UID osc::ModelStateCommit::getModelVersion() const
 {
     return m_Impl->getModelVersion();
@@ -144,3 +418,13 @@ float osc::ModelStateCommit::getFixupScaleFactor() const
 {
     return m_Impl->getFixupScaleFactor();
 }
+
+bool osc::ModelStateCommit::isKeyframe() const
+{
+    return m_Impl->isKeyframe();
+}
+
+size_t osc::ModelStateCommit::getStorageSizeInBytes() const
+{
+    return m_Impl->getStorageSizeInBytes();
+}
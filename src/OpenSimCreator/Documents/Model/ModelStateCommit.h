@@ -5,6 +5,7 @@
 #include <oscar/Utils/UID.h>
 
 #include <chrono>
+#include <cstddef>
 #include <memory>
 #include <string_view>
 
@@ -16,10 +17,23 @@ namespace osc
 {
     // immutable, reference-counted handle to a "Model+State commit", which is effectively
     // what is saved upon each user action
+    //
+    // commits don't hold a live copy of the model. Instead, they hold the model's serialized
+    // (.osim) representation, either as a full "keyframe" or as a (usually, tiny) delta against
+    // an earlier commit's keyframe, and only rebuild a model when one is requested
+    //
+    // constructing a commit only snapshots (serializes) the model: the more expensive work
+    // (delta-encoding, rebuilding + initializing a model) can be deferred to a background
+    // thread via `compactStorage` and `prepareModel`, which are thread-safe
     class ModelStateCommit final {
     public:
         ModelStateCommit(IConstModelStatePair const&, std::string_view message);
         ModelStateCommit(IConstModelStatePair const&, std::string_view message, UID parent);
+
+        // constructs a commit that (where possible) is stored as a delta against `parent`
+        // once it's `compactStorage`d
+        ModelStateCommit(IConstModelStatePair const&, std::string_view message, ModelStateCommit const& parent);
+
         ModelStateCommit(ModelStateCommit const&);
         ModelStateCommit(ModelStateCommit&&) noexcept;
         ModelStateCommit& operator=(ModelStateCommit const&);
@@ -31,10 +45,48 @@ namespace osc
         UID getParentID() const;
         std::chrono::system_clock::time_point getCommitTime() const;
         CStringView getCommitMessage() const;
+
+        // returns the commit's (initialized) model, which is lazily rebuilt on first access
+        // if it hasn't already been prepared
         SynchronizedValueGuard<OpenSim::Model const> getModel() const;
+
+        // returns a new, uninitialized, model that is rebuilt from the commit's storage
+        //
+        // (this is cheaper than copying `getModel()` if the caller only needs a copy)
+        std::unique_ptr<OpenSim::Model> instantiateModel() const;
+
+        // returns a new, initialized, model for the caller to own (e.g. for a checkout)
+        //
+        // moves the prepared model out of the commit if one is available, blocks if another
+        // thread is currently preparing it, or otherwise rebuilds one on the calling thread
+        //
+        // commits aren't validated when they're made, so this throws if the commit's model
+        // can't be rebuilt (e.g. because it fails to initialize)
+        std::unique_ptr<OpenSim::Model> checkoutModel() const;
+
+        // rebuilds and initializes the commit's model ahead of time, so that a later call to
+        // `getModel` or `checkoutModel` doesn't have to (no-op if already prepared)
+        void prepareModel() const;
+
+        // returns `true` if the commit holds a prepared model
+        bool hasPreparedModel() const;
+
+        // frees the commit's prepared model (if any)
+        void releasePreparedModel() const;
+
+        // delta-encodes the commit's storage against its parent's (no-op if already compacted)
+        void compactStorage() const;
+
         UID getModelVersion() const;
         float getFixupScaleFactor() const;
 
+        // returns `true` if the commit stores the whole model, rather than a delta
+        bool isKeyframe() const;
+
+        // returns the number of bytes that are uniquely held by this commit (i.e. excluding
+        // any keyframe that it shares with other commits, and any prepared model)
+        size_t getStorageSizeInBytes() const;
+
         friend bool operator==(ModelStateCommit const&, ModelStateCommit const&) = default;
     private:
         class Impl;
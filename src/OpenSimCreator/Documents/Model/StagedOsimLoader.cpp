@@ -0,0 +1,289 @@
+#include "StagedOsimLoader.h"
+
+#include <OpenSimCreator/Documents/Model/UndoableModelStatePair.h>
+#include <OpenSimCreator/Graphics/OpenSimDecorationGenerator.h>
+#include <OpenSimCreator/Graphics/OpenSimDecorationOptions.h>
+#include <OpenSimCreator/Graphics/SimTKMeshLoader.h>
+#include <OpenSimCreator/Utils/OpenSimHelpers.h>
+
+#include <OpenSim/Simulation/Model/Geometry.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/Model/ModelVisualizer.h>
+#include <oscar/Graphics/Scene/SceneCache.h>
+#include <oscar/Graphics/Scene/SceneDecoration.h>
+#include <oscar/Platform/Log.h>
+#include <oscar/Shims/Cpp20/stop_token.h>
+#include <oscar/Shims/Cpp20/thread.h>
+#include <oscar/Utils/CStringView.h>
+#include <oscar/Utils/EnumHelpers.h>
+#include <oscar/Utils/Perf.h>
+#include <SimTKcommon.h>
+
+#include <array>
+#include <chrono>
+#include <concepts>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace osc;
+namespace rgs = std::ranges;
+
+namespace
+{
+    constexpr auto c_OsimLoadingStages = std::to_array<OsimLoadingStage>(
+    {
+        OsimLoadingStage::ReadingFile,
+        OsimLoadingStage::FinalizingProperties,
+        OsimLoadingStage::LoadingGeometry,
+        OsimLoadingStage::BuildingSystem,
+        OsimLoadingStage::InitializingState,
+        OsimLoadingStage::WarmingCaches,
+    });
+    static_assert(c_OsimLoadingStages.size() == num_options<OsimLoadingStage>());
+
+    constexpr auto c_OsimLoadingStageStrings = std::to_array<CStringView>(
+    {
+        "reading file",
+        "finalizing properties",
+        "loading geometry",
+        "building system",
+        "initializing state",
+        "warming caches",
+    });
+    static_assert(c_OsimLoadingStageStrings.size() == num_options<OsimLoadingStage>());
+
+    // rough guess of the fraction of the overall loading time at which each stage starts
+    //
+    // (these only drive a progress bar, so they don't need to be accurate)
+    constexpr auto c_OsimLoadingStageStartFractions = std::to_array<float>(
+    {
+        0.00f,  // ReadingFile
+        0.30f,  // FinalizingProperties
+        0.40f,  // LoadingGeometry
+        0.40f,  // BuildingSystem
+        0.65f,  // InitializingState
+        0.85f,  // WarmingCaches
+    });
+    static_assert(c_OsimLoadingStageStartFractions.size() == num_options<OsimLoadingStage>());
+
+    // a mesh file that the model uses
+    struct MeshFileToLoad final {
+        // the path that OpenSim resolves the mesh's file to, exactly as it resolves it, because
+        // the decoration generator uses that string as the mesh cache key
+        std::string cacheKey;
+    };
+
+    // returns the (unique) mesh files that the (finalized) model uses, mimicing how
+    // `OpenSim::Mesh::extendFinalizeFromProperties` finds them
+    std::vector<MeshFileToLoad> FindMeshFilesToLoad(OpenSim::Model const& model)
+    {
+        std::vector<MeshFileToLoad> rv;
+        for (OpenSim::Mesh const& mesh : model.getComponentList<OpenSim::Mesh>())
+        {
+            std::string const& fileProp = mesh.get_mesh_file();
+            bool isAbsolute = std::filesystem::path{fileProp}.is_absolute();
+            SimTK::Array_<std::string> attempts;
+            if (OpenSim::ModelVisualizer::findGeometryFile(model, fileProp, isAbsolute, attempts) && !attempts.empty())
+            {
+                rv.push_back(MeshFileToLoad{attempts.back()});
+            }
+        }
+        rgs::sort(rv, rgs::less{}, &MeshFileToLoad::cacheKey);
+        auto const [newEnd, _] = rgs::unique(rv, rgs::equal_to{}, &MeshFileToLoad::cacheKey);
+        rv.erase(newEnd, rv.end());
+        return rv;
+    }
+
+    // loads the given mesh files (and their BVHs) into the cache until they're all loaded or
+    // either of the stop tokens is stopped
+    void LoadMeshFilesInto(
+        SceneCache& meshCache,
+        std::vector<MeshFileToLoad> const& meshFiles,
+        cpp20::stop_token const& stopToken,
+        cpp20::stop_token const& loaderStopToken)
+    {
+        for (MeshFileToLoad const& meshFile : meshFiles)
+        {
+            if (stopToken.stop_requested() || loaderStopToken.stop_requested())
+            {
+                return;
+            }
+
+            try
+            {
+                Mesh const mesh = meshCache.get_mesh(meshFile.cacheKey, [&meshFile]() { return LoadMeshViaSimTK(meshFile.cacheKey); });
+                meshCache.get_bvh(mesh);
+            }
+            catch (std::exception const& ex)
+            {
+                // not fatal: the decoration generator will report it when it needs the mesh
+                log_warn("%s: could not preload mesh: %s", meshFile.cacheKey.c_str(), ex.what());
+            }
+        }
+    }
+
+    // runs the loading stages, recording how long each one takes
+    class StageRunner final {
+    public:
+        StageRunner(
+            cpp20::stop_token const& stopToken,
+            std::function<void(OsimLoadingProgress const&)> const& onProgress) :
+
+            m_StopToken{&stopToken},
+            m_OnProgress{&onProgress}
+        {}
+
+        template<std::invocable F>
+        std::invoke_result_t<F> run(OsimLoadingStage stage, F&& f)
+        {
+            if (m_StopToken->stop_requested())
+            {
+                throw OsimLoadingCancelled{"loading was cancelled"};
+            }
+
+            if (*m_OnProgress)
+            {
+                (*m_OnProgress)({stage, c_OsimLoadingStageStartFractions[to_index(stage)]});
+            }
+
+            auto const start = std::chrono::steady_clock::now();
+            auto const recordTiming = [this, stage, start]()
+            {
+                m_Timings.push_back({stage, std::chrono::steady_clock::now() - start});
+            };
+
+            if constexpr (std::is_void_v<std::invoke_result_t<F>>)
+            {
+                std::invoke(std::forward<F>(f));
+                recordTiming();
+            }
+            else
+            {
+                auto rv = std::invoke(std::forward<F>(f));
+                recordTiming();
+                return rv;
+            }
+        }
+
+        void addTiming(OsimLoadingStageTiming timing)
+        {
+            m_Timings.push_back(timing);
+        }
+
+        std::vector<OsimLoadingStageTiming> takeTimings()
+        {
+            return std::move(m_Timings);
+        }
+
+    private:
+        cpp20::stop_token const* m_StopToken;
+        std::function<void(OsimLoadingProgress const&)> const* m_OnProgress;
+        std::vector<OsimLoadingStageTiming> m_Timings;
+    };
+}
+
+
+// public API
+
+std::span<OsimLoadingStage const> osc::GetAllOsimLoadingStages()
+{
+    return c_OsimLoadingStages;
+}
+
+std::span<CStringView const> osc::GetAllOsimLoadingStageStrings()
+{
+    return c_OsimLoadingStageStrings;
+}
+
+CStringView osc::GetOsimLoadingStageString(OsimLoadingStage stage)
+{
+    return c_OsimLoadingStageStrings.at(to_index(stage));
+}
+
+StagedOsimLoadingResult osc::LoadOsimInStages(
+    std::filesystem::path const& osimPath,
+    SceneCache& meshCache,
+    cpp20::stop_token const& stopToken,
+    std::function<void(OsimLoadingProgress const&)> const& onProgress)
+{
+    OSC_PERF("LoadOsimInStages");
+
+    StageRunner runner{stopToken, onProgress};
+
+    auto model = runner.run(OsimLoadingStage::ReadingFile, [&osimPath]()
+    {
+        return std::make_unique<OpenSim::Model>(osimPath.string());
+    });
+    auto const lastWriteTime = std::filesystem::last_write_time(osimPath);
+
+    runner.run(OsimLoadingStage::FinalizingProperties, [&model]()
+    {
+        FinalizeFromProperties(*model);
+    });
+
+    // load the model's mesh files on a background thread while the (single-threaded) system
+    // is built, because neither depends on the other
+    std::vector<MeshFileToLoad> meshFiles = FindMeshFilesToLoad(*model);
+    auto const geometryStart = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::duration geometryDuration{};
+    {
+        cpp20::jthread geometryLoader{[&meshCache, &meshFiles, &stopToken, &geometryDuration, geometryStart](cpp20::stop_token const& loaderStopToken)
+        {
+            LoadMeshFilesInto(meshCache, meshFiles, stopToken, loaderStopToken);
+            geometryDuration = std::chrono::steady_clock::now() - geometryStart;
+        }};
+
+        if (onProgress)
+        {
+            onProgress({OsimLoadingStage::LoadingGeometry, c_OsimLoadingStageStartFractions[to_index(OsimLoadingStage::LoadingGeometry)]});
+        }
+
+        // (if either of these throws, `geometryLoader` is stopped and joined on destruction)
+        runner.run(OsimLoadingStage::BuildingSystem, [&model]()
+        {
+            InitializeModel(*model);
+        });
+        runner.run(OsimLoadingStage::InitializingState, [&model]()
+        {
+            InitializeState(*model);
+        });
+
+        geometryLoader.join();  // let it finish (rather than stopping it)
+    }
+    runner.addTiming({OsimLoadingStage::LoadingGeometry, geometryDuration});
+
+    auto rv = std::make_unique<UndoableModelStatePair>(std::move(model), UndoableModelStatePair::ModelIsInitialized{});
+    rv->setUpToDateWithFilesystem(lastWriteTime);
+
+    // generate the model's decorations once, so that any remaining meshes (e.g. in-memory ones)
+    // and their BVHs are cached before the UI's first frame
+    runner.run(OsimLoadingStage::WarmingCaches, [&meshCache, &rv]()
+    {
+        GenerateModelDecorations(
+            meshCache,
+            rv->getModel(),
+            rv->getState(),
+            OpenSimDecorationOptions{},
+            rv->getFixupScaleFactor(),
+            [&meshCache](OpenSim::Component const&, SceneDecoration&& dec)
+            {
+                meshCache.get_bvh(dec.mesh);
+            }
+        );
+    });
+
+    if (onProgress)
+    {
+        onProgress({OsimLoadingStage::WarmingCaches, 1.0f});
+    }
+
+    return StagedOsimLoadingResult{std::move(rv), runner.takeTimings()};
+}
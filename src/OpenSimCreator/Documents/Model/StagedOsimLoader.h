@@ -0,0 +1,73 @@
+#pragma once
+
+#include <oscar/Utils/CStringView.h>
+
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace osc { class SceneCache; }
+namespace osc { class UndoableModelStatePair; }
+namespace osc::cpp20 { class stop_token; }
+
+namespace osc
+{
+    // a stage of loading an osim file (see `LoadOsimInStages`)
+    enum class OsimLoadingStage {
+        ReadingFile,
+        FinalizingProperties,
+        LoadingGeometry,  // runs concurrently with `BuildingSystem` and `InitializingState`
+        BuildingSystem,
+        InitializingState,
+        WarmingCaches,
+        NUM_OPTIONS,
+    };
+
+    std::span<OsimLoadingStage const> GetAllOsimLoadingStages();
+    std::span<CStringView const> GetAllOsimLoadingStageStrings();
+    CStringView GetOsimLoadingStageString(OsimLoadingStage);
+
+    // a progress report from `LoadOsimInStages`
+    struct OsimLoadingProgress final {
+        OsimLoadingStage stage = OsimLoadingStage::ReadingFile;
+        float fractionCompleted = 0.0f;  // rough estimate of the overall progress, in [0, 1]
+    };
+
+    // how long a stage of `LoadOsimInStages` took (wall time)
+    struct OsimLoadingStageTiming final {
+        OsimLoadingStage stage = OsimLoadingStage::ReadingFile;
+        std::chrono::duration<double> duration{};
+    };
+
+    // thrown by `LoadOsimInStages` when a stop was requested while loading
+    class OsimLoadingCancelled final : public std::runtime_error {
+    public:
+        using std::runtime_error::runtime_error;
+    };
+
+    struct StagedOsimLoadingResult final {
+        std::unique_ptr<UndoableModelStatePair> model;
+        std::vector<OsimLoadingStageTiming> timings;
+    };
+
+    // loads the given osim file in explicit stages, reporting progress to `onProgress` (from the
+    // calling thread) as it goes
+    //
+    // - the model's mesh files are loaded (+ their BVHs built) into `meshCache` concurrently
+    //   with the model's system being built, so that the first frame of a UI that shows the
+    //   model doesn't have to load them
+    // - cancellation is cooperative: `stopToken` is checked between stages (OpenSim's own
+    //   loading steps can't be interrupted), and `OsimLoadingCancelled` is thrown if a stop
+    //   was requested
+    // - any other loading error is thrown as-is
+    StagedOsimLoadingResult LoadOsimInStages(
+        std::filesystem::path const& osimPath,
+        SceneCache& meshCache,
+        cpp20::stop_token const& stopToken,
+        std::function<void(OsimLoadingProgress const&)> const& onProgress = {}
+    );
+}
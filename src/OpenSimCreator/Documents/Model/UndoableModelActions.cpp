@@ -55,6 +55,7 @@
 #include <oscar/Platform/App.h>
 #include <oscar/Platform/Log.h>
 #include <oscar/Platform/os.h>
+#include <oscar/Shims/Cpp23/ranges.h>
 #include <oscar/Utils/Algorithms.h>
 #include <oscar/Utils/FilesystemHelpers.h>
 #include <oscar/Utils/ParentPtr.h>
@@ -68,6 +69,7 @@
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <system_error>
 #include <typeinfo>
 #include <utility>
 
@@ -656,6 +658,70 @@ bool osc::ActionReloadOsimFromDisk(UndoableModelStatePair& uim, SceneCache& mesh
     }
 }
 
+bool osc::ActionReloadChangedMeshFiles(
+    UndoableModelStatePair& uim,
+    SceneCache& meshCache,
+    std::span<std::filesystem::path const> changedFiles)
+{
+    // `changedFiles` are normalized (see `FileWatch`), but OpenSim's paths might not be
+    auto const isChanged = [changedFiles](std::filesystem::path const& p)
+    {
+        std::error_code ec;
+        std::filesystem::path const normalized = std::filesystem::weakly_canonical(p, ec);
+        return !ec && cpp23::contains(changedFiles, normalized);
+    };
+
+    std::vector<OpenSim::ComponentPath> changedMeshes;
+    for (OpenSim::Mesh const& mesh : uim.getModel().getComponentList<OpenSim::Mesh>())
+    {
+        if (std::optional<std::filesystem::path> const p = FindGeometryFileAbsPath(uim.getModel(), mesh); p && isChanged(*p))
+        {
+            changedMeshes.push_back(GetAbsolutePath(mesh));
+        }
+    }
+
+    if (changedMeshes.empty())
+    {
+        return false;  // none of the changed files are meshes in this model
+    }
+
+    log_info("%zu mesh(es) changed on disk: reloading them", changedMeshes.size());
+
+    // purge only the changed meshes from the app-wide mesh cache (it's keyed by mesh file path)
+    meshCache.clear_meshes_if([&isChanged](std::string const& key) { return isChanged(key); });
+
+    bool const wasUpToDateWithFilesystem = uim.isUpToDateWithFilesystem();
+    std::filesystem::file_time_type const lastWriteTime = uim.getLastFilesystemWriteTime();
+    try
+    {
+        OpenSim::Model& mutModel = uim.updModel();
+        for (OpenSim::ComponentPath const& meshPath : changedMeshes)
+        {
+            // `OpenSim::Mesh` only reloads its file when its properties are out-of-date
+            if (auto* mutMesh = FindComponentMut<OpenSim::Mesh>(mutModel, meshPath))
+            {
+                mutMesh->set_mesh_file(std::string{mutMesh->get_mesh_file()});
+            }
+        }
+        InitializeModel(mutModel);
+        InitializeState(mutModel);
+        uim.commit("reloaded changed mesh files");
+
+        // the osim file itself didn't change
+        if (wasUpToDateWithFilesystem)
+        {
+            uim.setUpToDateWithFilesystem(lastWriteTime);
+        }
+        return true;
+    }
+    catch (std::exception const& ex)
+    {
+        log_error("error detected while trying to reload mesh files: %s", ex.what());
+        uim.rollback();
+        return false;
+    }
+}
+
 bool osc::ActionSimulateAgainstAllIntegrators(
     ParentPtr<IMainUIStateAPI> const& parent,
     UndoableModelStatePair const& uim)
@@ -159,6 +159,14 @@ namespace osc
         SceneCache&
     );
 
+    // reload the model's meshes that were loaded from any of the given (changed) files, without
+    // reloading the rest of the model (e.g. because the user is editing a mesh externally)
+    bool ActionReloadChangedMeshFiles(
+        UndoableModelStatePair&,
+        SceneCache&,
+        std::span<std::filesystem::path const> changedFiles
+    );
+
     // start performing a series of simulations against the model by opening a tab that tries all possible integrators
     bool ActionSimulateAgainstAllIntegrators(
         ParentPtr<IMainUIStateAPI> const&,
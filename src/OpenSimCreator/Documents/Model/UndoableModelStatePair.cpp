@@ -1,6 +1,7 @@
 #include "UndoableModelStatePair.h"
 
 #include <OpenSimCreator/Documents/Model/ModelStateCommit.h>
+#include <OpenSimCreator/Utils/ComponentPathIndex.h>
 #include <OpenSimCreator/Utils/OpenSimHelpers.h>
 
 #include <OpenSim/Common/ComponentPath.h>
@@ -8,14 +9,24 @@
 #include <OpenSim/Common/PropertyObjArray.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <oscar/Platform/Log.h>
+#include <oscar/Shims/Cpp20/stop_token.h>
+#include <oscar/Shims/Cpp20/thread.h>
 #include <oscar/Utils/Algorithms.h>
 #include <oscar/Utils/Assertions.h>
 #include <oscar/Utils/Perf.h>
 #include <oscar/Utils/UID.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <exception>
 #include <filesystem>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <unordered_map>
@@ -39,6 +50,9 @@ namespace
         return rv;
     }
 
+    // tag type for constructing a `UiModelStatePair` from an already-initialized model
+    struct AlreadyInitialized final {};
+
     class UiModelStatePair final : public IModelStatePair {
     public:
 
@@ -60,6 +74,12 @@ namespace
             InitializeState(*m_Model);
         }
 
+        UiModelStatePair(std::unique_ptr<OpenSim::Model> _model, AlreadyInitialized) :
+            m_Model{std::move(_model)},
+            m_FixupScaleFactor{1.0f}
+        {
+        }
+
         UiModelStatePair(UiModelStatePair const& other) :
             m_Model{std::make_unique<OpenSim::Model>(*other.m_Model)},
             m_FixupScaleFactor{other.m_FixupScaleFactor},
@@ -83,9 +103,22 @@ namespace
         OpenSim::Model& updModel()
         {
             m_ModelVersion = UID{};
+
+            // the caller may be about to add/remove components, which would leave the
+            // path index with dangling pointers, so don't use it until the mutation is
+            // known to be finished (see: `onModelCommitted`)
+            m_PathIndex = ComponentPathIndex{};
+            m_PathIndexIsUsable = false;
+
             return *m_Model;
         }
 
+        // called when the caller has finished mutating the model (e.g. it was committed)
+        void onModelCommitted()
+        {
+            m_PathIndexIsUsable = true;
+        }
+
         UID implGetModelVersion() const final
         {
             return m_ModelVersion;
@@ -126,9 +159,24 @@ namespace
             m_MaybeSelected = p;
         }
 
+        OpenSim::Component const* implFindComponent(OpenSim::ComponentPath const& p) const final
+        {
+            if (!m_PathIndexIsUsable)
+            {
+                return FindComponent(*m_Model, p);
+            }
+
+            if (m_PathIndexVersion != m_ModelVersion || !m_PathIndex.isIndexOf(*m_Model))
+            {
+                m_PathIndex = ComponentPathIndex{*m_Model};
+                m_PathIndexVersion = m_ModelVersion;
+            }
+            return m_PathIndex.find(p);
+        }
+
         OpenSim::Component const* implGetSelected() const final
         {
-            return FindComponent(*m_Model, m_MaybeSelected);
+            return implFindComponent(m_MaybeSelected);
         }
 
         void implSetSelected(OpenSim::Component const* c) final
@@ -148,7 +196,7 @@ namespace
 
         OpenSim::Component const* implGetHovered() const final
         {
-            return FindComponent(*m_Model, m_MaybeHovered);
+            return implFindComponent(m_MaybeHovered);
         }
 
         void implSetHovered(OpenSim::Component const* c) final
@@ -172,6 +220,12 @@ namespace
 
         // (maybe) absolute path to the current hover (empty otherwise)
         OpenSim::ComponentPath m_MaybeHovered;
+
+        // lazily-built index of the model's components, rebuilt whenever the model's
+        // version changes, so that the selection, hover, etc. are cheap to look up
+        mutable ComponentPathIndex m_PathIndex;
+        mutable UID m_PathIndexVersion = UID::empty();
+        bool m_PathIndexIsUsable = true;
     };
 
     void CopySelectedAndHovered(UiModelStatePair const& src, UiModelStatePair& dest)
@@ -179,6 +233,81 @@ namespace
         dest.setSelectedPath(src.getSelectedPath());
         dest.setHoveredPath(src.getHoveredPath());
     }
+
+    // runs deferred commit work (compaction, model preparation, destruction) on a
+    // background thread, so that it doesn't block the UI thread
+    class CommitWorker final {
+    public:
+        CommitWorker() = default;
+        CommitWorker(CommitWorker const&) = delete;
+        CommitWorker(CommitWorker&&) noexcept = delete;
+        CommitWorker& operator=(CommitWorker const&) = delete;
+        CommitWorker& operator=(CommitWorker&&) noexcept = delete;
+        ~CommitWorker() noexcept
+        {
+            {
+                std::lock_guard lock{m_Mutex};
+                m_Shutdown = true;
+            }
+            m_Condition.notify_all();
+            // `m_Thread` joins on destruction (pending tasks are dropped)
+        }
+
+        void post(std::function<void()> task)
+        {
+            {
+                std::lock_guard lock{m_Mutex};
+                m_Tasks.push_back(std::move(task));
+            }
+            m_Condition.notify_all();
+        }
+
+        // blocks until all tasks that were posted so far have finished
+        void waitUntilIdle()
+        {
+            std::unique_lock lock{m_Mutex};
+            m_Condition.wait(lock, [this]() { return m_Tasks.empty() and not m_Busy; });
+        }
+
+    private:
+        void run()
+        {
+            while (true) {
+                std::function<void()> task;
+                {
+                    std::unique_lock lock{m_Mutex};
+                    m_Condition.wait(lock, [this]() { return m_Shutdown or not m_Tasks.empty(); });
+                    if (m_Shutdown) {
+                        return;
+                    }
+                    task = std::move(m_Tasks.front());
+                    m_Tasks.pop_front();
+                    m_Busy = true;
+                }
+
+                try {
+                    task();
+                }
+                catch (std::exception const& ex) {
+                    log_warn("error while finalizing a model commit in the background: %s", ex.what());
+                }
+                task = nullptr;  // (destroy the task's captures before reporting that it's done)
+
+                {
+                    std::lock_guard lock{m_Mutex};
+                    m_Busy = false;
+                }
+                m_Condition.notify_all();
+            }
+        }
+
+        std::mutex m_Mutex;
+        std::condition_variable m_Condition;
+        std::deque<std::function<void()>> m_Tasks;
+        bool m_Busy = false;
+        bool m_Shutdown = false;
+        cpp20::jthread m_Thread{[this](cpp20::stop_token const&) { run(); }};  // last: uses the above
+    };
 }
 
 class osc::UndoableModelStatePair::Impl final {
@@ -198,16 +327,15 @@ public:
         m_Scratch{std::move(m)},
         m_MaybeFilesystemLocation{TryFindInputFile(m_Scratch.getModel())}
     {
-        std::stringstream ss;
-        if (!m_MaybeFilesystemLocation.empty())
-        {
-            ss << "loaded " << m_MaybeFilesystemLocation.filename().string();
-        }
-        else
-        {
-            ss << "loaded model";
-        }
-        doCommit(std::move(ss).str());  // make initial commit
+        commitLoadedModel();
+    }
+
+    // as above, but the caller has already initialized the model
+    Impl(std::unique_ptr<OpenSim::Model> m, UndoableModelStatePair::ModelIsInitialized) :
+        m_Scratch{std::move(m), AlreadyInitialized{}},
+        m_MaybeFilesystemLocation{TryFindInputFile(m_Scratch.getModel())}
+    {
+        commitLoadedModel();
     }
 
     explicit Impl(std::filesystem::path const& osimPath) :
@@ -264,6 +392,11 @@ public:
         return getHeadCommit();
     }
 
+    void waitForBackgroundWork() const
+    {
+        m_Worker->waitUntilIdle();
+    }
+
     bool canUndo() const
     {
         ModelStateCommit const* c = tryGetCommitByID(m_CurrentHead);
@@ -320,8 +453,12 @@ public:
             return false;  // commit isn't in this model's storage (is it from another model?)
         }
 
-        m_CurrentHead = commit.getID();
-        checkout();
+        UID const previousHead = std::exchange(m_CurrentHead, commit.getID());
+        if (!checkout())
+        {
+            m_CurrentHead = previousHead;  // the scratch space is still a checkout of the previous head
+            return false;
+        }
         return true;
     }
 
@@ -372,6 +509,11 @@ public:
         m_Scratch.setFixupScaleFactor(v);
     }
 
+    OpenSim::Component const* findComponent(OpenSim::ComponentPath const& p) const
+    {
+        return m_Scratch.findComponent(p);
+    }
+
     OpenSim::Component const* getSelected() const
     {
         return m_Scratch.getSelected();
@@ -393,21 +535,132 @@ public:
     }
 
 private:
+    // makes the initial commit of a newly-loaded model
+    void commitLoadedModel()
+    {
+        std::stringstream ss;
+        if (!m_MaybeFilesystemLocation.empty())
+        {
+            ss << "loaded " << m_MaybeFilesystemLocation.filename().string();
+        }
+        else
+        {
+            ss << "loaded model";
+        }
+        doCommit(std::move(ss).str());  // make initial commit
+    }
 
     UID doCommit(std::string_view message)
     {
-        auto commit = ModelStateCommit{m_Scratch, message, m_CurrentHead};
+        // only snapshot the model here: the commit is delta-encoded against its parent (so
+        // that the history doesn't hold a full model per entry) in the background
+        ModelStateCommit const* parent = tryGetCommitByID(m_CurrentHead);
+        auto commit = parent ?
+            ModelStateCommit{m_Scratch, message, *parent} :
+            ModelStateCommit{m_Scratch, message, m_CurrentHead};
         UID commitID = commit.getID();
 
         m_Commits.try_emplace(commitID, std::move(commit));
         m_CurrentHead = commitID;
         m_BranchHead = commitID;
+        m_Scratch.onModelCommitted();
 
         garbageCollect();
+        scheduleBackgroundWork();
 
         return commitID;
     }
 
+    // schedules background work that keeps the history cheap to store and to navigate:
+    //
+    // - compacts (delta-encodes) all commits
+    // - prepares the models of the commits that are likely to be checked out next (i.e. the
+    //   undo/redo targets). The current commit isn't prepared, because the scratch space
+    //   already holds its model
+    // - releases the prepared models of all other commits
+    // - destroys commits that were garbage-collected from the history
+    void scheduleBackgroundWork()
+    {
+        int const numRedos = distance(m_BranchHead, m_CurrentHead);
+        UID const undoTarget = tryGetParentIDOrEmpty(m_CurrentHead);
+        UID const redoTarget = numRedos > 0 ? nthAncestorID(m_BranchHead, numRedos - 1) : UID::empty();
+
+        std::vector<ModelStateCommit> toPrepare;
+        std::vector<ModelStateCommit> toRelease;
+        std::vector<ModelStateCommit> toCompact;
+        for (auto const& [id, commit] : m_Commits) {
+            if (id == undoTarget or id == redoTarget) {
+                toPrepare.push_back(commit);
+            }
+            else {
+                toRelease.push_back(commit);
+            }
+            toCompact.push_back(commit);
+        }
+
+        // later requests make earlier ones stale (e.g. when the user quickly presses undo)
+        uint64_t const generation = ++*m_BackgroundWorkGeneration;
+
+        m_Worker->post([
+            generation,
+            latestGeneration = m_BackgroundWorkGeneration,
+            toPrepare = std::move(toPrepare),
+            toRelease = std::move(toRelease),
+            toCompact = std::move(toCompact),
+            toDestroy = std::exchange(m_EvictedCommits, {})]() mutable
+        {
+            OSC_PERF("UndoableModelStatePair/backgroundWork");
+
+            toDestroy.clear();
+            for (ModelStateCommit const& commit : toRelease) {
+                commit.releasePreparedModel();
+            }
+            size_t historySizeInBytes = 0;
+            for (ModelStateCommit const& commit : toCompact) {
+                commit.compactStorage();
+                historySizeInBytes += commit.getStorageSizeInBytes();
+            }
+            log_debug("undo history: %zu commits, %zu bytes", toCompact.size(), historySizeInBytes);
+            for (ModelStateCommit const& commit : toPrepare) {
+                if (generation != latestGeneration->load()) {
+                    return;  // a newer request will prepare the (new) relevant commits
+                }
+                commit.prepareModel();
+            }
+        });
+    }
+
+    // returns a new scratch space for the given commit, with the user's selection and
+    // scene scale factor carried over from the current one, so that they're "sticky"
+    // between undo/redo
+    //
+    // only blocks if the commit's model hasn't been prepared by the background worker
+    UiModelStatePair checkoutScratch(ModelStateCommit const& commit) const
+    {
+        UiModelStatePair rv{commit.checkoutModel(), AlreadyInitialized{}};
+        CopySelectedAndHovered(m_Scratch, rv);
+        rv.setFixupScaleFactor(m_Scratch.getFixupScaleFactor());
+        return rv;
+    }
+
+    // as above, but returns `std::nullopt` (and logs the error) if the commit's model can't be
+    // rebuilt (e.g. because it doesn't round-trip through XML, or fails to initialize)
+    //
+    // commits aren't validated when they're made, so that committing stays cheap, which means
+    // that this is where an un-rebuildable commit is first detected
+    std::optional<UiModelStatePair> tryCheckoutScratch(ModelStateCommit const& commit) const
+    {
+        try {
+            return checkoutScratch(commit);
+        }
+        catch (std::exception const& ex) {
+            log_error("cannot check out the model from commit '%s':", commit.getCommitMessage().c_str());
+            log_error("    %s", ex.what());
+            log_error("the current model has been left as-is");
+            return std::nullopt;
+        }
+    }
+
     // try to lookup a commit by its ID
     ModelStateCommit const* tryGetCommitByID(UID id) const
     {
@@ -516,6 +769,7 @@ private:
         while (it != m_Commits.end() && it->second.getID() != end)
         {
             UID parent = it->second.getParentID();
+            m_EvictedCommits.push_back(std::move(it->second));  // destroyed by the background worker
             m_Commits.erase(it);
 
             it = m_Commits.find(parent);
@@ -551,9 +805,14 @@ private:
 
     void garbageCollectUnreachable()
     {
-        std::erase_if(m_Commits, [this](auto const& p)
+        std::erase_if(m_Commits, [this](auto& p)
         {
-            return !(p.first == m_BranchHead || isAncestor(p.first, m_BranchHead));
+            bool const unreachable = !(p.first == m_BranchHead || isAncestor(p.first, m_BranchHead));
+            if (unreachable)
+            {
+                m_EvictedCommits.push_back(std::move(p.second));  // destroyed by the background worker
+            }
+            return unreachable;
         });
     }
 
@@ -574,7 +833,9 @@ private:
     // checks out the current checkout to be active (scratch)
     //
     // effectively, reset the scratch space
-    void checkout()
+    //
+    // returns `false` (and leaves the scratch space as-is) if the checkout failed
+    bool checkout()
     {
         // because this is a "reset", try to maintain useful state from the
         // scratch space - things like reset and scaling state, which the
@@ -582,13 +843,19 @@ private:
 
         ModelStateCommit const* c = tryGetCommitByID(m_CurrentHead);
 
-        if (c)
+        if (!c)
         {
-            UiModelStatePair newScratch{std::make_unique<OpenSim::Model>(*c->getModel())};
-            CopySelectedAndHovered(m_Scratch, newScratch);
-            newScratch.setFixupScaleFactor(m_Scratch.getFixupScaleFactor());
-            m_Scratch = std::move(newScratch);
+            return true;
         }
+
+        std::optional<UiModelStatePair> scratch = tryCheckoutScratch(*c);
+        if (!scratch)
+        {
+            return false;
+        }
+        m_Scratch = std::move(*scratch);
+        scheduleBackgroundWork();
+        return true;
     }
 
     // performs an undo, if possible
@@ -610,16 +877,15 @@ private:
             return;
         }
 
-        // perform fixups to ensure the user experience is best:
-        //
-        // - user's selection state should be "sticky" between undo/redo
-        // - user's scene scale factor should be "sticky" between undo/redo
-        UiModelStatePair newModel{std::make_unique<OpenSim::Model>(*parent->getModel())};
-        CopySelectedAndHovered(m_Scratch, newModel);
-        newModel.setFixupScaleFactor(m_Scratch.getFixupScaleFactor());
-
-        m_Scratch = std::move(newModel);
+        OSC_PERF("undo model");
+        std::optional<UiModelStatePair> scratch = tryCheckoutScratch(*parent);
+        if (!scratch)
+        {
+            return;
+        }
+        m_Scratch = std::move(*scratch);
         m_CurrentHead = parent->getID();
+        scheduleBackgroundWork();
     }
 
     // performs a redo, if possible
@@ -639,16 +905,15 @@ private:
             return;
         }
 
-        // perform fixups to ensure the user experience is best:
-        //
-        // - user's selection state should be "sticky" between undo/redo
-        // - user's scene scale factor should be "sticky" between undo/redo
-        UiModelStatePair newModel{std::make_unique<OpenSim::Model>(*c->getModel())};
-        CopySelectedAndHovered(m_Scratch, newModel);
-        newModel.setFixupScaleFactor(m_Scratch.getFixupScaleFactor());
-
-        m_Scratch = std::move(newModel);
+        OSC_PERF("redo model");
+        std::optional<UiModelStatePair> scratch = tryCheckoutScratch(*c);
+        if (!scratch)
+        {
+            return;
+        }
+        m_Scratch = std::move(*scratch);
         m_CurrentHead = c->getID();
+        scheduleBackgroundWork();
     }
 
     std::filesystem::path const& getFilesystemLocation() const
@@ -678,6 +943,14 @@ private:
     // underlying storage for immutable commits
     std::unordered_map<UID, ModelStateCommit> m_Commits;
 
+    // commits that were garbage-collected, but are yet to be handed to the background worker
+    std::vector<ModelStateCommit> m_EvictedCommits;
+
+    // background worker that finalizes commits (shared between copies of the history,
+    // because the commits themselves are)
+    std::shared_ptr<CommitWorker> m_Worker = std::make_shared<CommitWorker>();
+    std::shared_ptr<std::atomic<uint64_t>> m_BackgroundWorkGeneration = std::make_shared<std::atomic<uint64_t>>(0);
+
     // (maybe) the location of the model on-disk
     std::filesystem::path m_MaybeFilesystemLocation;
 
@@ -711,6 +984,11 @@ osc::UndoableModelStatePair::UndoableModelStatePair(std::filesystem::path const&
 {
 }
 
+osc::UndoableModelStatePair::UndoableModelStatePair(std::unique_ptr<OpenSim::Model> model, ModelIsInitialized tag) :
+    m_Impl{std::make_unique<Impl>(std::move(model), tag)}
+{
+}
+
 osc::UndoableModelStatePair::UndoableModelStatePair(UndoableModelStatePair const& src) :
     m_Impl{std::make_unique<Impl>(*src.m_Impl)}
 {
@@ -773,6 +1051,11 @@ ModelStateCommit const& osc::UndoableModelStatePair::getLatestCommit() const
     return m_Impl->getLatestCommit();
 }
 
+void osc::UndoableModelStatePair::waitForBackgroundWork() const
+{
+    m_Impl->waitForBackgroundWork();
+}
+
 bool osc::UndoableModelStatePair::canUndo() const
 {
     return m_Impl->canUndo();
@@ -853,6 +1136,11 @@ void osc::UndoableModelStatePair::implSetFixupScaleFactor(float v)
     m_Impl->setFixupScaleFactor(v);
 }
 
+OpenSim::Component const* osc::UndoableModelStatePair::implFindComponent(OpenSim::ComponentPath const& p) const
+{
+    return m_Impl->findComponent(p);
+}
+
 OpenSim::Component const* osc::UndoableModelStatePair::implGetSelected() const
 {
     return m_Impl->getSelected();
@@ -10,6 +10,7 @@
 
 namespace OpenSim { class Model; }
 namespace OpenSim { class Component; }
+namespace OpenSim { class ComponentPath; }
 namespace osc { class ModelStateCommit; }
 namespace SimTK { class State; }
 
@@ -32,6 +33,13 @@ namespace osc
         // construct a model by loading an existing on-disk osim file
         explicit UndoableModelStatePair(std::filesystem::path const& osimPath);
 
+        // tag type for constructing from a model that the caller has already initialized (with
+        // `InitializeModel` and `InitializeState`), so that it isn't initialized again
+        struct ModelIsInitialized final {};
+
+        // constructs a model from an existing, already-initialized, in-memory OpenSim model
+        UndoableModelStatePair(std::unique_ptr<OpenSim::Model> model, ModelIsInitialized);
+
         // copy-construct a new UndoableUiModel
         UndoableModelStatePair(UndoableModelStatePair const&);
 
@@ -78,6 +86,12 @@ namespace osc
         // the safer undo/redo buffer)
         ModelStateCommit const& getLatestCommit() const;
 
+        // blocks until the history's background work (compacting commits, preparing the
+        // undo/redo targets' models) that has been scheduled so far has finished
+        //
+        // the UI never needs to call this: it's mostly useful for deterministic testing
+        void waitForBackgroundWork() const;
+
         // manipulate undo/redo state
         bool canUndo() const;
         void doUndo();
@@ -91,6 +105,9 @@ namespace osc
         void rollback();
 
         // try to checkout the given commit as the latest commit
+        //
+        // returns `false` (and leaves the model as-is) if the commit isn't from this model's
+        // history, or if its model can't be rebuilt
         bool tryCheckout(ModelStateCommit const&);
 
         // read/manipulate underlying OpenSim::Model
@@ -110,6 +127,8 @@ namespace osc
         float implGetFixupScaleFactor() const final;
         void implSetFixupScaleFactor(float) final;
 
+        OpenSim::Component const* implFindComponent(OpenSim::ComponentPath const&) const final;
+
         OpenSim::Component const* implGetSelected() const final;
         void implSetSelected(OpenSim::Component const* c) final;
 
@@ -11,6 +11,7 @@
 #include <OpenSimCreator/Utils/SimTKHelpers.h>
 #include <oscar/Platform/Log.h>
 #include <oscar/Utils/Assertions.h>
+#include <oscar/Utils/StridedSpan.h>
 
 #include <map>
 #include <memory>
@@ -30,10 +31,11 @@ namespace
     {
         // TODO: this ignores scale factors
         Mesh mesh = ToOscMesh(model, state, inputMesh);
-        auto vertices = mesh.vertices();
         auto compiled = warper.tryCreatePointWarper(document);
-        compiled->warpInPlace(vertices);
-        mesh.set_vertices(vertices);
+        mesh.modify_vertices([&compiled](StridedSpan<Vec3> vertices)
+        {
+            compiled->warpInPlace(vertices);
+        });
         mesh.recalculate_normals();
         return std::make_unique<InMemoryMesh>(mesh);
     }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <oscar/Maths/Vec3.h>
+#include <oscar/Utils/StridedSpan.h>
 
 #include <array>
 #include <span>
@@ -21,11 +22,12 @@ namespace osc::mow
         Vec3 warp(Vec3 p) const
         {
             auto ap = std::to_array({p});
-            implWarpInPlace(ap);
+            implWarpInPlace(std::span<Vec3>{ap});
             return ap[0];
         }
         void warpInPlace(std::span<Vec3> points) const { implWarpInPlace(points); }
+        void warpInPlace(StridedSpan<Vec3> points) const { implWarpInPlace(points); }
     private:
-        virtual void implWarpInPlace(std::span<Vec3>) const = 0;
+        virtual void implWarpInPlace(StridedSpan<Vec3>) const = 0;
     };
 }
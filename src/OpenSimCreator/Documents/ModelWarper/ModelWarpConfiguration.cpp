@@ -5,12 +5,18 @@
 
 #include <filesystem>
 
+std::filesystem::path osc::mow::CalcModelWarpConfigurationFileLocation(std::filesystem::path const& osimFileLocation)
+{
+    std::filesystem::path rv = osimFileLocation;
+    rv.replace_extension("warpconfig.toml");
+    return rv;
+}
+
 osc::mow::ModelWarpConfiguration::ModelWarpConfiguration(
     std::filesystem::path const& osimFileLocation,
     OpenSim::Model const&)
 {
-    std::filesystem::path maybeWarpconfigLocation = osimFileLocation;
-    maybeWarpconfigLocation.replace_extension("warpconfig.toml");
+    std::filesystem::path const maybeWarpconfigLocation = CalcModelWarpConfigurationFileLocation(osimFileLocation);
     if (std::filesystem::exists(maybeWarpconfigLocation)) {
         auto parsed = toml::parse_file(maybeWarpconfigLocation.string());
         if (auto globals = parsed.get_as<toml::table>("global_settings")) {
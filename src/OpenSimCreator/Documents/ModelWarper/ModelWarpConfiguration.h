@@ -8,6 +8,10 @@ namespace OpenSim { class Model; }
 
 namespace osc::mow
 {
+    // returns the location of the model warp configuration file that's associated with
+    // (i.e. sits next to) the given osim file
+    std::filesystem::path CalcModelWarpConfigurationFileLocation(std::filesystem::path const& osimFileLocation);
+
     // top-level runtime configuration for warping a single OpenSim model
     class ModelWarpConfiguration final {
     public:
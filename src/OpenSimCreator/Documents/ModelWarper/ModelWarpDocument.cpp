@@ -12,6 +12,7 @@
 #include <memory>
 #include <sstream>
 #include <utility>
+#include <vector>
 
 using namespace osc;
 using namespace osc::mow;
@@ -24,6 +25,7 @@ osc::mow::ModelWarpDocument::ModelWarpDocument() :
 {}
 
 osc::mow::ModelWarpDocument::ModelWarpDocument(std::filesystem::path const& osimFileLocation) :
+    m_OsimFileLocation{osimFileLocation},
     m_ModelState{make_cow<BasicModelStatePair>(osimFileLocation)},
     m_ModelWarpConfig{make_cow<ModelWarpConfiguration>(osimFileLocation, m_ModelState->getModel())},
     m_MeshWarpLookup{make_cow<PointWarperFactories>(osimFileLocation, m_ModelState->getModel(), *m_ModelWarpConfig)},
@@ -36,6 +38,21 @@ osc::mow::ModelWarpDocument& osc::mow::ModelWarpDocument::operator=(ModelWarpDoc
 osc::mow::ModelWarpDocument& osc::mow::ModelWarpDocument::operator=(ModelWarpDocument&&) noexcept = default;
 osc::mow::ModelWarpDocument::~ModelWarpDocument() noexcept = default;
 
+std::vector<std::filesystem::path> osc::mow::ModelWarpDocument::filesystemDependencies() const
+{
+    if (m_OsimFileLocation.empty()) {
+        return {};
+    }
+
+    std::vector<std::filesystem::path> rv = FindFilesystemDependencies(model());
+    rv.push_back(m_OsimFileLocation);
+    rv.push_back(CalcModelWarpConfigurationFileLocation(m_OsimFileLocation));
+    for (auto&& p : m_MeshWarpLookup->filesystemDependencies()) {
+        rv.push_back(std::move(p));
+    }
+    return rv;
+}
+
 OpenSim::Model const& osc::mow::ModelWarpDocument::model() const
 {
     return m_ModelState->getModel();
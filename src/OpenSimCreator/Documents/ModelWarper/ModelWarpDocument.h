@@ -34,6 +34,14 @@ namespace osc::mow
         ModelWarpDocument& operator=(ModelWarpDocument&&) noexcept;
         ~ModelWarpDocument() noexcept;
 
+        // returns the location of the osim file that the document was loaded from (empty if
+        // it wasn't loaded from a file)
+        std::filesystem::path const& osimFileLocation() const { return m_OsimFileLocation; }
+
+        // returns the paths of all files that the document is (or would be, if they existed)
+        // loaded from: the osim file, its meshes, its warp configuration, landmark files, etc.
+        std::vector<std::filesystem::path> filesystemDependencies() const;
+
         OpenSim::Model const& model() const;
         IConstModelStatePair const& modelstate() const;
 
@@ -56,6 +64,7 @@ namespace osc::mow
     private:
         std::vector<ValidationCheckResult> implValidate() const;
 
+        std::filesystem::path m_OsimFileLocation;
         CopyOnUpdPtr<BasicModelStatePair> m_ModelState;
         CopyOnUpdPtr<ModelWarpConfiguration> m_ModelWarpConfig;
         CopyOnUpdPtr<PointWarperFactories> m_MeshWarpLookup;
@@ -11,6 +11,7 @@
 #include <filesystem>
 #include <sstream>
 #include <utility>
+#include <vector>
 
 using namespace osc;
 using namespace osc::mow;
@@ -50,3 +51,16 @@ osc::mow::PointWarperFactories::PointWarperFactories(
 
     m_AbsPathToWarpLUT{CreateLut(osimFileLocation, model)}
 {}
+
+std::vector<std::filesystem::path> osc::mow::PointWarperFactories::filesystemDependencies() const
+{
+    std::vector<std::filesystem::path> rv;
+    for (auto const& [absPath, factory] : m_AbsPathToWarpLUT) {
+        if (auto const* tps = dynamic_cast<TPSLandmarkPairWarperFactory const*>(factory.get())) {
+            rv.push_back(tps->recommendedSourceLandmarksFilepath());
+            rv.push_back(tps->recommendedDestinationMeshFilepath());
+            rv.push_back(tps->recommendedDestinationLandmarksFilepath());
+        }
+    }
+    return rv;
+}
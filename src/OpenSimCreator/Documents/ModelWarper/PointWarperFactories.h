@@ -9,6 +9,7 @@
 #include <filesystem>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace OpenSim { class Model; }
 namespace osc::mow { class ModelWarpConfiguration; }
@@ -37,6 +38,10 @@ namespace osc::mow
             return dynamic_cast<TMeshWarp const*>(lookup(meshComponentAbsPath));
         }
 
+        // returns the paths of all files that the point warpers are (or would be, if
+        // they existed) loaded from, e.g. landmark files, destination meshes
+        std::vector<std::filesystem::path> filesystemDependencies() const;
+
     private:
         IPointWarperFactory const* lookup(std::string const& absPath) const
         {
@@ -9,6 +9,7 @@
 #include <oscar/Platform/Log.h>
 #include <oscar/Shims/Cpp23/ranges.h>
 #include <oscar/Utils/Algorithms.h>
+#include <oscar/Utils/StridedSpan.h>
 
 #include <algorithm>
 #include <filesystem>
@@ -328,7 +329,7 @@ std::unique_ptr<IPointWarper> osc::mow::TPSLandmarkPairWarperFactory::implTryCre
             m_BlendingFactor{blendingFactor_}
         {}
     private:
-        void implWarpInPlace(std::span<Vec3> points) const override
+        void implWarpInPlace(StridedSpan<Vec3> points) const override
         {
             ApplyThinPlateWarpToPointsInPlace(*m_Coefficients, points, m_BlendingFactor);
         }
@@ -0,0 +1,258 @@
+#include "AsyncOutputWatchEvaluator.h"
+
+#include <OpenSimCreator/Documents/Model/ModelStateCommit.h>
+#include <OpenSimCreator/Documents/Model/UndoableModelStatePair.h>
+#include <OpenSimCreator/Documents/OutputExtractors/OutputExtractor.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
+#include <OpenSimCreator/Utils/OpenSimHelpers.h>
+
+#include <OpenSim/Simulation/Model/Model.h>
+#include <oscar/Platform/App.h>
+#include <oscar/Platform/Log.h>
+#include <oscar/Utils/LatestRequestWorker.h>
+#include <oscar/Utils/Perf.h>
+#include <oscar/Utils/UID.h>
+#include <Simbody.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    // everything the worker needs in order to evaluate the outputs
+    struct OutputWatchRequest final {
+        ModelStateCommit commit;
+        SimTK::State state;
+        UID modelVersion;
+        UID stateVersion;
+        std::vector<OutputExtractor> outputs;
+    };
+
+    std::string EvaluateOutput(
+        OutputExtractor const& output,
+        OpenSim::Model const& model,
+        SimulationReport const& report)
+    {
+        try {
+            return output.getValueString(model, report);
+        }
+        catch (std::exception const& ex) {
+            log_warn("%s: error evaluating output: %s", output.getName().c_str(), ex.what());
+            return "(error)";
+        }
+    }
+
+    // evaluates each of the outputs against the (report-realized) state
+    //
+    // the outputs are evaluated one after another, because evaluating an `OpenSim::Output`
+    // writes to its (mutable) cached value, so they can't be evaluated concurrently against
+    // one model
+    std::vector<std::string> EvaluateOutputs(
+        OpenSim::Model const& model,
+        SimTK::State const& state,
+        std::span<OutputExtractor const> outputs)
+    {
+        OSC_PERF("AsyncOutputWatchEvaluator/EvaluateOutputs");
+
+        SimulationReport const report{SimTK::State{state}};
+        std::vector<std::string> values;
+        values.reserve(outputs.size());
+        for (OutputExtractor const& output : outputs) {
+            values.push_back(EvaluateOutput(output, model, report));
+        }
+        return values;
+    }
+
+    // the worker's own copy of the model, rebuilt whenever the requests' commit changes
+    struct WorkerModel final {
+        UID commitID = UID::empty();
+        std::unique_ptr<OpenSim::Model> model;
+    };
+
+    // processes one request on the worker thread
+    std::optional<OutputWatchValues> ProcessRequest(WorkerModel& workerModel, OutputWatchRequest& request)
+    {
+        OSC_PERF("AsyncOutputWatchEvaluator/ProcessRequest");
+
+        try {
+            if (not workerModel.model or workerModel.commitID != request.commit.getID()) {
+                workerModel.model = request.commit.instantiateModel();
+                workerModel.commitID = request.commit.getID();
+                InitializeModel(*workerModel.model);
+                InitializeState(*workerModel.model);
+            }
+
+            OpenSim::Model& model = *workerModel.model;
+            SimTK::State& state = model.updWorkingState();
+            state = std::move(request.state);
+            state.invalidateAllCacheAtOrAbove(SimTK::Stage::Instance);
+            model.realizeReport(state);
+
+            return OutputWatchValues{
+                .modelVersion = request.modelVersion,
+                .stateVersion = request.stateVersion,
+                .outputs = request.outputs,
+                .values = EvaluateOutputs(model, state, request.outputs),
+            };
+        }
+        catch (std::exception const&) {
+            workerModel = {};  // the model may be in a bad state
+            throw;  // (the worker logs it)
+        }
+    }
+}
+
+std::optional<std::string> osc::OutputWatchValues::find(OutputExtractor const& output) const
+{
+    for (size_t i = 0; i < outputs.size(); ++i) {
+        if (outputs[i] == output) {
+            return values[i];
+        }
+    }
+    return std::nullopt;
+}
+
+class osc::AsyncOutputWatchEvaluator::Impl final {
+public:
+    Impl() = default;
+    Impl(Impl const&) = delete;
+    Impl(Impl&&) noexcept = delete;
+    Impl& operator=(Impl const&) = delete;
+    Impl& operator=(Impl&&) noexcept = delete;
+    ~Impl() noexcept = default;
+
+    void request(UndoableModelStatePair const& msp, std::span<OutputExtractor const> outputs)
+    {
+        if (msp.getModelVersion() == m_PrevModelVersion and
+            msp.getStateVersion() == m_PrevStateVersion and
+            std::ranges::equal(outputs, m_PrevOutputs)) {
+
+            return;  // already requested
+        }
+
+        m_PrevModelVersion = msp.getModelVersion();
+        m_PrevStateVersion = msp.getStateVersion();
+        m_PrevOutputs.assign(outputs.begin(), outputs.end());
+
+        ModelStateCommit const& commit = msp.getLatestCommit();
+        if (commit.getModelVersion() == msp.getModelVersion()) {
+            m_Worker.request(OutputWatchRequest{  // replaces any stale request
+                .commit = commit,
+                .state = msp.getState(),
+                .modelVersion = msp.getModelVersion(),
+                .stateVersion = msp.getStateVersion(),
+                .outputs = m_PrevOutputs,
+            });
+            m_SynchronousValues.reset();  // (the worker's values will be newer)
+        }
+        else {
+            // there's no commit that the worker could rebuild the model from (e.g. because the
+            // caller is mid-edit), so evaluate the outputs against the caller's model
+            OSC_PERF("AsyncOutputWatchEvaluator/evaluateSynchronously");
+
+            m_Worker.supersede();  // cancels any stale request
+
+            SimTK::State state = msp.getState();
+            msp.getModel().realizeReport(state);
+
+            m_SynchronousValues = OutputWatchValues{
+                .modelVersion = msp.getModelVersion(),
+                .stateVersion = msp.getStateVersion(),
+                .outputs = m_PrevOutputs,
+                .values = EvaluateOutputs(msp.getModel(), state, m_PrevOutputs),
+            };
+        }
+    }
+
+    bool poll()
+    {
+        return swapIntoFront(m_Worker.poll());
+    }
+
+    bool wait()
+    {
+        return swapIntoFront(m_Worker.wait());
+    }
+
+    OutputWatchValues const& getValues() const
+    {
+        return m_Front;
+    }
+
+private:
+    using Worker = LatestRequestWorker<OutputWatchRequest, OutputWatchValues>;
+
+    // returns `true` if newer values (from the worker, or evaluated synchronously) were
+    // swapped into the front buffer
+    bool swapIntoFront(std::optional<Worker::Completed> completed)
+    {
+        if (completed) {
+            m_Front = std::move(completed->result);
+            return true;
+        }
+        if (m_SynchronousValues) {
+            m_Front = std::move(*m_SynchronousValues);
+            m_SynchronousValues.reset();
+            return true;
+        }
+        return false;
+    }
+
+    UID m_PrevModelVersion = UID::empty();
+    UID m_PrevStateVersion = UID::empty();
+    std::vector<OutputExtractor> m_PrevOutputs;
+
+    OutputWatchValues m_Front;
+    std::optional<OutputWatchValues> m_SynchronousValues;
+    Worker m_Worker{
+        "AsyncOutputWatchEvaluator",
+        [workerModel = std::make_shared<WorkerModel>()](OutputWatchRequest& request, LatestRequestCancellation const&)
+        {
+            return ProcessRequest(*workerModel, request);
+        },
+        []()
+        {
+            // something happened on a background thread, the UI thread should probably redraw
+            App::upd().request_redraw();
+        },
+    };  // last: joined on destruction
+};
+
+
+// public API (PIMPL)
+
+osc::AsyncOutputWatchEvaluator::AsyncOutputWatchEvaluator() :
+    m_Impl{std::make_unique<Impl>()}
+{}
+osc::AsyncOutputWatchEvaluator::AsyncOutputWatchEvaluator(AsyncOutputWatchEvaluator&&) noexcept = default;
+osc::AsyncOutputWatchEvaluator& osc::AsyncOutputWatchEvaluator::operator=(AsyncOutputWatchEvaluator&&) noexcept = default;
+osc::AsyncOutputWatchEvaluator::~AsyncOutputWatchEvaluator() noexcept = default;
+
+void osc::AsyncOutputWatchEvaluator::request(UndoableModelStatePair const& msp, std::span<OutputExtractor const> outputs)
+{
+    m_Impl->request(msp, outputs);
+}
+
+bool osc::AsyncOutputWatchEvaluator::poll()
+{
+    return m_Impl->poll();
+}
+
+bool osc::AsyncOutputWatchEvaluator::wait()
+{
+    return m_Impl->wait();
+}
+
+OutputWatchValues const& osc::AsyncOutputWatchEvaluator::getValues() const
+{
+    return m_Impl->getValues();
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <OpenSimCreator/Documents/OutputExtractors/OutputExtractor.h>
+
+#include <oscar/Utils/UID.h>
+
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace osc { class UndoableModelStatePair; }
+
+namespace osc
+{
+    // the values of a list of watched outputs, evaluated against one (model version, state)
+    struct OutputWatchValues final {
+
+        // returns the value of `output`, or `std::nullopt` if it wasn't evaluated
+        std::optional<std::string> find(OutputExtractor const& output) const;
+
+        UID modelVersion = UID::empty();
+        UID stateVersion = UID::empty();
+        std::vector<OutputExtractor> outputs;
+        std::vector<std::string> values;  // one per output
+    };
+
+    // evaluates a list of watched outputs against a model + state on a background worker
+    // thread, so that expensive outputs (e.g. path lengths, contact forces) don't stall the UI
+    //
+    // - requests are snapshots: the worker rebuilds its own copy of the model from the model's
+    //   latest commit (off the UI thread) and evaluates the outputs against it
+    // - requests are skipped if neither the model version, state version, nor watch list
+    //   changed since the previous request, and newer requests replace (not-yet-started)
+    //   stale ones
+    // - if the model has uncommitted changes (i.e. there's no commit that the worker could
+    //   rebuild it from), the outputs are evaluated synchronously
+    class AsyncOutputWatchEvaluator final {
+    public:
+        AsyncOutputWatchEvaluator();
+        AsyncOutputWatchEvaluator(AsyncOutputWatchEvaluator const&) = delete;
+        AsyncOutputWatchEvaluator(AsyncOutputWatchEvaluator&&) noexcept;
+        AsyncOutputWatchEvaluator& operator=(AsyncOutputWatchEvaluator const&) = delete;
+        AsyncOutputWatchEvaluator& operator=(AsyncOutputWatchEvaluator&&) noexcept;
+        ~AsyncOutputWatchEvaluator() noexcept;
+
+        // requests that `outputs` are evaluated against the model's current state (no-op if
+        // nothing changed since the previous request)
+        void request(UndoableModelStatePair const&, std::span<OutputExtractor const> outputs);
+
+        // swaps the most recently published values (if any) into the front buffer
+        //
+        // returns `true` if the front buffer changed
+        bool poll();
+
+        // blocks until the most recent request has been evaluated, then `poll`s
+        bool wait();
+
+        // returns the most recently polled values
+        OutputWatchValues const& getValues() const;
+
+    private:
+        class Impl;
+        std::unique_ptr<Impl> m_Impl;
+    };
+}
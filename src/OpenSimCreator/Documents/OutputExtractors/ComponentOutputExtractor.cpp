@@ -19,13 +19,16 @@
 #include <algorithm>
 #include <array>
 #include <concepts>
+#include <cstddef>
 #include <memory>
+#include <ranges>
 #include <span>
 #include <sstream>
 #include <typeinfo>
 #include <utility>
 
 using namespace osc;
+namespace rgs = std::ranges;
 
 // other helpers
 namespace
@@ -110,6 +113,32 @@ public:
         }
     }
 
+    void getValuesFloat(
+        OpenSim::Component const& component,
+        std::span<SimulationReport const> reports,
+        std::span<float> out) const
+    {
+        // look the output up once per batch, rather than once per report
+        OpenSim::AbstractOutput const* const ao = FindOutput(component, m_ComponentAbsPath, m_OutputName);
+        if (not ao or typeid(*ao) != *m_OutputTypeid) {
+            // cannot find output, or output has changed (same values as the null callbacks)
+            rgs::fill(out, m_ExtractorFunc ? quiet_nan_v<float> : Variant{std::string{}}.to<float>());
+            return;
+        }
+
+        if (m_ExtractorFunc) {
+            for (size_t i = 0; i < reports.size(); ++i) {
+                out[i] = static_cast<float>(m_ExtractorFunc(*ao, reports[i].getState()));
+            }
+        }
+        else {
+            // string outputs: same behavior as converting the extracted value to a float
+            for (size_t i = 0; i < reports.size(); ++i) {
+                out[i] = Variant{ao->getValueAsString(reports[i].getState())}.to<float>();
+            }
+        }
+    }
+
     size_t getHash() const
     {
         return hash_of(m_ComponentAbsPath.toString(), m_OutputName, m_Label, m_OutputTypeid, m_ExtractorFunc);
@@ -183,6 +212,14 @@ OutputValueExtractor osc::ComponentOutputExtractor::implGetOutputValueExtractor(
     return m_Impl->getOutputValueExtractor(component);
 }
 
+void osc::ComponentOutputExtractor::implGetValuesFloat(
+    OpenSim::Component const& component,
+    std::span<SimulationReport const> reports,
+    std::span<float> out) const
+{
+    m_Impl->getValuesFloat(component, reports, out);
+}
+
 std::size_t osc::ComponentOutputExtractor::implGetHash() const
 {
     return m_Impl->getHash();
@@ -12,8 +12,10 @@
 #include <oscar/Utils/HashHelpers.h>
 
 #include <cstddef>
+#include <span>
 #include <sstream>
 #include <string>
+#include <vector>
 
 using namespace osc;
 
@@ -84,6 +86,27 @@ OutputValueExtractor osc::ConcatenatingOutputExtractor::implGetOutputValueExtrac
     }
 }
 
+void osc::ConcatenatingOutputExtractor::implGetValuesVec2(
+    OpenSim::Component const& comp,
+    std::span<SimulationReport const> reports,
+    std::span<Vec2> out) const
+{
+    if (m_OutputType != OutputExtractorDataType::Vec2) {
+        OutputValueExtractor const extractor = implGetOutputValueExtractor(comp);
+        for (size_t i = 0; i < reports.size(); ++i) {
+            out[i] = extractor(reports[i]).to<Vec2>();
+        }
+        return;
+    }
+
+    // extract each side as a batch, then interleave them
+    std::vector<float> const lhs = m_First.slurpValuesFloat(comp, reports);
+    std::vector<float> const rhs = m_Second.slurpValuesFloat(comp, reports);
+    for (size_t i = 0; i < reports.size(); ++i) {
+        out[i] = Vec2{lhs[i], rhs[i]};
+    }
+}
+
 size_t osc::ConcatenatingOutputExtractor::implGetHash() const
 {
     return hash_of(m_First, m_Second);
@@ -8,6 +8,7 @@
 #include <oscar/Utils/CStringView.h>
 
 #include <cstddef>
+#include <span>
 #include <string>
 
 namespace OpenSim { class Component; }
@@ -24,6 +25,7 @@ namespace osc
         CStringView implGetDescription() const override { return {}; }
         OutputExtractorDataType implGetOutputType() const override { return m_OutputType; }
         OutputValueExtractor implGetOutputValueExtractor(OpenSim::Component const&) const override;
+        void implGetValuesVec2(OpenSim::Component const&, std::span<SimulationReport const>, std::span<Vec2>) const override;
         size_t implGetHash() const override;
         bool implEquals(IOutputExtractor const&) const override;
 
@@ -4,15 +4,25 @@
 #include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
 
 #include <oscar/Maths/Constants.h>
+#include <oscar/Utils/Assertions.h>
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
 #include <span>
 #include <sstream>
 #include <string>
 #include <utility>
+#include <vector>
 
 using namespace osc;
 
+namespace
+{
+    // number of values that the consumer-based APIs extract per batch
+    constexpr size_t c_BatchSize = 256;
+}
+
 float osc::IOutputExtractor::getValueFloat(
     OpenSim::Component const& component,
     SimulationReport const& report) const
@@ -26,23 +36,32 @@ void osc::IOutputExtractor::getValuesFloat(
     std::span<SimulationReport const> reports,
     std::function<void(float)> const& consumer) const
 {
-    OutputValueExtractor const extractor = getOutputValueExtractor(component);
-    for (auto const& report : reports) {
-        consumer(extractor(report).to<float>());
+    std::array<float, c_BatchSize> buf{};
+    for (size_t offset = 0; offset < reports.size(); offset += buf.size()) {
+        auto const batch = reports.subspan(offset, std::min(buf.size(), reports.size() - offset));
+        auto const values = std::span{buf}.first(batch.size());
+        implGetValuesFloat(component, batch, values);
+        for (float const v : values) {
+            consumer(v);
+        }
     }
 }
 
+void osc::IOutputExtractor::getValuesFloat(
+    OpenSim::Component const& component,
+    std::span<SimulationReport const> reports,
+    std::span<float> out) const
+{
+    OSC_ASSERT_ALWAYS(out.size() == reports.size() && "the output span should have one element per report");
+    implGetValuesFloat(component, reports, out);
+}
+
 std::vector<float> osc::IOutputExtractor::slurpValuesFloat(
     OpenSim::Component const& component,
     std::span<SimulationReport const> reports) const
 {
-    OutputValueExtractor const extractor = getOutputValueExtractor(component);
-
-    std::vector<float> rv;
-    rv.reserve(reports.size());
-    for (auto const& report : reports) {
-        rv.push_back(extractor(report).to<float>());
-    }
+    std::vector<float> rv(reports.size());
+    implGetValuesFloat(component, reports, rv);
     return rv;
 }
 
@@ -59,23 +78,32 @@ void osc::IOutputExtractor::getValuesVec2(
     std::span<SimulationReport const> reports,
     std::function<void(Vec2)> const& consumer) const
 {
-    OutputValueExtractor const extractor = getOutputValueExtractor(component);
-    for (auto const& report : reports) {
-        consumer(extractor(report).to<Vec2>());
+    std::array<Vec2, c_BatchSize> buf{};
+    for (size_t offset = 0; offset < reports.size(); offset += buf.size()) {
+        auto const batch = reports.subspan(offset, std::min(buf.size(), reports.size() - offset));
+        auto const values = std::span{buf}.first(batch.size());
+        implGetValuesVec2(component, batch, values);
+        for (Vec2 const v : values) {
+            consumer(v);
+        }
     }
 }
 
+void osc::IOutputExtractor::getValuesVec2(
+    OpenSim::Component const& component,
+    std::span<SimulationReport const> reports,
+    std::span<Vec2> out) const
+{
+    OSC_ASSERT_ALWAYS(out.size() == reports.size() && "the output span should have one element per report");
+    implGetValuesVec2(component, reports, out);
+}
+
 std::vector<Vec2> osc::IOutputExtractor::slurpValuesVec2(
     OpenSim::Component const& component,
     std::span<SimulationReport const> reports) const
 {
-    OutputValueExtractor const extractor = getOutputValueExtractor(component);
-
-    std::vector<Vec2> rv;
-    rv.reserve(reports.size());
-    for (auto const& report : reports) {
-        rv.push_back(extractor(report).to<Vec2>());
-    }
+    std::vector<Vec2> rv(reports.size());
+    implGetValuesVec2(component, reports, rv);
     return rv;
 }
 
@@ -85,3 +113,25 @@ std::string osc::IOutputExtractor::getValueString(
 {
     return getOutputValueExtractor(component)(report).to<std::string>();
 }
+
+void osc::IOutputExtractor::implGetValuesFloat(
+    OpenSim::Component const& component,
+    std::span<SimulationReport const> reports,
+    std::span<float> out) const
+{
+    OutputValueExtractor const extractor = getOutputValueExtractor(component);
+    for (size_t i = 0; i < reports.size(); ++i) {
+        out[i] = extractor(reports[i]).to<float>();
+    }
+}
+
+void osc::IOutputExtractor::implGetValuesVec2(
+    OpenSim::Component const& component,
+    std::span<SimulationReport const> reports,
+    std::span<Vec2> out) const
+{
+    OutputValueExtractor const extractor = getOutputValueExtractor(component);
+    for (size_t i = 0; i < reports.size(); ++i) {
+        out[i] = extractor(reports[i]).to<Vec2>();
+    }
+}
@@ -54,6 +54,16 @@ namespace osc
             std::function<void(float)> const& consumer
         ) const;
 
+        // writes one value per report into `out`, which must have the same size as the reports
+        //
+        // this is the fastest way of extracting many values, because implementations can look up
+        // their data source once per batch, rather than once (+ boxing) per value
+        void getValuesFloat(
+            OpenSim::Component const&,
+            std::span<SimulationReport const>,
+            std::span<float> out
+        ) const;
+
         std::vector<float> slurpValuesFloat(
             OpenSim::Component const&,
             std::span<SimulationReport const>
@@ -70,6 +80,13 @@ namespace osc
             std::function<void(Vec2)> const& consumer
         ) const;
 
+        // writes one value per report into `out`, which must have the same size as the reports
+        void getValuesVec2(
+            OpenSim::Component const&,
+            std::span<SimulationReport const>,
+            std::span<Vec2> out
+        ) const;
+
         std::vector<Vec2> slurpValuesVec2(
             OpenSim::Component const&,
             std::span<SimulationReport const>
@@ -92,6 +109,12 @@ namespace osc
         virtual CStringView implGetDescription() const = 0;
         virtual OutputExtractorDataType implGetOutputType() const = 0;
         virtual OutputValueExtractor implGetOutputValueExtractor(OpenSim::Component const&) const = 0;
+
+        // implementors may override these to provide faster batch extraction (by default, they
+        // call the implementation's `OutputValueExtractor` once per report)
+        virtual void implGetValuesFloat(OpenSim::Component const&, std::span<SimulationReport const>, std::span<float> out) const;
+        virtual void implGetValuesVec2(OpenSim::Component const&, std::span<SimulationReport const>, std::span<Vec2> out) const;
+
         virtual size_t implGetHash() const = 0;
         virtual bool implEquals(IOutputExtractor const&) const = 0;
     };
@@ -59,6 +59,16 @@ OutputValueExtractor osc::MultiBodySystemOutputExtractor::implGetOutputValueExtr
     }};
 }
 
+void osc::MultiBodySystemOutputExtractor::implGetValuesFloat(
+    OpenSim::Component const&,
+    std::span<SimulationReport const> reports,
+    std::span<float> out) const
+{
+    for (size_t i = 0; i < reports.size(); ++i) {
+        out[i] = reports[i].getAuxiliaryValue(m_AuxiliaryDataID).value_or(quiet_nan_v<float>);
+    }
+}
+
 std::size_t osc::MultiBodySystemOutputExtractor::implGetHash() const
 {
     return hash_of(m_AuxiliaryDataID, m_Name, m_Description, m_Extractor);
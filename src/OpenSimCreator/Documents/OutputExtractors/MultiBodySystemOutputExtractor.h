@@ -8,6 +8,7 @@
 #include <oscar/Utils/UID.h>
 
 #include <cstddef>
+#include <span>
 #include <string>
 #include <string_view>
 
@@ -42,6 +43,7 @@ namespace osc
         CStringView implGetDescription() const final { return m_Description; }
         OutputExtractorDataType implGetOutputType() const final { return OutputExtractorDataType::Float; }
         OutputValueExtractor implGetOutputValueExtractor(OpenSim::Component const&) const final;
+        void implGetValuesFloat(OpenSim::Component const&, std::span<SimulationReport const>, std::span<float>) const final;
         size_t implGetHash() const final;
         bool implEquals(IOutputExtractor const&) const final;
 
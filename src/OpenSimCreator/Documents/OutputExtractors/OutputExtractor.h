@@ -53,6 +53,14 @@ namespace osc
             m_Output->getValuesFloat(component, reports, consumer);
         }
 
+        void getValuesFloat(
+            OpenSim::Component const& component,
+            std::span<SimulationReport const> reports,
+            std::span<float> out) const
+        {
+            m_Output->getValuesFloat(component, reports, out);
+        }
+
         std::vector<float> slurpValuesFloat(
             OpenSim::Component const& component,
             std::span<SimulationReport const> reports) const
@@ -75,6 +83,14 @@ namespace osc
             m_Output->getValuesVec2(component, report, consumer);
         }
 
+        void getValuesVec2(
+            OpenSim::Component const& component,
+            std::span<SimulationReport const> reports,
+            std::span<Vec2> out) const
+        {
+            m_Output->getValuesVec2(component, reports, out);
+        }
+
         std::vector<Vec2> slurpValuesVec2(
             OpenSim::Component const& component,
             std::span<SimulationReport const> report) const
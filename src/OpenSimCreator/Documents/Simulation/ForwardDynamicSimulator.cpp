@@ -125,6 +125,14 @@ namespace
             }};
         }
 
+        void implGetValuesFloat(OpenSim::Component const&, std::span<SimulationReport const> reports, std::span<float> out) const final
+        {
+            for (size_t i = 0; i < reports.size(); ++i)
+            {
+                out[i] = reports[i].getAuxiliaryValue(m_UID).value_or(-1337.0f);
+            }
+        }
+
         std::size_t implGetHash() const final
         {
             return hash_of(m_Name, m_Description, m_UID);
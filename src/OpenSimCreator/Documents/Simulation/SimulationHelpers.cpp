@@ -5,12 +5,23 @@
 #include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
 
 #include <OpenSim/Simulation/Model/Model.h>
+#include <oscar/Formats/BinaryColumns.h>
+#include <oscar/Formats/CSV.h>
 #include <oscar/Utils/EnumHelpers.h>
 #include <Simbody.h>
 
+#include <algorithm>
 #include <cstddef>
 #include <ostream>
 #include <span>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // number of rows that are extracted (and written) as one chunk of the binary columns format
+    constexpr size_t c_BinaryColumnsChunkSize = 4096;
+}
 
 void osc::WriteOutputsAsCSV(
     OpenSim::Component const& root,
@@ -18,33 +29,97 @@ void osc::WriteOutputsAsCSV(
     std::span<const SimulationReport> reports,
     std::ostream& out)
 {
+    CSVWriter writer{out};
+
     // header line
-    out << "time";
+    writer.write_cell("time");
     for (const OutputExtractor& o : outputs) {
         static_assert(num_options<OutputExtractorDataType>() == 3);
         if (o.getOutputType() == OutputExtractorDataType::Vec2) {
-            out << ',' << o.getName() << "/0";
-            out << ',' << o.getName() << "/1";
+            writer.write_cell(std::string{o.getName()} + "/0");
+            writer.write_cell(std::string{o.getName()} + "/1");
+        }
+        else {
+            writer.write_cell(o.getName());
+        }
+    }
+    writer.end_row();
+
+    // extract each output's values as one batch (column), rather than one value per cell
+    std::vector<std::vector<float>> floatColumns(outputs.size());
+    std::vector<std::vector<Vec2>> vec2Columns(outputs.size());
+    for (size_t i = 0; i < outputs.size(); ++i) {
+        static_assert(num_options<OutputExtractorDataType>() == 3);
+        if (outputs[i].getOutputType() == OutputExtractorDataType::Vec2) {
+            vec2Columns[i] = outputs[i].slurpValuesVec2(root, reports);
         }
         else {
-            out << ',' << o.getName();
+            floatColumns[i] = outputs[i].slurpValuesFloat(root, reports);
         }
     }
-    out << '\n';
 
     // data lines
-    for (const SimulationReport& report : reports) {
-        out << report.getState().getTime();  // time column
+    for (size_t row = 0; row < reports.size(); ++row) {
+        writer.write_cell(reports[row].getState().getTime());  // time column
+        for (size_t i = 0; i < outputs.size(); ++i) {
+            if (outputs[i].getOutputType() == OutputExtractorDataType::Vec2) {
+                const Vec2 v = vec2Columns[i][row];
+                writer.write_cell(v.x);
+                writer.write_cell(v.y);
+            }
+            else {
+                writer.write_cell(floatColumns[i][row]);
+            }
+        }
+        writer.end_row();
+    }
+    writer.flush();
+}
+
+void osc::WriteOutputsAsBinaryColumns(
+    const OpenSim::Component& root,
+    std::span<const OutputExtractor> outputs,
+    std::span<const SimulationReport> reports,
+    std::ostream& out,
+    BinaryColumnsWriterFlags flags)
+{
+    std::vector<BinaryColumnDescription> columns;
+    columns.reserve(outputs.size() + 1);
+    columns.push_back({"time", BinaryColumnType::Double});
+    for (const OutputExtractor& o : outputs) {
+        static_assert(num_options<OutputExtractorDataType>() == 3);
+        const bool isVec2 = o.getOutputType() == OutputExtractorDataType::Vec2;
+        columns.push_back({std::string{o.getName()}, isVec2 ? BinaryColumnType::Vec2 : BinaryColumnType::Float});
+    }
+
+    BinaryColumnsWriter writer{out, columns, flags};
+
+    // extract each output one chunk (of rows) at a time, so that memory usage doesn't scale with the number of reports
+    std::vector<double> times;
+    std::vector<float> floats;
+    std::vector<Vec2> vec2s;
+    for (size_t begin = 0; begin < reports.size(); begin += c_BinaryColumnsChunkSize) {
+        const std::span<const SimulationReport> chunk = reports.subspan(begin, std::min(c_BinaryColumnsChunkSize, reports.size() - begin));
+        writer.begin_chunk(chunk.size());
+
+        times.clear();
+        for (const SimulationReport& report : chunk) {
+            times.push_back(report.getState().getTime());
+        }
+        writer.write_column(times);
+
         for (const OutputExtractor& o : outputs) {
-            static_assert(num_options<OutputExtractorDataType>() == 3);
             if (o.getOutputType() == OutputExtractorDataType::Vec2) {
-                const Vec2 v = o.getValueVec2(root, report);
-                out << ',' << v.x << ',' << v.y;
+                vec2s.resize(chunk.size());
+                o.getValuesVec2(root, chunk, std::span{vec2s});
+                writer.write_column(vec2s);
             }
             else {
-                out << ',' << o.getValueFloat(root, report);
+                floats.resize(chunk.size());
+                o.getValuesFloat(root, chunk, std::span{floats});
+                writer.write_column(floats);
             }
         }
-        out << '\n';
     }
+    writer.finish();
 }
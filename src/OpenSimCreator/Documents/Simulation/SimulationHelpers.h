@@ -1,5 +1,7 @@
 #pragma once
 
+#include <oscar/Formats/BinaryColumns.h>
+
 #include <iosfwd>
 #include <span>
 
@@ -15,4 +17,15 @@ namespace osc
         std::span<const SimulationReport>,
         std::ostream&
     );
+
+    // writes the outputs in the binary columns format (see `oscar/Formats/BinaryColumns.h`), with
+    // the same columns as `WriteOutputsAsCSV`, but typed (`time` is a `Double` column, `Vec2`
+    // outputs are `Vec2` columns, all other outputs are `Float` columns)
+    void WriteOutputsAsBinaryColumns(
+        const OpenSim::Component&,
+        std::span<const OutputExtractor>,
+        std::span<const SimulationReport>,
+        std::ostream&,
+        BinaryColumnsWriterFlags = BinaryColumnsWriterFlags::Default
+    );
 }
@@ -0,0 +1,391 @@
+#include "AsyncModelDecorationGenerator.h"
+
+#include <OpenSimCreator/Documents/Model/IConstModelStatePair.h>
+#include <OpenSimCreator/Documents/Model/ModelStatePairInfo.h>
+#include <OpenSimCreator/Graphics/OpenSimDecorationOptions.h>
+#include <OpenSimCreator/Graphics/OpenSimGraphicsHelpers.h>
+#include <OpenSimCreator/Graphics/OverlayDecorationGenerator.h>
+#include <OpenSimCreator/Graphics/OverlayDecorationOptions.h>
+#include <OpenSimCreator/Utils/OpenSimHelpers.h>
+
+#include <OpenSim/Common/Component.h>
+#include <OpenSim/Common/ComponentPath.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <oscar/Graphics/Scene/SceneCache.h>
+#include <oscar/Graphics/Scene/SceneDecoration.h>
+#include <oscar/Graphics/Scene/SceneHelpers.h>
+#include <oscar/Maths/AABB.h>
+#include <oscar/Maths/BVH.h>
+#include <oscar/Platform/App.h>
+#include <oscar/Utils/LatestRequestWorker.h>
+#include <oscar/Utils/Perf.h>
+#include <oscar/Utils/UID.h>
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    // a copy of the caller's model that is exclusively used by the background worker
+    //
+    // the copy is made on the caller's thread (so that it's a consistent snapshot) but
+    // is initialized lazily by the worker
+    struct ModelSnapshot final {
+        explicit ModelSnapshot(OpenSim::Model const& model_) :
+            model{std::make_unique<OpenSim::Model>(model_)}
+        {}
+
+        std::unique_ptr<OpenSim::Model> model;
+        bool isInitialized = false;  // only accessed by the worker
+    };
+
+    // a drawlist + scene BVH pair that is swapped between the worker and the caller
+    struct DecorationBuffers final {
+        UID id = UID::empty();
+        std::vector<SceneDecoration> drawlist;
+        BVH bvh;
+    };
+
+    // everything the worker needs in order to (re)generate decorations
+    struct DecorationGenerationRequest final {
+        std::shared_ptr<ModelSnapshot> modelSnapshot;
+        SimTK::State state;
+        OpenSim::ComponentPath selection;
+        OpenSim::ComponentPath hover;
+        float fixupScaleFactor = 1.0f;
+        OpenSimDecorationOptions decorationOptions;
+        OverlayDecorationOptions overlayOptions;
+        DecorationBuffers buffers;  // recycled from a previous result (if available)
+    };
+
+    // an `IConstModelStatePair` that refers to the worker's copy of the model
+    class SnapshotModelStatePair final : public IConstModelStatePair {
+    public:
+        SnapshotModelStatePair(
+            OpenSim::Model const& model,
+            SimTK::State const& state,
+            OpenSim::ComponentPath const& selection,
+            OpenSim::ComponentPath const& hover,
+            float fixupScaleFactor) :
+
+            m_Model{&model},
+            m_State{&state},
+            m_Selected{FindComponent(model, selection)},
+            m_Hovered{FindComponent(model, hover)},
+            m_FixupScaleFactor{fixupScaleFactor}
+        {}
+
+    private:
+        OpenSim::Model const& implGetModel() const final { return *m_Model; }
+        SimTK::State const& implGetState() const final { return *m_State; }
+        OpenSim::Component const* implGetSelected() const final { return m_Selected; }
+        OpenSim::Component const* implGetHovered() const final { return m_Hovered; }
+        float implGetFixupScaleFactor() const final { return m_FixupScaleFactor; }
+
+        OpenSim::Model const* m_Model;
+        SimTK::State const* m_State;
+        OpenSim::Component const* m_Selected;
+        OpenSim::Component const* m_Hovered;
+        float m_FixupScaleFactor;
+    };
+
+    // generates model + overlay decorations into the given buffers
+    void GenerateDecorationsInto(
+        SceneCache& meshCache,
+        IConstModelStatePair const& msp,
+        OpenSimDecorationOptions const& decorationOptions,
+        OverlayDecorationOptions const& overlayOptions,
+        DecorationBuffers& out,
+        std::function<void()> const& throwIfCancelled = []() {})
+    {
+        out.drawlist.clear();
+        out.bvh.clear();
+
+        GenerateDecorations(
+            meshCache,
+            msp,
+            decorationOptions,
+            [&out, &throwIfCancelled](OpenSim::Component const&, SceneDecoration&& dec)
+            {
+                throwIfCancelled();
+                out.drawlist.push_back(std::move(dec));
+            }
+        );
+        throwIfCancelled();
+        update_scene_bvh(out.drawlist, out.bvh);
+
+        GenerateOverlayDecorations(
+            meshCache,
+            overlayOptions,
+            out.bvh,
+            [&out](SceneDecoration&& dec)
+            {
+                out.drawlist.push_back(std::move(dec));
+            }
+        );
+    }
+
+    // processes one request on the worker thread
+    std::optional<DecorationBuffers> ProcessRequest(
+        SceneCache& meshCache,
+        DecorationGenerationRequest& request,
+        LatestRequestCancellation const& cancellation)
+    {
+        OSC_PERF("AsyncModelDecorationGenerator/ProcessRequest");
+
+        OpenSim::Model& model = *request.modelSnapshot->model;
+        if (not request.modelSnapshot->isInitialized) {
+            InitializeModel(model);
+            InitializeState(model);
+            request.modelSnapshot->isInitialized = true;
+        }
+        cancellation.throw_if_cancelled();
+
+        // note: realizing the report stage is usually the slow part (e.g. path wrapping)
+        SimTK::State& state = model.updWorkingState();
+        state = std::move(request.state);
+        state.invalidateAllCacheAtOrAbove(SimTK::Stage::Instance);
+        model.realizeReport(state);
+        cancellation.throw_if_cancelled();
+
+        SnapshotModelStatePair const msp{
+            model,
+            state,
+            request.selection,
+            request.hover,
+            request.fixupScaleFactor,
+        };
+        GenerateDecorationsInto(
+            meshCache,
+            msp,
+            request.decorationOptions,
+            request.overlayOptions,
+            request.buffers,
+            [&cancellation]() { cancellation.throw_if_cancelled(); }
+        );
+        return std::move(request.buffers);
+    }
+}
+
+class osc::AsyncModelDecorationGenerator::Impl final {
+public:
+    explicit Impl(std::shared_ptr<SceneCache> meshCache) :
+        m_MeshCache{std::move(meshCache)},
+        m_Worker{
+            "AsyncModelDecorationGenerator",
+            [cache = m_MeshCache](DecorationGenerationRequest& request, LatestRequestCancellation const& cancellation)
+            {
+                return ProcessRequest(*cache, request, cancellation);
+            },
+            []()
+            {
+                // something happened on a background thread, the UI thread should probably redraw
+                App::upd().request_redraw();
+            },
+        }
+    {}
+
+    Impl(Impl const&) = delete;
+    Impl(Impl&&) noexcept = delete;
+    Impl& operator=(Impl const&) = delete;
+    Impl& operator=(Impl&&) noexcept = delete;
+    ~Impl() noexcept = default;
+
+    void request(
+        IConstModelStatePair const& msp,
+        OpenSimDecorationOptions const& decorationOptions,
+        OverlayDecorationOptions const& overlayOptions)
+    {
+        ModelStatePairInfo const info{msp};
+        if (info == m_PrevInfo and
+            decorationOptions == m_PrevDecorationOptions and
+            overlayOptions == m_PrevOverlayOptions) {
+
+            return;  // already requested
+        }
+
+        bool const modelChanged = msp.getModelVersion() != m_PrevModelVersion;
+        bool const stateChanged = msp.getStateVersion() != m_PrevStateVersion;
+        if (modelChanged) {
+            m_ModelSnapshot.reset();
+        }
+        else if (stateChanged and not m_ModelSnapshot) {
+            // the caller is (probably) scrubbing through states of the same model, so it's
+            // worth taking a copy of the model so that the worker can handle future requests
+            OSC_PERF("AsyncModelDecorationGenerator/copyModel");
+            m_ModelSnapshot = std::make_shared<ModelSnapshot>(msp.getModel());
+        }
+
+        if (m_ModelSnapshot) {
+            sendToWorker(msp, decorationOptions, overlayOptions);
+        }
+        else {
+            generateSynchronously(msp, decorationOptions, overlayOptions);
+        }
+
+        m_PrevInfo = info;
+        m_PrevModelVersion = msp.getModelVersion();
+        m_PrevStateVersion = msp.getStateVersion();
+        m_PrevDecorationOptions = decorationOptions;
+        m_PrevOverlayOptions = overlayOptions;
+    }
+
+    bool poll()
+    {
+        return swapIntoFront(m_Worker.poll());
+    }
+
+    bool wait()
+    {
+        return swapIntoFront(m_Worker.wait());
+    }
+
+    bool isBusy() const
+    {
+        return m_Worker.is_busy();
+    }
+
+    SceneCache& updSceneCache() const
+    {
+        return *m_MeshCache;
+    }
+
+    std::span<SceneDecoration const> getDrawlist() const
+    {
+        return m_Front.drawlist;
+    }
+
+    BVH const& getBVH() const
+    {
+        return m_Front.bvh;
+    }
+
+    std::optional<AABB> getAABB() const
+    {
+        return m_Front.bvh.bounds();
+    }
+
+private:
+    using Worker = LatestRequestWorker<DecorationGenerationRequest, DecorationBuffers>;
+
+    // swaps the worker's result (if any) into the front buffer and recycles the old front
+    // buffer, then returns `true` if the front buffer changed since the last call
+    bool swapIntoFront(std::optional<Worker::Completed> completed)
+    {
+        if (completed) {
+            std::swap(m_Front, completed->result);
+            m_Front.id = completed->request_id;
+            m_Recycled = std::move(completed->result);
+        }
+
+        bool const changed = m_Front.id != m_LastPolledID;
+        m_LastPolledID = m_Front.id;
+        return changed;
+    }
+
+    void sendToWorker(
+        IConstModelStatePair const& msp,
+        OpenSimDecorationOptions const& decorationOptions,
+        OverlayDecorationOptions const& overlayOptions)
+    {
+        DecorationGenerationRequest request{
+            .modelSnapshot = m_ModelSnapshot,
+            .state = msp.getState(),
+            .selection = GetAbsolutePathOrEmpty(msp.getSelected()),
+            .hover = GetAbsolutePathOrEmpty(msp.getHovered()),
+            .fixupScaleFactor = msp.getFixupScaleFactor(),
+            .decorationOptions = decorationOptions,
+            .overlayOptions = overlayOptions,
+            .buffers = std::move(m_Recycled),
+        };
+        m_Recycled = {};
+
+        m_Worker.request(std::move(request));  // replaces (cancels) any stale request
+    }
+
+    void generateSynchronously(
+        IConstModelStatePair const& msp,
+        OpenSimDecorationOptions const& decorationOptions,
+        OverlayDecorationOptions const& overlayOptions)
+    {
+        OSC_PERF("AsyncModelDecorationGenerator/generateSynchronously");
+
+        UID const requestID = m_Worker.supersede();  // also cancels any in-flight work
+        GenerateDecorationsInto(*m_MeshCache, msp, decorationOptions, overlayOptions, m_Front);
+        m_Front.id = requestID;
+    }
+
+    // caller-side state
+    std::shared_ptr<SceneCache> m_MeshCache;
+    ModelStatePairInfo m_PrevInfo;
+    UID m_PrevModelVersion = UID::empty();
+    UID m_PrevStateVersion = UID::empty();
+    OpenSimDecorationOptions m_PrevDecorationOptions;
+    OverlayDecorationOptions m_PrevOverlayOptions;
+    std::shared_ptr<ModelSnapshot> m_ModelSnapshot;
+    DecorationBuffers m_Front;
+    DecorationBuffers m_Recycled;
+    UID m_LastPolledID = UID::empty();
+
+    // worker (joined on destruction, so must be declared last)
+    Worker m_Worker;
+};
+
+
+// public API (PIMPL)
+
+osc::AsyncModelDecorationGenerator::AsyncModelDecorationGenerator(std::shared_ptr<SceneCache> meshCache) :
+    m_Impl{std::make_unique<Impl>(std::move(meshCache))}
+{}
+osc::AsyncModelDecorationGenerator::AsyncModelDecorationGenerator(AsyncModelDecorationGenerator&&) noexcept = default;
+osc::AsyncModelDecorationGenerator& osc::AsyncModelDecorationGenerator::operator=(AsyncModelDecorationGenerator&&) noexcept = default;
+osc::AsyncModelDecorationGenerator::~AsyncModelDecorationGenerator() noexcept = default;
+
+void osc::AsyncModelDecorationGenerator::request(
+    IConstModelStatePair const& msp,
+    OpenSimDecorationOptions const& decorationOptions,
+    OverlayDecorationOptions const& overlayOptions)
+{
+    m_Impl->request(msp, decorationOptions, overlayOptions);
+}
+
+bool osc::AsyncModelDecorationGenerator::poll()
+{
+    return m_Impl->poll();
+}
+
+bool osc::AsyncModelDecorationGenerator::wait()
+{
+    return m_Impl->wait();
+}
+
+bool osc::AsyncModelDecorationGenerator::isBusy() const
+{
+    return m_Impl->isBusy();
+}
+
+SceneCache& osc::AsyncModelDecorationGenerator::updSceneCache() const
+{
+    return m_Impl->updSceneCache();
+}
+
+std::span<SceneDecoration const> osc::AsyncModelDecorationGenerator::getDrawlist() const
+{
+    return m_Impl->getDrawlist();
+}
+
+BVH const& osc::AsyncModelDecorationGenerator::getBVH() const
+{
+    return m_Impl->getBVH();
+}
+
+std::optional<AABB> osc::AsyncModelDecorationGenerator::getAABB() const
+{
+    return m_Impl->getAABB();
+}
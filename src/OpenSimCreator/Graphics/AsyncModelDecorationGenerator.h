@@ -0,0 +1,66 @@
+#pragma once
+
+#include <oscar/Maths/AABB.h>
+
+#include <memory>
+#include <optional>
+#include <span>
+
+namespace osc { class BVH; }
+namespace osc { class IConstModelStatePair; }
+namespace osc { class OpenSimDecorationOptions; }
+namespace osc { class OverlayDecorationOptions; }
+namespace osc { struct SceneDecoration; }
+namespace osc { class SceneCache; }
+
+namespace osc
+{
+    // generates decorations for a (model version, state, options) tuple on a background
+    // worker thread, so that slow decoration generation (e.g. wrapping surfaces, path
+    // realization) doesn't block the UI thread
+    //
+    // - results are double-buffered: callers always see the most recently completed
+    //   drawlist + scene BVH, which is only swapped when `poll`ing (or `wait`ing)
+    // - newer requests cancel older (stale) ones, so (e.g.) quickly scrubbing through a
+    //   simulation only generates decorations for the latest request
+    // - the first request for a new model version is handled synchronously, because the
+    //   worker needs its own copy of the model and the caller's model may be mutated
+    //   between frames (e.g. by the model editor). A copy is only made once the state
+    //   changes without the model changing (i.e. the caller is scrubbing)
+    class AsyncModelDecorationGenerator final {
+    public:
+        explicit AsyncModelDecorationGenerator(std::shared_ptr<SceneCache>);
+        AsyncModelDecorationGenerator(AsyncModelDecorationGenerator const&) = delete;
+        AsyncModelDecorationGenerator(AsyncModelDecorationGenerator&&) noexcept;
+        AsyncModelDecorationGenerator& operator=(AsyncModelDecorationGenerator const&) = delete;
+        AsyncModelDecorationGenerator& operator=(AsyncModelDecorationGenerator&&) noexcept;
+        ~AsyncModelDecorationGenerator() noexcept;
+
+        // requests decorations for the given inputs (no-op if they match the previous request)
+        void request(
+            IConstModelStatePair const&,
+            OpenSimDecorationOptions const&,
+            OverlayDecorationOptions const&
+        );
+
+        // swaps the most recently completed decorations (if any) into the front buffer
+        //
+        // returns `true` if the front buffer has changed since the last call to `poll`/`wait`
+        bool poll();
+
+        // blocks until the most recent request has completed, then `poll`s
+        bool wait();
+
+        // returns `true` if the background worker has a request that hasn't been polled yet
+        bool isBusy() const;
+
+        SceneCache& updSceneCache() const;
+        std::span<SceneDecoration const> getDrawlist() const;
+        BVH const& getBVH() const;
+        std::optional<AABB> getAABB() const;
+
+    private:
+        class Impl;
+        std::unique_ptr<Impl> m_Impl;
+    };
+}
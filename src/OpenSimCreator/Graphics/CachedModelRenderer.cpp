@@ -1,10 +1,9 @@
 #include "CachedModelRenderer.h"
 
 #include <OpenSimCreator/Documents/Model/IConstModelStatePair.h>
-#include <OpenSimCreator/Documents/Model/ModelStatePairInfo.h>
+#include <OpenSimCreator/Graphics/AsyncModelDecorationGenerator.h>
 #include <OpenSimCreator/Graphics/ModelRendererParams.h>
 #include <OpenSimCreator/Graphics/OpenSimGraphicsHelpers.h>
-#include <OpenSimCreator/Graphics/OverlayDecorationGenerator.h>
 
 #include <oscar/Graphics/AntiAliasingLevel.h>
 #include <oscar/Graphics/Scene/SceneCache.h>
@@ -28,88 +27,10 @@
 
 using namespace osc;
 
-namespace
-{
-    // cache for decorations generated from a model+state+params
-    class CachedDecorationState final {
-    public:
-        explicit CachedDecorationState(std::shared_ptr<SceneCache> meshCache_) :
-            m_MeshCache{std::move(meshCache_)}
-        {
-        }
-
-        bool update(
-            IConstModelStatePair const& modelState,
-            ModelRendererParams const& params)
-        {
-            OSC_PERF("CachedModelRenderer/generateDecorationsCached");
-
-            ModelStatePairInfo const info{modelState};
-            if (info != m_PrevModelStateInfo ||
-                params.decorationOptions != m_PrevDecorationOptions ||
-                params.overlayOptions != m_PrevOverlayOptions)
-            {
-                m_Drawlist.clear();
-                m_BVH.clear();
-
-                // regenerate
-                auto const onComponentDecoration = [this](OpenSim::Component const&, SceneDecoration&& dec)
-                {
-                    m_Drawlist.push_back(std::move(dec));
-                };
-                GenerateDecorations(
-                    *m_MeshCache,
-                    modelState,
-                    params.decorationOptions,
-                    onComponentDecoration
-                );
-                update_scene_bvh(m_Drawlist, m_BVH);
-
-                auto const onOverlayDecoration = [this](SceneDecoration&& dec)
-                {
-                    m_Drawlist.push_back(std::move(dec));
-                };
-                GenerateOverlayDecorations(
-                    *m_MeshCache,
-                    params.overlayOptions,
-                    m_BVH,
-                    onOverlayDecoration
-                );
-
-                m_PrevModelStateInfo = info;
-                m_PrevDecorationOptions = params.decorationOptions;
-                m_PrevOverlayOptions = params.overlayOptions;
-                return true;   // updated
-            }
-            else
-            {
-                return false;  // already up to date
-            }
-        }
-
-        std::span<SceneDecoration const> getDrawlist() const { return m_Drawlist; }
-        BVH const& getBVH() const { return m_BVH; }
-        std::optional<AABB> getAABB() const { return m_BVH.bounds(); }
-        SceneCache& updSceneCache() const
-        {
-            // TODO: technically (imo) this breaks `const`
-            return *m_MeshCache;
-        }
-
-    private:
-        std::shared_ptr<SceneCache> m_MeshCache;
-        ModelStatePairInfo m_PrevModelStateInfo;
-        OpenSimDecorationOptions m_PrevDecorationOptions;
-        OverlayDecorationOptions m_PrevOverlayOptions;
-        std::vector<SceneDecoration> m_Drawlist;
-        BVH m_BVH;
-    };
-}
-
 class osc::CachedModelRenderer::Impl final {
 public:
     explicit Impl(std::shared_ptr<SceneCache> const& cache) :
-        m_DecorationCache{cache},
+        m_DecorationGenerator{cache},
         m_Renderer{*cache}
     {}
 
@@ -118,8 +39,10 @@ public:
         ModelRendererParams& params,
         float aspectRatio)
     {
-        m_DecorationCache.update(modelState, params);
-        if (std::optional<AABB> const aabb = m_DecorationCache.getAABB())
+        // the camera can't be focused on decorations that haven't been generated yet
+        m_DecorationGenerator.request(modelState, params.decorationOptions, params.overlayOptions);
+        m_DecorationGenerator.wait();
+        if (std::optional<AABB> const aabb = m_DecorationGenerator.getAABB())
         {
             auto_focus(params.camera, *aabb, aspectRatio);
         }
@@ -141,12 +64,17 @@ public:
             modelState.getFixupScaleFactor()
         );
 
+        // request decorations for the current inputs, but keep rendering the previous
+        // decorations until the (potentially, background) generator has finished
+        m_DecorationGenerator.request(modelState, renderParams.decorationOptions, renderParams.overlayOptions);
+        bool const decorationsChanged = m_DecorationGenerator.poll();
+
         // if the decorations or rendering params have changed, re-render
-        if (m_DecorationCache.update(modelState, renderParams) ||
+        if (decorationsChanged ||
             rendererParameters != m_PrevRendererParams)
         {
             OSC_PERF("CachedModelRenderer/on_draw/render");
-            m_Renderer.render(m_DecorationCache.getDrawlist(), rendererParameters);
+            m_Renderer.render(m_DecorationGenerator.getDrawlist(), rendererParameters);
             m_PrevRendererParams = rendererParameters;
         }
 
@@ -160,12 +88,12 @@ public:
 
     std::span<SceneDecoration const> getDrawlist() const
     {
-        return m_DecorationCache.getDrawlist();
+        return m_DecorationGenerator.getDrawlist();
     }
 
     std::optional<AABB> bounds() const
     {
-        return m_DecorationCache.getAABB();
+        return m_DecorationGenerator.getAABB();
     }
 
     std::optional<SceneCollision> getClosestCollision(
@@ -174,9 +102,9 @@ public:
         Rect const& viewportScreenRect) const
     {
         return GetClosestCollision(
-            m_DecorationCache.getBVH(),
-            m_DecorationCache.updSceneCache(),
-            m_DecorationCache.getDrawlist(),
+            m_DecorationGenerator.getBVH(),
+            m_DecorationGenerator.updSceneCache(),
+            m_DecorationGenerator.getDrawlist(),
             params.camera,
             mouseScreenPos,
             viewportScreenRect
@@ -184,7 +112,7 @@ public:
     }
 
 private:
-    CachedDecorationState m_DecorationCache;
+    AsyncModelDecorationGenerator m_DecorationGenerator;
     SceneRendererParams m_PrevRendererParams;
     SceneRenderer m_Renderer;
 };
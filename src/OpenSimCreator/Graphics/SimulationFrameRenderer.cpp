@@ -0,0 +1,472 @@
+#include "SimulationFrameRenderer.h"
+
+#include <OpenSimCreator/Documents/Simulation/ISimulation.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
+#include <OpenSimCreator/Graphics/OpenSimDecorationGenerator.h>
+#include <OpenSimCreator/Graphics/OpenSimGraphicsHelpers.h>
+#include <OpenSimCreator/Graphics/OverlayDecorationGenerator.h>
+#include <OpenSimCreator/Utils/OpenSimHelpers.h>
+
+#include <OpenSim/Common/Component.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <oscar/Formats/Image.h>
+#include <oscar/Graphics/ColorSpace.h>
+#include <oscar/Graphics/Graphics.h>
+#include <oscar/Graphics/Scene/SceneCache.h>
+#include <oscar/Graphics/Scene/SceneDecoration.h>
+#include <oscar/Graphics/Scene/SceneHelpers.h>
+#include <oscar/Graphics/Scene/SceneRenderer.h>
+#include <oscar/Graphics/Scene/SceneRendererParams.h>
+#include <oscar/Graphics/Texture2D.h>
+#include <oscar/Graphics/TextureFormat.h>
+#include <oscar/Maths/AABB.h>
+#include <oscar/Maths/BVH.h>
+#include <oscar/Maths/GeometricFunctions.h>
+#include <oscar/Maths/PolarPerspectiveCamera.h>
+#include <oscar/Maths/Vec2.h>
+#include <oscar/Platform/App.h>
+#include <oscar/Shims/Cpp20/stop_token.h>
+#include <oscar/Shims/Cpp20/thread.h>
+#include <oscar/Utils/Perf.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    // the decorations of one simulation frame, ready for rendering
+    struct DecoratedFrame final {
+        std::vector<SceneDecoration> drawlist;
+        BVH bvh;
+    };
+
+    // a sliding window of frames that the decoration workers fill (in any order) and
+    // the renderer consumes (in order)
+    //
+    // workers block when they get `maxFramesInFlight` ahead of the renderer, which bounds
+    // how many decorated frames are held in memory at once
+    class DecorationWindow final {
+    public:
+        DecorationWindow(size_t numFrames, size_t maxFramesInFlight) :
+            m_Frames(numFrames),
+            m_MaxFramesInFlight{std::max<size_t>(maxFramesInFlight, 1)}
+        {}
+
+        // called by a worker: returns the index of the next frame that it should decorate, or
+        // `std::nullopt` if there's nothing left to do (or the pipeline was cancelled)
+        std::optional<size_t> claimNextFrame()
+        {
+            std::unique_lock lock{m_Mutex};
+            m_Condition.wait(lock, [this]()
+            {
+                return m_Cancelled or m_NextFrameToClaim >= m_Frames.size() or m_NextFrameToClaim < m_NextFrameToRender + m_MaxFramesInFlight;
+            });
+
+            if (m_Cancelled or m_NextFrameToClaim >= m_Frames.size()) {
+                return std::nullopt;
+            }
+            return m_NextFrameToClaim++;
+        }
+
+        // called by a worker once it has decorated the given frame
+        void submit(size_t frameIndex, DecoratedFrame&& frame)
+        {
+            {
+                std::lock_guard lock{m_Mutex};
+                m_Frames.at(frameIndex) = std::move(frame);
+            }
+            m_Condition.notify_all();
+        }
+
+        // called by a worker if it fails: the error is rethrown on the rendering thread
+        void fail(std::exception_ptr ex)
+        {
+            {
+                std::lock_guard lock{m_Mutex};
+                if (not m_Failure) {
+                    m_Failure = std::move(ex);
+                }
+                m_Cancelled = true;
+            }
+            m_Condition.notify_all();
+        }
+
+        // called by the renderer: blocks until the given frame is decorated and returns it
+        DecoratedFrame take(size_t frameIndex)
+        {
+            DecoratedFrame rv;
+            {
+                std::unique_lock lock{m_Mutex};
+                m_Condition.wait(lock, [this, frameIndex]()
+                {
+                    return m_Failure or m_Frames.at(frameIndex).has_value();
+                });
+
+                if (m_Failure) {
+                    std::rethrow_exception(m_Failure);
+                }
+
+                rv = std::move(*m_Frames[frameIndex]);
+                m_Frames[frameIndex].reset();
+                m_NextFrameToRender = frameIndex + 1;
+            }
+            m_Condition.notify_all();  // workers may now be able to run ahead
+            return rv;
+        }
+
+        // makes all workers exit at their next opportunity
+        void cancel()
+        {
+            {
+                std::lock_guard lock{m_Mutex};
+                m_Cancelled = true;
+            }
+            m_Condition.notify_all();
+        }
+
+    private:
+        std::mutex m_Mutex;
+        std::condition_variable m_Condition;
+        std::vector<std::optional<DecoratedFrame>> m_Frames;
+        size_t m_MaxFramesInFlight;
+        size_t m_NextFrameToClaim = 0;
+        size_t m_NextFrameToRender = 0;
+        std::exception_ptr m_Failure;
+        bool m_Cancelled = false;
+    };
+
+    // pixels of one rendered frame that are waiting to be encoded
+    struct RenderedFrame final {
+        size_t frameIndex = 0;
+        Vec2i dimensions;
+        std::vector<uint8_t> pixelData;
+    };
+
+    // a bounded, single-producer, single-consumer, queue of rendered frames
+    class RenderedFrameQueue final {
+    public:
+        explicit RenderedFrameQueue(size_t capacity) :
+            m_Capacity{std::max<size_t>(capacity, 1)}
+        {}
+
+        // called by the renderer: blocks while the queue is full
+        //
+        // rethrows the encoder's error if encoding has failed
+        void push(RenderedFrame&& frame)
+        {
+            {
+                std::unique_lock lock{m_Mutex};
+                m_Condition.wait(lock, [this]() { return m_Failure or m_Closed or m_Frames.size() < m_Capacity; });
+
+                if (m_Failure) {
+                    std::rethrow_exception(m_Failure);
+                }
+                if (m_Closed) {
+                    return;
+                }
+                m_Frames.push_back(std::move(frame));
+            }
+            m_Condition.notify_all();
+        }
+
+        // called by the encoder: blocks until a frame is available, or returns `std::nullopt`
+        // once the queue is closed and drained
+        std::optional<RenderedFrame> pop()
+        {
+            std::optional<RenderedFrame> rv;
+            {
+                std::unique_lock lock{m_Mutex};
+                m_Condition.wait(lock, [this]() { return m_Closed or not m_Frames.empty(); });
+
+                if (m_Frames.empty()) {
+                    return std::nullopt;
+                }
+                rv = std::move(m_Frames.front());
+                m_Frames.pop_front();
+            }
+            m_Condition.notify_all();
+            return rv;
+        }
+
+        // called by the encoder if it fails: the error is rethrown on the rendering thread
+        void fail(std::exception_ptr ex)
+        {
+            {
+                std::lock_guard lock{m_Mutex};
+                m_Failure = std::move(ex);
+                m_Closed = true;
+                m_Frames.clear();
+            }
+            m_Condition.notify_all();
+        }
+
+        // stops accepting new frames (the encoder drains any remaining ones)
+        void close()
+        {
+            {
+                std::lock_guard lock{m_Mutex};
+                m_Closed = true;
+            }
+            m_Condition.notify_all();
+        }
+
+        void rethrowIfFailed()
+        {
+            std::lock_guard lock{m_Mutex};
+            if (m_Failure) {
+                std::rethrow_exception(m_Failure);
+            }
+        }
+
+    private:
+        std::mutex m_Mutex;
+        std::condition_variable m_Condition;
+        std::deque<RenderedFrame> m_Frames;
+        size_t m_Capacity;
+        std::exception_ptr m_Failure;
+        bool m_Closed = false;
+    };
+
+    std::filesystem::path CalcFramePath(SimulationFrameRendererParams const& params, size_t frameIndex)
+    {
+        std::stringstream ss;
+        ss << params.filenamePrefix << std::setw(6) << std::setfill('0') << frameIndex << ".png";
+        return params.outputDirectory / std::move(ss).str();
+    }
+
+    // top-level "main" function that each decoration worker executes
+    void DecorationWorkerMain(
+        cpp20::stop_token const&,
+        ISimulation const& simulation,
+        std::span<SimulationReport const> reports,
+        ModelRendererParams const& params,
+        SceneCache& meshCache,
+        DecorationWindow& window,
+        SimulationFrameRendererStageStats& stats)
+    {
+        try {
+            // each worker has its own copy of the model, so that workers can independently
+            // realize states without contending on the simulation's model
+            std::unique_ptr<OpenSim::Model> model;
+            {
+                auto const guard = simulation.getModel();
+                model = std::make_unique<OpenSim::Model>(*guard);
+            }
+            InitializeModel(*model);
+            InitializeState(*model);
+            float const fixupScaleFactor = simulation.getFixupScaleFactor();
+
+            while (std::optional<size_t> const frameIndex = window.claimNextFrame()) {
+                OSC_PERF("SimulationFrameRenderer/decorate");
+                auto const start = Clock::now();
+
+                SimTK::State& state = model->updWorkingState();
+                state = reports[*frameIndex].getState();
+                state.invalidateAllCacheAtOrAbove(SimTK::Stage::Instance);
+                model->realizeReport(state);
+
+                DecoratedFrame frame;
+                GenerateModelDecorations(
+                    meshCache,
+                    *model,
+                    state,
+                    params.decorationOptions,
+                    fixupScaleFactor,
+                    [&frame](OpenSim::Component const&, SceneDecoration&& dec)
+                    {
+                        frame.drawlist.push_back(std::move(dec));
+                    }
+                );
+                update_scene_bvh(frame.drawlist, frame.bvh);
+                GenerateOverlayDecorations(
+                    meshCache,
+                    params.overlayOptions,
+                    frame.bvh,
+                    [&frame](SceneDecoration&& dec)
+                    {
+                        frame.drawlist.push_back(std::move(dec));
+                    }
+                );
+
+                stats.busyTime += Clock::now() - start;
+                ++stats.numFrames;
+                window.submit(*frameIndex, std::move(frame));
+            }
+        }
+        catch (...) {
+            window.fail(std::current_exception());
+        }
+    }
+
+    // top-level "main" function that the PNG encoder executes
+    void EncoderMain(
+        cpp20::stop_token const&,
+        SimulationFrameRendererParams const& params,
+        RenderedFrameQueue& queue,
+        SimulationFrameRendererStageStats& stats)
+    {
+        try {
+            while (std::optional<RenderedFrame> frame = queue.pop()) {
+                OSC_PERF("SimulationFrameRenderer/encode");
+                auto const start = Clock::now();
+
+                // note: the texture never leaves the CPU, so it's safe to use on this thread
+                Texture2D texture{frame->dimensions, TextureFormat::RGB24, ColorSpace::sRGB};
+                texture.set_pixel_data(frame->pixelData);
+
+                std::filesystem::path const path = CalcFramePath(params, frame->frameIndex);
+                std::ofstream fout{path, std::ios_base::binary};
+                if (not fout) {
+                    throw std::runtime_error{path.string() + ": cannot open for writing"};
+                }
+                write_to_png(texture, fout);
+
+                stats.busyTime += Clock::now() - start;
+                ++stats.numFrames;
+            }
+        }
+        catch (...) {
+            queue.fail(std::current_exception());
+        }
+    }
+
+    void PrintStageStats(std::ostream& o, char const* label, SimulationFrameRendererStageStats const& stats)
+    {
+        o << "    " << label << ": " << stats.numFrames << " frames on " << stats.numThreads << " thread(s), "
+          << stats.busyTime.count() << " s busy, " << stats.framesPerSecondPerThread() << " fps per thread\n";
+    }
+}
+
+std::ostream& osc::operator<<(std::ostream& o, SimulationFrameRendererReport const& report)
+{
+    o << "SimulationFrameRendererReport:\n";
+    o << "    wrote " << report.numFramesWritten << " frames in " << report.wallTime.count() << " s (" << report.framesPerSecond() << " fps end-to-end)\n";
+    PrintStageStats(o, "decoration", report.decoration);
+    PrintStageStats(o, "rendering", report.rendering);
+    PrintStageStats(o, "encoding", report.encoding);
+    return o;
+}
+
+SimulationFrameRendererReport osc::RenderSimulationFramesToPNGs(
+    ISimulation const& simulation,
+    SimulationFrameRendererParams const& params)
+{
+    OSC_PERF("RenderSimulationFramesToPNGs");
+
+    auto const wallStart = Clock::now();
+
+    SimulationFrameRendererReport rv;
+    rv.decoration.numThreads = std::max<size_t>(params.numDecorationThreads, 1);
+    rv.rendering.numThreads = 1;
+    rv.encoding.numThreads = 1;
+
+    std::vector<SimulationReport> const reports = simulation.getAllSimulationReports();
+    if (reports.empty()) {
+        return rv;
+    }
+    std::filesystem::create_directories(params.outputDirectory);
+
+    std::shared_ptr<SceneCache> const meshCache = App::singleton<SceneCache>(App::resource_loader());
+    DecorationWindow window{reports.size(), params.maxFramesInFlight};
+    RenderedFrameQueue queue{params.maxFramesInFlight};
+    std::vector<SimulationFrameRendererStageStats> workerStats(rv.decoration.numThreads);
+
+    // note: declared outside of the `try` block, so that the threads are only joined
+    //       after the pipeline has been cancelled (otherwise, they could deadlock)
+    std::vector<cpp20::jthread> decorationWorkers;
+    cpp20::jthread encoder;
+    try {
+        decorationWorkers.reserve(workerStats.size());
+        for (SimulationFrameRendererStageStats& stats : workerStats) {
+            decorationWorkers.emplace_back(
+                DecorationWorkerMain,
+                std::cref(simulation),
+                std::span<SimulationReport const>{reports},
+                std::cref(params.rendererParams),
+                std::ref(*meshCache),
+                std::ref(window),
+                std::ref(stats)
+            );
+        }
+        encoder = cpp20::jthread{EncoderMain, std::cref(params), std::ref(queue), std::ref(rv.encoding)};
+
+        // render each frame, in order, on this (the graphics context's) thread
+        SceneRenderer renderer{*meshCache};
+        ModelRendererParams rendererParams = params.rendererParams;
+        Texture2D readback{params.dimensions, TextureFormat::RGB24, ColorSpace::sRGB};
+        for (size_t i = 0; i < reports.size(); ++i) {
+            DecoratedFrame const frame = window.take(i);
+
+            OSC_PERF("SimulationFrameRenderer/render");
+            auto const start = Clock::now();
+
+            if (i == 0 and params.autoFocusCamera) {
+                if (std::optional<AABB> const aabb = frame.bvh.bounds()) {
+                    auto_focus(rendererParams.camera, *aabb, aspect_ratio_of(params.dimensions));
+                }
+            }
+
+            SceneRendererParams const rendererParameters = CalcSceneRendererParams(
+                rendererParams,
+                Vec2{params.dimensions},
+                params.antiAliasingLevel,
+                simulation.getFixupScaleFactor()
+            );
+            renderer.render(frame.drawlist, rendererParameters);
+            graphics::copy_texture(renderer.upd_render_texture(), readback);  // reads back to the CPU
+            std::span<uint8_t const> const pixelData = readback.pixel_data();
+
+            rv.rendering.busyTime += Clock::now() - start;
+            ++rv.rendering.numFrames;
+
+            queue.push(RenderedFrame{
+                .frameIndex = i,
+                .dimensions = params.dimensions,
+                .pixelData = {pixelData.begin(), pixelData.end()},
+            });
+        }
+    }
+    catch (...) {
+        window.cancel();
+        queue.fail(std::current_exception());
+        throw;
+    }
+
+    // drain the encoder
+    queue.close();
+    encoder.join();
+    for (cpp20::jthread& worker : decorationWorkers) {
+        worker.join();
+    }
+    queue.rethrowIfFailed();
+
+    for (SimulationFrameRendererStageStats const& stats : workerStats) {
+        rv.decoration.numFrames += stats.numFrames;
+        rv.decoration.busyTime += stats.busyTime;
+    }
+    rv.numFramesWritten = rv.encoding.numFrames;
+    rv.wallTime = Clock::now() - wallStart;
+    return rv;
+}
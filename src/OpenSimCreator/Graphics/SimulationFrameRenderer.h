@@ -0,0 +1,88 @@
+#pragma once
+
+#include <OpenSimCreator/Graphics/ModelRendererParams.h>
+
+#include <oscar/Graphics/AntiAliasingLevel.h>
+#include <oscar/Maths/Vec2.h>
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <iosfwd>
+#include <string>
+
+namespace osc { class ISimulation; }
+
+namespace osc
+{
+    // parameters for rendering each report of a simulation to an image sequence
+    struct SimulationFrameRendererParams final {
+
+        // directory that the images are written to (created if it doesn't exist)
+        std::filesystem::path outputDirectory;
+
+        // images are named `{filenamePrefix}{frameIndex:06}.png`
+        std::string filenamePrefix = "frame_";
+
+        Vec2i dimensions = {1280, 720};
+        AntiAliasingLevel antiAliasingLevel{4};
+        ModelRendererParams rendererParams;
+
+        // if `true`, the camera is focused on the first frame's decorations
+        bool autoFocusCamera = true;
+
+        // how many background threads generate decorations for upcoming frames
+        size_t numDecorationThreads = 2;
+
+        // how many frames the decoration/encoding stages may run ahead of rendering
+        size_t maxFramesInFlight = 8;
+    };
+
+    // throughput of one stage of the rendering pipeline
+    struct SimulationFrameRendererStageStats final {
+
+        // frames per second that each thread in the stage achieved (on average) while busy
+        double framesPerSecondPerThread() const
+        {
+            return busyTime.count() > 0.0 ? static_cast<double>(numFrames) / busyTime.count() : 0.0;
+        }
+
+        size_t numThreads = 1;
+        size_t numFrames = 0;
+        std::chrono::duration<double> busyTime{};  // summed over all threads in the stage
+    };
+
+    // a summary of a (completed) simulation frame rendering run
+    struct SimulationFrameRendererReport final {
+
+        // end-to-end frames per second of the whole pipeline
+        double framesPerSecond() const
+        {
+            return wallTime.count() > 0.0 ? static_cast<double>(numFramesWritten) / wallTime.count() : 0.0;
+        }
+
+        size_t numFramesWritten = 0;
+        std::chrono::duration<double> wallTime{};
+        SimulationFrameRendererStageStats decoration;
+        SimulationFrameRendererStageStats rendering;
+        SimulationFrameRendererStageStats encoding;
+    };
+
+    std::ostream& operator<<(std::ostream&, SimulationFrameRendererReport const&);
+
+    // renders each report in the simulation to a PNG image without any UI
+    //
+    // the work is pipelined: decorations for upcoming frames are generated on background
+    // threads (each with its own copy of the model) while the current frame is rendered
+    // on the calling thread, and rendered frames are PNG-encoded on a writer thread
+    //
+    // - must be called from the thread that owns the graphics context (e.g. after
+    //   constructing an `App`), but doesn't require the application's main loop and only
+    //   renders into offscreen render textures, so it works with software OpenGL
+    //   implementations on (e.g.) headless CI machines (e.g. Mesa's llvmpipe under Xvfb)
+    // - throws if any stage of the pipeline fails
+    SimulationFrameRendererReport RenderSimulationFramesToPNGs(
+        ISimulation const&,
+        SimulationFrameRendererParams const&
+    );
+}
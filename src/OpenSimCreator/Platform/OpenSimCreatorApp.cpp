@@ -17,6 +17,7 @@
 #include <OpenSim/Simulation/Model/ModelVisualizer.h>
 #include <OpenSim/Tools/RegisterTypes_osimTools.h>
 #include <OpenSimThirdPartyPlugins/RegisterTypes_osimPlugin.h>
+#include <oscar/Graphics/Scene/SceneCache.h>
 #include <oscar/Platform/App.h>
 #include <oscar/Platform/AppConfig.h>
 #include <oscar/Platform/AppMetadata.h>
@@ -24,13 +25,17 @@
 #include <oscar/Platform/os.h>
 #include <oscar/UI/Tabs/TabRegistry.h>
 #include <oscar/Utils/CStringView.h>
+#include <oscar/Utils/Perf.h>
+#include <oscar/Utils/TaskGraph.h>
 #include <oscar_demos/OscarDemosTabRegistry.h>
 #include <oscar_learnopengl/LearnOpenGLTabRegistry.h>
 
+#include <chrono>
 #include <clocale>
 #include <filesystem>
 #include <locale>
 #include <memory>
+#include <span>
 #include <string>
 
 using namespace osc::fd;
@@ -154,6 +159,16 @@ namespace
         log_info("added geometry search path entry: %s", geometryDir.string().c_str());
     }
 
+    // logs the given startup task timings and records them for the perf panel
+    void ReportStartupTaskTimings(std::span<TaskTiming const> timings)
+    {
+        for (TaskTiming const& timing : timings)
+        {
+            log_info("startup: %s: took %.1f ms (thread %zu)", timing.label.c_str(), std::chrono::duration<double, std::milli>{timing.duration()}.count(), timing.thread_index);
+        }
+        submit_startup_task_timings(timings);
+    }
+
     bool InitializeOpenSim(AppConfig const& config)
     {
         // make this process (OSC) globally use the same locale that OpenSim uses
@@ -235,6 +250,26 @@ bool osc::GlobalInitOpenSim(AppConfig const& config)
 osc::OpenSimCreatorApp::OpenSimCreatorApp() :
     App{GetOpenSimCreatorAppMetadata()}
 {
-    GlobalInitOpenSim(config());
-    InitializeTabRegistry(*singleton<TabRegistry>());
+    // (everything else, e.g. the component registries and icons, is lazily initialized
+    // on first use)
+    TaskGraph startup;
+
+    // OpenSim's global state (e.g. its object registry, log, and search paths) isn't
+    // thread-safe, so it's initialized on the calling thread
+    auto const opensim = startup.add("initialize OpenSim", [&config = config()]() { GlobalInitOpenSim(config); }, {}, TaskFlags::RunOnCallingThread);
+    startup.add("initialize tab registry", []() { InitializeTabRegistry(*singleton<TabRegistry>()); }, {opensim}, TaskFlags::RunOnCallingThread);
+
+    // meanwhile, a worker thread generates the (CPU-side) meshes that most 3D viewports
+    // use, so that the first frame that shows a model doesn't have to
+    startup.add("generate scene meshes", [cache = singleton<SceneCache>(resource_loader())]()
+    {
+        cache->sphere_mesh();
+        cache->cylinder_mesh();
+        cache->brick_mesh();
+        cache->cone_mesh();
+        cache->floor_mesh();
+        cache->grid_mesh();
+    });
+
+    ReportStartupTaskTimings(startup.run());
 }
@@ -1,26 +1,32 @@
 #include "LoadingTab.h"
 
+#include <OpenSimCreator/Documents/Model/StagedOsimLoader.h>
 #include <OpenSimCreator/Documents/Model/UndoableModelStatePair.h>
 #include <OpenSimCreator/Platform/RecentFiles.h>
 #include <OpenSimCreator/UI/IMainUIStateAPI.h>
 #include <OpenSimCreator/UI/ModelEditor/ModelEditorTab.h>
 #include <OpenSimCreator/Utils/OpenSimHelpers.h>
 
+#include <oscar/Graphics/Scene/SceneCache.h>
 #include <oscar/Maths/MathHelpers.h>
 #include <oscar/Maths/Rect.h>
 #include <oscar/Maths/Vec2.h>
 #include <oscar/Platform/App.h>
 #include <oscar/Platform/Log.h>
+#include <oscar/Shims/Cpp20/stop_token.h>
+#include <oscar/Shims/Cpp20/thread.h>
 #include <oscar/UI/ImGuiHelpers.h>
 #include <oscar/UI/oscimgui.h>
 #include <oscar/UI/Tabs/ITabHost.h>
 #include <oscar/Utils/ParentPtr.h>
+#include <oscar/Utils/SynchronizedValue.h>
 
 #include <chrono>
 #include <exception>
 #include <filesystem>
-#include <future>
 #include <memory>
+#include <optional>
+#include <span>
 #include <string>
 #include <utility>
 
@@ -28,9 +34,48 @@ using namespace osc;
 
 namespace
 {
-    std::unique_ptr<UndoableModelStatePair> LoadOsimIntoUndoableModel(std::filesystem::path const& p)
+    // state that's shared between the UI thread and the loading thread
+    struct LoadingState final {
+        OsimLoadingProgress progress;
+        std::unique_ptr<UndoableModelStatePair> result;
+        std::optional<std::string> errorMessage;
+        bool cancelled = false;
+    };
+
+    void LogStageTimings(std::filesystem::path const& osimPath, std::span<OsimLoadingStageTiming const> timings)
     {
-        return std::make_unique<UndoableModelStatePair>(p);
+        log_info("loaded %s: stage timings:", osimPath.filename().string().c_str());
+        for (OsimLoadingStageTiming const& timing : timings)
+        {
+            log_info("    %s: %.1f ms", GetOsimLoadingStageString(timing.stage).c_str(), 1000.0 * timing.duration.count());
+        }
+    }
+
+    void LoadOsimIntoUndoableModel(
+        cpp20::stop_token const& stopToken,
+        std::filesystem::path const& osimPath,
+        std::shared_ptr<SceneCache> const& meshCache,
+        std::shared_ptr<SynchronizedValue<LoadingState>> const& state)
+    {
+        try
+        {
+            StagedOsimLoadingResult loaded = LoadOsimInStages(osimPath, *meshCache, stopToken, [&state](OsimLoadingProgress const& progress)
+            {
+                state->lock()->progress = progress;
+            });
+            LogStageTimings(osimPath, loaded.timings);
+            state->lock()->result = std::move(loaded.model);
+        }
+        catch (OsimLoadingCancelled const&)
+        {
+            log_info("%s: loading cancelled", osimPath.string().c_str());
+            state->lock()->cancelled = true;
+        }
+        catch (std::exception const& ex)
+        {
+            log_info("exception thrown while loading model: %s", ex.what());
+            state->lock()->errorMessage = ex.what();
+        }
     }
 }
 
@@ -43,7 +88,7 @@ public:
 
         m_Parent{parent_},
         m_OsimPath{std::move(path_)},
-        m_LoadingResult{std::async(std::launch::async, LoadOsimIntoUndoableModel, m_OsimPath)}
+        m_LoadingThread{LoadOsimIntoUndoableModel, m_OsimPath, App::singleton<SceneCache>(), m_LoadingState}
     {
     }
 
@@ -59,11 +104,6 @@ public:
 
     void on_tick()
     {
-        auto const dt = static_cast<float>(App::get().frame_delta_since_last_frame().count());
-
-        // tick the progress bar up a little bit
-        m_LoadingProgress += (dt * (1.0f - m_LoadingProgress))/2.0f;
-
         // if there's an error, then the result came through (it's an error)
         // and this screen should just continuously show the error until the
         // user decides to transition back
@@ -72,20 +112,24 @@ public:
             return;
         }
 
-        // otherwise, poll for the result and catch any exceptions that bubble
-        // up from the background thread
-        std::unique_ptr<UndoableModelStatePair> result = nullptr;
-        try
+        // otherwise, poll the loading thread for its progress/result
+        std::unique_ptr<UndoableModelStatePair> result;
+        bool cancelled = false;
         {
-            if (m_LoadingResult.wait_for(std::chrono::seconds{0}) == std::future_status::ready)
+            auto state = m_LoadingState->lock();
+            m_LoadingProgress = state->progress;
+            if (state->errorMessage)
             {
-                result = m_LoadingResult.get();
+                m_LoadingErrorMsg = *state->errorMessage;
+                return;
             }
+            result = std::move(state->result);
+            cancelled = state->cancelled;
         }
-        catch (std::exception const& ex)
+
+        if (cancelled)
         {
-            log_info("LoadingScreen::on_tick: exception thrown while loading model: %s", ex.what());
-            m_LoadingErrorMsg = ex.what();
+            m_Parent->close_tab(m_TabID);
             return;
         }
 
@@ -121,7 +165,20 @@ public:
             if (ui::begin_panel("Loading Message", nullptr, ImGuiWindowFlags_NoTitleBar))
             {
                 ui::draw_text("loading: %s", m_OsimPath.string().c_str());
-                ui::draw_progress_bar(m_LoadingProgress);
+                ui::draw_progress_bar(m_LoadingProgress.fractionCompleted);
+                if (m_CancellationRequested)
+                {
+                    ui::draw_text_disabled("cancelling (after %s)...", GetOsimLoadingStageString(m_LoadingProgress.stage).c_str());
+                }
+                else
+                {
+                    ui::draw_text_disabled("%s...", GetOsimLoadingStageString(m_LoadingProgress.stage).c_str());
+                    if (ui::draw_button("cancel"))
+                    {
+                        m_LoadingThread.request_stop();
+                        m_CancellationRequested = true;
+                    }
+                }
             }
             ui::end_panel();
         }
@@ -152,19 +209,20 @@ private:
     // filesystem path to the osim being loaded
     std::filesystem::path m_OsimPath;
 
-    // future that lets the UI thread poll the loading thread for
-    // the loaded model
-    std::future<std::unique_ptr<UndoableModelStatePair>> m_LoadingResult;
+    // state that the loading thread writes, and the UI thread polls
+    std::shared_ptr<SynchronizedValue<LoadingState>> m_LoadingState = std::make_shared<SynchronizedValue<LoadingState>>();
+
+    // the most recent progress reported by the loading thread
+    OsimLoadingProgress m_LoadingProgress;
 
     // if not empty, any error encountered by the loading thread
     std::string m_LoadingErrorMsg;
 
-    // a fake progress indicator that never quite reaches 100 %
-    //
-    // this might seem evil, but its main purpose is to ensure the
-    // user that *something* is happening - even if that "something"
-    // is "the background thread is deadlocked" ;)
-    float m_LoadingProgress = 0.0f;
+    // `true` if the user clicked "cancel" (the loading thread stops after its current stage)
+    bool m_CancellationRequested = false;
+
+    // the thread that loads the osim (last, so that it's stopped+joined first)
+    cpp20::jthread m_LoadingThread;
 };
 
 
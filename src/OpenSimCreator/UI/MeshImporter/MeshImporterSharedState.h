@@ -28,7 +28,10 @@
 #include <oscar/Graphics/Scene/SceneHelpers.h>
 #include <oscar/Graphics/Scene/SceneRenderer.h>
 #include <oscar/Graphics/Scene/SceneRendererParams.h>
+#include <oscar/Maths/AABB.h>
 #include <oscar/Maths/Angle.h>
+#include <oscar/Maths/BVH.h>
+#include <oscar/Maths/BVHCollision.h>
 #include <oscar/Maths/CollisionTests.h>
 #include <oscar/Maths/Line.h>
 #include <oscar/Maths/MathHelpers.h>
@@ -56,6 +59,7 @@
 #include <cstddef>
 #include <exception>
 #include <filesystem>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <span>
@@ -555,10 +559,8 @@ namespace osc::mi
             m_SceneScaleFactor = newScaleFactor;
         }
 
-        MeshImporterHover doHovertest(std::vector<DrawableThing> const& drawables) const
+        MeshImporterHover doHovertest(std::vector<DrawableThing> const& drawables)
         {
-            auto cache = App::singleton<SceneCache>(App::resource_loader());
-
             Rect const sceneRect = get3DSceneRect();
             Vec2 const mousePos = ui::get_mouse_pos();
 
@@ -572,45 +574,29 @@ namespace osc::mi
             Vec2 const relMousePos = mousePos - sceneRect.p1;
 
             Line const ray = getCamera().unproject_topleft_pos_to_world_ray(relMousePos, sceneDims);
-            bool const hittestMeshes = isMeshesInteractable();
-            bool const hittestBodies = isBodiesInteractable();
-            bool const hittestJointCenters = isJointCentersInteractable();
-            bool const hittestGround = isGroundInteractable();
-            bool const hittestStations = isStationsInteractable();
 
-            UID closestID = MIIDs::Empty();
-            float closestDist = std::numeric_limits<float>::max();
+            // update the scene-level BVH with the worldspace bounds of each hittable drawable
+            //
+            // non-hittable drawables are given an empty (point) AABB, which excludes them from
+            // the BVH, so that they're never considered for (expensive) ray-triangle tests. The
+            // drawables are regenerated each frame, but mostly only move a little, so the BVH is
+            // usually refit, rather than rebuilt
+            m_HovertestAABBs.clear();
+            m_HovertestAABBs.reserve(drawables.size());
             for (DrawableThing const& drawable : drawables)
             {
-                if (drawable.id == MIIDs::Empty())
-                {
-                    continue;  // no hittest data
-                }
-
-                if (drawable.groupId == MIIDs::BodyGroup() && !hittestBodies)
-                {
-                    continue;
-                }
-
-                if (drawable.groupId == MIIDs::MeshGroup() && !hittestMeshes)
-                {
-                    continue;
-                }
-
-                if (drawable.groupId == MIIDs::JointGroup() && !hittestJointCenters)
-                {
-                    continue;
-                }
-
-                if (drawable.groupId == MIIDs::GroundGroup() && !hittestGround)
-                {
-                    continue;
-                }
+                m_HovertestAABBs.push_back(isHittable(drawable) ? calcBounds(drawable) : AABB{});
+            }
+            m_HovertestBVH.update_from_aabbs(m_HovertestAABBs);
 
-                if (drawable.groupId == MIIDs::StationGroup() && !hittestStations)
-                {
-                    continue;
-                }
+            // visit drawables in nearest-first order, only ray-triangle testing drawables
+            // that could contain a closer hit than the closest one found so far
+            auto cache = App::singleton<SceneCache>(App::resource_loader());
+            UID closestID = MIIDs::Empty();
+            float closestDist = std::numeric_limits<float>::max();
+            m_HovertestBVH.for_each_ray_aabb_collision_nearest_first(ray, [&](BVHCollision const& aabbCollision)
+            {
+                DrawableThing const& drawable = drawables[aabbCollision.id];
 
                 std::optional<RayCollision> const rc = get_closest_worldspace_ray_triangle_collision(
                     drawable.mesh,
@@ -624,7 +610,8 @@ namespace osc::mi
                     closestID = drawable.id;
                     closestDist = rc->distance;
                 }
-            }
+                return closestDist;
+            });
 
             Vec3 const hitPos = closestID != MIIDs::Empty() ? ray.origin + closestDist*ray.direction : Vec3{};
 
@@ -1305,6 +1292,40 @@ namespace osc::mi
             return {&m_InteractivityFlags.ground, sizeof(m_InteractivityFlags)/sizeof(bool)};
         }
 
+        // returns `true` if the drawable has hittest data and its group is currently interactable
+        bool isHittable(DrawableThing const& drawable) const
+        {
+            if (drawable.id == MIIDs::Empty())
+            {
+                return false;  // no hittest data
+            }
+
+            if (drawable.groupId == MIIDs::BodyGroup())
+            {
+                return isBodiesInteractable();
+            }
+            else if (drawable.groupId == MIIDs::MeshGroup())
+            {
+                return isMeshesInteractable();
+            }
+            else if (drawable.groupId == MIIDs::JointGroup())
+            {
+                return isJointCentersInteractable();
+            }
+            else if (drawable.groupId == MIIDs::GroundGroup())
+            {
+                return isGroundInteractable();
+            }
+            else if (drawable.groupId == MIIDs::StationGroup())
+            {
+                return isStationsInteractable();
+            }
+            else
+            {
+                return true;
+            }
+        }
+
         bool isMeshesInteractable() const
         {
             return m_InteractivityFlags.meshes;
@@ -1558,6 +1579,12 @@ namespace osc::mi
         // mesh was the leg of a fly
         float m_SceneScaleFactor = 1.0f;
 
+        // scene-level BVH of the worldspace bounds of the most recently hittested drawables
+        //
+        // it's kept between frames, so that it can be incrementally updated as things move
+        std::vector<AABB> m_HovertestAABBs;
+        BVH m_HovertestBVH;
+
         // buffer containing issues found in the modelgraph
         std::vector<std::string> m_IssuesBuffer;
 
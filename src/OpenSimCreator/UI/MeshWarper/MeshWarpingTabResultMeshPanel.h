@@ -129,7 +129,7 @@ namespace osc
                 ui::table_set_column_index(0);
                 ui::draw_text("# vertices");
                 ui::table_set_column_index(1);
-                ui::draw_text("%zu", m_State->getResultMesh().num_vertices());
+                ui::draw_text("%zu%s", m_State->getResultMesh().num_vertices(), m_State->isResultMeshAPreview() ? " (preview)" : "");
 
                 ui::table_next_row();
                 ui::table_set_column_index(0);
@@ -150,15 +150,15 @@ namespace osc
             {
                 if (ui::draw_menu_item("Mesh to OBJ"))
                 {
-                    ActionTrySaveMeshToObjFile(m_State->getResultMesh(), ObjWriterFlags::Default);
+                    ActionTrySaveMeshToObjFile(m_State->getFullResolutionResultMesh(), ObjWriterFlags::Default);
                 }
                 if (ui::draw_menu_item("Mesh to OBJ (no normals)"))
                 {
-                    ActionTrySaveMeshToObjFile(m_State->getResultMesh(), ObjWriterFlags::NoWriteNormals);
+                    ActionTrySaveMeshToObjFile(m_State->getFullResolutionResultMesh(), ObjWriterFlags::NoWriteNormals);
                 }
                 if (ui::draw_menu_item("Mesh to STL"))
                 {
-                    ActionTrySaveMeshToStlFile(m_State->getResultMesh());
+                    ActionTrySaveMeshToStlFile(m_State->getFullResolutionResultMesh());
                 }
                 if (ui::draw_menu_item("Warped Non-Participating Landmarks to CSV"))
                 {
@@ -70,11 +70,26 @@ namespace osc
         }
 
         // returns a (potentially cached) post-TPS-warp mesh
+        //
+        // this may be a (decimated) preview of the result while the full-resolution
+        // warp is computed in the background
         Mesh const& getResultMesh()
         {
             return meshResultCache.getWarpedMesh(editedDocument->scratch());
         }
 
+        // returns the full-resolution post-TPS-warp mesh, blocking until it's available
+        Mesh const& getFullResolutionResultMesh()
+        {
+            return meshResultCache.getFullResolutionWarpedMesh(editedDocument->scratch());
+        }
+
+        // returns `true` if the mesh most recently returned by `getResultMesh` is a preview
+        bool isResultMeshAPreview() const
+        {
+            return meshResultCache.isWarpedMeshAPreview();
+        }
+
         std::span<Vec3 const> getResultNonParticipatingLandmarkLocations()
         {
             return meshResultCache.getWarpedNonParticipatingLandmarkLocations(editedDocument->scratch());
@@ -162,7 +177,10 @@ namespace osc
         ParentPtr<ITabHost> tabHost;
 
         // cached TPS3D algorithm result (to prevent recomputing it each frame)
-        TPSResultCache meshResultCache;
+        TPSResultCache meshResultCache{
+            TPSResultCache::c_DefaultMaxSynchronouslyWarpedVertices,
+            []() { App::upd().request_redraw(); },  // show background-warped results ASAP
+        };
 
         // the document that the user is editing
         std::shared_ptr<UndoableTPSDocument> editedDocument = std::make_shared<UndoableTPSDocument>();
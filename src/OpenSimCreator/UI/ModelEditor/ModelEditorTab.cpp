@@ -25,8 +25,11 @@
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/Model/Muscle.h>
 #include <OpenSim/Simulation/SimbodyEngine/Coordinate.h>
+#include <oscar/Graphics/Scene/SceneCache.h>
 #include <oscar/Platform/App.h>
+#include <oscar/Platform/FileWatch.h>
 #include <oscar/Platform/Log.h>
+#include <oscar/Shims/Cpp23/ranges.h>
 #include <oscar/UI/ImGuiHelpers.h>
 #include <oscar/UI/oscimgui.h>
 #include <oscar/UI/Panels/LogViewerPanel.h>
@@ -38,7 +41,6 @@
 #include <oscar/UI/Widgets/PopupManager.h>
 #include <oscar/Utils/Assertions.h>
 #include <oscar/Utils/CStringView.h>
-#include <oscar/Utils/FileChangePoller.h>
 #include <oscar/Utils/ParentPtr.h>
 #include <oscar/Utils/Perf.h>
 #include <oscar/Utils/UID.h>
@@ -47,11 +49,14 @@
 
 #include <chrono>
 #include <exception>
+#include <filesystem>
 #include <memory>
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <system_error>
 #include <utility>
+#include <vector>
 
 using namespace osc;
 
@@ -200,15 +205,44 @@ public:
 
     void on_tick()
     {
-        if (m_FileChangePoller.change_detected(m_Model->getModel().getInputFileName()))
-        {
-            ActionUpdateModelFromBackingFile(*m_Model);
-        }
+        handleFilesystemChanges();
 
         m_TabName = computeTabName();
         m_PanelManager->on_tick();
     }
 
+    // reloads whatever the model depends on that changed on disk (the osim file, mesh
+    // files, etc.) and keeps the file watch in sync with the model's dependencies
+    void handleFilesystemChanges()
+    {
+        if (std::vector<std::filesystem::path> const changes = m_FileWatch.take_changes(); !changes.empty())
+        {
+            std::error_code ec;
+            std::filesystem::path const osimPath = m_Model->hasFilesystemLocation() ?
+                std::filesystem::weakly_canonical(m_Model->getFilesystemPath(), ec) :
+                std::filesystem::path{};
+
+            if (!osimPath.empty() && cpp23::contains(changes, osimPath))
+            {
+                ActionUpdateModelFromBackingFile(*m_Model);  // reloads everything, incl. meshes
+            }
+            else
+            {
+                ActionReloadChangedMeshFiles(*m_Model, *App::singleton<SceneCache>(), changes);
+            }
+        }
+
+        // edits can add/remove/repoint meshes (or save the model somewhere else), so re-scan the
+        // model's dependencies after it changes (rate-limited, because edits can be per-frame)
+        auto const now = std::chrono::steady_clock::now();
+        if (m_FileWatchModelVersion != m_Model->getModelVersion() && now >= m_NextFileWatchRescan)
+        {
+            m_FileWatch.set_paths(FindFilesystemDependencies(m_Model->getModel()));
+            m_FileWatchModelVersion = m_Model->getModelVersion();
+            m_NextFileWatchRescan = now + std::chrono::seconds{1};
+        }
+    }
+
     void onDrawMainMenu()
     {
         m_MainMenu.onDraw();
@@ -425,12 +459,10 @@ private:
     // the model being edited
     std::shared_ptr<UndoableModelStatePair> m_Model;
 
-    // polls changes to a file
-    FileChangePoller m_FileChangePoller
-    {
-        std::chrono::milliseconds{1000},  // polling rate
-        m_Model->getModel().getInputFileName(),
-    };
+    // watches the files that the model depends on (osim, meshes) for external changes
+    FileWatch m_FileWatch{FindFilesystemDependencies(m_Model->getModel())};
+    UID m_FileWatchModelVersion = m_Model->getModelVersion();
+    std::chrono::steady_clock::time_point m_NextFileWatchRescan = std::chrono::steady_clock::now();
 
     // manager for toggleable and spawnable UI panels
     std::shared_ptr<PanelManager> m_PanelManager = std::make_shared<PanelManager>();
@@ -14,10 +14,12 @@
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/Model/Muscle.h>
 #include <OpenSim/Simulation/SimbodyEngine/Coordinate.h>
+#include <oscar/Formats/BinaryColumns.h>
 #include <oscar/Formats/CSV.h>
 #include <oscar/Graphics/Color.h>
 #include <oscar/Maths/Angle.h>
 #include <oscar/Maths/MathHelpers.h>
+#include <oscar/Maths/Vec2.h>
 #include <oscar/Maths/Vec4.h>
 #include <oscar/Platform/App.h>
 #include <oscar/Platform/Log.h>
@@ -29,6 +31,7 @@
 #include <oscar/Utils/Algorithms.h>
 #include <oscar/Utils/Assertions.h>
 #include <oscar/Utils/CStringView.h>
+#include <oscar/Utils/StdVariantHelpers.h>
 #include <oscar/Utils/StringHelpers.h>
 #include <oscar/Utils/SynchronizedValue.h>
 #include <oscar/Utils/SynchronizedValueGuard.h>
@@ -38,9 +41,13 @@
 #include <atomic>
 #include <chrono>
 #include <compare>
+#include <exception>
+#include <filesystem>
+#include <fstream>
 #include <functional>
 #include <future>
 #include <memory>
+#include <optional>
 #include <ranges>
 #include <span>
 #include <sstream>
@@ -48,6 +55,7 @@
 #include <string_view>
 #include <type_traits>
 #include <utility>
+#include <variant>
 #include <vector>
 
 namespace SimTK { class State; }
@@ -450,8 +458,9 @@ namespace
             return PlottingTaskStatus::Finished;
         }
 
-        // create a local copy of the model
-        std::unique_ptr<OpenSim::Model> model = std::make_unique<OpenSim::Model>(*params.getCommit().getModel());
+        // create a local copy of the model (rebuilt from the commit, rather than copied from
+        // its prepared model, because it's re-initialized below anyway)
+        std::unique_ptr<OpenSim::Model> model = params.getCommit().instantiateModel();
 
         if (stopToken.stop_requested())
         {
@@ -875,39 +884,46 @@ namespace
     std::vector<Plot> TryLoadSVCFileAsPlots(std::filesystem::path const& inputPath)
     {
         // create input reader
-        std::ifstream inputFileStream{inputPath};
-        inputFileStream.exceptions(std::ios_base::badbit);
-        if (!inputFileStream)
+        std::optional<CSVReader> reader;
+        try
+        {
+            reader.emplace(inputPath, CSVReaderFlags::MemoryMap);  // overlay datasets can be large
+        }
+        catch (std::exception const&)
         {
             return {};  // error opening path
         }
 
         // try to read header row
         std::vector<std::string> headers;
-        if (!read_csv_row_into_vector(inputFileStream, headers))
+        if (auto const headerRow = reader->next_row())
+        {
+            headers.assign(headerRow->begin(), headerRow->end());
+        }
+        else
         {
             return {};  // no CSV data (headers) in top row
         }
 
         // map each CSV row from [$independent, ...$dependent] -> [($independent, $dependent[i])]
         std::vector<std::vector<PlotDataPoint>> columnsAsPlots;
-        for (std::vector<std::string> row; read_csv_row_into_vector(inputFileStream, row);)
+        for (auto row = reader->next_row(); row; row = reader->next_row())
         {
-            if (row.size() < 2)
+            if (row->size() < 2)
             {
                 continue;  // skip: row does not contain enough columns
             }
 
-            std::optional<float> const independentVar = from_chars_strip_whitespace(row.front());
+            std::optional<float> const independentVar = from_chars_strip_whitespace(row->front());
             if (!independentVar)
             {
                 continue;  // skip: row does not contain a valid independent variable
             }
 
             // parse remaining columns as dependent variables
-            for (size_t dependentCol = 1; dependentCol < row.size(); ++dependentCol)
+            for (size_t dependentCol = 1; dependentCol < row->size(); ++dependentCol)
             {
-                std::string const& dependentVarStr = row[dependentCol];
+                std::string_view const dependentVarStr = (*row)[dependentCol];
                 std::optional<float> const dependentVar = from_chars_strip_whitespace(dependentVarStr);
                 if (!dependentVar)
                 {
@@ -961,6 +977,85 @@ namespace
         }
     }
 
+    // loads a file in the binary columns format (e.g. as exported from the simulator) as plots, where
+    // the first (scalar) column is the independent variable and each remaining scalar is a dependent one
+    std::vector<Plot> TryLoadBinaryColumnsFileAsPlots(std::filesystem::path const& inputPath)
+    {
+        std::ifstream inputFileStream{inputPath, std::ios_base::binary};
+        if (!inputFileStream)
+        {
+            return {};  // error opening path
+        }
+
+        std::vector<BinaryColumn> columns;
+        try
+        {
+            columns = read_binary_columns(inputFileStream);
+        }
+        catch (std::exception const& ex)
+        {
+            log_error("%s: error reading binary columns: %s", inputPath.string().c_str(), ex.what());
+            return {};
+        }
+
+        // flatten the columns into named scalar series (e.g. `Vec2` columns become two series)
+        std::vector<std::pair<std::string, std::vector<float>>> series;
+        for (BinaryColumn& column : columns)
+        {
+            std::visit(Overload{
+                [&series, &column](std::vector<float>& data)
+                {
+                    series.emplace_back(column.name, std::move(data));
+                },
+                [&series, &column](std::vector<Vec2> const& data)
+                {
+                    std::vector<float> xs;
+                    std::vector<float> ys;
+                    xs.reserve(data.size());
+                    ys.reserve(data.size());
+                    for (Vec2 const& v : data)
+                    {
+                        xs.push_back(v.x);
+                        ys.push_back(v.y);
+                    }
+                    series.emplace_back(column.name + "/0", std::move(xs));
+                    series.emplace_back(column.name + "/1", std::move(ys));
+                },
+                [&series, &column](std::vector<double> const& data)
+                {
+                    series.emplace_back(column.name, std::vector<float>(data.begin(), data.end()));
+                },
+            }, column.data);
+        }
+
+        if (series.size() < 2)
+        {
+            return {};  // not enough columns to plot anything
+        }
+
+        std::vector<float> const& independentVar = series.front().second;
+        std::vector<Plot> rv;
+        rv.reserve(series.size() - 1);
+        for (size_t i = 1; i < series.size(); ++i)
+        {
+            std::vector<PlotDataPoint> points;
+            points.reserve(independentVar.size());
+            for (size_t row = 0; row < independentVar.size(); ++row)
+            {
+                points.push_back({independentVar[row], series[i].second[row]});
+            }
+
+            std::stringstream ss;
+            ss << inputPath.filename();
+            if (series.size() > 2)
+            {
+                ss << " (" << series[i].first << ')';
+            }
+            rv.emplace_back(std::move(ss).str(), std::move(points));
+        }
+        return rv;
+    }
+
     void TrySavePlotToCSV(OpenSim::Coordinate const& coord, PlotParameters const& params, Plot const& plot, std::filesystem::path const& outPath)
     {
         std::ofstream fileOutputStream{outPath};
@@ -1414,16 +1509,20 @@ namespace
         }
     }
 
-    // a UI action in which the user in prompted for a CSV file that they would like to overlay
-    // over the current plot
+    // a UI action in which the user in prompted for a CSV (or binary columns) file that they would
+    // like to overlay over the current plot
     void ActionPromptUserForCSVOverlayFile(PlotLines& lines)
     {
         std::optional<std::filesystem::path> const maybeCSVPath =
-            prompt_user_to_select_file({"csv"});
+            prompt_user_to_select_file({"csv", "osccols"});
 
         if (maybeCSVPath)
         {
-            for (Plot& plot : TryLoadSVCFileAsPlots(*maybeCSVPath))
+            std::vector<Plot> plots = maybeCSVPath->extension() == ".osccols" ?
+                TryLoadBinaryColumnsFileAsPlots(*maybeCSVPath) :
+                TryLoadSVCFileAsPlots(*maybeCSVPath);
+
+            for (Plot& plot : plots)
             {
                 plot.setIsLocked(true);
                 lines.pushPlotAsPrevious(std::move(plot));
@@ -1986,7 +2085,7 @@ namespace
             if (ui::draw_menu_item("import CSV overlay(s)")) {
                 ActionPromptUserForCSVOverlayFile(m_Lines);
             }
-            ui::draw_tooltip_if_item_hovered("import CSV overlay(s)", "Imports the specified CSV file as an overlay over the current plot. This is handy fitting muscle curves against externally-supplied data.\n\nThe provided CSV file must contain a header row and at least two columns of numeric data on each data row. The values in the columns must match this plot's axes.");
+            ui::draw_tooltip_if_item_hovered("import CSV overlay(s)", "Imports the specified CSV file as an overlay over the current plot. This is handy fitting muscle curves against externally-supplied data.\n\nThe provided CSV file must contain a header row and at least two columns of numeric data on each data row. The values in the columns must match this plot's axes.\n\nBinary columns (.osccols) files, as exported by the simulator, are also supported: their first column is used as the independent variable.");
 
             if (ui::begin_menu("export CSV")) {
                 drawExportCSVMenuContent(coord);
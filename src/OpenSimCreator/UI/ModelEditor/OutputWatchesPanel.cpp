@@ -1,53 +1,26 @@
 #include "OutputWatchesPanel.h"
 
 #include <OpenSimCreator/Documents/Model/UndoableModelStatePair.h>
+#include <OpenSimCreator/Documents/OutputExtractors/AsyncOutputWatchEvaluator.h>
 #include <OpenSimCreator/Documents/OutputExtractors/OutputExtractor.h>
-#include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
 #include <OpenSimCreator/UI/IMainUIStateAPI.h>
 
 #include <IconsFontAwesome5.h>
-#include <OpenSim/Simulation/Model/Model.h>
 #include <oscar/UI/Panels/StandardPanelImpl.h>
 #include <oscar/UI/ImGuiHelpers.h>
 #include <oscar/UI/oscimgui.h>
 #include <oscar/Utils/ParentPtr.h>
 #include <oscar/Utils/UID.h>
-#include <Simbody.h>
 
 #include <memory>
+#include <optional>
+#include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 using namespace osc;
 
-namespace
-{
-    struct CachedSimulationReport final {
-        UID sourceModelVersion;
-        UID sourceStateVersion;
-        SimulationReport simulationReport;
-    };
-
-    void UpdateCachedSimulationReportIfNecessary(IConstModelStatePair const& src, CachedSimulationReport& cache)
-    {
-        UID const modelVersion = src.getModelVersion();
-        UID const stateVersion = src.getStateVersion();
-
-        if (cache.sourceModelVersion == modelVersion &&
-            cache.sourceStateVersion == stateVersion)
-        {
-            return;  // it's already up-to-date
-        }
-
-        SimTK::State s = src.getState();
-        src.getModel().realizeReport(s);
-
-        cache.simulationReport = SimulationReport{std::move(s)};
-        cache.sourceModelVersion = modelVersion;
-        cache.sourceStateVersion = stateVersion;
-    }
-}
-
 class osc::OutputWatchesPanel::Impl final : public StandardPanelImpl {
 public:
 
@@ -64,7 +37,15 @@ public:
 private:
     void impl_draw_content() final
     {
-        UpdateCachedSimulationReportIfNecessary(*m_Model, m_CachedReport);
+        // evaluate the outputs on a background thread, and show the latest values that it produced
+        m_WatchList.clear();
+        for (int outputIdx = 0; outputIdx < m_API->getNumUserOutputExtractors(); ++outputIdx)
+        {
+            m_WatchList.push_back(m_API->getUserOutputExtractor(outputIdx));
+        }
+        m_Evaluator.request(*m_Model, m_WatchList);
+        m_Evaluator.poll();
+        OutputWatchValues const& values = m_Evaluator.getValues();
 
         if (m_API->getNumUserOutputExtractors() > 0 && ui::begin_table("##OutputWatchesTable", 2, ImGuiTableFlags_SizingStretchProp))
         {
@@ -90,7 +71,14 @@ private:
                 ui::draw_text_unformatted(o.getName());
 
                 ui::table_set_column_index(column++);
-                ui::draw_text_unformatted(o.getValueString(m_Model->getModel(), m_CachedReport.simulationReport));
+                if (std::optional<std::string> const value = values.find(o))
+                {
+                    ui::draw_text_unformatted(*value);
+                }
+                else
+                {
+                    ui::draw_text_disabled("(evaluating)");
+                }
 
                 ui::pop_id();
             }
@@ -106,7 +94,8 @@ private:
 
     ParentPtr<IMainUIStateAPI> m_API;
     std::shared_ptr<UndoableModelStatePair const> m_Model;
-    CachedSimulationReport m_CachedReport;
+    std::vector<OutputExtractor> m_WatchList;
+    AsyncOutputWatchEvaluator m_Evaluator;
 };
 
 
@@ -83,6 +83,7 @@ private:
 
     void impl_on_tick() final
     {
+        m_State->onTick();
         m_PanelManager->on_tick();
     }
 
@@ -10,11 +10,33 @@
 #include <oscar/Platform/Log.h>
 #include <oscar/Platform/os.h>
 
+#include <exception>
 #include <filesystem>
 #include <memory>
 #include <optional>
 #include <utility>
 
+void osc::mow::UIState::onTick()
+{
+    if (m_FileWatch.take_changes().empty()) {
+        return;
+    }
+
+    // the document is entirely derived from its files, so rebuild all of it, but keep the
+    // user's (in-UI) blending factor
+    try {
+        auto reloaded = std::make_shared<ModelWarpDocument>(m_Document->osimFileLocation());
+        reloaded->setWarpBlendingFactor(m_Document->getWarpBlendingFactor());
+        m_Document = std::move(reloaded);
+    }
+    catch (std::exception const& ex) {
+        log_error("%s: error reloading the model warping document: %s", m_Document->osimFileLocation().string().c_str(), ex.what());
+    }
+
+    // a reload can change which files the document depends on (e.g. a mesh was added to the osim)
+    m_FileWatch.set_paths(m_Document->filesystemDependencies());
+}
+
 void osc::mow::UIState::actionOpenOsimOrPromptUser(std::optional<std::filesystem::path> path)
 {
     if (not path) {
@@ -24,6 +46,7 @@ void osc::mow::UIState::actionOpenOsimOrPromptUser(std::optional<std::filesystem
     if (path) {
         App::singleton<RecentFiles>()->push_back(*path);
         m_Document = std::make_shared<ModelWarpDocument>(std::move(path).value());
+        m_FileWatch.set_paths(m_Document->filesystemDependencies());
     }
 }
 
@@ -8,6 +8,7 @@
 #include <OpenSimCreator/Documents/ModelWarper/WarpDetail.h>
 
 #include <oscar/Maths/PolarPerspectiveCamera.h>
+#include <oscar/Platform/FileWatch.h>
 #include <oscar/UI/Tabs/ITabHost.h>
 #include <oscar/Utils/ParentPtr.h>
 
@@ -63,6 +64,9 @@ namespace osc::mow
             }
         }
 
+        // reloads the document if any of the files that it was loaded from changed on disk
+        void onTick();
+
         void actionOpenOsimOrPromptUser(
             std::optional<std::filesystem::path> maybeOsimPath = std::nullopt
         );
@@ -72,6 +76,7 @@ namespace osc::mow
         ParentPtr<ITabHost> m_TabHost;
         std::shared_ptr<ModelWarpDocument> m_Document = std::make_shared<ModelWarpDocument>();
         CachedModelWarper m_ModelWarper;
+        FileWatch m_FileWatch;
 
         bool m_LinkCameras = true;
         bool m_OnlyLinkRotation = false;
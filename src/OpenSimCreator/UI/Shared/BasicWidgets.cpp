@@ -484,12 +484,12 @@ void osc::DrawOutputNameColumn(
     {
         if (ui::is_item_hovered())
         {
-            maybeActiveSate->setHovered(FindComponent(maybeActiveSate->getModel(), co->getComponentAbsPath()));
+            maybeActiveSate->setHovered(maybeActiveSate->findComponent(co->getComponentAbsPath()));
         }
 
         if (ui::is_item_clicked(ImGuiMouseButton_Left))
         {
-            maybeActiveSate->setSelected(FindComponent(maybeActiveSate->getModel(), co->getComponentAbsPath()));
+            maybeActiveSate->setSelected(maybeActiveSate->findComponent(co->getComponentAbsPath()));
         }
     }
 
@@ -6,13 +6,14 @@
 #include <OpenSimCreator/Documents/MeshImporter/UndoableActions.h>
 
 #include <IconsFontAwesome5.h>
+#include <oscar/Formats/CSV.h>
 #include <oscar/Graphics/Color.h>
 #include <oscar/Platform/os.h>
 #include <oscar/UI/ImGuiHelpers.h>
 #include <oscar/UI/Widgets/StandardPopup.h>
 
+#include <exception>
 #include <filesystem>
-#include <fstream>
 #include <memory>
 #include <optional>
 #include <sstream>
@@ -215,8 +216,12 @@ private:
         m_ImportedLandmarks.clear();
         m_ImportWarnings.clear();
 
-        std::ifstream ifs{path};
-        if (!ifs)
+        std::optional<CSVReader> reader;
+        try
+        {
+            reader.emplace(path, CSVReaderFlags::MemoryMap);  // landmark files can be large
+        }
+        catch (std::exception const&)
         {
             std::stringstream ss;
             ss << path << ": could not load the given path";
@@ -226,8 +231,8 @@ private:
 
         std::vector<lm::Landmark> lms;
         lm::ReadLandmarksFromCSV(
-            ifs,
-            [&lms](lm::Landmark&& lm) { lms.push_back(lm); },
+            *reader,
+            [&lms](lm::Landmark&& lm) { lms.push_back(std::move(lm)); },
             [this](lm::CSVParseWarning const& warning) { m_ImportWarnings.push_back(to_string(warning)); }
         );
         m_ImportedLandmarks = GenerateNames(lms);
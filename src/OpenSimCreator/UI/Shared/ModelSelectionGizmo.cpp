@@ -119,12 +119,12 @@ namespace
             m_ComponentAbsPath{component.getAbsolutePath()}
         {
             OSC_ASSERT(m_Model != nullptr);
-            OSC_ASSERT(FindComponent<TComponent>(m_Model->getModel(), m_ComponentAbsPath));
+            OSC_ASSERT(m_Model->findComponentAs<TComponent>(m_ComponentAbsPath));
         }
 
         TComponent const* findSelection() const
         {
-            return FindComponent<TComponent>(m_Model->getModel(), m_ComponentAbsPath);
+            return m_Model->findComponentAs<TComponent>(m_ComponentAbsPath);
         }
 
         OpenSim::Model const& getModel() const
@@ -11,124 +11,277 @@
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/Wrap/WrapObjectSet.h>
 #include <oscar/Graphics/Color.h>
-#include <oscar/Shims/Cpp23/ranges.h>
 #include <oscar/UI/ImGuiHelpers.h>
 #include <oscar/UI/oscimgui.h>
 #include <oscar/UI/Panels/StandardPanelImpl.h>
-#include <oscar/Utils/Algorithms.h>
-#include <oscar/Utils/Assertions.h>
+#include <oscar/Utils/Perf.h>
 #include <oscar/Utils/StringHelpers.h>
+#include <oscar/Utils/UID.h>
 
 #include <algorithm>
-#include <array>
 #include <cstddef>
-#include <limits>
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <ranges>
-#include <stdexcept>
+#include <span>
 #include <string>
-#include <typeinfo>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 using namespace osc;
 namespace rgs = std::ranges;
 
 namespace
 {
-    // poor-man's abstraction for a constant-sized array
-    template<typename T, size_t N>
-    class SizedArray final {
-        static_assert(std::is_trivial_v<T>);
-        static_assert(N <= std::numeric_limits<int>::max());
-
-    public:
-        void push_back(T v) {
-            if (m_Size >= N) {
-                throw std::runtime_error{"cannot render a navigator: the Model/Component tree is too deep"};
-            }
-            m_Data[m_Size++] = v;
+    // returns `true` if the given component should be shown as a row in the navigator
+    bool ShouldShowInNavigator(OpenSim::Component const& c, bool showFrames)
+    {
+        if (!showFrames && dynamic_cast<OpenSim::FrameGeometry const*>(&c))
+        {
+            return false;
         }
-
-        T const* begin() const {
-            return m_Data.data();
+        else if (auto const* wos = dynamic_cast<OpenSim::WrapObjectSet const*>(&c))
+        {
+            return !empty(*wos);
         }
-
-        T* begin() {
-            return m_Data.data();
+        else
+        {
+            return ShouldShowInUI(c);
         }
+    }
 
-        T const* end() const {
-            return m_Data.data() + m_Size;
+    // returns the number of ownership hops between `c` and `root`
+    int DepthFrom(OpenSim::Component const& root, OpenSim::Component const& c)
+    {
+        int depth = 0;
+        for (OpenSim::Component const* p = &c; p != &root && p->hasOwner(); p = &p->getOwner())
+        {
+            ++depth;
         }
+        return depth;
+    }
 
-        T* end() {
-            return m_Data.data() + m_Size;
-        }
+    // packs the first three characters of `s` into a lookup key
+    uint32_t ToTrigramKey(std::string_view s)
+    {
+        return
+            static_cast<uint32_t>(static_cast<unsigned char>(s[0])) << 16 |
+            static_cast<uint32_t>(static_cast<unsigned char>(s[1])) << 8 |
+            static_cast<uint32_t>(static_cast<unsigned char>(s[2]));
+    }
 
-        size_t size() const {
-            return m_Size;
-        }
+    // one row of the (flattened, depth-first) navigator tree
+    struct NavigatorRow final {
+        OpenSim::Component const* component = nullptr;
+        std::string absolutePath;  // used to carry user-expanded rows over between rebuilds
+        std::string lowercaseName;
+        int depth = 0;             // number of ownership hops from the root
+        int parent = -1;           // index of the nearest shown ancestor (-1 for the root)
+        int subtreeEnd = 0;        // index one past the row's last shown descendant
+        bool isExpandedByUser = false;
+    };
 
-        ptrdiff_t sizei() const {
-            return static_cast<ptrdiff_t>(m_Size);
-        }
+    // a flattened snapshot of the model's component tree
+    //
+    // iterating the component tree, computing paths, lowercasing names, etc. is too slow to
+    // do every frame on large models, so it's done once (per model version) here
+    class NavigatorTree final {
+    public:
+        NavigatorTree() = default;
 
-        bool empty() const {
-            return m_Size == 0;
+        NavigatorTree(
+            OpenSim::Component const& root,
+            bool showFrames,
+            std::unordered_set<std::string> const& expandedPaths)
+        {
+            OSC_PERF("NavigatorTree/build");
+
+            pushRow(root, 0, -1, expandedPaths);
+            std::vector<int> openRows = {0};  // rows that later rows may be descendants of
+            for (OpenSim::Component const& c : root.getComponentList())
+            {
+                if (!ShouldShowInNavigator(c, showFrames))
+                {
+                    continue;
+                }
+
+                int const depth = DepthFrom(root, c);
+                while (openRows.size() > 1 && m_Rows[openRows.back()].depth >= depth)
+                {
+                    m_Rows[openRows.back()].subtreeEnd = size();
+                    openRows.pop_back();
+                }
+                openRows.push_back(pushRow(c, depth, openRows.back(), expandedPaths));
+            }
+            for (int row : openRows)
+            {
+                m_Rows[row].subtreeEnd = size();
+            }
         }
 
-        void resize(size_t newsize) {
-            m_Size = newsize;
+        int size() const { return static_cast<int>(m_Rows.size()); }
+        NavigatorRow const& operator[](int i) const { return m_Rows[i]; }
+        NavigatorRow& upd(int i) { return m_Rows[i]; }
+
+        bool isInternalNode(int i) const
+        {
+            return i == 0 || m_Rows[i].subtreeEnd > i+1;
         }
 
-        void clear() {
-            m_Size = 0;
+        // returns `true` if row `maybeAncestor` is a (strict) ancestor of row `i`
+        bool isAncestor(int maybeAncestor, int i) const
+        {
+            return maybeAncestor < i && i < m_Rows[maybeAncestor].subtreeEnd;
         }
 
-        T& operator[](size_t idx) {
-            return m_Data[idx];
+        // returns the index of the component's row, or -1 if the component isn't shown
+        int indexOf(OpenSim::Component const* c) const
+        {
+            auto const it = m_RowIndices.find(c);
+            return it != m_RowIndices.end() ? it->second : -1;
         }
 
-        T const& operator[](size_t i) const {
-            return m_Data[i];
+        // returns the (sorted) indices of the rows whose lowercased names contain `trigram`
+        std::span<int const> rowsContainingTrigram(std::string_view trigram) const
+        {
+            auto const it = m_TrigramIndex.find(ToTrigramKey(trigram));
+            return it != m_TrigramIndex.end() ? std::span<int const>{it->second} : std::span<int const>{};
         }
 
     private:
-        std::array<T, N> m_Data{};
-        size_t m_Size = 0;
-    };
+        int pushRow(
+            OpenSim::Component const& c,
+            int depth,
+            int parent,
+            std::unordered_set<std::string> const& expandedPaths)
+        {
+            int const index = size();
 
-    using ComponentPath = SizedArray<OpenSim::Component const*, 16>;
+            NavigatorRow& row = m_Rows.emplace_back();
+            row.component = &c;
+            row.absolutePath = GetAbsolutePathString(c);
+            row.lowercaseName = to_lowercase(c.getName());
+            row.depth = depth;
+            row.parent = parent;
+            row.isExpandedByUser = expandedPaths.contains(row.absolutePath);
 
-    // populates `out` with the sequence of nodes between (ancestor..child]
-    void computeComponentPath(
-        OpenSim::Component const* ancestor,
-        OpenSim::Component const* child,
-        ComponentPath& out)
-    {
+            m_RowIndices.try_emplace(&c, index);
 
-        out.clear();
+            std::vector<uint32_t>& keys = m_TrigramScratch;
+            keys.clear();
+            for (size_t i = 0; i+3 <= row.lowercaseName.size(); ++i)
+            {
+                keys.push_back(ToTrigramKey(std::string_view{row.lowercaseName}.substr(i, 3)));
+            }
+            rgs::sort(keys);
+            auto const [uniqueEnd, _] = rgs::unique(keys);
+            for (auto it = keys.begin(); it != uniqueEnd; ++it)
+            {
+                m_TrigramIndex[*it].push_back(index);  // rows are pushed in order, so postings are sorted
+            }
+
+            return index;
+        }
 
-        // populate child --> parent
-        for (; child != nullptr; child = GetOwner(*child))
+        std::vector<NavigatorRow> m_Rows;
+        std::unordered_map<OpenSim::Component const*, int> m_RowIndices;
+        std::unordered_map<uint32_t, std::vector<int>> m_TrigramIndex;
+        std::vector<uint32_t> m_TrigramScratch;
+    };
+
+    // the result of filtering the navigator's rows by a search string
+    //
+    // a row is a search hit if its name, or the name of any of its ancestors, contains the
+    // search string (case-insensitive)
+    class NavigatorSearch final {
+    public:
+        bool isActive() const { return !m_Query.empty(); }
+        bool isHit(int row) const { return m_IsHit[row]; }
+
+        // updates the search for `query`
+        //
+        // this is incremental: when the query only narrows the previous one (e.g. because
+        // the user typed another character) only the previous matches are re-checked, and
+        // otherwise only the rows that share a trigram with the query are checked
+        void update(NavigatorTree const& tree, std::string_view query, bool treeChanged)
         {
-            out.push_back(child);
+            std::string lowercaseQuery = to_lowercase(query);
+            if (!treeChanged && lowercaseQuery == m_Query)
+            {
+                return;  // nothing changed
+            }
 
-            if (!child->hasOwner() || child == ancestor)
+            OSC_PERF("NavigatorSearch/update");
+
+            bool const isNarrowing = !treeChanged && !m_Query.empty() && contains(lowercaseQuery, m_Query);
+            m_Query = std::move(lowercaseQuery);
+            m_IsHit.assign(tree.size(), false);
+
+            if (m_Query.empty())
             {
-                break;
+                m_NameMatches.clear();
+                return;
             }
-        }
 
-        // reverse to yield parent --> child
-        rgs::reverse(out);
-    }
+            // find the smallest set of rows that the matches must be within
+            std::optional<std::span<int const>> candidates;
+            std::vector<int> previousMatches;
+            if (isNarrowing)
+            {
+                previousMatches = std::move(m_NameMatches);
+                candidates = previousMatches;
+            }
+            for (size_t i = 0; i+3 <= m_Query.size(); ++i)
+            {
+                std::span<int const> const rows = tree.rowsContainingTrigram(std::string_view{m_Query}.substr(i, 3));
+                if (!candidates || rows.size() < candidates->size())
+                {
+                    candidates = rows;
+                }
+            }
 
-    bool pathContains(ComponentPath const& p, OpenSim::Component const* c)
-    {
-        auto end = p.begin() == p.end() ? p.end() : p.end()-1;
-        return cpp23::contains(p.begin(), end, c);
-    }
+            m_NameMatches.clear();
+            auto const checkRow = [this, &tree](int row)
+            {
+                if (contains(tree[row].lowercaseName, m_Query))
+                {
+                    m_NameMatches.push_back(row);
+                }
+            };
+            if (candidates)
+            {
+                rgs::for_each(*candidates, checkRow);
+            }
+            else
+            {
+                for (int row = 0; row < tree.size(); ++row)
+                {
+                    checkRow(row);
+                }
+            }
+
+            // a match's whole subtree are hits (rows are depth-first, so subtrees are contiguous)
+            int coveredUntil = 0;
+            for (int match : m_NameMatches)
+            {
+                if (match < coveredUntil)
+                {
+                    continue;  // already covered by an ancestor's match
+                }
+                coveredUntil = tree[match].subtreeEnd;
+                std::fill(m_IsHit.begin() + match, m_IsHit.begin() + coveredUntil, true);
+            }
+        }
+
+    private:
+        std::string m_Query;  // lowercased
+        std::vector<int> m_NameMatches;  // sorted indices of rows whose names contain the query
+        std::vector<bool> m_IsHit;
+    };
 
     enum class ResponseType {
         NothingHappened,
@@ -140,14 +293,6 @@ namespace
         OpenSim::Component const* ptr = nullptr;
         ResponseType type = ResponseType::NothingHappened;
     };
-
-    bool isSearchHit(std::string const& searchStr, ComponentPath const& cp)
-    {
-        return rgs::any_of(cp, [&searchStr](OpenSim::Component const* c)
-        {
-            return contains_case_insensitive(c->getName(), searchStr);
-        });
-    }
 }
 
 class osc::NavigatorPanel::Impl final : public StandardPanelImpl {
@@ -199,6 +344,60 @@ private:
         }
     }
 
+    // rebuilds the tree snapshot (+ search) if the model, or how it's shown, has changed
+    void updateTree()
+    {
+        bool treeChanged = false;
+        if (m_Model->getModelVersion() != m_TreeModelVersion || m_ShowFrames != m_TreeShowsFrames)
+        {
+            m_Tree = NavigatorTree{m_Model->getModel(), m_ShowFrames, m_ExpandedPaths};
+            m_TreeModelVersion = m_Model->getModelVersion();
+            m_TreeShowsFrames = m_ShowFrames;
+            treeChanged = true;
+        }
+        m_Search.update(m_Tree, m_CurrentSearch, treeChanged);
+    }
+
+    // returns `true` if the row is shown open regardless of whether the user expanded it (i.e. it's
+    // the root, a search hit, or the selection/an ancestor of the selection)
+    bool isRowForcedOpen(int row, int selectionRow) const
+    {
+        return
+            row == 0 ||
+            (m_Search.isActive() && m_Search.isHit(row)) ||
+            (selectionRow >= 0 && (row == selectionRow || m_Tree.isAncestor(row, selectionRow)));
+    }
+
+    bool isRowOpen(int row, int selectionRow) const
+    {
+        if (!m_Tree.isInternalNode(row))
+        {
+            return false;
+        }
+        return m_Tree[row].isExpandedByUser || isRowForcedOpen(row, selectionRow);
+    }
+
+    void toggleRowExpansion(int row, int selectionRow)
+    {
+        // collapsing a forced-open row only lasts until the next frame, so it shouldn't flip the
+        // user's expansion state (otherwise, the row would stay expanded once it's no longer forced)
+        if (isRowForcedOpen(row, selectionRow))
+        {
+            return;
+        }
+
+        NavigatorRow& r = m_Tree.upd(row);
+        r.isExpandedByUser = !r.isExpandedByUser;
+        if (r.isExpandedByUser)
+        {
+            m_ExpandedPaths.insert(r.absolutePath);
+        }
+        else
+        {
+            m_ExpandedPaths.erase(r.absolutePath);
+        }
+    }
+
     Response drawWithResponse()
     {
         Response rv;
@@ -220,122 +419,50 @@ private:
         ui::draw_separator();
         ui::draw_dummy({0.0f, 3.0f});
 
-        // draw content
-        ui::begin_child_panel("##componentnavigatorvieweritems", {0.0, 0.0}, ImGuiChildFlags_None, ImGuiWindowFlags_NoBackground);
+        updateTree();
 
-        OpenSim::Component const* root = &m_Model->getModel();
-        OpenSim::Component const* selection = m_Model->getSelected();
-        OpenSim::Component const* hover = m_Model->getHovered();
+        OpenSim::Component const* const hover = m_Model->getHovered();
+        int const selectionRow = m_Tree.indexOf(m_Model->getSelected());
 
-        ComponentPath selectionPath{};
-        if (selection)
+        // only the rows within expanded subtrees are visible
+        m_VisibleRows.clear();
+        for (int row = 0; row < m_Tree.size();)
         {
-            computeComponentPath(root, selection, selectionPath);
+            m_VisibleRows.push_back(row);
+            row = isRowOpen(row, selectionRow) ? row+1 : m_Tree[row].subtreeEnd;
         }
 
-        ComponentPath hoverPath{};
-        if (hover)
-        {
-            computeComponentPath(root, hover, hoverPath);
-        }
-
-        // init iterators: this alg. is single-pass with a 1-token lookahead
-        auto const lst = root->getComponentList();
-        auto it = lst.begin();
-        auto const end = lst.end();
-
-        // initially populate lookahead (+ path)
-        OpenSim::Component const* lookahead = root;
-        ComponentPath lookaheadPath;
-        computeComponentPath(root, root, lookaheadPath);
-
-        // set cur path empty (first step copies lookahead into this)
-        OpenSim::Component const* cur = nullptr;
-        ComponentPath currentPath;
-
-        int imguiTreeDepth = 0;
-        int imguiId = 0;
-        bool const hasSearch = !m_CurrentSearch.empty();
+        // draw content
+        ui::begin_child_panel("##componentnavigatorvieweritems", {0.0, 0.0}, ImGuiChildFlags_None, ImGuiWindowFlags_NoBackground);
 
-        float const unindentPerLevel = ui::get_tree_node_to_label_spacing() - 15.0f;
+        float const indentPerLevel = ui::get_style().IndentSpacing - (ui::get_tree_node_to_label_spacing() - 15.0f);
+        std::optional<int> toggledRow;
 
-        while (lookahead)
+        // virtualized: only the rows that are scrolled into view are drawn
+        ui::draw_clipped_rows(static_cast<int>(m_VisibleRows.size()), [&](int visibleIndex)
         {
-            // important: ensure all nodes have a unique ID: regardess of filtering
-            ++imguiId;
-
-            // populate current (+ path) from lookahead
-            cur = lookahead;
-            currentPath = lookaheadPath;
-
-            OSC_ASSERT(cur && "cur ptr should *definitely* be populated at this point");
-            OSC_ASSERT(!currentPath.empty() && "current path cannot be empty (even a root element has a path)");
-
-            // update lookahead (+ path) by stepping to the next component in the component tree
-            lookahead = nullptr;
-            lookaheadPath.clear();
-            while (it != end)
-            {
-                OpenSim::Component const& c = *it++;
-
-                bool shouldRender = true;
-
-                if (!m_ShowFrames && dynamic_cast<OpenSim::FrameGeometry const*>(&c))
-                {
-                    shouldRender = false;
-                }
-                else if (auto const* wos = dynamic_cast<OpenSim::WrapObjectSet const*>(&c))
-                {
-                    shouldRender = !empty(*wos);
-                }
-                else if (!ShouldShowInUI(c))
-                {
-                    shouldRender = false;
-                }
-
-                if (shouldRender)
-                {
-                    lookahead = &c;
-                    computeComponentPath(root, &c, lookaheadPath);
-                    break;
-                }
-            }
-            OSC_ASSERT((lookahead || !lookahead) && "a lookahead is not *required* at this point");
+            int const row = m_VisibleRows[visibleIndex];
+            NavigatorRow const& r = m_Tree[row];
+            OpenSim::Component const* const cur = r.component;
 
-            bool const searchHit = hasSearch && isSearchHit(m_CurrentSearch, currentPath);
-
-            // skip rendering if a parent node is collapsed
-            if (imguiTreeDepth < currentPath.sizei() - 1)
+            float const indent = static_cast<float>(r.depth) * indentPerLevel;
+            if (indent > 0.0f)
             {
-                continue;
+                ui::indent(indent);
             }
 
-            // pop tree nodes down to the current depth
-            while (imguiTreeDepth >= currentPath.sizei())
-            {
-                ui::indent(unindentPerLevel);
-                ui::tree_pop();
-                --imguiTreeDepth;
-            }
-            OSC_ASSERT(imguiTreeDepth <= currentPath.sizei() - 1);
-
             // handle display mode (node vs leaf)
-            bool const isInternalNode = currentPath.size() < 2 || lookaheadPath.size() > currentPath.size();
-            ImGuiTreeNodeFlags const nodeFlags = isInternalNode ? ImGuiTreeNodeFlags_OpenOnArrow : (ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_Bullet);
+            ImGuiTreeNodeFlags nodeFlags = ImGuiTreeNodeFlags_NoTreePushOnOpen;
+            nodeFlags |= m_Tree.isInternalNode(row) ? ImGuiTreeNodeFlags_OpenOnArrow : (ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_Bullet);
 
             // handle coloring
             int styles = 0;
-            if (cur == selection)
-            {
-                ui::push_style_color(ImGuiCol_Text, Color::yellow());
-                ++styles;
-            }
-            else if (cur == hover)
+            if (row == selectionRow || cur == hover)
             {
                 ui::push_style_color(ImGuiCol_Text, Color::yellow());
                 ++styles;
             }
-            else if (!hasSearch || searchHit)
+            else if (!m_Search.isActive() || m_Search.isHit(row))
             {
                 // display as normal
             }
@@ -345,17 +472,12 @@ private:
                 ++styles;
             }
 
-            // auto-open in these cases
-            if (searchHit || currentPath.sizei() == 1 || pathContains(selectionPath, cur))
+            ui::set_next_item_open(isRowOpen(row, selectionRow));
+            ui::push_id(row);
+            ui::draw_tree_node_ex(cur->getName(), nodeFlags);
+            if (ui::is_item_toggled_open())
             {
-                ui::set_next_item_open(true);
-            }
-
-            ui::push_id(imguiId);
-            if (ui::draw_tree_node_ex(cur->getName(), nodeFlags))
-            {
-                ui::unindent(unindentPerLevel);
-                ++imguiTreeDepth;
+                toggledRow = row;
             }
             ui::pop_id();
             ui::pop_style_color(styles);
@@ -378,17 +500,20 @@ private:
             {
                 m_OnRightClick(GetAbsolutePath(*cur));
             }
-        }
 
-        // pop remaining dangling tree elements
-        while (imguiTreeDepth-- > 0)
-        {
-            ui::indent(unindentPerLevel);
-            ui::tree_pop();
-        }
+            if (indent > 0.0f)
+            {
+                ui::unindent(indent);
+            }
+        });
 
         ui::end_child_panel();
 
+        if (toggledRow)
+        {
+            toggleRowExpansion(*toggledRow, selectionRow);
+        }
+
         return rv;
     }
 
@@ -396,6 +521,14 @@ private:
     std::function<void(OpenSim::ComponentPath const&)> m_OnRightClick;
     std::string m_CurrentSearch;
     bool m_ShowFrames = false;
+
+    // flattened tree (+ search) that's only rebuilt when the model changes
+    NavigatorTree m_Tree;
+    UID m_TreeModelVersion = UID::empty();
+    bool m_TreeShowsFrames = false;
+    NavigatorSearch m_Search;
+    std::unordered_set<std::string> m_ExpandedPaths;
+    std::vector<int> m_VisibleRows;
 };
 
 
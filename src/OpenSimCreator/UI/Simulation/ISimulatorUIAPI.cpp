@@ -3,15 +3,18 @@
 #include <OpenSimCreator/Documents/OutputExtractors/OutputExtractor.h>
 #include <OpenSimCreator/Documents/Simulation/ISimulation.h>
 #include <OpenSimCreator/Documents/Simulation/SimulationHelpers.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
 
 #include <OpenSim/Simulation/Model/Model.h>
 #include <oscar/Platform/Log.h>
 #include <oscar/Platform/os.h>
 #include <oscar/Utils/Assertions.h>
+#include <oscar/Utils/CStringView.h>
 
 #include <filesystem>
 #include <fstream>
 #include <optional>
+#include <ostream>
 #include <span>
 #include <string>
 #include <string_view>
@@ -20,19 +23,24 @@ using namespace osc;
 
 namespace
 {
-    std::optional<std::filesystem::path> TryExportOutputsToCSV(
+    using OutputsWriter = void(*)(OpenSim::Component const&, std::span<const OutputExtractor>, std::span<const SimulationReport>, std::ostream&);
+
+    std::optional<std::filesystem::path> TryExportOutputs(
         const ISimulation& simulation,
-        std::span<const OutputExtractor> outputs)
+        std::span<const OutputExtractor> outputs,
+        CStringView extension,
+        std::ios_base::openmode mode,
+        OutputsWriter writer)
     {
         // prompt user for save location
         std::optional<std::filesystem::path> path =
-            PromptUserForFileSaveLocationAndAddExtensionIfNecessary("csv");
+            PromptUserForFileSaveLocationAndAddExtensionIfNecessary(extension);
         if (not path) {
             return std::nullopt;  // user probably cancelled out
         }
 
         // open output file
-        std::ofstream fout{*path};
+        std::ofstream fout{*path, mode};
         if (not fout) {
             log_error("%s: error opening file for writing", path->string().c_str());
             return std::nullopt;  // error opening output file for writing
@@ -41,10 +49,31 @@ namespace
 
         // write output
         const auto guard = simulation.getModel();
-        WriteOutputsAsCSV(*guard, outputs, simulation.getAllSimulationReports(), fout);
+        writer(*guard, outputs, simulation.getAllSimulationReports(), fout);
 
         return path;
     }
+
+    std::optional<std::filesystem::path> TryExportOutputsToCSV(
+        const ISimulation& simulation,
+        std::span<const OutputExtractor> outputs)
+    {
+        return TryExportOutputs(simulation, outputs, "csv", std::ios_base::out, WriteOutputsAsCSV);
+    }
+
+    std::optional<std::filesystem::path> TryExportOutputsToBinaryColumns(
+        const ISimulation& simulation,
+        std::span<const OutputExtractor> outputs)
+    {
+        return TryExportOutputs(simulation, outputs, "osccols", std::ios_base::out | std::ios_base::binary, [](
+            OpenSim::Component const& root,
+            std::span<const OutputExtractor> outputs,
+            std::span<const SimulationReport> reports,
+            std::ostream& out)
+        {
+            WriteOutputsAsBinaryColumns(root, outputs, reports, out);
+        });
+    }
 }
 
 std::vector<OutputExtractor> osc::ISimulatorUIAPI::getAllUserOutputExtractors() const
@@ -68,3 +97,13 @@ std::optional<std::filesystem::path> osc::ISimulatorUIAPI::tryPromptToSaveAllOut
 {
     return TryExportOutputsToCSV(getSimulation(), getAllUserOutputExtractors());
 }
+
+std::optional<std::filesystem::path> osc::ISimulatorUIAPI::tryPromptToSaveOutputsAsBinaryColumns(std::span<OutputExtractor const> outputs) const
+{
+    return TryExportOutputsToBinaryColumns(getSimulation(), outputs);
+}
+
+std::optional<std::filesystem::path> osc::ISimulatorUIAPI::tryPromptToSaveAllOutputsAsBinaryColumns() const
+{
+    return TryExportOutputsToBinaryColumns(getSimulation(), getAllUserOutputExtractors());
+}
@@ -66,6 +66,8 @@ namespace osc
             return tryPromptToSaveOutputsAsCSV(std::span<OutputExtractor const>{il});
         }
         std::optional<std::filesystem::path> tryPromptToSaveAllOutputsAsCSV() const;
+        std::optional<std::filesystem::path> tryPromptToSaveOutputsAsBinaryColumns(std::span<OutputExtractor const>) const;
+        std::optional<std::filesystem::path> tryPromptToSaveAllOutputsAsBinaryColumns() const;
 
         SimulationModelStatePair* tryGetCurrentSimulationState() { return implTryGetCurrentSimulationState(); }
 
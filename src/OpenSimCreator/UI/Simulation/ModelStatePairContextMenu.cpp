@@ -40,7 +40,7 @@ public:
         {
             drawRightClickedNothingContextMenu();
         }
-        else if (OpenSim::Component const* c = FindComponent(m_Model->getModel(), *m_MaybeComponentAbsPath))
+        else if (OpenSim::Component const* c = m_Model->findComponent(*m_MaybeComponentAbsPath))
         {
             drawRightClickedSomethingContextMenu(*c);
         }
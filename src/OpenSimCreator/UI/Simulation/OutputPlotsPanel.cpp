@@ -70,6 +70,10 @@ private:
                     }
                 }
 
+                if (ui::draw_menu_item("as binary columns (.osccols)")) {
+                    m_SimulatorUIAPI->tryPromptToSaveAllOutputsAsBinaryColumns();
+                }
+
                 ui::end_popup();
             }
         }
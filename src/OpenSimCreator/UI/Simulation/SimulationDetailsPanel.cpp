@@ -100,6 +100,11 @@ private:
                     }
                 }
 
+                if (ui::draw_menu_item("as binary columns (.osccols)"))
+                {
+                    m_SimulatorUIAPI->tryPromptToSaveOutputsAsBinaryColumns(outputs);
+                }
+
                 ui::end_popup();
             }
         }
@@ -36,6 +36,7 @@
 #include <SDL_events.h>
 
 #include <filesystem>
+#include <future>
 #include <span>
 #include <string>
 #include <utility>
@@ -402,9 +403,12 @@ private:
     };
     SceneRendererParams m_LastSceneRendererParams = GetSplashScreenDefaultRenderParams(m_Camera);
 
+    // (the logos are rasterized in parallel, because rasterizing SVGs is slow)
+    std::future<Texture2D> m_CziLogoLoader = load_texture2D_from_svg_async(App::load_resource("textures/chanzuckerberg_logo.svg"), 0.5f);
+    std::future<Texture2D> m_TudLogoLoader = load_texture2D_from_svg_async(App::load_resource("textures/tudelft_logo.svg"), 0.5f);
     Texture2D m_MainAppLogo = load_texture2D_from_svg(App::load_resource("textures/banner.svg"));
-    Texture2D m_CziLogo = load_texture2D_from_svg(App::load_resource("textures/chanzuckerberg_logo.svg"), 0.5f);
-    Texture2D m_TudLogo = load_texture2D_from_svg(App::load_resource("textures/tudelft_logo.svg"), 0.5f);
+    Texture2D m_CziLogo = m_CziLogoLoader.get();
+    Texture2D m_TudLogo = m_TudLogoLoader.get();
 
     // dimensions of stuff
     Vec2 m_SplashMenuMaxDims = {640.0f, 512.0f};
@@ -0,0 +1,181 @@
+#include "ComponentPathIndex.h"
+
+#include <OpenSimCreator/Utils/OpenSimHelpers.h>
+
+#include <ankerl/unordered_dense.h>
+#include <OpenSim/Common/Component.h>
+#include <OpenSim/Common/ComponentPath.h>
+#include <oscar/Utils/Perf.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    uint64_t ChildKey(uint32_t parent, uint32_t segment)
+    {
+        return (static_cast<uint64_t>(parent) << 32) | static_cast<uint64_t>(segment);
+    }
+
+    // returns `true` if the path element is `.` or `..` (i.e. a path that contains it might
+    // resolve to a component that has a different absolute path)
+    bool IsRelativeElement(std::string const& el)
+    {
+        return el == "." || el == "..";
+    }
+
+    struct SegmentHasher final {
+        using is_transparent = void;
+        using is_avalanching = void;
+
+        [[nodiscard]] uint64_t operator()(std::string_view segment) const noexcept
+        {
+            return ankerl::unordered_dense::hash<std::string_view>{}(segment);
+        }
+    };
+}
+
+class osc::ComponentPathIndex::Impl final {
+public:
+    Impl() = default;
+
+    explicit Impl(OpenSim::Component const& root) :
+        m_Root{&root}
+    {
+        OSC_PERF("ComponentPathIndex/build");
+
+        m_Nodes.push_back(nullptr);  // the root path
+
+        auto const index = [this](OpenSim::Component const& c)
+        {
+            OpenSim::ComponentPath const path = GetAbsolutePath(c);
+
+            uint32_t node = 0;
+            for (size_t i = 0; i < path.getNumPathLevels(); ++i)
+            {
+                uint32_t const segment = m_SegmentIDs.try_emplace(path.getSubcomponentNameAtLevel(i), static_cast<uint32_t>(m_SegmentIDs.size())).first->second;
+                auto const [childIt, inserted] = m_Children.try_emplace(ChildKey(node, segment), static_cast<uint32_t>(m_Nodes.size()));
+                if (inserted)
+                {
+                    m_Nodes.push_back(nullptr);
+                }
+                node = childIt->second;
+            }
+
+            // first (depth-first) component wins, like `FindComponent`
+            if (m_Nodes[node] == nullptr)
+            {
+                m_Nodes[node] = &c;
+                ++m_NumComponents;
+            }
+        };
+
+        index(root);
+        for (OpenSim::Component const& c : root.getComponentList())
+        {
+            index(c);
+        }
+    }
+
+    bool isIndexOf(OpenSim::Component const& root) const
+    {
+        return m_Root == &root;
+    }
+
+    size_t size() const
+    {
+        return m_NumComponents;
+    }
+
+    OpenSim::Component const* find(OpenSim::ComponentPath const& path) const
+    {
+        if (m_Root == nullptr || path == OpenSim::ComponentPath{})
+        {
+            return nullptr;
+        }
+
+        if (!path.isAbsolute())
+        {
+            return FindComponent(*m_Root, path);
+        }
+
+        uint32_t node = 0;
+        for (size_t i = 0; i < path.getNumPathLevels(); ++i)
+        {
+            std::string const segment = path.getSubcomponentNameAtLevel(i);
+
+            auto const it = m_SegmentIDs.find(segment);
+            node = it != m_SegmentIDs.end() ? findChild(node, it->second) : c_NoNode;
+
+            if (node == c_NoNode)
+            {
+                // unknown (or misplaced) name: only `.` and `..` elements can still resolve
+                for (size_t j = i; j < path.getNumPathLevels(); ++j)
+                {
+                    if (IsRelativeElement(path.getSubcomponentNameAtLevel(j)))
+                    {
+                        return FindComponent(*m_Root, path);
+                    }
+                }
+                return nullptr;
+            }
+        }
+        return m_Nodes[node];
+    }
+
+private:
+    static constexpr uint32_t c_NoNode = static_cast<uint32_t>(-1);
+
+    // returns the node that's the child of `parent` via `segment`, or `c_NoNode`
+    uint32_t findChild(uint32_t parent, uint32_t segment) const
+    {
+        auto const it = m_Children.find(ChildKey(parent, segment));
+        return it != m_Children.end() ? it->second : c_NoNode;
+    }
+
+    OpenSim::Component const* m_Root = nullptr;
+    size_t m_NumComponents = 0;
+
+    // component (if any) at each node of the path trie (node 0 is the root path)
+    std::vector<OpenSim::Component const*> m_Nodes;
+
+    // interned path segments (i.e. component names) --> segment ID
+    ankerl::unordered_dense::map<std::string, uint32_t, SegmentHasher, std::equal_to<>> m_SegmentIDs;
+
+    // (parent node, segment ID) --> child node
+    ankerl::unordered_dense::map<uint64_t, uint32_t> m_Children;
+};
+
+osc::ComponentPathIndex::ComponentPathIndex() :
+    m_Impl{std::make_unique<Impl>()}
+{}
+
+osc::ComponentPathIndex::ComponentPathIndex(OpenSim::Component const& root) :
+    m_Impl{std::make_unique<Impl>(root)}
+{}
+
+osc::ComponentPathIndex::ComponentPathIndex(ComponentPathIndex&&) noexcept = default;
+osc::ComponentPathIndex& osc::ComponentPathIndex::operator=(ComponentPathIndex&&) noexcept = default;
+osc::ComponentPathIndex::~ComponentPathIndex() noexcept = default;
+
+bool osc::ComponentPathIndex::isIndexOf(OpenSim::Component const& root) const
+{
+    return m_Impl->isIndexOf(root);
+}
+
+size_t osc::ComponentPathIndex::size() const
+{
+    return m_Impl->size();
+}
+
+OpenSim::Component const* osc::ComponentPathIndex::find(OpenSim::ComponentPath const& path) const
+{
+    return m_Impl->find(path);
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <memory>
+
+namespace OpenSim { class Component; }
+namespace OpenSim { class ComponentPath; }
+
+namespace osc
+{
+    // a flat lookup table from absolute component paths to the components in a
+    // (finalized) component tree
+    //
+    // `FindComponent` walks the tree one path segment at a time (and throws+catches
+    // internally when a path doesn't resolve), which adds up when the UI resolves the
+    // same paths (selection, hover, etc.) many times per frame. This index does that
+    // walk once and interns each path segment (component name) as an integer, so that a
+    // lookup is one integer hash lookup per segment, doesn't build the path's string, and
+    // rejects paths that contain an unknown name without walking further
+    //
+    // the index holds raw pointers into the tree, so the caller must rebuild it whenever
+    // the tree may have changed (e.g. whenever the model's version changes)
+    class ComponentPathIndex final {
+    public:
+        ComponentPathIndex();
+
+        // indexes `root` and all of its (recursive) subcomponents
+        //
+        // `root` should be the root of its component tree (e.g. an `OpenSim::Model`),
+        // because only components within `root` can be looked up by absolute path
+        explicit ComponentPathIndex(OpenSim::Component const& root);
+
+        ComponentPathIndex(ComponentPathIndex const&) = delete;
+        ComponentPathIndex(ComponentPathIndex&&) noexcept;
+        ComponentPathIndex& operator=(ComponentPathIndex const&) = delete;
+        ComponentPathIndex& operator=(ComponentPathIndex&&) noexcept;
+        ~ComponentPathIndex() noexcept;
+
+        // returns `true` if the index was built from `root`
+        bool isIndexOf(OpenSim::Component const& root) const;
+
+        size_t size() const;
+        bool empty() const { return size() == 0; }
+
+        // returns the indexed component at the given path, or `nullptr` if the path
+        // doesn't resolve to a component (same behavior as `FindComponent(root, path)`)
+        //
+        // relative paths, and absolute paths that contain `.` or `..` elements, aren't
+        // indexed, so they fall back to walking the component tree
+        OpenSim::Component const* find(OpenSim::ComponentPath const&) const;
+
+        template<std::derived_from<OpenSim::Component> T>
+        T const* find(OpenSim::ComponentPath const& path) const
+        {
+            return dynamic_cast<T const*>(find(path));
+        }
+
+    private:
+        class Impl;
+        std::unique_ptr<Impl> m_Impl;
+    };
+}
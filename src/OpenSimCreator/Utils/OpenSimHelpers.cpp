@@ -831,6 +831,25 @@ std::optional<std::filesystem::path> osc::FindGeometryFileAbsPath(
     return std::optional<std::filesystem::path>{std::filesystem::weakly_canonical({attempts.back()})};
 }
 
+std::vector<std::filesystem::path> osc::FindFilesystemDependencies(OpenSim::Model const& model)
+{
+    std::vector<std::filesystem::path> rv;
+    if (std::filesystem::path osimPath = TryFindInputFile(model); !osimPath.empty())
+    {
+        rv.push_back(std::move(osimPath));
+    }
+    for (OpenSim::Mesh const& mesh : model.getComponentList<OpenSim::Mesh>())
+    {
+        if (std::optional<std::filesystem::path> meshPath = FindGeometryFileAbsPath(model, mesh))
+        {
+            rv.push_back(std::move(meshPath).value());
+        }
+    }
+    rgs::sort(rv);
+    rv.erase(rgs::unique(rv).begin(), rv.end());
+    return rv;
+}
+
 bool osc::ShouldShowInUI(OpenSim::Component const& c)
 {
     if (dynamic_cast<OpenSim::PathWrapPoint const*>(&c))
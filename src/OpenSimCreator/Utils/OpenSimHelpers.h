@@ -509,6 +509,11 @@ namespace osc
         OpenSim::Mesh const&
     );
 
+    // returns the (deduplicated) absolute paths of the files that the model was loaded from
+    // and depends on (i.e. its osim file and any mesh files that it references), if they
+    // can be found
+    std::vector<std::filesystem::path> FindFilesystemDependencies(OpenSim::Model const&);
+
     // returns `true` if the component should be shown in the UI
     //
     // this uses heuristics to determine whether the component is something the UI should be
@@ -4,6 +4,9 @@
 
 #include <Simbody.h>
 #include <oscar/Graphics/Mesh.h>
+#include <oscar/Graphics/MeshIndicesView.h>
+#include <oscar/Graphics/MeshTopology.h>
+#include <oscar/Maths/AABBFunctions.h>
 #include <oscar/Maths/GeometricFunctions.h>
 #include <oscar/Maths/MathHelpers.h>
 #include <oscar/Maths/Rect.h>
@@ -12,12 +15,18 @@
 #include <oscar/Maths/Vec3.h>
 #include <oscar/Shims/Cpp23/numeric.h>
 #include <oscar/Utils/Assertions.h>
+#include <oscar/Utils/ParalellizationHelpers.h>
+#include <oscar/Utils/StridedSpan.h>
 
 #include <cmath>
 #include <algorithm>
 #include <array>
 #include <complex>
+#include <concepts>
+#include <cstddef>
+#include <limits>
 #include <numeric>
+#include <optional>
 #include <ranges>
 #include <span>
 #include <vector>
@@ -318,6 +327,33 @@ namespace
         return planeSurfacePoint.x*basis1 + planeSurfacePoint.y*basis2;
     }
 
+    // solves the normal equations of the ellipsoid's algebraic form (`DtD * u = Dtd2`) for `u`
+    std::array<double, 9> SolveEllipsoidNormalEquations(
+        SimTK::Matrix const& DtD,
+        SimTK::Vector const& Dtd2)
+    {
+        // note: SimTK and MATLAB behave slightly different when given inputs
+        //       that are signular or badly scaled.
+        //
+        //       I'm using a hard-coded rcond here to match MATLAB's error message,
+        //       so that I can verify that SimTK's behavior can be modified to yield
+        //       identical results to MATLAB
+        constexpr double c_RCondReportedByMatlab = 1.202234e-16;
+
+        // solve the normal system of equations
+        SimTK::Vector u = SolveLinearLeastSquares(
+            DtD,   // lhs * u = ...
+            Dtd2,  // ... rhs
+            c_RCondReportedByMatlab
+        );
+
+        // repack vector into compile-time-known array
+        OSC_ASSERT(u.size() == 9);
+        std::array<double, 9> rv{};
+        std::copy(u.begin(), u.end(), rv.begin());
+        return rv;
+    }
+
     // part of solving this algeberic form for an ellipsoid:
     //
     //     - Ax^2 + By^2 + Cz^2 + 2Dxy + 2Exz + 2Fyz + 2Gx + 2Hy + 2Iz + J = 0
@@ -359,26 +395,7 @@ namespace
             d2(row) = x*x + y*y + z*z;
         }
 
-        // note: SimTK and MATLAB behave slightly different when given inputs
-        //       that are signular or badly scaled.
-        //
-        //       I'm using a hard-coded rcond here to match MATLAB's error message,
-        //       so that I can verify that SimTK's behavior can be modified to yield
-        //       identical results to MATLAB
-        constexpr double c_RCondReportedByMatlab = 1.202234e-16;
-
-        // solve the normal system of equations
-        SimTK::Vector u = SolveLinearLeastSquares(
-            D.transpose() * D,  // lhs * u = ...
-            D.transpose() * d2, // ... rhs
-            c_RCondReportedByMatlab
-        );
-
-        // repack vector into compile-time-known array
-        OSC_ASSERT(u.size() == 9);
-        std::array<double, 9> rv{};
-        std::copy(u.begin(), u.end(), rv.begin());
-        return rv;
+        return SolveEllipsoidNormalEquations(D.transpose() * D, D.transpose() * d2);
     }
 
     // like-for-like translation from original MATLAB version of the code
@@ -468,9 +485,239 @@ namespace
         SimTK::Matrix const R = T * SimTK::Matrix{A} * T.transpose();
         return EigSorted(TopLeft<3, 3>(R) / -R(3, 3));
     }
+
+    // returns the ellipsoid described by the solution of `SolveEllipsoidAlgebraicForm`
+    Ellipsoid CalcEllipsoidFromAlgebraicForm(std::array<double, 9> const& u)
+    {
+        auto const v = SolveV(u);
+        auto const A = CalcA(v);  // form the algebraic form of the ellipsoid
+
+        // solve for ellipsoid origin
+        auto const ellipsoidOrigin = CalcEllipsoidOrigin(A, v);
+
+        // use Eigenanalysis to solve for the ellipsoid's radii and and frame
+        auto [evecs, evals] = SolveEigenProblem(A, ellipsoidOrigin);
+
+        // OpenSimCreator modification (this is slightly different behavior from "How to Build a Dinosaur"'s MATLAB code)
+        //
+        // the original code allows negative radii to come out of the algorithm, but
+        // OSC's implementation ensures radii are always positive by negating the
+        // corresponding Eigenvector
+        {
+            SimTK::Vec3 const signs = Sign(Diag(evals));
+            for (int i = 0; i < 3; ++i)
+            {
+                evecs.col(i) *= signs[i];
+                evals.col(i) *= signs[i];
+            }
+        }
+
+        // OpenSimCreator modification: also ensure that the Eigen vectors form a _right handed_ coordinate
+        // system, because that's what SimTK etc. use
+        RightHandify(evecs);
+
+        return Ellipsoid
+        {
+            ToVec3(ellipsoidOrigin),
+            ToVec3(SimTK::sqrt(Reciporical(Diag(evals)))),
+            quat_cast(ToMat3(evecs)),
+        };
+    }
+}
+
+// streaming shape-fitting helpers
+//
+// these fit shapes by accumulating weighted sums (e.g. normal equations) over a mesh's
+// unique vertices, rather than materializing a dense per-indexed-vertex matrix
+namespace
+{
+    // a mesh's unique vertices, plus how much each one contributes to a fit
+    struct WeightedVertices final {
+
+        // only populated if the mesh's vertices can't be viewed directly
+        std::vector<Vec3> vertexStorage;
+
+        StridedSpan<Vec3 const> vertices;
+
+        // per-vertex weight (0.0 for vertices that aren't indexed by the mesh)
+        std::vector<double> weights;
+
+        // subtracted from each vertex before it's accumulated, so that the sums are computed
+        // around the mesh's center (this improves the conditioning of the solved equations,
+        // which are all translation-equivariant)
+        Vec3d shift{};
+    };
+
+    WeightedVertices CalcWeightedVertices(Mesh const& mesh, ShapeFitWeighting weighting)
+    {
+        WeightedVertices rv;
+        if (auto const view = mesh.try_view_vertices())
+        {
+            rv.vertices = *view;
+        }
+        else
+        {
+            rv.vertexStorage = mesh.vertices();
+            rv.vertices = StridedSpan<Vec3 const>{std::span<Vec3 const>{rv.vertexStorage}};
+        }
+        rv.weights.assign(rv.vertices.size(), 0.0);
+        rv.shift = Vec3d{centroid_of(mesh.bounds())};
+
+        MeshIndicesView const indices = mesh.indices();
+        if (weighting == ShapeFitWeighting::Area && mesh.topology() == MeshTopology::Triangles)
+        {
+            for (size_t i = 0; i+2 < indices.size(); i += 3)
+            {
+                auto const a = indices[i];
+                auto const b = indices[i+1];
+                auto const c = indices[i+2];
+                Vec3d const pa{rv.vertices[a]};
+                double const thirdOfArea = length(cross(Vec3d{rv.vertices[b]} - pa, Vec3d{rv.vertices[c]} - pa)) / 6.0;
+                rv.weights[a] += thirdOfArea;
+                rv.weights[b] += thirdOfArea;
+                rv.weights[c] += thirdOfArea;
+            }
+        }
+        else
+        {
+            for (auto const index : indices)
+            {
+                rv.weights[index] += 1.0;
+            }
+
+            if (weighting != ShapeFitWeighting::IndexCount)
+            {
+                for (double& w : rv.weights)
+                {
+                    w = w > 0.0 ? 1.0 : 0.0;
+                }
+            }
+        }
+        return rv;
+    }
+
+    // returns the sum of `accumulate(sums, vertex - shift, weight)` over all (non-zero weighted) vertices
+    //
+    // the vertices are accumulated in fixed-size chunks that are summed in-order, so the result
+    // doesn't depend on how many threads were used
+    template<typename Sums, std::invocable<Sums&, Vec3d const&, double> Accumulator>
+    Sums ParallelAccumulate(WeightedVertices const& wv, Accumulator accumulate)
+    {
+        constexpr size_t c_ChunkSize = 8192;
+
+        struct Chunk final {
+            size_t begin = 0;
+            size_t end = 0;
+            Sums sums{};
+        };
+
+        std::vector<Chunk> chunks;
+        chunks.reserve(wv.vertices.size()/c_ChunkSize + 1);
+        for (size_t begin = 0; begin < wv.vertices.size(); begin += c_ChunkSize)
+        {
+            chunks.push_back(Chunk{.begin = begin, .end = std::min(begin + c_ChunkSize, wv.vertices.size())});
+        }
+
+        for_each_parallel_unsequenced(1, std::span<Chunk>{chunks}, [&wv, &accumulate](Chunk& chunk)
+        {
+            for (size_t i = chunk.begin; i < chunk.end; ++i)
+            {
+                if (double const w = wv.weights[i]; w != 0.0)
+                {
+                    accumulate(chunk.sums, Vec3d{wv.vertices[i]} - wv.shift, w);
+                }
+            }
+        });
+
+        Sums rv{};
+        for (Chunk const& chunk : chunks)
+        {
+            rv += chunk.sums;
+        }
+        return rv;
+    }
+
+    // weighted normal equations (`AtA * c = Atf`) of the sphere fit (see `FitSphereReference`)
+    struct SphereSums final {
+        SphereSums& operator+=(SphereSums const& other)
+        {
+            AtA += other.AtA;
+            Atf += other.Atf;
+            return *this;
+        }
+
+        SimTK::Mat44 AtA = SimTK::Mat44(0.0);
+        SimTK::Vec4 Atf = SimTK::Vec4(0.0);
+    };
+
+    // weighted first and second moments of the vertices (for the plane fit's PCA)
+    struct PlaneSums final {
+        PlaneSums& operator+=(PlaneSums const& other)
+        {
+            totalWeight += other.totalWeight;
+            weightedSum += other.weightedSum;
+            weightedOuterProductSum += other.weightedOuterProductSum;
+            return *this;
+        }
+
+        double totalWeight = 0.0;
+        SimTK::Vec3 weightedSum = SimTK::Vec3(0.0);
+        SimTK::Mat33 weightedOuterProductSum = SimTK::Mat33(0.0);
+    };
+
+    // 2D bounds of the vertices, once they're projected onto a plane
+    struct PlaneSurfaceBounds final {
+        PlaneSurfaceBounds& operator+=(PlaneSurfaceBounds const& other)
+        {
+            min = elementwise_min(min, other.min);
+            max = elementwise_max(max, other.max);
+            return *this;
+        }
+
+        Vec2 min{std::numeric_limits<float>::max()};
+        Vec2 max{std::numeric_limits<float>::lowest()};
+    };
+
+    // weighted normal equations (`DtD * u = Dtd2`) of the ellipsoid fit (see `SolveEllipsoidAlgebraicForm`)
+    struct EllipsoidSums final {
+        EllipsoidSums& operator+=(EllipsoidSums const& other)
+        {
+            DtD += other.DtD;
+            Dtd2 += other.Dtd2;
+            return *this;
+        }
+
+        SimTK::Mat<9, 9> DtD = SimTK::Mat<9, 9>(0.0);
+        SimTK::Vec<9> Dtd2 = SimTK::Vec<9>(0.0);
+    };
+
+    template<int M, int N>
+    SimTK::Matrix ToMatrix(SimTK::Mat<M, N> const& m)
+    {
+        SimTK::Matrix rv(M, N);
+        for (int row = 0; row < M; ++row)
+        {
+            for (int col = 0; col < N; ++col)
+            {
+                rv(row, col) = m(row, col);
+            }
+        }
+        return rv;
+    }
+
+    template<int N>
+    SimTK::Vector ToVector(SimTK::Vec<N> const& v)
+    {
+        SimTK::Vector rv(N);
+        for (int i = 0; i < N; ++i)
+        {
+            rv(i) = v[i];
+        }
+        return rv;
+    }
 }
 
-Sphere osc::FitSphere(Mesh const& mesh)
+Sphere osc::FitSphereReference(Mesh const& mesh)
 {
     // # Background Reading:
     //
@@ -566,7 +813,7 @@ Sphere osc::FitSphere(Mesh const& mesh)
     return Sphere{origin, radius};
 }
 
-Plane osc::FitPlane(Mesh const& mesh)
+Plane osc::FitPlaneReference(Mesh const& mesh)
 {
     // # Background Reading:
     //
@@ -669,7 +916,7 @@ Plane osc::FitPlane(Mesh const& mesh)
     return Plane{boundsMidPointInMeshSpace, normal};
 }
 
-Ellipsoid osc::FitEllipsoid(Mesh const& mesh)
+Ellipsoid osc::FitEllipsoidReference(Mesh const& mesh)
 {
     // # Background Reading:
     //
@@ -696,38 +943,132 @@ Ellipsoid osc::FitEllipsoid(Mesh const& mesh)
     // as a form of PCA?
 
     std::vector<Vec3> const meshVertices = mesh.indexed_vertices();
-    auto const u = SolveEllipsoidAlgebraicForm(meshVertices);
-    auto const v = SolveV(u);
-    auto const A = CalcA(v);  // form the algebraic form of the ellipsoid
-
-    // solve for ellipsoid origin
-    auto const ellipsoidOrigin = CalcEllipsoidOrigin(A, v);
-
-    // use Eigenanalysis to solve for the ellipsoid's radii and and frame
-    auto [evecs, evals] = SolveEigenProblem(A, ellipsoidOrigin);
+    return CalcEllipsoidFromAlgebraicForm(SolveEllipsoidAlgebraicForm(meshVertices));
+}
 
-    // OpenSimCreator modification (this is slightly different behavior from "How to Build a Dinosaur"'s MATLAB code)
-    //
-    // the original code allows negative radii to come out of the algorithm, but
-    // OSC's implementation ensures radii are always positive by negating the
-    // corresponding Eigenvector
+Sphere osc::FitSphere(Mesh const& mesh, ShapeFitWeighting weighting)
+{
+    // see `FitSphereReference` for an explanation of the maths: this accumulates `AtA` and
+    // `Atf` (weighted), rather than `A` and `f`, and then solves the (4x4) normal equations
+    WeightedVertices const wv = CalcWeightedVertices(mesh, weighting);
+    auto const sums = ParallelAccumulate<SphereSums>(wv, [](SphereSums& acc, Vec3d const& v, double w)
     {
-        SimTK::Vec3 const signs = Sign(Diag(evals));
-        for (int i = 0; i < 3; ++i)
+        SimTK::Vec4 const a{2.0*v.x, 2.0*v.y, 2.0*v.z, 1.0};
+        double const f = v.x*v.x + v.y*v.y + v.z*v.z;
+        for (int row = 0; row < 4; ++row)
         {
-            evecs.col(i) *= signs[i];
-            evals.col(i) *= signs[i];
+            for (int col = 0; col < 4; ++col)
+            {
+                acc.AtA(row, col) += w * a[row] * a[col];
+            }
+            acc.Atf[row] += w * f * a[row];
         }
+    });
+
+    if (sums.AtA(3, 3) == 0.0)
+    {
+        return Sphere{{}, 1.0f};  // edge-case: no (weighted) points in input mesh
     }
 
-    // OpenSimCreator modification: also ensure that the Eigen vectors form a _right handed_ coordinate
-    // system, because that's what SimTK etc. use
-    RightHandify(evecs);
+    SimTK::Vector const c = SolveLinearLeastSquares(ToMatrix(sums.AtA), ToVector(sums.Atf));
+    OSC_ASSERT(c.size() == 4);
+
+    double const x0 = c[0];
+    double const y0 = c[1];
+    double const z0 = c[2];
+    double const r2 = c[3] + x0*x0 + y0*y0 + z0*z0;
+
+    return Sphere{Vec3{Vec3d{x0, y0, z0} + wv.shift}, static_cast<float>(sqrt(r2))};
+}
 
-    return Ellipsoid
+Plane osc::FitPlane(Mesh const& mesh, ShapeFitWeighting weighting)
+{
+    // see `FitPlaneReference` for an explanation of the algorithm: this computes the
+    // covariance matrix from the (weighted) first and second moments of the vertices,
+    // rather than from a mean-subtracted copy of them
+    WeightedVertices const wv = CalcWeightedVertices(mesh, weighting);
+    auto const sums = ParallelAccumulate<PlaneSums>(wv, [](PlaneSums& acc, Vec3d const& v, double w)
     {
-        ToVec3(ellipsoidOrigin),
-        ToVec3(SimTK::sqrt(Reciporical(Diag(evals)))),
-        quat_cast(ToMat3(evecs)),
-    };
+        SimTK::Vec3 const p{v.x, v.y, v.z};
+        acc.totalWeight += w;
+        acc.weightedSum += w * p;
+        acc.weightedOuterProductSum += w * (p * p.transpose());
+    });
+
+    if (sums.totalWeight == 0.0)
+    {
+        return Plane{{}, {0.0f, 1.0f, 0.0f}};  // edge-case: return unit plane
+    }
+
+    // covariance = sum(w * (p - mean)(p - mean)^T) = sum(w * pp^T) - totalWeight * mean*mean^T
+    SimTK::Vec3 const mean = sums.weightedSum / sums.totalWeight;
+    SimTK::Mat33 const covarianceMatrix = sums.weightedOuterProductSum - sums.totalWeight * (mean * mean.transpose());
+
+    // eigen analysis to yield [N, B1, B2]
+    SimTK::Mat33 const eigenVectors = EigSorted(covarianceMatrix).first;
+    Vec3 const normal = ToVec3(eigenVectors.col(0));
+    Vec3 const basis1 = ToVec3(eigenVectors.col(1));
+    Vec3 const basis2 = ToVec3(eigenVectors.col(2));
+
+    // project the mean-subtracted points onto B1 and B2 (plane-space) and calculate the
+    // 2D bounding box of them in plane-space
+    Vec3d const meanInShiftedSpace{mean[0], mean[1], mean[2]};
+    auto const bounds = ParallelAccumulate<PlaneSurfaceBounds>(wv, [&meanInShiftedSpace, &basis1, &basis2](PlaneSurfaceBounds& acc, Vec3d const& v, double)
+    {
+        Vec2 const projected = Project3DPointOntoPlane(Vec3{v - meanInShiftedSpace}, basis1, basis2);
+        acc.min = elementwise_min(acc.min, projected);
+        acc.max = elementwise_max(acc.max, projected);
+    });
+
+    // un-project the plane-space midpoint back into mesh-space
+    Vec3 const boundsMidPointInReducedSpace = Unproject2DPlanePointInto3D(
+        0.5f*(bounds.min + bounds.max),
+        basis1,
+        basis2
+    );
+    Vec3 const boundsMidPointInMeshSpace{Vec3d{boundsMidPointInReducedSpace} + meanInShiftedSpace + wv.shift};
+
+    return Plane{boundsMidPointInMeshSpace, normal};
+}
+
+Ellipsoid osc::FitEllipsoid(Mesh const& mesh, ShapeFitWeighting weighting)
+{
+    // see `FitEllipsoidReference` and `SolveEllipsoidAlgebraicForm` for an explanation of
+    // the algorithm: this accumulates `DtD` and `Dtd2` (weighted), rather than `D` and `d2`
+    WeightedVertices const wv = CalcWeightedVertices(mesh, weighting);
+    auto const sums = ParallelAccumulate<EllipsoidSums>(wv, [](EllipsoidSums& acc, Vec3d const& v, double w)
+    {
+        double const x = v.x;
+        double const y = v.y;
+        double const z = v.z;
+
+        SimTK::Vec<9> const d{
+            x*x + y*y - 2.0*z*z,
+            x*x + z*z - 2.0*y*y,
+            2.0*x*y,
+            2.0*x*z,
+            2.0*y*z,
+            2.0*x,
+            2.0*y,
+            2.0*z,
+            1.0,
+        };
+        double const d2 = x*x + y*y + z*z;
+
+        for (int row = 0; row < 9; ++row)
+        {
+            double const wd = w * d[row];
+            for (int col = 0; col < 9; ++col)
+            {
+                acc.DtD(row, col) += wd * d[col];
+            }
+            acc.Dtd2[row] += wd * d2;
+        }
+    });
+
+    // the ellipsoid's shape and orientation are translation-invariant, so only its origin
+    // needs to be shifted back into mesh-space
+    Ellipsoid rv = CalcEllipsoidFromAlgebraicForm(SolveEllipsoidNormalEquations(ToMatrix(sums.DtD), ToVector(sums.Dtd2)));
+    rv.origin = Vec3{Vec3d{rv.origin} + wv.shift};
+    return rv;
 }
@@ -8,7 +8,37 @@ namespace osc { class Mesh; }
 
 namespace osc
 {
-    Sphere FitSphere(Mesh const&);
-    Plane FitPlane(Mesh const&);
-    Ellipsoid FitEllipsoid(Mesh const&);
+    // how much each of a mesh's vertices contributes to a shape fit
+    enum class ShapeFitWeighting {
+        // each vertex is weighted by the number of times that it's indexed by the mesh, which
+        // gives the same result as fitting `Mesh::indexed_vertices()` (i.e. the same result as
+        // the original published algorithms, which were fed indexed vertices)
+        IndexCount,
+
+        // each indexed vertex is weighted equally
+        Uniform,
+
+        // each vertex is weighted by a third of the area of the triangles that it's part of, so
+        // that densely-tessellated regions of the mesh don't bias the fit (meshes that aren't
+        // made of triangles are weighted `Uniform`ly)
+        Area,
+
+        Default = IndexCount,
+    };
+
+    // these fit the shape to the mesh's unique vertices in a single (parallelized) pass that
+    // accumulates the fit's normal equation/covariance sums, so they don't need to materialize
+    // the mesh's indexed vertices, or a dense per-point matrix
+    Sphere FitSphere(Mesh const&, ShapeFitWeighting = ShapeFitWeighting::Default);
+    Plane FitPlane(Mesh const&, ShapeFitWeighting = ShapeFitWeighting::Default);
+    Ellipsoid FitEllipsoid(Mesh const&, ShapeFitWeighting = ShapeFitWeighting::Default);
+
+    // reference implementations, which fit `Mesh::indexed_vertices()` using dense per-point
+    // matrices, exactly like the original published algorithms
+    //
+    // these are (much) slower, and use (much) more memory, than the above, but are kept as a
+    // regression baseline for them with `ShapeFitWeighting::IndexCount`
+    Sphere FitSphereReference(Mesh const&);
+    Plane FitPlaneReference(Mesh const&);
+    Ellipsoid FitEllipsoidReference(Mesh const&);
 }
@@ -0,0 +1,363 @@
+#include "TPS.h"
+
+#include <Simbody.h>
+#include <oscar/Graphics/Mesh.h>
+#include <oscar/Maths/CommonFunctions.h>
+#include <oscar/Maths/GeometricFunctions.h>
+#include <oscar/Maths/Vec.h>
+#include <oscar/Maths/Vec2.h>
+#include <oscar/Maths/Vec3.h>
+#include <oscar/Utils/ParalellizationHelpers.h>
+#include <oscar/Utils/Perf.h>
+#include <oscar/Utils/StridedSpan.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <span>
+#include <vector>
+
+using namespace osc;
+
+template<>
+float osc::TPSRadialBasisFunction<2>(Vec2 const& controlPoint, Vec2 const& p)
+{
+    // this is the original Bookstein definition: U(r) = r^2 * log(r^2)
+    Vec2 const diff = controlPoint - p;
+    float const r2 = dot(diff, diff);
+
+    if (r2 == 0.0f)
+    {
+        // this ensures that the result is always non-zero and non-NaN (this might be
+        // necessary for some types of linear solvers?)
+        return std::numeric_limits<float>::min();
+    }
+    else
+    {
+        return r2 * std::log(r2);
+    }
+}
+
+template<>
+float osc::TPSRadialBasisFunction<3>(Vec3 const& controlPoint, Vec3 const& p)
+{
+    // this implementation uses the U definition from the following (later) source:
+    //
+    // Chapter 3, "Semilandmarks in Three Dimensions" by Phillip Gunz, Phillip Mitteroecker,
+    // and Fred L. Bookstein
+    //
+    // the original Bookstein paper uses U(v) = |v|^2 * log(|v|^2), but subsequent literature
+    // (e.g. the above book) uses U(v) = |v|. The primary author (Gunz) claims that the original
+    // basis function is not as good as just using the magnitude?
+    return length(controlPoint - p);
+}
+
+namespace
+{
+    // returns the system matrix, L, of the TPS equation
+    //
+    // this is based on the Bookstein Thin Plate Sline (TPS) warping algorithm
+    //
+    // 1. A TPS warp is (simplifying here) a linear combination:
+    //
+    //     f(p) = a1 + a2*p.x + a3*p.y + ... + SUM{ wi * U(||controlPoint_i - p||) }
+    //
+    //    which can be represented as a matrix multiplication between the terms (1, p.x, p.y,
+    //    ..., U(||cpi - p||)) and the coefficients (a1, a2, a3, ..., wi..)
+    //
+    // 2. The caller provides "landmark pairs": these are (effectively) the input
+    //    arguments and the expected output
+    //
+    // 3. This algorithm uses the input + output to solve for the linear coefficients.
+    //    Once those coefficients are known, we then have a linear equation that we
+    //    we can pump new inputs into (e.g. mesh points, muscle points)
+    //
+    // 4. So, given the equation L * [w a] = [v o], where L is a matrix of linear terms,
+    //    [w a] is a vector of the linear coefficients (we're solving for these), and [v o]
+    //    is the expected output (v), with some (padding) zero elements (o)
+    //
+    // 5. Create matrix L:
+    //
+    //   |K  P|
+    //   |PT 0|
+    //
+    //     where:
+    //
+    //     - K is a symmetric matrix of each *input* landmark pair evaluated via the
+    //       basis function:
+    //
+    //        |U(p00) U(p01) U(p02)  ...  |
+    //        |U(p10) U(p11) U(p12)  ...  |
+    //        | ...    ...    ...   U(pnn)|
+    //
+    //     - P is a n-row (N+1)-column matrix containing the number 1 (the constant term),
+    //       x, y, etc. (effectively, the p term):
+    //
+    //       |1 x1 y1 ...|
+    //       |1 x2 y2 ...|
+    //
+    //     - PT is the transpose of P
+    //     - 0 is a (N+1)x(N+1) zero matrix (padding)
+    //
+    // 6. Use a linear solver to solve L * [w a] = [v o] to yield [w a] (see `TPSCoefficientSolver`)
+    //
+    // L only depends on the source landmarks
+    template<size_t N>
+    SimTK::Matrix CalcSystemMatrix(std::span<TPSLandmarkPair<N> const> landmarks)
+    {
+        int const numPairs = static_cast<int>(landmarks.size());
+        int const numAffineTerms = static_cast<int>(N) + 1;
+
+        SimTK::Matrix L(numPairs + numAffineTerms, numPairs + numAffineTerms);
+
+        // populate the K part of matrix L (upper-left)
+        for (int row = 0; row < numPairs; ++row)
+        {
+            for (int col = 0; col < numPairs; ++col)
+            {
+                L(row, col) = TPSRadialBasisFunction<N>(landmarks[row].source, landmarks[col].source);
+            }
+        }
+
+        // populate the P part (upper-right) and PT part (bottom-left) of matrix L
+        for (int i = 0; i < numPairs; ++i)
+        {
+            L(i, numPairs) = 1.0;
+            L(numPairs, i) = 1.0;
+            for (int dim = 0; dim < static_cast<int>(N); ++dim)
+            {
+                L(i, numPairs + 1 + dim) = landmarks[i].source[dim];
+                L(numPairs + 1 + dim, i) = landmarks[i].source[dim];
+            }
+        }
+
+        // populate the 0 part of matrix L (bottom-right)
+        for (int row = 0; row < numAffineTerms; ++row)
+        {
+            for (int col = 0; col < numAffineTerms; ++col)
+            {
+                L(numPairs + row, numPairs + col) = 0.0;
+            }
+        }
+
+        return L;
+    }
+}
+
+template<size_t N>
+class osc::TPSCoefficientSolver<N>::Impl final {
+public:
+    TPSCoefficients<N> solve(std::span<TPSLandmarkPair<N> const> landmarks)
+    {
+        OSC_PERF("TPSCoefficientSolver::solve");
+
+        int const numPairs = static_cast<int>(landmarks.size());
+        int const numRows = numPairs + static_cast<int>(N) + 1;
+
+        if (numPairs == 0)
+        {
+            // edge-case: there are no pairs, so return an identity-like transform
+            return TPSCoefficients<N>{};
+        }
+
+        // (re)factorize the system matrix, but only if the source landmarks changed
+        if (not hasFactorizationFor(landmarks))
+        {
+            m_Factorization = std::make_unique<SimTK::FactorQTZ>(CalcSystemMatrix<N>(landmarks));
+            m_FactorizedSources.clear();
+            m_FactorizedSources.reserve(landmarks.size());
+            for (TPSLandmarkPair<N> const& landmark : landmarks)
+            {
+                m_FactorizedSources.push_back(landmark.source);
+            }
+            ++m_NumFactorizations;
+        }
+
+        // solve `L*Cn = Vn` for `Cn` for each dimension `n`, where `Vn` holds the destinations
+        std::array<SimTK::Vector, N> coefficients;
+        for (size_t dim = 0; dim < N; ++dim)
+        {
+            SimTK::Vector V(numRows, 0.0);
+            for (int row = 0; row < numPairs; ++row)
+            {
+                V[row] = landmarks[row].destination[dim];
+            }
+            coefficients[dim] = SimTK::Vector(numRows, 0.0);
+            m_Factorization->solve(V, coefficients[dim]);
+        }
+
+        // each `Cn` now contains the solved coefficients, e.g. for X: [w1, w2, ... wx, a1x, a2x, ...]
+        //
+        // extract the coefficients into the return value
+        TPSCoefficients<N> rv;
+        for (size_t dim = 0; dim < N; ++dim)
+        {
+            SimTK::Vector const& C = coefficients[dim];
+            rv.a1[dim] = static_cast<float>(C[numPairs]);
+            for (size_t i = 0; i < N; ++i)
+            {
+                rv.linear[i][dim] = static_cast<float>(C[numPairs + 1 + static_cast<int>(i)]);
+            }
+        }
+        rv.nonAffineTerms.reserve(landmarks.size());
+        for (int i = 0; i < numPairs; ++i)
+        {
+            TPSNonAffineTerm<N>& term = rv.nonAffineTerms.emplace_back();
+            for (size_t dim = 0; dim < N; ++dim)
+            {
+                term.weight[dim] = static_cast<float>(coefficients[dim][i]);
+            }
+            term.controlPoint = landmarks[i].source;
+        }
+        return rv;
+    }
+
+    size_t getNumFactorizations() const
+    {
+        return m_NumFactorizations;
+    }
+
+private:
+    bool hasFactorizationFor(std::span<TPSLandmarkPair<N> const> landmarks) const
+    {
+        return
+            m_Factorization and
+            std::equal(
+                m_FactorizedSources.begin(),
+                m_FactorizedSources.end(),
+                landmarks.begin(),
+                landmarks.end(),
+                [](Vec<N, float> const& source, TPSLandmarkPair<N> const& landmark) { return source == landmark.source; }
+            );
+    }
+
+    std::vector<Vec<N, float>> m_FactorizedSources;
+    std::unique_ptr<SimTK::FactorQTZ> m_Factorization;
+    size_t m_NumFactorizations = 0;
+};
+
+template<size_t N>
+osc::TPSCoefficientSolver<N>::TPSCoefficientSolver() :
+    m_Impl{std::make_unique<Impl>()}
+{}
+template<size_t N>
+osc::TPSCoefficientSolver<N>::TPSCoefficientSolver(TPSCoefficientSolver&&) noexcept = default;
+template<size_t N>
+osc::TPSCoefficientSolver<N>& osc::TPSCoefficientSolver<N>::operator=(TPSCoefficientSolver&&) noexcept = default;
+template<size_t N>
+osc::TPSCoefficientSolver<N>::~TPSCoefficientSolver() noexcept = default;
+
+template<size_t N>
+TPSCoefficients<N> osc::TPSCoefficientSolver<N>::solve(std::span<TPSLandmarkPair<N> const> landmarks)
+{
+    return m_Impl->solve(landmarks);
+}
+
+template<size_t N>
+size_t osc::TPSCoefficientSolver<N>::getNumFactorizations() const
+{
+    return m_Impl->getNumFactorizations();
+}
+
+template<size_t N>
+TPSCoefficients<N> osc::CalcTPSCoefficients(std::span<TPSLandmarkPair<N> const> landmarks)
+{
+    return TPSCoefficientSolver<N>{}.solve(landmarks);
+}
+
+template<size_t N>
+Vec<N, float> osc::EvaluateTPSEquation(TPSCoefficients<N> const& coefs, std::type_identity_t<Vec<N, float>> p)
+{
+    return EvaluateTPSEquation<N>(coefs.a1, coefs.linear, coefs.nonAffineTerms, p);
+}
+
+template<size_t N>
+Vec<N, float> osc::EvaluateTPSEquation(
+    Vec<N, float> const& a1,
+    std::array<Vec<N, float>, N> const& linear,
+    std::span<TPSNonAffineTerm<N> const> nonAffineTerms,
+    std::type_identity_t<Vec<N, float>> p)
+{
+    // this implementation evaluates `fx(p)`, `fy(p)` (etc.) at the same time, because
+    // the per-dimension variants of each coefficient are stored together in memory (as `Vec`s)
+
+    // compute affine terms (a1 + a2*p[0] + a3*p[1] + ...)
+    Vec<N, double> rv{a1};
+    for (size_t i = 0; i < N; ++i)
+    {
+        rv += Vec<N, double>{linear[i] * p[i]};
+    }
+
+    // accumulate non-affine terms (effectively: wi * U(||controlPoint - p||))
+    for (TPSNonAffineTerm<N> const& term : nonAffineTerms)
+    {
+        rv += term.weight * TPSRadialBasisFunction<N>(term.controlPoint, p);
+    }
+
+    return Vec<N, float>{rv};
+}
+
+template<size_t N>
+void osc::ApplyTPSWarpToPointsInPlace(
+    TPSCoefficients<N> const& coefs,
+    std::type_identity_t<std::span<Vec<N, float>>> points,
+    float blendingFactor)
+{
+    ApplyTPSWarpToPointsInPlace<N>(coefs, StridedSpan<Vec<N, float>>{points}, blendingFactor);
+}
+
+template<size_t N>
+void osc::ApplyTPSWarpToPointsInPlace(
+    TPSCoefficients<N> const& coefs,
+    std::type_identity_t<StridedSpan<Vec<N, float>>> points,
+    float blendingFactor)
+{
+    OSC_PERF("ApplyTPSWarpToPointsInPlace");
+    for_each_parallel_unsequenced(8192, points, [&coefs, blendingFactor](Vec<N, float>& point)
+    {
+        point = lerp(point, EvaluateTPSEquation(coefs, point), blendingFactor);
+    });
+}
+
+template<size_t N>
+Mesh osc::ApplyTPSWarpToMesh(TPSCoefficients<N> const& coefs, Mesh const& mesh, float blendingFactor)
+{
+    OSC_PERF("ApplyTPSWarpToMesh");
+
+    Mesh rv = mesh;
+    rv.modify_vertices([&coefs, blendingFactor](StridedSpan<Vec3> vertices)
+    {
+        if constexpr (N == 3)
+        {
+            ApplyTPSWarpToPointsInPlace(coefs, vertices, blendingFactor);
+        }
+        else
+        {
+            for_each_parallel_unsequenced(8192, vertices, [&coefs, blendingFactor](Vec3& vertex)
+            {
+                Vec2 const p{vertex};
+                vertex = Vec3{lerp(p, EvaluateTPSEquation(coefs, p), blendingFactor), vertex.z};
+            });
+        }
+    });
+    return rv;
+}
+
+// explicit instantiations
+template class osc::TPSCoefficientSolver<2>;
+template class osc::TPSCoefficientSolver<3>;
+template TPSCoefficients<2> osc::CalcTPSCoefficients<2>(std::span<TPSLandmarkPair<2> const>);
+template TPSCoefficients<3> osc::CalcTPSCoefficients<3>(std::span<TPSLandmarkPair<3> const>);
+template Vec2 osc::EvaluateTPSEquation<2>(TPSCoefficients<2> const&, Vec2);
+template Vec3 osc::EvaluateTPSEquation<3>(TPSCoefficients<3> const&, Vec3);
+template Vec2 osc::EvaluateTPSEquation<2>(Vec2 const&, std::array<Vec2, 2> const&, std::span<TPSNonAffineTerm<2> const>, Vec2);
+template Vec3 osc::EvaluateTPSEquation<3>(Vec3 const&, std::array<Vec3, 3> const&, std::span<TPSNonAffineTerm<3> const>, Vec3);
+template void osc::ApplyTPSWarpToPointsInPlace<2>(TPSCoefficients<2> const&, std::span<Vec2>, float);
+template void osc::ApplyTPSWarpToPointsInPlace<3>(TPSCoefficients<3> const&, std::span<Vec3>, float);
+template void osc::ApplyTPSWarpToPointsInPlace<2>(TPSCoefficients<2> const&, StridedSpan<Vec2>, float);
+template void osc::ApplyTPSWarpToPointsInPlace<3>(TPSCoefficients<3> const&, StridedSpan<Vec3>, float);
+template Mesh osc::ApplyTPSWarpToMesh<2>(TPSCoefficients<2> const&, Mesh const&, float);
+template Mesh osc::ApplyTPSWarpToMesh<3>(TPSCoefficients<3> const&, Mesh const&, float);
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <oscar/Graphics/Mesh.h>
+#include <oscar/Maths/Vec.h>
+#include <oscar/Maths/Vec2.h>
+#include <oscar/Maths/Vec3.h>
+#include <oscar/Utils/StridedSpan.h>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+// dimension-generic TPS algorithm code
+//
+// this is a generalization of the algorithm in `TPS3D.h` (see there for background and
+// references), which supports the 2D and 3D variants of the algorithm through one shared
+// solver and evaluator. The only dimension-specific part of the algorithm is the radial
+// basis function (see `TPSRadialBasisFunction`)
+//
+// the templates are explicitly instantiated (in `TPS.cpp`) for `N == 2` and `N == 3`
+namespace osc
+{
+    // a single source-to-destination landmark pair in `N`-dimensional space
+    template<size_t N>
+    struct TPSLandmarkPair final {
+        static_assert(N == 2 or N == 3, "only 2D and 3D TPS is supported");
+
+        friend bool operator==(TPSLandmarkPair const&, TPSLandmarkPair const&) = default;
+
+        Vec<N, float> source{};
+        Vec<N, float> destination{};
+    };
+
+    // a single non-affine term of the `N`-dimensional TPS equation
+    //
+    // i.e. in `f(p) = a1 + SUM{ ai * p[i] } + SUM{ wi * U(||controlPoint - p||) }` this
+    //      encodes the `wi` and `controlPoint` parts of that equation
+    template<size_t N>
+    struct TPSNonAffineTerm final {
+
+        TPSNonAffineTerm() = default;
+
+        TPSNonAffineTerm(
+            Vec<N, float> const& weight_,
+            Vec<N, float> const& controlPoint_) :
+
+            weight{weight_},
+            controlPoint{controlPoint_}
+        {}
+
+        friend bool operator==(TPSNonAffineTerm const&, TPSNonAffineTerm const&) = default;
+
+        Vec<N, float> weight{};
+        Vec<N, float> controlPoint{};
+    };
+
+    // all coefficients in the `N`-dimensional TPS equation
+    //
+    // i.e. `a1` is the constant term, `linear[i]` is the coefficient of `p[i]`, and
+    // `nonAffineTerms` are the w's (+ control points)
+    template<size_t N>
+    struct TPSCoefficients final {
+
+        friend bool operator==(TPSCoefficients const&, TPSCoefficients const&) = default;
+
+        // default the coefficients to an "identity" warp
+        Vec<N, float> a1{};
+        std::array<Vec<N, float>, N> linear = []()
+        {
+            std::array<Vec<N, float>, N> rv{};
+            for (size_t i = 0; i < N; ++i) {
+                rv[i][i] = 1.0f;
+            }
+            return rv;
+        }();
+        std::vector<TPSNonAffineTerm<N>> nonAffineTerms;
+    };
+
+    // returns `U(||controlPoint - p||)`, the radial basis function term of the TPS equation
+    //
+    // - in 2D, this is Bookstein's original `U(r) = r^2 * log(r^2)`
+    // - in 3D, this is `U(r) = r` (see `TPS.cpp` for why)
+    template<size_t N>
+    float TPSRadialBasisFunction(Vec<N, float> const& controlPoint, Vec<N, float> const& p);
+
+    template<>
+    float TPSRadialBasisFunction<2>(Vec2 const& controlPoint, Vec2 const& p);
+
+    template<>
+    float TPSRadialBasisFunction<3>(Vec3 const& controlPoint, Vec3 const& p);
+
+    // a solver for the coefficients of the `N`-dimensional TPS equation
+    //
+    // the (expensive) factorization of the TPS system matrix only depends on the source
+    // landmarks, so the solver caches it: re-solving for landmarks with the same sources,
+    // but different destinations, (e.g. because the user is dragging a destination landmark)
+    // only costs an O(N^2) back-substitution, rather than an O(N^3) refactorization
+    template<size_t N>
+    class TPSCoefficientSolver final {
+    public:
+        TPSCoefficientSolver();
+        TPSCoefficientSolver(TPSCoefficientSolver const&) = delete;
+        TPSCoefficientSolver(TPSCoefficientSolver&&) noexcept;
+        TPSCoefficientSolver& operator=(TPSCoefficientSolver const&) = delete;
+        TPSCoefficientSolver& operator=(TPSCoefficientSolver&&) noexcept;
+        ~TPSCoefficientSolver() noexcept;
+
+        // computes all coefficients of the TPS equation (a1, the linear terms, and all the w's)
+        TPSCoefficients<N> solve(std::span<TPSLandmarkPair<N> const>);
+
+        // returns the number of times the solver has factorized a system matrix (handy for testing
+        // and performance measurement)
+        size_t getNumFactorizations() const;
+
+    private:
+        class Impl;
+        std::unique_ptr<Impl> m_Impl;
+    };
+
+    // computes all coefficients of the TPS equation (a1, the linear terms, and all the w's)
+    //
+    // (uncached: prefer using a `TPSCoefficientSolver` when solving repeatedly)
+    template<size_t N>
+    TPSCoefficients<N> CalcTPSCoefficients(std::span<TPSLandmarkPair<N> const>);
+
+    // evaluates the TPS equation with the given coefficients and input point
+    template<size_t N>
+    Vec<N, float> EvaluateTPSEquation(TPSCoefficients<N> const&, std::type_identity_t<Vec<N, float>>);
+
+    // evaluates the TPS equation with the given (separately-stored) coefficients and input point
+    //
+    // (handy for callers that don't store their coefficients in a `TPSCoefficients<N>`)
+    template<size_t N>
+    Vec<N, float> EvaluateTPSEquation(
+        Vec<N, float> const& a1,
+        std::array<Vec<N, float>, N> const& linear,
+        std::span<TPSNonAffineTerm<N> const> nonAffineTerms,
+        std::type_identity_t<Vec<N, float>>
+    );
+
+    // evaluates the TPS equation for each point in-place, blended by `blendingFactor`, in parallel
+    template<size_t N>
+    void ApplyTPSWarpToPointsInPlace(TPSCoefficients<N> const&, std::type_identity_t<std::span<Vec<N, float>>>, float blendingFactor);
+
+    template<size_t N>
+    void ApplyTPSWarpToPointsInPlace(TPSCoefficients<N> const&, std::type_identity_t<StridedSpan<Vec<N, float>>>, float blendingFactor);
+
+    // returns a mesh that is the equivalent of applying the TPS warp to each vertex of the mesh,
+    // which is done in parallel
+    //
+    // the 2D warp only warps the X and Y components of each vertex (i.e. it warps the mesh in
+    // the XY plane and leaves Z as-is)
+    template<size_t N>
+    Mesh ApplyTPSWarpToMesh(TPSCoefficients<N> const&, Mesh const&, float blendingFactor);
+}
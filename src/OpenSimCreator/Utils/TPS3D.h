@@ -1,9 +1,11 @@
 #pragma once
 
 #include <OpenSimCreator/Utils/LandmarkPair3D.h>
+#include <OpenSimCreator/Utils/TPS.h>
 
 #include <oscar/Graphics/Mesh.h>
 #include <oscar/Maths/Vec3.h>
+#include <oscar/Utils/StridedSpan.h>
 
 #include <iosfwd>
 #include <span>
@@ -12,6 +14,8 @@
 
 // core 3D TPS algorithm code
 //
+// this is a 3D-specific API that's implemented with the dimension-generic code in `TPS.h`
+//
 // most of the background behind this is discussed in issue #467. For redundancy's sake, here
 // are some of the references used to write this implementation:
 //
@@ -42,21 +46,7 @@ namespace osc
     //
     // i.e. in `f(p) = a1 + a2*p.x + a3*p.y + a4*p.z + SUM{ wi * U(||controlPoint - p||) }` this encodes
     //      the `wi` and `controlPoint` parts of that equation
-    struct TPSNonAffineTerm3D final {
-
-        TPSNonAffineTerm3D(
-            Vec3 const& weight_,
-            Vec3 const& controlPoint_) :
-
-            weight{weight_},
-            controlPoint{controlPoint_}
-        {}
-
-        friend bool operator==(TPSNonAffineTerm3D const&, TPSNonAffineTerm3D const&) = default;
-
-        Vec3 weight;
-        Vec3 controlPoint;
-    };
+    using TPSNonAffineTerm3D = TPSNonAffineTerm<3>;
 
     std::ostream& operator<<(std::ostream&, TPSNonAffineTerm3D const&);
 
@@ -79,6 +69,10 @@ namespace osc
     // computes all coefficients of the 3D TPS equation (a1, a2, a3, a4, and all the w's)
     TPSCoefficients3D CalcCoefficients(TPSCoefficientSolverInputs3D const&);
 
+    // computes all coefficients of the 3D TPS equation via the given solver, which reuses its
+    // cached factorization if only the destination landmarks changed since its last solve
+    TPSCoefficients3D CalcCoefficients(TPSCoefficientSolverInputs3D const&, TPSCoefficientSolver<3>&);
+
     // evaluates the TPS equation with the given coefficients and input point
     Vec3 EvaluateTPSEquation(TPSCoefficients3D const&, Vec3);
 
@@ -90,4 +84,5 @@ namespace osc
 
     // applies the 3D TPS warp in-place to each SimTK::Vec3 in the provided span
     void ApplyThinPlateWarpToPointsInPlace(TPSCoefficients3D const&, std::span<Vec3>, float blendingFactor);
+    void ApplyThinPlateWarpToPointsInPlace(TPSCoefficients3D const&, StridedSpan<Vec3>, float blendingFactor);
 }
@@ -0,0 +1,396 @@
+#include "TPSFarFieldEvaluator3D.h"
+
+#include <OpenSimCreator/Utils/TPS3D.h>
+
+#include <oscar/Graphics/Mesh.h>
+#include <oscar/Maths/AABB.h>
+#include <oscar/Maths/AABBFunctions.h>
+#include <oscar/Maths/CommonFunctions.h>
+#include <oscar/Maths/GeometricFunctions.h>
+#include <oscar/Maths/Vec3.h>
+#include <oscar/Utils/ParalellizationHelpers.h>
+#include <oscar/Utils/Perf.h>
+#include <oscar/Utils/StridedSpan.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+using namespace osc;
+namespace rgs = std::ranges;
+
+namespace
+{
+    // clusters with this many (or fewer) terms aren't subdivided further
+    //
+    // (approximating a small cluster is barely cheaper than evaluating its terms exactly)
+    constexpr size_t c_MaxTermsPerLeaf = 32;
+
+    // clusters at this depth aren't subdivided further (e.g. because of many coincident control points)
+    constexpr size_t c_MaxDepth = 24;
+
+    // a bound on the magnitude of the third directional derivative of `U(x) = |x|` (scaled by
+    // |x|^2), divided by 3! (see: Lagrange remainder of a second-order Taylor expansion)
+    //
+    // i.e. if `g(t) = |d - t*delta|`, then `|g'''(t)| <= (2/sqrt(3)) * |delta|^3 / |d - t*delta|^2`
+    const double c_TruncationErrorConstant = 1.0 / (3.0 * std::sqrt(3.0));
+
+    // a cluster of non-affine terms (i.e. an octree node)
+    //
+    // only contains the data that's necessary to traverse the octree, so that traversal
+    // touches as little memory as possible
+    struct Cluster final {
+        Vec3 center;
+        float minSquaredApproximationDistance;
+        uint32_t firstTerm;
+        uint32_t numTerms;
+        uint32_t firstChild;
+        uint32_t numChildren;  // 0 == leaf
+    };
+
+    // the multipole moments of a cluster of non-affine terms
+    //
+    // the terms' contribution to the TPS equation can be approximated at a point `p` that's far
+    // away from the cluster via a second-order multipole expansion of `SUM{ wi * |p - ci| }`
+    // around the cluster's center `c`:
+    //
+    //     with d = p - c, dhat = d/|d|, and deltai = ci - c
+    //
+    //     SUM{ wi * |d - deltai| } ~= W*|d| - SUM_j{ dhat_j * M1_j } + (trace(M2) - dhat^T*M2*dhat) / (2*|d|)
+    //
+    //     where W = SUM{ wi }, M1_j = SUM{ wi * deltai_j }, and M2_jk = SUM{ wi * deltai_j * deltai_k }
+    struct ClusterMoments final {
+        Vec3d w{};
+        std::array<Vec3d, 3> m1{};  // x, y, z
+        std::array<Vec3d, 6> m2{};  // xx, yy, zz, xy, xz, yz
+    };
+
+    Vec3d EvaluateMultipoleExpansion(ClusterMoments const& moments, Vec3d const& d, double distance)
+    {
+        Vec3d const dhat = d / distance;
+
+        Vec3d rv = distance * moments.w;
+        rv -= dhat.x*moments.m1[0] + dhat.y*moments.m1[1] + dhat.z*moments.m1[2];
+
+        Vec3d const trace = moments.m2[0] + moments.m2[1] + moments.m2[2];
+        Vec3d const quadratic =
+            (dhat.x*dhat.x)*moments.m2[0] +
+            (dhat.y*dhat.y)*moments.m2[1] +
+            (dhat.z*dhat.z)*moments.m2[2] +
+            (2.0*dhat.x*dhat.y)*moments.m2[3] +
+            (2.0*dhat.x*dhat.z)*moments.m2[4] +
+            (2.0*dhat.y*dhat.z)*moments.m2[5];
+        rv += (trace - quadratic) / (2.0*distance);
+
+        return rv;
+    }
+
+    // returns the index (0-7) of the octant of `aabb` that `p` is in
+    size_t OctantIndex(AABB const& aabb, Vec3 const& p)
+    {
+        Vec3 const mid = centroid_of(aabb);
+        return (p.x > mid.x ? 1 : 0) | (p.y > mid.y ? 2 : 0) | (p.z > mid.z ? 4 : 0);
+    }
+
+    double WeightMagnitude(TPSNonAffineTerm3D const& term)
+    {
+        Vec3d const w{term.weight};
+        return std::sqrt(dot(w, w));
+    }
+}
+
+class osc::TPSFarFieldEvaluator3D::Impl final {
+public:
+    Impl(TPSCoefficients3D const& coefs, float errorTolerance, TPSFarFieldErrorBudget errorBudget) :
+        m_Affine{coefs.a1, coefs.a2, coefs.a3, coefs.a4},
+        m_Terms{coefs.nonAffineTerms},
+        m_ErrorTolerance{errorTolerance},
+        m_ErrorBudget{errorBudget}
+    {
+        OSC_PERF("TPSFarFieldEvaluator3D/build");
+
+        if (m_Terms.empty())
+        {
+            return;
+        }
+
+        for (TPSNonAffineTerm3D const& term : m_Terms)
+        {
+            m_SumOfWeightMagnitudes += WeightMagnitude(term);
+        }
+
+        m_Clusters.emplace_back();
+        m_Moments.emplace_back();
+        buildCluster(0, 0, m_Terms.size(), 0);
+    }
+
+    float getErrorTolerance() const
+    {
+        return m_ErrorTolerance;
+    }
+
+    TPSFarFieldErrorBudget getErrorBudget() const
+    {
+        return m_ErrorBudget;
+    }
+
+    size_t getNumClusters() const
+    {
+        return m_Clusters.size();
+    }
+
+    // (`stats`, if provided, is updated with how the point was evaluated)
+    Vec3 evaluate(Vec3 p, EvaluationStats* stats = nullptr) const
+    {
+        // compute affine terms (a1 + a2*x + a3*y + a4*z), like `EvaluateTPSEquation`
+        Vec3d rv = Vec3d{m_Affine[0]} + Vec3d{m_Affine[1]*p.x} + Vec3d{m_Affine[2]*p.y} + Vec3d{m_Affine[3]*p.z};
+
+        if (m_Clusters.empty())
+        {
+            return rv;
+        }
+
+        // accumulate non-affine terms by traversing the cluster tree
+        std::array<uint32_t, 7*c_MaxDepth + 1> stack;  // (each level of a depth-first traversal leaves <= 7 siblings on the stack)
+        size_t stackSize = 0;
+        stack[stackSize++] = 0;
+        while (stackSize > 0)
+        {
+            uint32_t const clusterIndex = stack[--stackSize];
+            Cluster const& cluster = m_Clusters[clusterIndex];
+            Vec3 const d = p - cluster.center;
+            float const squaredDistance = dot(d, d);
+
+            if (squaredDistance > cluster.minSquaredApproximationDistance and squaredDistance > 0.0f)
+            {
+                Vec3d const dd{d};
+                rv += EvaluateMultipoleExpansion(m_Moments[clusterIndex], dd, std::sqrt(dot(dd, dd)));
+                if (stats)
+                {
+                    ++stats->numApproximatedClusters;
+                }
+            }
+            else if (cluster.numChildren == 0)
+            {
+                if (stats)
+                {
+                    stats->numExactlyEvaluatedTerms += cluster.numTerms;
+                }
+                for (uint32_t i = cluster.firstTerm; i < cluster.firstTerm + cluster.numTerms; ++i)
+                {
+                    rv += m_Terms[i].weight * length(m_Terms[i].controlPoint - p);
+                }
+            }
+            else
+            {
+                for (uint32_t i = 0; i < cluster.numChildren; ++i)
+                {
+                    stack[stackSize++] = cluster.firstChild + i;
+                }
+            }
+        }
+
+        return rv;
+    }
+
+private:
+    void buildCluster(size_t clusterIndex, size_t firstTerm, size_t numTerms, size_t depth)
+    {
+        std::span<TPSNonAffineTerm3D> const terms{m_Terms.data() + firstTerm, numTerms};
+
+        // compute the cluster's center, radius, and multipole moments
+        Vec3d centroid{};
+        AABB bounds = bounding_aabb_of(terms.front().controlPoint);
+        for (TPSNonAffineTerm3D const& term : terms)
+        {
+            centroid += Vec3d{term.controlPoint};
+            bounds = bounding_aabb_of(bounds, term.controlPoint);
+        }
+        Vec3 const center{centroid / static_cast<double>(numTerms)};
+
+        ClusterMoments moments;
+        double radius = 0.0;
+        double sumOfWeightMagnitudes = 0.0;
+        for (TPSNonAffineTerm3D const& term : terms)
+        {
+            Vec3d const w{term.weight};
+            Vec3d const delta = Vec3d{term.controlPoint} - Vec3d{center};
+
+            moments.w += w;
+            moments.m1[0] += delta.x * w;
+            moments.m1[1] += delta.y * w;
+            moments.m1[2] += delta.z * w;
+            moments.m2[0] += (delta.x*delta.x) * w;
+            moments.m2[1] += (delta.y*delta.y) * w;
+            moments.m2[2] += (delta.z*delta.z) * w;
+            moments.m2[3] += (delta.x*delta.y) * w;
+            moments.m2[4] += (delta.x*delta.z) * w;
+            moments.m2[5] += (delta.y*delta.z) * w;
+
+            radius = max(radius, std::sqrt(dot(delta, delta)));
+            sumOfWeightMagnitudes += WeightMagnitude(term);
+        }
+
+        // the truncation error of approximating the cluster at distance `D` from its center is at most
+        //
+        //     errorBound(D) = SUM{ |wi| } * c * radius^3 / (D - radius)^2
+        //
+        // the cluster is approximated when `errorBound(D)` is within the cluster's share of `errorTolerance`:
+        //
+        // - `RootSumSquare`: `errorTolerance * sqrt(SUM{ |wi| } / SUM_all{ |wi| })`, which ensures that the
+        //   root-sum-square of the error bounds of all clusters that are approximated at a point is at most
+        //   `errorTolerance`
+        //
+        // - `Strict`: `errorTolerance * SUM{ |wi| } / SUM_all{ |wi| }`, which ensures that the sum of the
+        //   error bounds of all clusters that are approximated at a point (which are disjoint) is at most
+        //   `errorTolerance`
+        double minSquaredApproximationDistance = std::numeric_limits<double>::infinity();
+        if (radius == 0.0)
+        {
+            minSquaredApproximationDistance = 0.0;  // the expansion is exact (coincident control points)
+        }
+        else if (m_ErrorTolerance > 0.0f)
+        {
+            double const weightMagnitudes = m_ErrorBudget == TPSFarFieldErrorBudget::Strict ?
+                m_SumOfWeightMagnitudes :
+                std::sqrt(sumOfWeightMagnitudes * m_SumOfWeightMagnitudes);
+            double const k = c_TruncationErrorConstant * weightMagnitudes / static_cast<double>(m_ErrorTolerance);
+            double const minDistance = radius + std::sqrt(k * radius * radius * radius);
+            minSquaredApproximationDistance = minDistance * minDistance;
+        }
+
+        Cluster cluster{
+            .center = center,
+            .minSquaredApproximationDistance = static_cast<float>(minSquaredApproximationDistance),
+            .firstTerm = static_cast<uint32_t>(firstTerm),
+            .numTerms = static_cast<uint32_t>(numTerms),
+            .firstChild = 0,
+            .numChildren = 0,
+        };
+        m_Moments[clusterIndex] = moments;
+
+        // subdivide the cluster into (non-empty) octants, if necessary
+        bool const isLeaf =
+            numTerms <= c_MaxTermsPerLeaf or
+            depth >= c_MaxDepth or
+            radius == 0.0;
+
+        if (isLeaf)
+        {
+            m_Clusters[clusterIndex] = cluster;
+            return;
+        }
+
+        std::array<std::vector<TPSNonAffineTerm3D>, 8> octants;
+        for (TPSNonAffineTerm3D const& term : terms)
+        {
+            octants[OctantIndex(bounds, term.controlPoint)].push_back(term);
+        }
+
+        size_t offset = firstTerm;
+        std::array<std::pair<size_t, size_t>, 8> childRanges{};
+        size_t numChildren = 0;
+        for (auto const& octant : octants)
+        {
+            if (not octant.empty())
+            {
+                rgs::copy(octant, m_Terms.begin() + static_cast<ptrdiff_t>(offset));
+                childRanges[numChildren++] = {offset, octant.size()};
+                offset += octant.size();
+            }
+        }
+
+        cluster.firstChild = static_cast<uint32_t>(m_Clusters.size());
+        cluster.numChildren = static_cast<uint32_t>(numChildren);
+        m_Clusters[clusterIndex] = cluster;
+        m_Clusters.resize(m_Clusters.size() + numChildren);
+        m_Moments.resize(m_Moments.size() + numChildren);
+
+        for (size_t i = 0; i < numChildren; ++i)
+        {
+            buildCluster(cluster.firstChild + i, childRanges[i].first, childRanges[i].second, depth + 1);
+        }
+    }
+
+    std::array<Vec3, 4> m_Affine;
+    std::vector<TPSNonAffineTerm3D> m_Terms;  // reordered, so that each cluster's terms are contiguous
+    std::vector<Cluster> m_Clusters;  // `m_Clusters[0]` is the root (if there are any terms)
+    std::vector<ClusterMoments> m_Moments;  // `m_Moments[i]` contains the moments of `m_Clusters[i]`
+    float m_ErrorTolerance;
+    TPSFarFieldErrorBudget m_ErrorBudget;
+    double m_SumOfWeightMagnitudes = 0.0;
+};
+
+
+// public API (PIMPL)
+
+osc::TPSFarFieldEvaluator3D::TPSFarFieldEvaluator3D(
+    TPSCoefficients3D const& coefs,
+    float errorTolerance,
+    TPSFarFieldErrorBudget errorBudget) :
+
+    m_Impl{std::make_unique<Impl>(coefs, errorTolerance, errorBudget)}
+{}
+osc::TPSFarFieldEvaluator3D::TPSFarFieldEvaluator3D(TPSFarFieldEvaluator3D&&) noexcept = default;
+osc::TPSFarFieldEvaluator3D& osc::TPSFarFieldEvaluator3D::operator=(TPSFarFieldEvaluator3D&&) noexcept = default;
+osc::TPSFarFieldEvaluator3D::~TPSFarFieldEvaluator3D() noexcept = default;
+
+float osc::TPSFarFieldEvaluator3D::getErrorTolerance() const
+{
+    return m_Impl->getErrorTolerance();
+}
+
+TPSFarFieldErrorBudget osc::TPSFarFieldEvaluator3D::getErrorBudget() const
+{
+    return m_Impl->getErrorBudget();
+}
+
+size_t osc::TPSFarFieldEvaluator3D::getNumClusters() const
+{
+    return m_Impl->getNumClusters();
+}
+
+Vec3 osc::TPSFarFieldEvaluator3D::evaluate(Vec3 p) const
+{
+    return m_Impl->evaluate(p);
+}
+
+TPSFarFieldEvaluator3D::EvaluationStats osc::TPSFarFieldEvaluator3D::calcEvaluationStats(Vec3 p) const
+{
+    EvaluationStats rv;
+    m_Impl->evaluate(p, &rv);
+    return rv;
+}
+
+void osc::TPSFarFieldEvaluator3D::applyWarpToPointsInPlace(std::span<Vec3> points, float blendingFactor) const
+{
+    applyWarpToPointsInPlace(StridedSpan<Vec3>{points}, blendingFactor);
+}
+
+void osc::TPSFarFieldEvaluator3D::applyWarpToPointsInPlace(StridedSpan<Vec3> points, float blendingFactor) const
+{
+    OSC_PERF("TPSFarFieldEvaluator3D::applyWarpToPointsInPlace");
+    for_each_parallel_unsequenced(8192, points, [this, blendingFactor](Vec3& point)
+    {
+        point = lerp(point, evaluate(point), blendingFactor);
+    });
+}
+
+Mesh osc::TPSFarFieldEvaluator3D::applyWarpToMesh(Mesh const& mesh, float blendingFactor) const
+{
+    OSC_PERF("TPSFarFieldEvaluator3D::applyWarpToMesh");
+
+    Mesh rv = mesh;
+    rv.modify_vertices([this, blendingFactor](StridedSpan<Vec3> vertices)
+    {
+        applyWarpToPointsInPlace(vertices, blendingFactor);
+    });
+    return rv;
+}
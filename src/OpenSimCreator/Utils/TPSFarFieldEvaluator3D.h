@@ -0,0 +1,92 @@
+#pragma once
+
+#include <OpenSimCreator/Utils/TPS3D.h>
+
+#include <oscar/Graphics/Mesh.h>
+#include <oscar/Maths/Vec3.h>
+#include <oscar/Utils/StridedSpan.h>
+
+#include <cstddef>
+#include <memory>
+#include <span>
+
+namespace osc
+{
+    // how a `TPSFarFieldEvaluator3D` shares its `errorTolerance` between the clusters that it
+    // approximates at a point
+    enum class TPSFarFieldErrorBudget {
+
+        // the shares are chosen such that the root-sum-square of the error bounds of all of the
+        // clusters that are approximated at a point is at most `errorTolerance`, because the clusters'
+        // errors tend to cancel, rather than accumulate. So `errorTolerance` isn't a hard bound on
+        // the Euclidean distance between the approximate and exact result but, in practice (see the
+        // tests/benchmarks), the measured distance is well within it
+        RootSumSquare,
+
+        // each cluster's share is proportional to its fraction of the sum of all weight magnitudes,
+        // so the sum of the error bounds of all of the clusters that are approximated at a point is
+        // at most `errorTolerance`. This makes `errorTolerance` a hard (worst-case) bound, at the
+        // cost of approximating fewer clusters
+        Strict,
+
+        Default = RootSumSquare,
+    };
+
+    // a fast, approximate, evaluator for the 3D TPS equation
+    //
+    // evaluating the TPS equation exactly (`EvaluateTPSEquation`) costs O(landmarks) per point,
+    // which is slow when warping dense meshes with dense (e.g. semi-landmark) landmark sets. This
+    // evaluator instead clusters the non-affine terms' control points into an octree and, Barnes-Hut
+    // style, evaluates the terms in each far-away cluster via a second-order multipole expansion
+    // of `U(r) = r` around the cluster's center
+    //
+    // `errorTolerance` controls the accuracy/speed tradeoff: a cluster is only approximated when
+    // a (conservative) bound on its truncation error fits within its share of `errorTolerance` (see
+    // `TPSFarFieldErrorBudget`). An `errorTolerance` of zero only approximates clusters where the
+    // expansion is exact
+    //
+    // the speedup depends on the number of landmarks and `errorTolerance`: it's only worth using
+    // for large (e.g. thousands of) landmarks where some error is acceptable
+    class TPSFarFieldEvaluator3D final {
+    public:
+        TPSFarFieldEvaluator3D(
+            TPSCoefficients3D const&,
+            float errorTolerance,
+            TPSFarFieldErrorBudget = TPSFarFieldErrorBudget::Default
+        );
+        TPSFarFieldEvaluator3D(TPSFarFieldEvaluator3D const&) = delete;
+        TPSFarFieldEvaluator3D(TPSFarFieldEvaluator3D&&) noexcept;
+        TPSFarFieldEvaluator3D& operator=(TPSFarFieldEvaluator3D const&) = delete;
+        TPSFarFieldEvaluator3D& operator=(TPSFarFieldEvaluator3D&&) noexcept;
+        ~TPSFarFieldEvaluator3D() noexcept;
+
+        float getErrorTolerance() const;
+        TPSFarFieldErrorBudget getErrorBudget() const;
+
+        // returns the number of clusters (octree nodes) that the control points were clustered into
+        size_t getNumClusters() const;
+
+        // approximately evaluates the TPS equation at the given point
+        Vec3 evaluate(Vec3) const;
+
+        struct EvaluationStats final {
+            size_t numApproximatedClusters = 0;   // clusters evaluated via their multipole expansion
+            size_t numExactlyEvaluatedTerms = 0;  // non-affine terms evaluated exactly
+        };
+
+        // returns how `evaluate` evaluates the TPS equation at the given point (handy for testing
+        // and measuring how much work the approximation saves)
+        EvaluationStats calcEvaluationStats(Vec3) const;
+
+        // approximately applies the 3D TPS warp in-place to each point, in parallel
+        void applyWarpToPointsInPlace(std::span<Vec3>, float blendingFactor) const;
+        void applyWarpToPointsInPlace(StridedSpan<Vec3>, float blendingFactor) const;
+
+        // returns a mesh that is the equivalent of approximately applying the 3D TPS warp to the mesh
+        Mesh applyWarpToMesh(Mesh const&, float blendingFactor) const;
+
+    private:
+        class Impl;
+        std::unique_ptr<Impl> m_Impl;
+    };
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <oscar/Formats/BinaryColumns.h>
 #include <oscar/Formats/CSV.h>
 #include <oscar/Formats/DAE.h>
 #include <oscar/Formats/Image.h>
@@ -0,0 +1,416 @@
+#include "BinaryColumns.h"
+
+#include <oscar/Maths/Vec2.h>
+#include <oscar/Shims/Cpp20/bit.h>
+#include <oscar/Utils/Assertions.h>
+#include <oscar/Utils/EnumHelpers.h>
+#include <oscar/Utils/StdVariantHelpers.h>
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    constexpr std::string_view c_magic = "OSCBCOLS";
+    constexpr uint16_t c_version = 1;
+
+    // column names are short labels, so anything longer than this is treated as corruption
+    constexpr uint32_t c_max_name_size = 1<<16;
+
+    // sizes in the data are untrusted, so payloads are read (and allocated) in blocks of at
+    // most this size, so that a corrupt size can't make the reader allocate much more memory
+    // than there is data
+    constexpr size_t c_read_block_size = 1<<20;
+
+    // the most that run-length-encoding can expand its input by (2 bytes --> 130 bytes)
+    constexpr size_t c_max_rle_expansion = 65;
+
+    enum class ChunkEncoding : uint8_t {
+        Raw,
+        XorDeltaRLE,
+        NUM_OPTIONS,
+    };
+
+    constexpr auto c_bytes_per_row = std::to_array<size_t>({
+        4,  // Float
+        8,  // Vec2
+        8,  // Double
+    });
+    static_assert(c_bytes_per_row.size() == num_options<BinaryColumnType>());
+
+    size_t bytes_per_row(BinaryColumnType type)
+    {
+        return c_bytes_per_row.at(to_index(type));
+    }
+
+    template<std::unsigned_integral T>
+    void write_le(std::ostream& out, T v)
+    {
+        std::array<char, sizeof(T)> bytes{};
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            bytes[i] = static_cast<char>((v >> (8*i)) & 0xff);
+        }
+        out.write(bytes.data(), bytes.size());
+    }
+
+    template<std::unsigned_integral T>
+    void append_le(std::vector<uint8_t>& out, T v)
+    {
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            out.push_back(static_cast<uint8_t>((v >> (8*i)) & 0xff));
+        }
+    }
+
+    void read_exactly(std::istream& in, void* dest, size_t num_bytes)
+    {
+        in.read(static_cast<char*>(dest), static_cast<std::streamsize>(num_bytes));
+        if (static_cast<size_t>(in.gcount()) != num_bytes) {
+            throw std::runtime_error{"binary columns: unexpected end of data"};
+        }
+    }
+
+    // reads exactly `num_bytes` into `out`, growing it as the data arrives
+    void read_exactly_into(std::istream& in, std::vector<uint8_t>& out, size_t num_bytes)
+    {
+        out.clear();
+        while (out.size() < num_bytes) {
+            const size_t offset = out.size();
+            out.resize(offset + std::min(num_bytes - offset, c_read_block_size));
+            read_exactly(in, out.data() + offset, out.size() - offset);
+        }
+    }
+
+    template<std::unsigned_integral T>
+    T read_le(std::istream& in)
+    {
+        std::array<uint8_t, sizeof(T)> bytes{};
+        read_exactly(in, bytes.data(), bytes.size());
+        T rv = 0;
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            rv |= static_cast<T>(static_cast<T>(bytes[i]) << (8*i));
+        }
+        return rv;
+    }
+
+    template<std::unsigned_integral T>
+    T load_le(const uint8_t* p)
+    {
+        T rv = 0;
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            rv |= static_cast<T>(static_cast<T>(p[i]) << (8*i));
+        }
+        return rv;
+    }
+
+    // PackBits-style run-length encoding: a control byte `c < 128` is followed by `c+1`
+    // literal bytes, `c >= 128` is followed by one byte that's repeated `c-125` (3..130) times
+    void rle_encode(std::span<const uint8_t> in, std::vector<uint8_t>& out)
+    {
+        const auto run_length_at = [&in](size_t i)
+        {
+            size_t len = 1;
+            while (i+len < in.size() and in[i+len] == in[i] and len < 130) {
+                ++len;
+            }
+            return len;
+        };
+
+        for (size_t i = 0; i < in.size();) {
+            if (const size_t run = run_length_at(i); run >= 3) {
+                out.push_back(static_cast<uint8_t>(128 + (run-3)));
+                out.push_back(in[i]);
+                i += run;
+                continue;
+            }
+
+            size_t end = i;
+            while (end < in.size() and end-i < 128 and not (end+2 < in.size() and in[end] == in[end+1] and in[end] == in[end+2])) {
+                ++end;
+            }
+            out.push_back(static_cast<uint8_t>(end-i-1));
+            out.insert(out.end(), in.begin() + static_cast<ptrdiff_t>(i), in.begin() + static_cast<ptrdiff_t>(end));
+            i = end;
+        }
+    }
+
+    void rle_decode(std::span<const uint8_t> in, std::span<uint8_t> out)
+    {
+        size_t o = 0;
+        for (size_t i = 0; i < in.size();) {
+            const uint8_t control = in[i++];
+            if (control < 128) {
+                const size_t len = control + 1;
+                if (i+len > in.size() or o+len > out.size()) {
+                    throw std::runtime_error{"binary columns: malformed compressed chunk"};
+                }
+                std::copy_n(in.begin() + static_cast<ptrdiff_t>(i), len, out.begin() + static_cast<ptrdiff_t>(o));
+                i += len;
+                o += len;
+            }
+            else {
+                const size_t len = control - 125;
+                if (i >= in.size() or o+len > out.size()) {
+                    throw std::runtime_error{"binary columns: malformed compressed chunk"};
+                }
+                std::fill_n(out.begin() + static_cast<ptrdiff_t>(o), len, in[i++]);
+                o += len;
+            }
+        }
+        if (o != out.size()) {
+            throw std::runtime_error{"binary columns: malformed compressed chunk"};
+        }
+    }
+
+    // transforms row-major little-endian values into byte planes of each value XORed with the
+    // previous row's value (XOR is bytewise, so it can be applied per byte)
+    void xor_delta_to_planes(std::span<const uint8_t> values, size_t row_size, std::vector<uint8_t>& planes)
+    {
+        const size_t num_rows = values.size() / row_size;
+        planes.resize(values.size());
+        for (size_t k = 0; k < row_size; ++k) {
+            uint8_t* plane = planes.data() + k*num_rows;
+            uint8_t prev = 0;
+            for (size_t r = 0; r < num_rows; ++r) {
+                const uint8_t cur = values[r*row_size + k];
+                plane[r] = cur ^ prev;
+                prev = cur;
+            }
+        }
+    }
+
+    void planes_to_values(std::span<const uint8_t> planes, size_t row_size, std::span<uint8_t> values)
+    {
+        const size_t num_rows = planes.size() / row_size;
+        for (size_t k = 0; k < row_size; ++k) {
+            const uint8_t* plane = planes.data() + k*num_rows;
+            uint8_t prev = 0;
+            for (size_t r = 0; r < num_rows; ++r) {
+                prev ^= plane[r];
+                values[r*row_size + k] = prev;
+            }
+        }
+    }
+
+    // appends the little-endian values in `bytes` to `column`
+    void append_values(BinaryColumn& column, std::span<const uint8_t> bytes)
+    {
+        std::visit(Overload{
+            [&bytes](std::vector<float>& data)
+            {
+                for (size_t i = 0; i < bytes.size(); i += 4) {
+                    data.push_back(cpp20::bit_cast<float>(load_le<uint32_t>(bytes.data() + i)));
+                }
+            },
+            [&bytes](std::vector<Vec2>& data)
+            {
+                for (size_t i = 0; i < bytes.size(); i += 8) {
+                    data.emplace_back(
+                        cpp20::bit_cast<float>(load_le<uint32_t>(bytes.data() + i)),
+                        cpp20::bit_cast<float>(load_le<uint32_t>(bytes.data() + i + 4))
+                    );
+                }
+            },
+            [&bytes](std::vector<double>& data)
+            {
+                for (size_t i = 0; i < bytes.size(); i += 8) {
+                    data.push_back(cpp20::bit_cast<double>(load_le<uint64_t>(bytes.data() + i)));
+                }
+            },
+        }, column.data);
+    }
+
+    BinaryColumn make_empty_column(std::string name, BinaryColumnType type)
+    {
+        static_assert(num_options<BinaryColumnType>() == 3);
+        switch (type) {
+        case BinaryColumnType::Float:  return BinaryColumn{std::move(name), std::vector<float>{}};
+        case BinaryColumnType::Vec2:   return BinaryColumn{std::move(name), std::vector<Vec2>{}};
+        case BinaryColumnType::Double: return BinaryColumn{std::move(name), std::vector<double>{}};
+        default:                       throw std::runtime_error{"binary columns: unknown column type"};
+        }
+    }
+}
+
+osc::BinaryColumnsWriter::BinaryColumnsWriter(
+    std::ostream& out,
+    std::span<const BinaryColumnDescription> columns,
+    BinaryColumnsWriterFlags flags) :
+
+    out_{&out},
+    flags_{flags}
+{
+    out_->write(c_magic.data(), static_cast<std::streamsize>(c_magic.size()));
+    write_le<uint16_t>(*out_, c_version);
+    write_le<uint32_t>(*out_, static_cast<uint32_t>(columns.size()));
+    for (const BinaryColumnDescription& column : columns) {
+        OSC_ASSERT(column.name.size() <= c_max_name_size);
+        write_le<uint8_t>(*out_, cpp23::to_underlying(column.type));
+        write_le<uint32_t>(*out_, static_cast<uint32_t>(column.name.size()));
+        out_->write(column.name.data(), static_cast<std::streamsize>(column.name.size()));
+        column_types_.push_back(column.type);
+    }
+    next_column_ = column_types_.size();
+}
+
+void osc::BinaryColumnsWriter::begin_chunk(size_t num_rows)
+{
+    OSC_ASSERT(next_column_ == column_types_.size() && "the previous chunk wasn't completely written");
+    OSC_ASSERT(0 < num_rows and num_rows <= std::numeric_limits<uint32_t>::max());
+
+    write_le<uint32_t>(*out_, static_cast<uint32_t>(num_rows));
+    chunk_num_rows_ = num_rows;
+    next_column_ = 0;
+}
+
+void osc::BinaryColumnsWriter::write_column(std::span<const float> values)
+{
+    scratch_values_.clear();
+    for (float v : values) {
+        append_le(scratch_values_, cpp20::bit_cast<uint32_t>(v));
+    }
+    write_encoded_column(BinaryColumnType::Float, scratch_values_, values.size());
+}
+
+void osc::BinaryColumnsWriter::write_column(std::span<const Vec2> values)
+{
+    scratch_values_.clear();
+    for (const Vec2& v : values) {
+        append_le(scratch_values_, cpp20::bit_cast<uint32_t>(v.x));
+        append_le(scratch_values_, cpp20::bit_cast<uint32_t>(v.y));
+    }
+    write_encoded_column(BinaryColumnType::Vec2, scratch_values_, values.size());
+}
+
+void osc::BinaryColumnsWriter::write_column(std::span<const double> values)
+{
+    scratch_values_.clear();
+    for (double v : values) {
+        append_le(scratch_values_, cpp20::bit_cast<uint64_t>(v));
+    }
+    write_encoded_column(BinaryColumnType::Double, scratch_values_, values.size());
+}
+
+void osc::BinaryColumnsWriter::finish()
+{
+    OSC_ASSERT(next_column_ == column_types_.size() && "the last chunk wasn't completely written");
+    write_le<uint32_t>(*out_, 0);
+}
+
+void osc::BinaryColumnsWriter::write_encoded_column(
+    BinaryColumnType type,
+    std::span<const uint8_t> little_endian_values,
+    size_t num_rows)
+{
+    OSC_ASSERT(next_column_ < column_types_.size() && "more columns were written than were described");
+    OSC_ASSERT(column_types_[next_column_] == type && "the column's type doesn't match its description");
+    OSC_ASSERT(num_rows == chunk_num_rows_ && "the column's size doesn't match the chunk's size");
+    ++next_column_;
+
+    if (flags_ & BinaryColumnsWriterFlags::Compress) {
+        xor_delta_to_planes(little_endian_values, bytes_per_row(type), scratch_planes_);
+        scratch_encoded_.clear();
+        rle_encode(scratch_planes_, scratch_encoded_);
+
+        if (scratch_encoded_.size() < little_endian_values.size()) {
+            write_le<uint8_t>(*out_, cpp23::to_underlying(ChunkEncoding::XorDeltaRLE));
+            write_le<uint64_t>(*out_, scratch_encoded_.size());
+            out_->write(reinterpret_cast<const char*>(scratch_encoded_.data()), static_cast<std::streamsize>(scratch_encoded_.size()));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+            return;
+        }
+        // else: it's incompressible, write it raw
+    }
+
+    write_le<uint8_t>(*out_, cpp23::to_underlying(ChunkEncoding::Raw));
+    write_le<uint64_t>(*out_, little_endian_values.size());
+    out_->write(reinterpret_cast<const char*>(little_endian_values.data()), static_cast<std::streamsize>(little_endian_values.size()));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+}
+
+BinaryColumnType osc::type_of(const BinaryColumn& column)
+{
+    static_assert(std::variant_size_v<decltype(BinaryColumn::data)> == num_options<BinaryColumnType>());
+    return static_cast<BinaryColumnType>(column.data.index());
+}
+
+std::vector<BinaryColumn> osc::read_binary_columns(std::istream& in)
+{
+    std::array<char, c_magic.size()> magic{};
+    read_exactly(in, magic.data(), magic.size());
+    if (std::string_view{magic.data(), magic.size()} != c_magic) {
+        throw std::runtime_error{"binary columns: the data doesn't start with the expected magic bytes"};
+    }
+    if (const auto version = read_le<uint16_t>(in); version != c_version) {
+        throw std::runtime_error{"binary columns: unsupported version: " + std::to_string(version)};
+    }
+
+    // read header
+    const auto num_columns = read_le<uint32_t>(in);
+    std::vector<BinaryColumn> columns;
+    for (uint32_t i = 0; i < num_columns; ++i) {
+        const auto type = read_le<uint8_t>(in);
+        if (type >= num_options<BinaryColumnType>()) {
+            throw std::runtime_error{"binary columns: unknown column type"};
+        }
+        const auto name_size = read_le<uint32_t>(in);
+        if (name_size > c_max_name_size) {
+            throw std::runtime_error{"binary columns: column name is too long"};
+        }
+        std::string name(name_size, '\0');
+        read_exactly(in, name.data(), name.size());
+        columns.push_back(make_empty_column(std::move(name), static_cast<BinaryColumnType>(type)));
+    }
+
+    // read chunks
+    std::vector<uint8_t> payload;
+    std::vector<uint8_t> planes;
+    std::vector<uint8_t> values;
+    for (auto num_rows = read_le<uint32_t>(in); num_rows != 0; num_rows = read_le<uint32_t>(in)) {
+        for (BinaryColumn& column : columns) {
+            const size_t decoded_size = num_rows * bytes_per_row(type_of(column));
+            const auto encoding = read_le<uint8_t>(in);
+            const auto payload_size = read_le<uint64_t>(in);
+
+            // care: `num_rows` is untrusted, so nothing is allocated based on it until the
+            // payload (which must be consistent with it) has been read
+            if (encoding == cpp23::to_underlying(ChunkEncoding::Raw)) {
+                if (payload_size != decoded_size) {
+                    throw std::runtime_error{"binary columns: raw chunk has an unexpected size"};
+                }
+                read_exactly_into(in, values, decoded_size);
+            }
+            else if (encoding == cpp23::to_underlying(ChunkEncoding::XorDeltaRLE)) {
+                if (payload_size > decoded_size + decoded_size/128 + 2) {
+                    throw std::runtime_error{"binary columns: compressed chunk is larger than possible"};
+                }
+                if (decoded_size > payload_size * c_max_rle_expansion) {
+                    throw std::runtime_error{"binary columns: compressed chunk is smaller than possible"};
+                }
+                read_exactly_into(in, payload, static_cast<size_t>(payload_size));
+                planes.resize(decoded_size);
+                rle_decode(payload, planes);
+                values.resize(decoded_size);
+                planes_to_values(planes, bytes_per_row(type_of(column)), values);
+            }
+            else {
+                throw std::runtime_error{"binary columns: unknown chunk encoding"};
+            }
+
+            append_values(column, values);
+        }
+    }
+
+    return columns;
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <oscar/Maths/Vec2.h>
+#include <oscar/Shims/Cpp23/utility.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <span>
+#include <string>
+#include <variant>
+#include <vector>
+
+// binary columns: a self-describing, chunked, (optionally) compressed binary format for
+// tables of numeric columns (e.g. simulation outputs)
+//
+// layout (all integers are little-endian):
+//
+//     magic          8 bytes   "OSCBCOLS"
+//     version        u16       currently 1
+//     num_columns    u32
+//     columns        num_columns x (u8 type, u32 name_size, name_size bytes of UTF-8 name)
+//     chunks         any number of (u32 num_rows > 0, num_columns x (u8 encoding, u64 size, size bytes))
+//     end marker     u32       0
+//
+// each column's values within a chunk are encoded independently, either as their raw
+// little-endian bytes or, if it's smaller, by XORing each value with the previous one,
+// splitting the result into byte planes, and run-length-encoding the planes (which
+// works well for smoothly-varying data, because the high bytes of the XORed values are
+// mostly zero)
+namespace osc
+{
+    enum class BinaryColumnType : uint8_t {
+        Float,   // f32
+        Vec2,    // f32 x, f32 y
+        Double,  // f64
+        NUM_OPTIONS,
+    };
+
+    enum class BinaryColumnsWriterFlags {
+        None     = 0,
+        Compress = 1<<0,  // try to compress each column's chunks (otherwise, they're written raw)
+
+        Default = Compress,
+    };
+
+    constexpr bool operator&(BinaryColumnsWriterFlags lhs, BinaryColumnsWriterFlags rhs)
+    {
+        return cpp23::to_underlying(lhs) & cpp23::to_underlying(rhs);
+    }
+
+    struct BinaryColumnDescription final {
+        std::string name;
+        BinaryColumnType type;
+    };
+
+    // a streaming writer for the binary columns format
+    //
+    // usage: construct it with the column descriptions, then (repeatedly) call `begin_chunk`
+    // followed by one `write_column` per column (in order), then call `finish`
+    class BinaryColumnsWriter final {
+    public:
+        // writes the header to `out`, which must outlive the writer
+        BinaryColumnsWriter(
+            std::ostream& out,
+            std::span<const BinaryColumnDescription>,
+            BinaryColumnsWriterFlags = BinaryColumnsWriterFlags::Default
+        );
+
+        // begins a chunk that contains `num_rows` (> 0) rows of each column
+        void begin_chunk(size_t num_rows);
+
+        // writes the next column of the current chunk (its type must match the column's description)
+        void write_column(std::span<const float>);
+        void write_column(std::span<const Vec2>);
+        void write_column(std::span<const double>);
+
+        // writes the end marker
+        void finish();
+
+    private:
+        void write_encoded_column(BinaryColumnType, std::span<const uint8_t> little_endian_values, size_t num_rows);
+
+        std::ostream* out_;
+        std::vector<BinaryColumnType> column_types_;
+        BinaryColumnsWriterFlags flags_;
+        size_t chunk_num_rows_ = 0;
+        size_t next_column_ = 0;
+        std::vector<uint8_t> scratch_values_;
+        std::vector<uint8_t> scratch_planes_;
+        std::vector<uint8_t> scratch_encoded_;
+    };
+
+    // a fully-loaded column
+    struct BinaryColumn final {
+        std::string name;
+        std::variant<std::vector<float>, std::vector<Vec2>, std::vector<double>> data;
+    };
+
+    // returns the type of the given column's data
+    BinaryColumnType type_of(const BinaryColumn&);
+
+    // returns the columns of the binary columns data in `in`
+    //
+    // throws if the data is malformed (e.g. truncated, or not in the binary columns format). The
+    // sizes in the data aren't trusted, so malformed data can't make it allocate much more memory
+    // than the data's size
+    std::vector<BinaryColumn> read_binary_columns(std::istream& in);
+}
@@ -2,11 +2,31 @@
 
 #include <array>
 #include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <optional>
 #include <ranges>
+#include <span>
+#include <stdexcept>
 #include <string>
 #include <string_view>
+#include <system_error>
 #include <utility>
+#include <vector>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 using namespace osc;
 namespace rgs = std::ranges;
@@ -15,12 +35,371 @@ namespace
 {
     constexpr auto c_special_csv_chars = std::to_array({ ',', '\r', '\n', '"'});
 
+    // size of each block that's read from (or written to) a stream
+    constexpr size_t c_chunk_size = 1<<16;
+
     constexpr bool should_be_quoted(std::string_view str)
     {
         return rgs::find_first_of(str, c_special_csv_chars) != str.end();
     }
+
+    // appends `v` to `out` in a form that reads back as the same value
+    template<typename T>
+    void append_float(std::string& out, T v)
+    {
+        std::array<char, 32> buf{};
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        const auto [end, ec] = std::to_chars(buf.data(), buf.data() + buf.size(), v);
+        if (ec == std::errc{}) {
+            out.append(buf.data(), end);
+        }
+#else
+        // `std::to_chars` doesn't support floating-point values in this standard library
+        const int n = std::snprintf(buf.data(), buf.size(), "%.*g", std::numeric_limits<T>::max_digits10, static_cast<double>(v));
+        if (n > 0) {
+            out.append(buf.data(), std::min(static_cast<size_t>(n), buf.size()-1));
+        }
+#endif
+    }
+
+    // a read-only, memory-mapped file
+    class MappedFile final {
+    public:
+        // returns the mapped file, or `std::nullopt` if it couldn't be mapped (or the platform doesn't support it)
+        static std::optional<MappedFile> try_map(const std::filesystem::path& path)
+        {
+#if defined(__linux__) || defined(__APPLE__)
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd == -1) {
+                return std::nullopt;
+            }
+
+            struct stat st{};
+            if (::fstat(fd, &st) != 0) {
+                ::close(fd);
+                return std::nullopt;
+            }
+
+            const auto size = static_cast<size_t>(st.st_size);
+            if (size == 0) {
+                ::close(fd);
+                return MappedFile{nullptr, 0};  // `mmap` can't map zero bytes
+            }
+
+            void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);  // the mapping keeps its own reference to the file
+            if (data == MAP_FAILED) {
+                return std::nullopt;
+            }
+            ::madvise(data, size, MADV_SEQUENTIAL);
+
+            return MappedFile{data, size};
+#else
+            static_cast<void>(path);
+            return std::nullopt;
+#endif
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile(MappedFile&& tmp) noexcept :
+            data_{std::exchange(tmp.data_, nullptr)},
+            size_{std::exchange(tmp.size_, 0)}
+        {}
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile& operator=(MappedFile&& tmp) noexcept
+        {
+            std::swap(data_, tmp.data_);
+            std::swap(size_, tmp.size_);
+            return *this;
+        }
+        ~MappedFile() noexcept
+        {
+#if defined(__linux__) || defined(__APPLE__)
+            if (data_) {
+                ::munmap(data_, size_);
+            }
+#endif
+        }
+
+        std::string_view content() const
+        {
+            return data_ ? std::string_view{static_cast<const char*>(data_), size_} : std::string_view{};
+        }
+
+    private:
+        MappedFile(void* data, size_t size) : data_{data}, size_{size} {}
+
+        void* data_;
+        size_t size_;
+    };
+
+    // a cell, as an offset into either the row's data or the decoded cell buffer
+    struct CellRef final {
+        bool decoded;
+        size_t offset;
+        size_t size;
+    };
+
+    enum class CellTerminator {
+        Comma,
+        Newline,
+        EndOfData,
+    };
+
+    // the outcome of tokenizing a cell, or `std::nullopt` if more data is needed to tokenize it
+    struct CellResult final {
+        CellTerminator terminator;
+        size_t next;  // offset of the first character after the terminator
+    };
+
+    // tokenizes the cell that begins at `begin` with the same state machine that
+    // `read_csv_row_into_vector` uses, decoding its content into `decoded`
+    std::optional<CellResult> tokenize_cell_slow(
+        std::string_view data,
+        size_t begin,
+        bool is_final,
+        std::vector<CellRef>& cells,
+        std::string& decoded)
+    {
+        const size_t decoded_begin = decoded.size();
+        const auto push_cell = [&cells, &decoded, decoded_begin]()
+        {
+            cells.push_back({true, decoded_begin, decoded.size() - decoded_begin});
+        };
+
+        bool inside_quotes = false;
+        for (size_t i = begin;;) {
+            if (i == data.size()) {
+                if (not is_final) {
+                    return std::nullopt;
+                }
+                push_cell();
+                return CellResult{CellTerminator::EndOfData, i};
+            }
+
+            const char c = data[i];
+            const bool can_peek = i+1 < data.size();
+            if (not can_peek and not is_final and (c == '\r' or c == '"')) {
+                return std::nullopt;  // the next character affects how `c` is handled
+            }
+            const bool next_is_newline = can_peek and data[i+1] == '\n';
+            const bool next_is_quote = can_peek and data[i+1] == '"';
+
+            if (c == '\n' and not inside_quotes) {
+                // standard newline
+                push_cell();
+                return CellResult{CellTerminator::Newline, i+1};
+            }
+            else if (c == '\r' and next_is_newline and not inside_quotes) {
+                // windows newline
+                push_cell();
+                return CellResult{CellTerminator::Newline, i+2};
+            }
+            else if (c == '"' and decoded.size() == decoded_begin and not inside_quotes) {
+                // quote at beginning of quoted column
+                inside_quotes = true;
+                i += 1;
+            }
+            else if (c == '"' and next_is_quote) {
+                // escaped quote
+                decoded += '"';
+                i += 2;
+            }
+            else if (c == '"' and inside_quotes) {
+                // quote at end of quoted column
+                inside_quotes = false;
+                i += 1;
+            }
+            else if (c == ',' and not inside_quotes) {
+                // comma delimiter at end of column
+                push_cell();
+                return CellResult{CellTerminator::Comma, i+1};
+            }
+            else {
+                // normal text
+                decoded += c;
+                i += 1;
+            }
+        }
+    }
+
+    // returns how the (undecoded) cell content that ends at `end` is terminated, or `std::nullopt`
+    // if it's terminated by something other than a delimiter (or if more data is needed)
+    std::optional<CellResult> try_match_terminator(std::string_view data, size_t end, bool is_final, bool& r_needs_more_data)
+    {
+        if (end == data.size()) {
+            r_needs_more_data = not is_final;
+            return is_final ? std::optional<CellResult>{{CellTerminator::EndOfData, end}} : std::nullopt;
+        }
+        else if (data[end] == ',') {
+            return CellResult{CellTerminator::Comma, end+1};
+        }
+        else if (data[end] == '\n') {
+            return CellResult{CellTerminator::Newline, end+1};
+        }
+        else if (data[end] == '\r' and end+1 == data.size()) {
+            r_needs_more_data = not is_final;
+            return std::nullopt;
+        }
+        else if (data[end] == '\r' and data[end+1] == '\n') {
+            return CellResult{CellTerminator::Newline, end+2};
+        }
+        else {
+            return std::nullopt;
+        }
+    }
+
+    // tokenizes the cell that begins at `begin`, pushing it onto `cells`
+    //
+    // returns `std::nullopt` if `data` ends before the cell does and `is_final` is `false`
+    std::optional<CellResult> tokenize_cell(
+        std::string_view data,
+        size_t begin,
+        bool is_final,
+        std::vector<CellRef>& cells,
+        std::string& decoded)
+    {
+        bool needs_more_data = false;
+
+        if (begin == data.size() or data[begin] != '"') {
+            // fast path: unquoted cell that doesn't contain any quotes
+            size_t end = begin;
+            while (end < data.size() and data[end] != ',' and data[end] != '\n' and data[end] != '"') {
+                if (data[end] == '\r' and (end+1 == data.size() or data[end+1] == '\n')) {
+                    break;
+                }
+                ++end;
+            }
+            if (auto terminator = try_match_terminator(data, end, is_final, needs_more_data)) {
+                cells.push_back({false, begin, end - begin});
+                return terminator;
+            }
+        }
+        else {
+            // fast path: quoted cell that doesn't contain any escaped quotes
+            const size_t closing_quote = data.find('"', begin+1);
+            if (closing_quote == std::string_view::npos) {
+                needs_more_data = not is_final;
+            }
+            else if (auto terminator = try_match_terminator(data, closing_quote+1, is_final, needs_more_data)) {
+                cells.push_back({false, begin+1, closing_quote - (begin+1)});
+                return terminator;
+            }
+        }
+
+        if (needs_more_data) {
+            return std::nullopt;
+        }
+        return tokenize_cell_slow(data, begin, is_final, cells, decoded);
+    }
 }
 
+class osc::CSVReader::Impl final {
+public:
+    explicit Impl(std::istream& in) :
+        stream_{&in},
+        is_final_{false}
+    {}
+
+    explicit Impl(std::string_view content) :
+        data_{content},
+        is_final_{true}
+    {}
+
+    explicit Impl(const std::filesystem::path& path, CSVReaderFlags flags)
+    {
+        if (flags & CSVReaderFlags::MemoryMap) {
+            if ((mapping_ = MappedFile::try_map(path))) {
+                data_ = mapping_->content();
+                is_final_ = true;
+                return;
+            }
+            // else: fall back to reading it in chunks
+        }
+
+        owned_stream_ = std::make_unique<std::ifstream>(path, std::ios::binary);
+        if (not *owned_stream_) {
+            throw std::runtime_error{path.string() + ": cannot open for reading"};
+        }
+        stream_ = owned_stream_.get();
+        is_final_ = false;
+    }
+
+    std::optional<std::span<const std::string_view>> next_row()
+    {
+        if (done_) {
+            return std::nullopt;
+        }
+
+        while (not try_tokenize_row()) {
+            refill();
+        }
+        return std::span<const std::string_view>{cells_};
+    }
+
+private:
+    // tries to tokenize the row at the front of `data_`, returns `false` if more data is needed
+    bool try_tokenize_row()
+    {
+        cell_refs_.clear();
+        decoded_.clear();
+
+        for (size_t pos = 0;;) {
+            const std::optional<CellResult> result = tokenize_cell(data_, pos, is_final_, cell_refs_, decoded_);
+            if (not result) {
+                return false;
+            }
+            pos = result->next;
+
+            if (result->terminator == CellTerminator::Comma) {
+                continue;
+            }
+
+            cells_.clear();
+            for (const CellRef& ref : cell_refs_) {
+                const std::string_view source = ref.decoded ? std::string_view{decoded_} : data_;
+                cells_.push_back(source.substr(ref.offset, ref.size));
+            }
+            data_.remove_prefix(pos);
+            done_ = result->terminator == CellTerminator::EndOfData;
+            return true;
+        }
+    }
+
+    // moves the unconsumed data to the front of the buffer and appends the next chunk of the stream to it
+    void refill()
+    {
+        const size_t unconsumed = data_.size();
+        if (unconsumed > 0 and data_.data() != buffer_.data()) {
+            std::memmove(buffer_.data(), data_.data(), unconsumed);
+        }
+        if (buffer_.size() < unconsumed + c_chunk_size) {
+            buffer_.resize(std::max(2*buffer_.size(), unconsumed + c_chunk_size));
+        }
+
+        const size_t requested = buffer_.size() - unconsumed;
+        std::streambuf* const streambuf = stream_->rdbuf();
+        const auto n = streambuf ? streambuf->sgetn(buffer_.data() + unconsumed, static_cast<std::streamsize>(requested)) : 0;
+        const size_t num_read = n > 0 ? static_cast<size_t>(n) : 0;
+
+        data_ = std::string_view{buffer_.data(), unconsumed + num_read};
+        is_final_ = num_read < requested;  // `sgetn` only returns fewer characters at the end of the stream
+    }
+
+    std::unique_ptr<std::ifstream> owned_stream_;
+    std::optional<MappedFile> mapping_;
+    std::istream* stream_ = nullptr;
+    std::string buffer_;
+
+    std::string_view data_;  // the data that hasn't been tokenized yet
+    bool is_final_ = true;   // `true` if there's no more data after `data_`
+    bool done_ = false;
+
+    std::vector<CellRef> cell_refs_;
+    std::string decoded_;
+    std::vector<std::string_view> cells_;
+};
+
 std::optional<std::vector<std::string>> osc::read_csv_row(
     std::istream& in)
 {
@@ -109,29 +488,125 @@ void osc::write_csv_row(
     std::ostream& out,
     std::span<const std::string> columns)
 {
-    std::string_view delimeter;
-    for (const auto& column : columns) {
-        const bool quoted = should_be_quoted(column);
+    CSVWriter writer{out};
+    writer.write_row(columns);
+    writer.flush();
+}
 
-        out << delimeter;
-        if (quoted) {
-            out << '"';
-        }
+osc::CSVReader::CSVReader(std::istream& in) :
+    impl_{std::make_unique<Impl>(in)}
+{}
+osc::CSVReader::CSVReader(std::string_view content) :
+    impl_{std::make_unique<Impl>(content)}
+{}
+osc::CSVReader::CSVReader(const std::filesystem::path& path, CSVReaderFlags flags) :
+    impl_{std::make_unique<Impl>(path, flags)}
+{}
+osc::CSVReader::CSVReader(CSVReader&&) noexcept = default;
+osc::CSVReader& osc::CSVReader::operator=(CSVReader&&) noexcept = default;
+osc::CSVReader::~CSVReader() noexcept = default;
 
-        for (auto c : column) {
-            if (c != '"') {
-                out << c;
-            }
-            else {
-                out << '"' << '"';
-            }
-        }
+std::optional<std::span<const std::string_view>> osc::CSVReader::next_row()
+{
+    return impl_->next_row();
+}
+
+osc::CSVWriter::CSVWriter(std::ostream& out) :
+    out_{&out}
+{}
 
-        if (quoted) {
-            out << '"';
+osc::CSVWriter::~CSVWriter() noexcept
+{
+    try {
+        flush();
+    }
+    catch (const std::exception&) {
+        // the caller should've called `flush` if they wanted to handle this
+    }
+}
+
+void osc::CSVWriter::write_cell(std::string_view cell)
+{
+    begin_cell();
+
+    const bool quoted = should_be_quoted(cell);
+    if (quoted) {
+        buffer_ += '"';
+    }
+
+    for (auto c : cell) {
+        if (c != '"') {
+            buffer_ += c;
         }
+        else {
+            buffer_ += "\"\"";
+        }
+    }
+
+    if (quoted) {
+        buffer_ += '"';
+    }
+
+    flush_if_full();
+}
+
+void osc::CSVWriter::write_cell(float v)
+{
+    begin_cell();
+    append_float(buffer_, v);
+    flush_if_full();
+}
+
+void osc::CSVWriter::write_cell(double v)
+{
+    begin_cell();
+    append_float(buffer_, v);
+    flush_if_full();
+}
+
+void osc::CSVWriter::end_row()
+{
+    buffer_ += '\n';
+    at_row_start_ = true;
+    flush_if_full();
+}
+
+void osc::CSVWriter::write_row(std::span<const std::string> cells)
+{
+    for (const auto& cell : cells) {
+        write_cell(cell);
+    }
+    end_row();
+}
+
+void osc::CSVWriter::write_row(std::span<const std::string_view> cells)
+{
+    for (const auto& cell : cells) {
+        write_cell(cell);
+    }
+    end_row();
+}
 
-        delimeter = ",";
+void osc::CSVWriter::flush()
+{
+    if (buffer_.empty()) {
+        return;
+    }
+    out_->write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    buffer_.clear();
+}
+
+void osc::CSVWriter::begin_cell()
+{
+    if (not at_row_start_) {
+        buffer_ += ',';
+    }
+    at_row_start_ = false;
+}
+
+void osc::CSVWriter::flush_if_full()
+{
+    if (buffer_.size() >= c_chunk_size) {
+        flush();
     }
-    out << '\n';
 }
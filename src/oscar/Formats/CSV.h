@@ -1,9 +1,14 @@
 #pragma once
 
+#include <oscar/Shims/Cpp23/utility.h>
+
+#include <filesystem>
 #include <iosfwd>
+#include <memory>
 #include <optional>
 #include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace osc
@@ -24,4 +29,99 @@ namespace osc
         std::ostream&,
         std::span<const std::string> columns
     );
+
+    enum class CSVReaderFlags {
+        None      = 0,
+        MemoryMap = 1<<0,  // memory-map the file, if the platform supports it (otherwise, it's read in chunks)
+
+        Default = None,
+    };
+
+    constexpr bool operator&(CSVReaderFlags lhs, CSVReaderFlags rhs)
+    {
+        return cpp23::to_underlying(lhs) & cpp23::to_underlying(rhs);
+    }
+
+    // a streaming CSV tokenizer that yields each row's cells as views into its internal buffers
+    //
+    // - rows are tokenized exactly like `read_csv_row` (incl. its edge-cases, such as emitting a
+    //   single empty cell for a trailing newline), so it's a drop-in replacement for it
+    // - stream input is read in large chunks, rather than character-by-character
+    // - cells are only copied if they contain escaped quotes, and the reader reuses its buffers
+    //   between rows, so reading doesn't allocate once the buffers have grown to fit the largest row
+    class CSVReader final {
+    public:
+        // reads rows from `in`, which must outlive the reader
+        //
+        // the reader reads ahead of the rows that it has emitted, so the stream's read position
+        // is unspecified until the reader is exhausted
+        explicit CSVReader(std::istream& in);
+
+        // reads rows from `content`, which must outlive the reader
+        explicit CSVReader(std::string_view content);
+
+        // reads rows from the file at `path`
+        //
+        // throws if the file cannot be opened
+        explicit CSVReader(const std::filesystem::path& path, CSVReaderFlags = CSVReaderFlags::Default);
+
+        CSVReader(const CSVReader&) = delete;
+        CSVReader(CSVReader&&) noexcept;
+        CSVReader& operator=(const CSVReader&) = delete;
+        CSVReader& operator=(CSVReader&&) noexcept;
+        ~CSVReader() noexcept;
+
+        // returns the next row's cells, or `std::nullopt` if there are no more rows
+        //
+        // the returned cells are only valid until the next call to `next_row`
+        std::optional<std::span<const std::string_view>> next_row();
+
+    private:
+        class Impl;
+        std::unique_ptr<Impl> impl_;
+    };
+
+    // a buffered CSV writer that formats cells directly into an internal buffer, which is
+    // written to the output stream in large blocks
+    //
+    // - cells are quoted/escaped in the same way as `write_csv_row`
+    // - floating-point cells are written in a round-trippable form without going through
+    //   `std::ostream` formatting (the shortest one, e.g. `1337`, `0.1`, `1e+20`, where the
+    //   standard library's `std::to_chars` supports floating-point values)
+    class CSVWriter final {
+    public:
+        // writes rows to `out`, which must outlive the writer
+        explicit CSVWriter(std::ostream& out);
+        CSVWriter(const CSVWriter&) = delete;
+        CSVWriter(CSVWriter&&) noexcept = default;
+        CSVWriter& operator=(const CSVWriter&) = delete;
+        CSVWriter& operator=(CSVWriter&&) noexcept = default;
+
+        // flushes the writer, ignoring any errors (call `flush` to handle them)
+        ~CSVWriter() noexcept;
+
+        void write_cell(std::string_view);
+        void write_cell(const char* cell) { write_cell(std::string_view{cell}); }
+        void write_cell(const std::string& cell) { write_cell(std::string_view{cell}); }
+        void write_cell(float);
+        void write_cell(double);
+
+        // ends the current row (i.e. writes a newline)
+        void end_row();
+
+        // writes each of `cells` followed by the end of the row
+        void write_row(std::span<const std::string> cells);
+        void write_row(std::span<const std::string_view> cells);
+
+        // writes any buffered content to the output stream
+        void flush();
+
+    private:
+        void begin_cell();
+        void flush_if_full();
+
+        std::ostream* out_;
+        std::string buffer_;
+        bool at_row_start_ = true;
+    };
 }
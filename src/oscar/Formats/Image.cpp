@@ -12,11 +12,14 @@
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include <stb_image_write.h>
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <istream>
 #include <memory>
-#include <mutex>
 #include <new>
 #include <optional>
+#include <span>
 #include <sstream>
 #include <string>
 #include <string_view>
@@ -27,14 +30,19 @@ using namespace osc;
 
 namespace
 {
-    inline constexpr int c_stb_true = 1;
-    inline constexpr int c_stb_false = 0;
-
-    // this mutex is required because stbi has global mutable state (e.g. `stbi_set_flip_vertically_on_load`)
-    auto lock_stbi_api()
+    // flips the rows of a row-major image in-place
+    //
+    // this is done explicitly, rather than with `stbi_set_flip_vertically_on_load`, because
+    // stbi's flip flag is global mutable state, which would prevent decoding images in parallel
+    template<typename T>
+    void flip_rows_vertically(std::span<T> pixel_data, size_t row_size)
     {
-        static std::mutex s_stbi_mutex;
-        return std::lock_guard{s_stbi_mutex};
+        const size_t num_rows = pixel_data.size() / row_size;
+        for (size_t row = 0; row < num_rows/2; ++row) {
+            const auto top = pixel_data.subspan(row * row_size, row_size);
+            const auto bottom = pixel_data.subspan((num_rows - row - 1) * row_size, row_size);
+            std::swap_ranges(top.begin(), top.end(), bottom.begin());
+        }
     }
 
     // OSC-specific IO callbacks for `stbi`, to make it compatible with (e.g.) virtual filesystems
@@ -74,12 +82,6 @@ namespace
         ColorSpace color_space,
         ImageLoadingFlags flags)
     {
-        const auto guard = lock_stbi_api();
-
-        if (flags & ImageLoadingFlags::FlipVertically) {
-            stbi_set_flip_vertically_on_load(c_stb_true);
-        }
-
         Vec2i dimensions{};
         int num_channels = 0;
         const std::unique_ptr<float, decltype(&stbi_image_free)> pixel_data = {
@@ -87,10 +89,6 @@ namespace
             stbi_image_free,
         };
 
-        if (flags & ImageLoadingFlags::FlipVertically) {
-            stbi_set_flip_vertically_on_load(c_stb_false);
-        }
-
         if (not pixel_data) {
             std::stringstream ss;
             ss << input_name << ": error loading HDR image: " << stbi_failure_reason();
@@ -108,13 +106,17 @@ namespace
             throw std::runtime_error{std::move(ss).str()};
         }
 
-        const std::span<const float> pixel_span{
+        const std::span<float> pixel_span{
             pixel_data.get(),
             static_cast<size_t>(dimensions.x*dimensions.y*num_channels)
         };
 
+        if (flags & ImageLoadingFlags::FlipVertically) {
+            flip_rows_vertically(pixel_span, static_cast<size_t>(dimensions.x*num_channels));
+        }
+
         Texture2D rv{dimensions, *texture_format, color_space};
-        rv.set_pixel_data(view_object_representations<uint8_t>(pixel_span));
+        rv.set_pixel_data(view_object_representations<uint8_t>(std::span<const float>{pixel_span}));
         return rv;
     }
 
@@ -124,12 +126,6 @@ namespace
         ColorSpace color_space,
         ImageLoadingFlags flags)
     {
-        const auto guard = lock_stbi_api();
-
-        if (flags & ImageLoadingFlags::FlipVertically) {
-            stbi_set_flip_vertically_on_load(c_stb_true);
-        }
-
         Vec2i dimensions{};
         int num_channels = 0;
         const std::unique_ptr<stbi_uc, decltype(&stbi_image_free)> pixel_data = {
@@ -137,10 +133,6 @@ namespace
             stbi_image_free,
         };
 
-        if (flags & ImageLoadingFlags::FlipVertically) {
-            stbi_set_flip_vertically_on_load(c_stb_false);
-        }
-
         if (not pixel_data) {
             std::stringstream ss;
             ss << input_name  << ": error loading non-HDR image: " << stbi_failure_reason();
@@ -158,8 +150,17 @@ namespace
             throw std::runtime_error{std::move(ss).str()};
         }
 
+        const std::span<uint8_t> pixel_span{
+            pixel_data.get(),
+            static_cast<size_t>(dimensions.x*dimensions.y*num_channels)
+        };
+
+        if (flags & ImageLoadingFlags::FlipVertically) {
+            flip_rows_vertically(pixel_span, static_cast<size_t>(dimensions.x*num_channels));
+        }
+
         Texture2D rv{dimensions, *texture_format, color_space};
-        rv.set_pixel_data({pixel_data.get(), static_cast<size_t>(dimensions.x*dimensions.y*num_channels)});
+        rv.set_pixel_data(pixel_span);
         return rv;
     }
 
@@ -196,11 +197,9 @@ void osc::write_to_png(
 {
     const Vec2i dimensions = texture.dimensions();
     const int row_stride = 4 * dimensions.x;
-    const std::vector<Color32> pixels = texture.pixels32();
-
-    const auto guard = lock_stbi_api();
+    std::vector<Color32> pixels = texture.pixels32();
+    flip_rows_vertically(std::span<Color32>{pixels}, static_cast<size_t>(dimensions.x));
 
-    stbi_flip_vertically_on_write(c_stb_true);
     const int rv = stbi_write_png_to_func(
         osc_stbi_write_via_std_ostream,
         &out,
@@ -210,7 +209,6 @@ void osc::write_to_png(
         pixels.data(),
         row_stride
     );
-    stbi_flip_vertically_on_write(c_stb_false);
 
     if (rv == 0) {
         std::stringstream ss;
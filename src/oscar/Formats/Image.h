@@ -5,6 +5,8 @@
 #include <oscar/Graphics/Texture2D.h>
 #include <oscar/Utils/Concepts.h>
 
+#include <concepts>
+#include <future>
 #include <iosfwd>
 #include <utility>
 
@@ -35,6 +37,24 @@ namespace osc
         );
     }
 
+    // asynchronously loads the given (named) image stream into a `Texture2D` on a background thread
+    //
+    // image loading doesn't use any global state, so many images can be loaded in parallel. The
+    // returned texture only contains CPU-side pixel data: its GPU-side counterpart is created when
+    // it's first used by the renderer (i.e. on the render thread)
+    template<NamedInputStream Stream>
+    requires std::movable<Stream>
+    std::future<Texture2D> load_texture2D_from_image_async(
+        Stream stream,
+        ColorSpace color_space,
+        ImageLoadingFlags flags = ImageLoadingFlags::None)
+    {
+        return std::async(std::launch::async, [stream = std::move(stream), color_space, flags]() mutable
+        {
+            return load_texture2D_from_image(stream, color_space, flags);
+        });
+    }
+
     void write_to_png(
         const Texture2D&,
         std::ostream&
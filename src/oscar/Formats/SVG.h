@@ -2,7 +2,10 @@
 
 #include <oscar/Graphics/Texture2D.h>
 
+#include <concepts>
+#include <future>
 #include <iosfwd>
+#include <utility>
 
 namespace osc
 {
@@ -10,4 +13,21 @@ namespace osc
         std::istream&,
         float scale = 1.0f
     );
+
+    // asynchronously rasterizes the given SVG stream into a `Texture2D` on a background thread
+    //
+    // rasterization doesn't use any global state, so many SVGs can be rasterized in parallel. The
+    // returned texture only contains CPU-side pixel data: its GPU-side counterpart is created when
+    // it's first used by the renderer (i.e. on the render thread)
+    template<typename Stream>
+    requires std::movable<Stream> and std::convertible_to<Stream&, std::istream&>
+    std::future<Texture2D> load_texture2D_from_svg_async(
+        Stream stream,
+        float scale = 1.0f)
+    {
+        return std::async(std::launch::async, [stream = std::move(stream), scale]() mutable
+        {
+            return load_texture2D_from_svg(stream, scale);
+        });
+    }
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <oscar/Graphics/AntiAliasingLevel.h>
+#include <oscar/Graphics/GraphicsStreamingStats.h>
 #include <oscar/Graphics/Texture2D.h>
 
 #include <future>
@@ -49,6 +50,10 @@ namespace osc
         std::string backend_version_string() const;
         std::string backend_shading_language_version_string() const;
 
+        // returns counters for the data that was streamed to the GPU since startup (or the last reset)
+        GraphicsStreamingStats streaming_stats() const;
+        void reset_streaming_stats();
+
         class Impl;
     private:
         // no data - it uses globals (you can only have one of these, globally)
@@ -20,6 +20,7 @@
 #include <oscar/Graphics/Geometries/PlaneGeometry.h>
 #include <oscar/Graphics/Graphics.h>
 #include <oscar/Graphics/GraphicsContext.h>
+#include <oscar/Graphics/GraphicsStreamingStats.h>
 #include <oscar/Graphics/Material.h>
 #include <oscar/Graphics/Mesh.h>
 #include <oscar/Graphics/MeshFunctions.h>
@@ -75,6 +76,7 @@
 #include <oscar/Utils/ObjectRepresentation.h>
 #include <oscar/Utils/Perf.h>
 #include <oscar/Utils/StdVariantHelpers.h>
+#include <oscar/Utils/StridedSpan.h>
 #include <oscar/Utils/UID.h>
 
 #include <GL/glew.h>
@@ -82,12 +84,16 @@
 
 #include <algorithm>
 #include <array>
+#include <bit>
+#include <concepts>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <functional>
 #include <iostream>
 #include <iterator>
+#include <limits>
+#include <optional>
 #include <ranges>
 #include <span>
 #include <sstream>
@@ -864,16 +870,189 @@ namespace
         gl::VertexArray vao;
     };
 
+    // a ring buffer for streaming per-draw data (e.g. instance matrices) to the GPU
+    //
+    // the buffer is split into `c_num_segments` segments. Allocations are bump-allocated
+    // from the current segment and, once the CPU moves on from a segment (e.g. because
+    // it's full, or because the frame ended), it's fenced, so that the CPU never writes
+    // into a segment that the GPU might still be reading from. This means that uploads
+    // don't need to orphan (reallocate) the buffer for every batch.
+    //
+    // if the driver supports `GL_ARB_buffer_storage`, the buffer is persistently mapped
+    // and allocations are written directly into it. Otherwise, it falls back to writing
+    // allocations with `glBufferSubData`
+    class StreamingBuffer final {
+    public:
+        // where an allocation was written
+        //
+        // holds the buffer's name, rather than a reference to its handle, because a later
+        // `push` may reallocate (i.e. replace) the handle
+        struct Allocation final {
+            GLuint buffer;
+            size_t offset;
+        };
+
+        StreamingBuffer() :
+            use_persistent_mapping_{GLEW_ARB_buffer_storage != 0}
+        {
+            reallocate(c_initial_segment_size);
+        }
+        StreamingBuffer(const StreamingBuffer&) = delete;
+        StreamingBuffer(StreamingBuffer&&) noexcept = delete;
+        StreamingBuffer& operator=(const StreamingBuffer&) = delete;
+        StreamingBuffer& operator=(StreamingBuffer&&) noexcept = delete;
+        ~StreamingBuffer() noexcept
+        {
+            delete_all_fences();
+            unmap();
+        }
+
+        // copies `data` into the buffer and returns where it was written
+        Allocation push(std::span<const std::byte> data)
+        {
+            if (data.size() > segment_size_) {
+                reallocate(std::bit_ceil(data.size()));
+            }
+            else if (segment_offset_ + data.size() > segment_size_) {
+                advance_segment();
+            }
+
+            const size_t offset = current_segment_*segment_size_ + segment_offset_;
+            if (mapped_data_) {
+                std::copy(data.begin(), data.end(), mapped_data_ + offset);
+            }
+            else {
+                gl::bind_buffer(buffer_);
+                glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(data.size()), data.data());
+            }
+            segment_offset_ += round_up_to_alignment(data.size());
+
+            ++stats_.num_uploads;
+            stats_.num_bytes_uploaded += data.size();
+
+            return Allocation{buffer_.get(), offset};
+        }
+
+        const GraphicsStreamingStats& stats() const { return stats_; }
+        void reset_stats() { stats_ = {}; }
+
+        // fences the current segment (if it was written to) and moves onto the next one
+        void on_frame_end()
+        {
+            if (segment_offset_ > 0) {
+                advance_segment();
+            }
+        }
+
+    private:
+        static constexpr size_t c_num_segments = 3;
+        static constexpr size_t c_initial_segment_size = 1<<16;
+        static constexpr size_t c_alignment = 16;
+
+        static size_t round_up_to_alignment(size_t n)
+        {
+            return ((n + c_alignment - 1) / c_alignment) * c_alignment;
+        }
+
+        void reallocate(size_t new_segment_size)
+        {
+            // in-flight draws may still be reading from the old buffer, but the driver keeps
+            // it alive until they're done, so it's safe to unmap + drop it here
+            delete_all_fences();
+            unmap();
+
+            if (segment_size_ > 0) {
+                ++stats_.num_reallocations;
+            }
+
+            buffer_ = gl::TypedBufferHandle<GL_ARRAY_BUFFER>{};
+            segment_size_ = round_up_to_alignment(new_segment_size);
+            current_segment_ = 0;
+            segment_offset_ = 0;
+
+            const auto num_bytes = static_cast<GLsizeiptr>(c_num_segments * segment_size_);
+            gl::bind_buffer(buffer_);
+            if (use_persistent_mapping_) {
+                const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+                glBufferStorage(GL_ARRAY_BUFFER, num_bytes, nullptr, flags);
+                mapped_data_ = static_cast<std::byte*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, num_bytes, flags));
+                if (not mapped_data_) {
+                    // mapping failed: fall back to `glBufferSubData` for the rest of the session
+                    log_warn("failed to persistently map a streaming buffer: falling back to glBufferSubData");
+                    use_persistent_mapping_ = false;
+                    buffer_ = gl::TypedBufferHandle<GL_ARRAY_BUFFER>{};
+                    gl::bind_buffer(buffer_);
+                    gl::buffer_data(GL_ARRAY_BUFFER, num_bytes, nullptr, GL_STREAM_DRAW);
+                }
+            }
+            else {
+                gl::buffer_data(GL_ARRAY_BUFFER, num_bytes, nullptr, GL_STREAM_DRAW);
+            }
+        }
+
+        void advance_segment()
+        {
+            // fence the segment that was just written to, so that it isn't overwritten
+            // until the GPU has finished with it
+            fences_[current_segment_] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+            current_segment_ = (current_segment_ + 1) % c_num_segments;
+            segment_offset_ = 0;
+
+            // wait for the GPU to finish with the next segment (usually, it already has)
+            if (GLsync& fence = fences_[current_segment_]) {
+                OSC_PERF("StreamingBuffer::advance_segment/wait");
+                ++stats_.num_fence_waits;
+                const GLenum status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, std::numeric_limits<GLuint64>::max());
+                if (status == GL_WAIT_FAILED) {
+                    log_warn("failed to wait on a streaming buffer segment's fence: the segment may be overwritten while in use");
+                }
+                glDeleteSync(fence);
+                fence = nullptr;
+            }
+        }
+
+        void delete_all_fences()
+        {
+            for (GLsync& fence : fences_) {
+                if (fence) {
+                    glDeleteSync(fence);
+                    fence = nullptr;
+                }
+            }
+        }
+
+        void unmap()
+        {
+            if (mapped_data_) {
+                gl::bind_buffer(buffer_);
+                glUnmapBuffer(GL_ARRAY_BUFFER);
+                mapped_data_ = nullptr;
+            }
+        }
+
+        bool use_persistent_mapping_;
+        gl::TypedBufferHandle<GL_ARRAY_BUFFER> buffer_;
+        std::byte* mapped_data_ = nullptr;
+        size_t segment_size_ = 0;
+        size_t current_segment_ = 0;
+        size_t segment_offset_ = 0;
+        std::array<GLsync, c_num_segments> fences_{};
+        GraphicsStreamingStats stats_;
+    };
+
     struct InstancingState final {
         InstancingState(
-            gl::ArrayBuffer<float, GL_STREAM_DRAW>& buf_,
-            size_t stride_) :
+            GLuint buffer_,
+            size_t stride_,
+            size_t base_offset_) :
 
-            buffer{buf_},
-            stride{stride_}
+            buffer{buffer_},
+            stride{stride_},
+            base_offset{base_offset_}
         {}
 
-        gl::ArrayBuffer<float, GL_STREAM_DRAW>& buffer;
+        GLuint buffer = 0;  // name of the (streaming) buffer that the instance data was written to
         size_t stride = 0;
         size_t base_offset = 0;
     };
@@ -3737,6 +3916,21 @@ namespace
     template<typename T>
     concept UserFacingVertexData = IsAnyOf<T, Vec2, Vec3, Vec4, Vec<4, Unorm8>, Color, Color32>;
 
+    // types that can be directly viewed (i.e. without decoding) in a vertex buffer,
+    // provided that the attribute is stored in `native_vertex_attribute_format<T>()`
+    template<typename T>
+    concept ZeroCopyVertexData = IsAnyOf<T, Vec2, Vec3, Vec4>;
+
+    template<ZeroCopyVertexData T>
+    constexpr VertexAttributeFormat native_vertex_attribute_format()
+    {
+        static_assert(sizeof(T) == T{}.size() * sizeof(float));
+
+        if constexpr (std::same_as<T, Vec2>) { return VertexAttributeFormat::Float32x2; }
+        else if constexpr (std::same_as<T, Vec3>) { return VertexAttributeFormat::Float32x3; }
+        else { return VertexAttributeFormat::Float32x4; }
+    }
+
     // types that are encode-/decode-able into a vertex buffer
     template<typename T>
     concept VertexBufferComponent = IsAnyOf<T, float, Unorm8>;
@@ -4365,6 +4559,36 @@ namespace
             }
         }
 
+        // returns a zero-copy view of the given attribute's data, or `std::nullopt` if the
+        // attribute isn't stored in the buffer in a format that's bit-compatible with `T`
+        template<ZeroCopyVertexData T>
+        std::optional<StridedSpan<const T>> try_view(VertexAttribute attribute) const
+        {
+            return try_view_impl<const T>(data_, vertex_format_, attribute);
+        }
+
+        template<ZeroCopyVertexData T>
+        std::optional<StridedSpan<T>> try_upd_view(VertexAttribute attribute)
+        {
+            return try_view_impl<T>(data_, vertex_format_, attribute);
+        }
+
+        // calls `modifier` with a mutable view of the given attribute's data, which is
+        // zero-copy if possible, or decoded into (and re-encoded from) a temporary buffer
+        // otherwise
+        template<ZeroCopyVertexData T>
+        void modify_attribute(VertexAttribute attribute, const std::function<void(StridedSpan<T>)>& modifier)
+        {
+            if (auto view = try_upd_view<T>(attribute)) {
+                modifier(*view);
+            }
+            else {
+                std::vector<T> values = read<T>(attribute);
+                modifier(StridedSpan<T>{std::span<T>{values}});
+                std::copy(values.begin(), values.end(), iter<T>(attribute).begin());
+            }
+        }
+
         bool emplace_attribute_descriptor(VertexAttributeDescriptor descriptor)
         {
             if (has_attribute(descriptor.attribute())) {
@@ -4412,6 +4636,34 @@ namespace
             data_.assign(data.begin(), data.end());
         }
     private:
+        template<typename T, typename Bytes>
+        static std::optional<StridedSpan<T>> try_view_impl(
+            Bytes& data,
+            const VertexFormat& format,
+            VertexAttribute attribute)
+        {
+            using Value = std::remove_const_t<T>;
+
+            const auto layout = format.attribute_layout(attribute);
+            if (not layout or layout->format() != native_vertex_attribute_format<Value>()) {
+                return std::nullopt;  // not stored, or requires decoding
+            }
+            if (layout->offset() % alignof(Value) != 0 or format.stride() % alignof(Value) != 0) {
+                return std::nullopt;  // cannot be viewed via a (suitably-aligned) `T*`
+            }
+            if (data.empty()) {
+                return StridedSpan<T>{};
+            }
+
+            // note: the buffer is allocated via `operator new`, so its base address is
+            // suitably aligned for any of the `ZeroCopyVertexData` types
+            return StridedSpan<T>{
+                data.data() + layout->offset(),
+                data.size() / format.stride(),
+                format.stride(),
+            };
+        }
+
         std::vector<std::byte> data_;
         VertexFormat vertex_format_;
     };
@@ -4484,6 +4736,19 @@ public:
         version_->reset();
     }
 
+    std::optional<StridedSpan<const Vec3>> try_view_vertices() const
+    {
+        return vertex_buffer_.try_view<Vec3>(VertexAttribute::Position);
+    }
+
+    void modify_vertices(const std::function<void(StridedSpan<Vec3>)>& modifier)
+    {
+        vertex_buffer_.modify_attribute<Vec3>(VertexAttribute::Position, modifier);
+
+        range_check_indices_and_recalculate_bounds();
+        version_->reset();
+    }
+
     bool has_normals() const
     {
         return vertex_buffer_.has_attribute(VertexAttribute::Normal);
@@ -4508,6 +4773,18 @@ public:
         version_->reset();
     }
 
+    std::optional<StridedSpan<const Vec3>> try_view_normals() const
+    {
+        return vertex_buffer_.try_view<Vec3>(VertexAttribute::Normal);
+    }
+
+    void modify_normals(const std::function<void(StridedSpan<Vec3>)>& modifier)
+    {
+        vertex_buffer_.modify_attribute<Vec3>(VertexAttribute::Normal, modifier);
+
+        version_->reset();
+    }
+
     bool has_tex_coords() const
     {
         return vertex_buffer_.has_attribute(VertexAttribute::TexCoord0);
@@ -4532,6 +4809,18 @@ public:
         version_->reset();
     }
 
+    std::optional<StridedSpan<const Vec2>> try_view_tex_coords() const
+    {
+        return vertex_buffer_.try_view<Vec2>(VertexAttribute::TexCoord0);
+    }
+
+    void modify_tex_coords(const std::function<void(StridedSpan<Vec2>)>& modifier)
+    {
+        vertex_buffer_.modify_attribute<Vec2>(VertexAttribute::TexCoord0, modifier);
+
+        version_->reset();
+    }
+
     std::vector<Color> colors() const
     {
         return vertex_buffer_.read<Color>(VertexAttribute::Color);
@@ -4541,7 +4830,7 @@ public:
     {
         vertex_buffer_.write<Color>(VertexAttribute::Color, colors);
 
-        version_.reset();
+        version_->reset();
     }
 
     std::vector<Vec4> tangents() const
@@ -4668,6 +4957,7 @@ public:
     void push_submesh_descriptor(const SubMeshDescriptor& descriptor)
     {
         submesh_descriptors_.push_back(descriptor);
+        version_->reset();
     }
 
     const SubMeshDescriptor& submesh_descriptor_at(size_t pos) const
@@ -4678,6 +4968,7 @@ public:
     void clear_submesh_descriptors()
     {
         submesh_descriptors_.clear();
+        version_->reset();
     }
 
     size_t num_vertex_attributes() const
@@ -4766,6 +5057,8 @@ public:
                 normals[i] = normalize(Vec3{normals[i]});
             }
         }
+
+        version_->reset();
     }
 
     void recalculate_tangents()
@@ -4805,6 +5098,12 @@ public:
         );
 
         vertex_buffer_.write<Vec4>(VertexAttribute::Tangent, tangents);
+        version_->reset();
+    }
+
+    UID version() const
+    {
+        return *version_;
     }
 
     // non-PIMPL methods
@@ -5100,6 +5399,16 @@ void osc::Mesh::transform_vertices(const Mat4& mat4)
     impl_.upd()->transform_vertices(mat4);
 }
 
+std::optional<StridedSpan<const Vec3>> osc::Mesh::try_view_vertices() const
+{
+    return impl_->try_view_vertices();
+}
+
+void osc::Mesh::modify_vertices(const std::function<void(StridedSpan<Vec3>)>& modifier)
+{
+    impl_.upd()->modify_vertices(modifier);
+}
+
 bool osc::Mesh::has_normals() const
 {
     return impl_->has_normals();
@@ -5120,6 +5429,16 @@ void osc::Mesh::transform_normals(const std::function<Vec3(Vec3)>& transformer)
     impl_.upd()->transform_normals(transformer);
 }
 
+std::optional<StridedSpan<const Vec3>> osc::Mesh::try_view_normals() const
+{
+    return impl_->try_view_normals();
+}
+
+void osc::Mesh::modify_normals(const std::function<void(StridedSpan<Vec3>)>& modifier)
+{
+    impl_.upd()->modify_normals(modifier);
+}
+
 bool osc::Mesh::has_tex_coords() const
 {
     return impl_->has_tex_coords();
@@ -5140,6 +5459,16 @@ void osc::Mesh::transform_tex_coords(const std::function<Vec2(Vec2)>& transforme
     impl_.upd()->transform_tex_coords(transformer);
 }
 
+std::optional<StridedSpan<const Vec2>> osc::Mesh::try_view_tex_coords() const
+{
+    return impl_->try_view_tex_coords();
+}
+
+void osc::Mesh::modify_tex_coords(const std::function<void(StridedSpan<Vec2>)>& modifier)
+{
+    impl_.upd()->modify_tex_coords(modifier);
+}
+
 std::vector<Color> osc::Mesh::colors() const
 {
     return impl_->colors();
@@ -5260,6 +5589,11 @@ void osc::Mesh::recalculate_tangents()
     impl_.upd()->recalculate_tangents();
 }
 
+UID osc::Mesh::version() const
+{
+    return impl_->version();
+}
+
 std::ostream& osc::operator<<(std::ostream& o, const Mesh&)
 {
     return o << "Mesh()";
@@ -6132,6 +6466,9 @@ public:
             screenshot_request_queue_.clear();
         }
 
+        // fence this frame's instance data, so that the next frame writes elsewhere
+        instance_gpu_buffer_.on_frame_end();
+
         SDL_GL_SwapWindow(&window);
     }
 
@@ -6170,7 +6507,7 @@ public:
         return instance_cpu_buffer_;
     }
 
-    gl::ArrayBuffer<float, GL_STREAM_DRAW>& updInstanceGPUBuffer()
+    StreamingBuffer& updInstanceGPUBuffer()
     {
         return instance_gpu_buffer_;
     }
@@ -6202,7 +6539,7 @@ private:
 
     // storage for instance data
     std::vector<float> instance_cpu_buffer_;
-    gl::ArrayBuffer<float, GL_STREAM_DRAW> instance_gpu_buffer_;
+    StreamingBuffer instance_gpu_buffer_;
 };
 
 static std::unique_ptr<osc::GraphicsContext::Impl> g_graphics_context_impl = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
@@ -6286,6 +6623,16 @@ std::string osc::GraphicsContext::backend_shading_language_version_string() cons
     return g_graphics_context_impl->backend_shading_language_version_string();
 }
 
+GraphicsStreamingStats osc::GraphicsContext::streaming_stats() const
+{
+    return g_graphics_context_impl->updInstanceGPUBuffer().stats();
+}
+
+void osc::GraphicsContext::reset_streaming_stats()
+{
+    g_graphics_context_impl->updInstanceGPUBuffer().reset_stats();
+}
+
 
 void osc::graphics::draw(
     const Mesh& mesh,
@@ -6380,7 +6727,7 @@ void osc::GraphicsBackend::bind_to_instanced_attributes(
     const Shader::Impl& shader_impl,
     InstancingState& instancing_state)
 {
-    gl::bind_buffer(instancing_state.buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, instancing_state.buffer);
 
     size_t byte_offset = 0;
     if (shader_impl.maybe_instanced_model_mat_attr_) {
@@ -6493,8 +6840,10 @@ std::optional<InstancingState> osc::GraphicsBackend::upload_instance_data(
         }
         OSC_ASSERT_ALWAYS(sizeof(float)*float_offset == render_queue.size() * byte_stride);
 
-        auto& vbo = maybeInstancingState.emplace(g_graphics_context_impl->updInstanceGPUBuffer(), byte_stride).buffer;
-        vbo.assign(std::span<const float>{buf.data(), float_offset});
+        const auto allocation = g_graphics_context_impl->updInstanceGPUBuffer().push(
+            view_object_representations<std::byte>(std::span<const float>{buf.data(), float_offset})
+        );
+        maybeInstancingState.emplace(allocation.buffer, byte_stride, allocation.offset);
     }
     return maybeInstancingState;
 }
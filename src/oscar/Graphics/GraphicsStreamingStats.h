@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+
+namespace osc
+{
+    // counters for data that the graphics backend streamed to the GPU (e.g. per-instance
+    // data), so that upload strategies can be measured/compared
+    struct GraphicsStreamingStats final {
+        size_t num_uploads = 0;
+        size_t num_bytes_uploaded = 0;
+        size_t num_reallocations = 0;  // times the streaming buffer had to grow
+        size_t num_fence_waits = 0;    // times the CPU had to wait for the GPU before reusing part of the buffer
+
+        friend bool operator==(const GraphicsStreamingStats&, const GraphicsStreamingStats&) = default;
+    };
+}
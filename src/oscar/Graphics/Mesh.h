@@ -13,6 +13,8 @@
 #include <oscar/Utils/Concepts.h>
 #include <oscar/Utils/CopyOnUpdPtr.h>
 #include <oscar/Utils/ObjectRepresentation.h>
+#include <oscar/Utils/StridedSpan.h>
+#include <oscar/Utils/UID.h>
 
 #include <cstddef>
 #include <cstdint>
@@ -56,6 +58,18 @@ namespace osc
         void transform_vertices(const Transform&);
         void transform_vertices(const Mat4&);
 
+        // zero-copy access: returns a view of the vertices in the underlying vertex buffer,
+        // or `std::nullopt` if they aren't stored as `Vec3`s (e.g. because the vertex format
+        // was changed via `set_vertex_buffer_params`), in which case callers should fall back
+        // to `vertices()`
+        //
+        // the view is invalidated by any subsequent modification of the mesh
+        std::optional<StridedSpan<const Vec3>> try_view_vertices() const;
+
+        // in-place bulk modification: calls the callback with a mutable view of the vertices
+        // (without copying them, if possible) and then recalculates the mesh's bounds
+        void modify_vertices(const std::function<void(StridedSpan<Vec3>)>&);
+
         // attribute: you can only set an equal amount of normals to the number of
         //            vertices (or zero, which means "clear them")
         bool has_normals() const;
@@ -66,6 +80,8 @@ namespace osc
             set_normals(std::span<const Vec3>{il});
         }
         void transform_normals(const std::function<Vec3(Vec3)>&);
+        std::optional<StridedSpan<const Vec3>> try_view_normals() const;
+        void modify_normals(const std::function<void(StridedSpan<Vec3>)>&);
 
         // attribute: you can only set an equal amount of texture coordinates to
         //            the number of vertices (or zero, which means "clear them")
@@ -77,6 +93,8 @@ namespace osc
             set_tex_coords(std::span<const Vec2>{il});
         }
         void transform_tex_coords(const std::function<Vec2(Vec2)>&);
+        std::optional<StridedSpan<const Vec2>> try_view_tex_coords() const;
+        void modify_tex_coords(const std::function<void(StridedSpan<Vec2>)>&);
 
         // attribute: you can only set an equal amount of colors to the number of
         //            vertices (or zero, which means "clear them")
@@ -174,6 +192,12 @@ namespace osc
         // - creates a tangent vertex attribute if tangents aren't assigned yet
         void recalculate_tangents();
 
+        // returns an ID that changes whenever the mesh's data is modified
+        //
+        // `Mesh`es compare (and hash) by identity, so this is handy for caches that need to
+        // notice in-place modifications
+        UID version() const;
+
         friend bool operator==(const Mesh&, const Mesh&) = default;
         friend std::ostream& operator<<(std::ostream&, const Mesh&);
     private:
@@ -3,6 +3,9 @@
 #include <oscar/Graphics/Mesh.h>
 #include <oscar/Graphics/MeshTopology.h>
 #include <oscar/Graphics/MeshIndicesView.h>
+#include <oscar/Maths/AABB.h>
+#include <oscar/Maths/AABBFunctions.h>
+#include <oscar/Maths/CommonFunctions.h>
 #include <oscar/Maths/GeometricFunctions.h>
 #include <oscar/Maths/MathHelpers.h>
 #include <oscar/Maths/Sphere.h>
@@ -14,14 +17,64 @@
 #include <oscar/Utils/Algorithms.h>
 #include <oscar/Utils/Assertions.h>
 
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <ranges>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 using namespace osc;
 namespace ranges = std::ranges;
 
+namespace
+{
+    // a uniform grid of cubic cells that covers an AABB
+    class ClusteringGrid final {
+    public:
+        // the maximum number of cells along each axis (so that a cell ID fits in 64 bits)
+        static constexpr float max_resolution = static_cast<float>((1<<21) - 1);
+
+        // `cells_along_longest_edge` must be >= 1.0f
+        ClusteringGrid(const AABB& bounds, float cells_along_longest_edge) :
+            origin_{bounds.min},
+            inverse_cell_size_{cells_along_longest_edge / longest_edge_of(bounds)},
+            max_cell_index_{static_cast<uint64_t>(std::ceil(cells_along_longest_edge)) - 1}
+        {}
+
+        uint64_t cell_id_of(const Vec3& p) const
+        {
+            const auto cell_index = [this, &p](Vec3::size_type i)
+            {
+                const auto index = static_cast<uint64_t>(max((p[i] - origin_[i]) * inverse_cell_size_, 0.0f));
+                return min(index, max_cell_index_);
+            };
+            return cell_index(0) | (cell_index(1) << 21) | (cell_index(2) << 42);
+        }
+
+    private:
+        static float longest_edge_of(const AABB& bounds)
+        {
+            const Vec3 dimensions = dimensions_of(bounds);
+            return max(max(max(dimensions.x, dimensions.y), dimensions.z), epsilon_v<float>);
+        }
+
+        Vec3 origin_;
+        float inverse_cell_size_;
+        uint64_t max_cell_index_;
+    };
+
+    size_t count_occupied_cells(const ClusteringGrid& grid, std::span<const Vec3> vertices)
+    {
+        std::unordered_set<uint64_t> occupied;
+        for (const Vec3& vertex : vertices) {
+            occupied.insert(grid.cell_id_of(vertex));
+        }
+        return occupied.size();
+    }
+}
+
 Vec3 osc::average_centroid_of(const Mesh& mesh)
 {
     Vec3d accumulator{};
@@ -174,3 +227,77 @@ Sphere osc::bounding_sphere_of(const Mesh& mesh)
 {
     return bounding_sphere_of(mesh.vertices());
 }
+
+Mesh osc::decimate_by_vertex_clustering(const Mesh& mesh, size_t max_vertices)
+{
+    if (mesh.topology() != MeshTopology::Triangles or mesh.num_vertices() <= max_vertices) {
+        return mesh;
+    }
+
+    const std::vector<Vec3> vertices = mesh.vertices();
+    const AABB bounds = bounding_aabb_of(vertices);
+    const auto fits = [&bounds, &vertices, max_vertices](float resolution)
+    {
+        return count_occupied_cells(ClusteringGrid{bounds, resolution}, vertices) <= max_vertices;
+    };
+
+    // find a (roughly) maximal grid resolution that yields no more than `max_vertices` clusters by
+    // doubling the resolution until it no longer fits and then bisecting the last doubling a couple
+    // of times (the number of occupied cells isn't monotonic in the resolution, so this is a heuristic)
+    float resolution = 1.0f;
+    if (not fits(resolution)) {
+        return Mesh{};  // edge-case: `max_vertices` is zero
+    }
+    while (2.0f*resolution <= ClusteringGrid::max_resolution and fits(2.0f*resolution)) {
+        resolution *= 2.0f;
+    }
+    for (float step = 0.5f*resolution; step >= 1.0f and step >= 0.25f*resolution; step *= 0.5f) {
+        if (resolution + step <= ClusteringGrid::max_resolution and fits(resolution + step)) {
+            resolution += step;
+        }
+    }
+
+    // cluster the vertices
+    const ClusteringGrid grid{bounds, resolution};
+    std::unordered_map<uint64_t, uint32_t> cell_to_cluster;
+    std::vector<Vec3d> cluster_sums;
+    std::vector<uint32_t> cluster_sizes;
+    std::vector<uint32_t> vertex_to_cluster;
+    vertex_to_cluster.reserve(vertices.size());
+    for (const Vec3& vertex : vertices) {
+        const auto [it, inserted] = cell_to_cluster.try_emplace(grid.cell_id_of(vertex), static_cast<uint32_t>(cluster_sums.size()));
+        if (inserted) {
+            cluster_sums.emplace_back();
+            cluster_sizes.push_back(0);
+        }
+        cluster_sums[it->second] += vertex;
+        ++cluster_sizes[it->second];
+        vertex_to_cluster.push_back(it->second);
+    }
+
+    std::vector<Vec3> clustered_vertices;
+    clustered_vertices.reserve(cluster_sums.size());
+    for (size_t i = 0; i < cluster_sums.size(); ++i) {
+        clustered_vertices.emplace_back(cluster_sums[i] / static_cast<double>(cluster_sizes[i]));
+    }
+
+    // remap the triangles onto the clusters, dropping triangles that have collapsed
+    const MeshIndicesView indices = mesh.indices();
+    std::vector<uint32_t> clustered_indices;
+    for (size_t i = 0; i+2 < indices.size(); i += 3) {
+        const uint32_t a = vertex_to_cluster[indices[i]];
+        const uint32_t b = vertex_to_cluster[indices[i+1]];
+        const uint32_t c = vertex_to_cluster[indices[i+2]];
+        if (a != b and b != c and a != c) {
+            clustered_indices.insert(clustered_indices.end(), {a, b, c});
+        }
+    }
+
+    Mesh rv;
+    rv.set_vertices(clustered_vertices);
+    rv.set_indices(clustered_indices);
+    if (mesh.has_normals()) {
+        rv.recalculate_normals();
+    }
+    return rv;
+}
@@ -8,6 +8,7 @@
 #include <oscar/Maths/Vec3.h>
 #include <oscar/Maths/Vec4.h>
 
+#include <cstddef>
 #include <span>
 #include <vector>
 
@@ -39,4 +40,15 @@ namespace osc
 
     // returns the bounding sphere of the given mesh
     Sphere bounding_sphere_of(const Mesh&);
+
+    // returns a decimated copy of the given (triangle) mesh that has, at most, `max_vertices` vertices
+    //
+    // vertices are clustered into the cells of a uniform grid, where each cell is replaced by the
+    // average of its vertices, and triangles that collapse into lines/points are dropped. This is a
+    // fast (and crude) way of producing a preview of a large mesh, but it does not preserve texture
+    // coordinates, colors, or tangents (normals are recalculated, if the mesh has normals)
+    //
+    // returns a copy of the mesh as-is if it's not a triangle mesh or if it already has no more
+    // than `max_vertices` vertices
+    Mesh decimate_by_vertex_clustering(const Mesh&, size_t max_vertices);
 }
@@ -16,6 +16,7 @@
 #include <cstddef>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -80,6 +81,28 @@ namespace
         rv.set_indices({0, 1});
         return rv;
     }
+
+    // a mesh that's only generated when it's first used
+    //
+    // (not every UI uses every cached mesh, and some of them, e.g. the grid, are slow to generate
+    // at startup)
+    class LazyMesh final {
+    public:
+        explicit LazyMesh(Mesh(*generator)()) :
+            generator_{generator}
+        {}
+
+        Mesh get()
+        {
+            std::call_once(generated_, [this]() { mesh_ = generator_(); });
+            return mesh_;
+        }
+
+    private:
+        Mesh(*generator_)();
+        std::once_flag generated_;
+        Mesh mesh_;
+    };
 }
 
 template<>
@@ -116,13 +139,18 @@ public:
         torus_cache.lock()->clear();
     }
 
+    void clear_meshes_if(const std::function<bool(const std::string&)>& predicate)
+    {
+        std::erase_if(*mesh_cache.lock(), [&predicate](const auto& kv) { return predicate(kv.first); });
+    }
+
     Mesh get_mesh(
         const std::string& key,
         const std::function<Mesh()>& getter)
     {
         auto guard = mesh_cache.lock();
 
-        auto [it, inserted] = guard->try_emplace(key, cube);
+        auto [it, inserted] = guard->try_emplace(key, cube.get());
         if (inserted) {
             it->second = getter();
         }
@@ -130,23 +158,23 @@ public:
         return it->second;
     }
 
-    Mesh sphere_mesh() { return sphere; }
-    Mesh circle_mesh() { return circle; }
-    Mesh cylinder_mesh() { return cylinder; }
-    Mesh uncapped_cylinder_mesh() { return uncapped_cylinder; }
-    Mesh brick_mesh() { return cube; }
-    Mesh cone_mesh() { return cone; }
-    Mesh floor_mesh() { return floor; }
-    Mesh grid_mesh() { return grid100x100; }
-    Mesh cube_wireframe_mesh() { return cube_wireframe; }
-    Mesh yline_mesh() { return y_line; }
-    Mesh quad_mesh() { return textured_quad; }
+    Mesh sphere_mesh() { return sphere.get(); }
+    Mesh circle_mesh() { return circle.get(); }
+    Mesh cylinder_mesh() { return cylinder.get(); }
+    Mesh uncapped_cylinder_mesh() { return uncapped_cylinder.get(); }
+    Mesh brick_mesh() { return cube.get(); }
+    Mesh cone_mesh() { return cone.get(); }
+    Mesh floor_mesh() { return floor.get(); }
+    Mesh grid_mesh() { return grid100x100.get(); }
+    Mesh cube_wireframe_mesh() { return cube_wireframe.get(); }
+    Mesh yline_mesh() { return y_line.get(); }
+    Mesh quad_mesh() { return floor.get(); }
     Mesh torus_mesh(float tube_center_radius, float tube_radius)
     {
         const TorusParameters key{tube_center_radius, tube_radius};
 
         auto guard = torus_cache.lock();
-        auto [it, inserted] = guard->try_emplace(key, cube);
+        auto [it, inserted] = guard->try_emplace(key, cube.get());
         if (inserted) {
             it->second = TorusGeometry{key.tube_center_radius, key.tube_radius, 12, 12, Degrees{360}};
         }
@@ -218,17 +246,16 @@ public:
     }
 
 private:
-    Mesh sphere = SphereGeometry{1.0f, 16, 16};
-    Mesh circle = CircleGeometry{1.0f, 16};
-    Mesh cylinder = CylinderGeometry{1.0f, 1.0f, 2.0f, 16};
-    Mesh uncapped_cylinder = CylinderGeometry{1.0f, 1.0f, 2.0f, 16, 1, true};
-    Mesh cube = BoxGeometry{2.0f, 2.0f, 2.0f};
-    Mesh cone = ConeGeometry{1.0f, 2.0f, 16};
-    Mesh floor = PlaneGeometry{2.0f, 2.0f, 1, 1};
-    Mesh grid100x100 = GridGeometry{2.0f, 1000};
-    Mesh cube_wireframe = AABBGeometry{};
-    Mesh y_line = generate_y_to_y_line_mesh();
-    Mesh textured_quad = floor;
+    LazyMesh sphere{[]() -> Mesh { return SphereGeometry{1.0f, 16, 16}; }};
+    LazyMesh circle{[]() -> Mesh { return CircleGeometry{1.0f, 16}; }};
+    LazyMesh cylinder{[]() -> Mesh { return CylinderGeometry{1.0f, 1.0f, 2.0f, 16}; }};
+    LazyMesh uncapped_cylinder{[]() -> Mesh { return CylinderGeometry{1.0f, 1.0f, 2.0f, 16, 1, true}; }};
+    LazyMesh cube{[]() -> Mesh { return BoxGeometry{2.0f, 2.0f, 2.0f}; }};
+    LazyMesh cone{[]() -> Mesh { return ConeGeometry{1.0f, 2.0f, 16}; }};
+    LazyMesh floor{[]() -> Mesh { return PlaneGeometry{2.0f, 2.0f, 1, 1}; }};  // (also used as the textured quad)
+    LazyMesh grid100x100{[]() -> Mesh { return GridGeometry{2.0f, 1000}; }};
+    LazyMesh cube_wireframe{[]() -> Mesh { return AABBGeometry{}; }};
+    LazyMesh y_line{generate_y_to_y_line_mesh};
 
     SynchronizedValue<std::unordered_map<TorusParameters, Mesh>> torus_cache;
     SynchronizedValue<std::unordered_map<std::string, Mesh>> mesh_cache;
@@ -256,6 +283,11 @@ void osc::SceneCache::clear_meshes()
     impl_->clear_meshes();
 }
 
+void osc::SceneCache::clear_meshes_if(const std::function<bool(const std::string&)>& predicate)
+{
+    impl_->clear_meshes_if(predicate);
+}
+
 Mesh osc::SceneCache::get_mesh(
     const std::string& key,
     const std::function<Mesh()>& getter)
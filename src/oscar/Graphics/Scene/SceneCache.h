@@ -27,6 +27,10 @@ namespace osc
         // clear all cached meshes (can be slow: forces a full reload)
         void clear_meshes();
 
+        // clear the cached meshes that have a key for which `predicate` returns `true` (e.g.
+        // because the mesh files that they were loaded from changed on disk)
+        void clear_meshes_if(const std::function<bool(const std::string& key)>& predicate);
+
         // always returns (it will use a dummy cube and print a log error if something fails)
         Mesh get_mesh(const std::string& key, const std::function<Mesh()>& getter);
 
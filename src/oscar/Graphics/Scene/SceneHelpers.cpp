@@ -27,9 +27,11 @@
 #include <oscar/Maths/Vec2.h>
 #include <oscar/Maths/Vec3.h>
 #include <oscar/Utils/Algorithms.h>
+#include <oscar/Utils/StridedSpan.h>
 
 #include <functional>
 #include <optional>
+#include <span>
 #include <vector>
 
 using namespace osc::literals;
@@ -331,11 +333,24 @@ BVH osc::create_triangle_bvh(const Mesh& mesh)
     else if (mesh.topology() != MeshTopology::Triangles) {
         return rv;
     }
-    else if (indices.is_uint32()) {
-        rv.build_from_indexed_triangles(mesh.vertices() , indices.to_uint32_span());
+
+    // build directly from the mesh's vertex buffer, if possible, because meshes can
+    // be large and copying out all of the vertices is expensive
+    std::vector<Vec3> copied_vertices;
+    StridedSpan<const Vec3> vertices;
+    if (const auto view = mesh.try_view_vertices()) {
+        vertices = *view;
+    }
+    else {
+        copied_vertices = mesh.vertices();
+        vertices = StridedSpan<const Vec3>{std::span<const Vec3>{copied_vertices}};
+    }
+
+    if (indices.is_uint32()) {
+        rv.build_from_indexed_triangles(vertices, indices.to_uint32_span());
     }
     else {
-        rv.build_from_indexed_triangles(mesh.vertices(), indices.to_uint16_span());
+        rv.build_from_indexed_triangles(vertices, indices.to_uint16_span());
     }
     return rv;
 }
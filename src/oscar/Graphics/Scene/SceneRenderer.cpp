@@ -26,10 +26,13 @@
 #include <oscar/Maths/Vec2.h>
 #include <oscar/Maths/Vec3.h>
 #include <oscar/Platform/ResourcePath.h>
+#include <oscar/Utils/HashHelpers.h>
 #include <oscar/Utils/Perf.h>
 
 #include <algorithm>
+#include <cstddef>
 #include <memory>
+#include <optional>
 #include <span>
 #include <utility>
 
@@ -69,6 +72,37 @@ namespace
         Mat4 lightspace_mat;
     };
 
+    // the (content-hashed) inputs + outputs of a previously-rendered rims pass, so that
+    // the pass can be skipped if nothing that affects it has changed since the last frame
+    struct CachedRimsPass final {
+        size_t inputs_hash = 0;
+        Mat4 quad_transform;
+    };
+
+    // the (content-hashed) inputs + outputs of a previously-rendered shadowmap pass, so that
+    // the pass can be skipped if nothing that affects it has changed since the last frame
+    struct CachedShadowsPass final {
+        size_t inputs_hash = 0;
+        Mat4 lightspace_mat;
+    };
+
+    // returns a hash of a decoration's geometry (i.e. what would be drawn into a depth/solid pass)
+    size_t hash_of_decoration_geometry(const SceneDecoration& decoration)
+    {
+        // `Mesh`es hash by identity, so hash the mesh's version, which also changes when a caller
+        // modifies the mesh in-place
+        const Transform& t = decoration.transform;
+        return hash_of(
+            decoration.mesh.version(),
+            t.scale,
+            t.rotation.w,
+            t.rotation.x,
+            t.rotation.y,
+            t.rotation.z,
+            t.position
+        );
+    }
+
     struct PolarAngles final {
         Radians theta;
         Radians phi;
@@ -355,6 +389,42 @@ private:
             .position = {centroid_of(rim_ndc_rect), 0.0f},
         };
 
+        // compute where the quad should be drawn in clip space (it's drawn with an identity camera)
+        const Mat4 quad_transform = inverse(params.projection_matrix * params.view_matrix) * mat4_cast(quad_mesh_to_rims_quad);
+
+        // hash everything that affects the rims pass, so that it can be skipped if the
+        // previous frame rendered exactly the same thing
+        size_t inputs_hash = hash_of(
+            params.dimensions,
+            params.antialiasing_level.get_as<int>(),
+            params.view_matrix,
+            params.projection_matrix,
+            params.near_clipping_plane,
+            params.far_clipping_plane,
+            params.rim_color,
+            params.rim_thickness_in_pixels
+        );
+        for (const SceneDecoration& decoration : decorations) {
+            if (decoration.flags & (SceneDecorationFlags::IsSelected | SceneDecorationFlags::IsChildOfSelected)) {
+                inputs_hash = hash_combine(inputs_hash, hash_of(SceneDecorationFlags::IsSelected, hash_of_decoration_geometry(decoration)));
+            }
+            else if (decoration.flags & (SceneDecorationFlags::IsHovered | SceneDecorationFlags::IsChildOfHovered)) {
+                inputs_hash = hash_combine(inputs_hash, hash_of(SceneDecorationFlags::IsHovered, hash_of_decoration_geometry(decoration)));
+            }
+        }
+
+        if (cached_rims_pass_ and cached_rims_pass_->inputs_hash == inputs_hash) {
+            OSC_PERF("SceneRenderer/try_generate_rims/reused");
+
+            // the off-screen texture already contains the rims and the edge detection material's
+            // parameters are unchanged, but the texture is unset after each render (prevents copies)
+            edge_detection_material_.set_render_texture("uScreenTexture", rims_rendertexture_);
+            return RimHighlights{quad_mesh_, cached_rims_pass_->quad_transform, edge_detection_material_};
+        }
+
+        OSC_PERF("SceneRenderer/try_generate_rims/recomputed");
+        cached_rims_pass_.reset();
+
         // rendering:
 
         // setup scene camera
@@ -396,10 +466,12 @@ private:
         edge_detection_material_.set_vec2("uTextureOffset", rim_rect_uv.p1);
         edge_detection_material_.set_vec2("uTextureScale", dimensions_of(rim_rect_uv));
 
+        cached_rims_pass_ = CachedRimsPass{inputs_hash, quad_transform};
+
         // return necessary information for rendering the rims
         return RimHighlights{
             quad_mesh_,
-            inverse(params.projection_matrix * params.view_matrix) * mat4_cast(quad_mesh_to_rims_quad),
+            quad_transform,
             edge_detection_material_,
         };
     }
@@ -412,6 +484,31 @@ private:
             return std::nullopt;  // the caller doesn't actually want shadows
         }
 
+        // hash everything that affects the shadowmap pass, so that it can be skipped if the
+        // previous frame rendered exactly the same thing (the shadowmap is independent of the
+        // viewport, so orbiting the camera around a static scene doesn't affect it)
+        size_t inputs_hash = hash_of(params.light_direction);
+        bool has_shadowcasters = false;
+        for (const SceneDecoration& decoration : decorations) {
+            if (decoration.flags & SceneDecorationFlags::CastsShadows) {
+                inputs_hash = hash_combine(inputs_hash, hash_of_decoration_geometry(decoration));
+                has_shadowcasters = true;
+            }
+        }
+
+        if (not has_shadowcasters) {
+            // there are no shadow casters, so there will be no shadows
+            return std::nullopt;
+        }
+
+        if (cached_shadows_pass_ and cached_shadows_pass_->inputs_hash == inputs_hash) {
+            OSC_PERF("SceneRenderer/try_generate_shadowmap/reused");
+            return Shadows{shadowmap_rendertexture_, cached_shadows_pass_->lightspace_mat};
+        }
+
+        OSC_PERF("SceneRenderer/try_generate_shadowmap/recomputed");
+        cached_shadows_pass_.reset();
+
         // setup scene camera
         camera_.reset();
 
@@ -426,12 +523,6 @@ private:
             }
         }
 
-        if (not shadowcaster_aabbs) {
-            // there are no shadow casters, so there will be no shadows
-            camera_.reset();
-            return std::nullopt;
-        }
-
         // compute camera matrices for the orthogonal (direction) camera used for lighting
         const ShadowCameraMatrices matrices = calc_shadow_camera_matrices(*shadowcaster_aabbs, params.light_direction);
 
@@ -442,7 +533,10 @@ private:
         shadowmap_rendertexture_.set_read_write(RenderTextureReadWrite::Linear);  // it's writing distances
         camera_.render_to(shadowmap_rendertexture_);
 
-        return Shadows{shadowmap_rendertexture_, matrices.projection_mat * matrices.view_mat};
+        const Mat4 lightspace_mat = matrices.projection_mat * matrices.view_mat;
+        cached_shadows_pass_ = CachedShadowsPass{inputs_hash, lightspace_mat};
+
+        return Shadows{shadowmap_rendertexture_, lightspace_mat};
     }
 
     Material scene_colored_els_material_;
@@ -460,6 +554,8 @@ private:
     RenderTexture rims_rendertexture_;
     RenderTexture shadowmap_rendertexture_;
     RenderTexture output_rendertexture_;
+    std::optional<CachedRimsPass> cached_rims_pass_;
+    std::optional<CachedShadowsPass> cached_shadows_pass_;
 };
 
 
@@ -5,6 +5,7 @@
 #include <oscar/Maths/BVHNode.h>
 #include <oscar/Maths/BVHPrim.h>
 #include <oscar/Maths/Vec3.h>
+#include <oscar/Utils/StridedSpan.h>
 
 #include <cstdint>
 #include <cstddef>
@@ -27,6 +28,9 @@ namespace osc
         // triangle `BVH`es
         //
         // `prim.id()` will refer to the index of the first vertex in the triangle
+        //
+        // the `StridedSpan` overloads enable building directly from interleaved vertex
+        // data (e.g. `Mesh::try_view_vertices`) without first copying it out
         void build_from_indexed_triangles(
             std::span<const Vec3> vertices,
             std::span<const uint16_t> indices
@@ -35,6 +39,14 @@ namespace osc
             std::span<const Vec3> vertices,
             std::span<const uint32_t> indices
         );
+        void build_from_indexed_triangles(
+            StridedSpan<const Vec3> vertices,
+            std::span<const uint16_t> indices
+        );
+        void build_from_indexed_triangles(
+            StridedSpan<const Vec3> vertices,
+            std::span<const uint32_t> indices
+        );
 
         // returns the location of the closest ray-triangle collision along the ray, if any
         std::optional<BVHCollision> closest_ray_indexed_triangle_collision(
@@ -47,16 +59,46 @@ namespace osc
             std::span<const uint32_t> indices,
             const Line&
         ) const;
+        std::optional<BVHCollision> closest_ray_indexed_triangle_collision(
+            StridedSpan<const Vec3> vertices,
+            std::span<const uint16_t> indices,
+            const Line&
+        ) const;
+        std::optional<BVHCollision> closest_ray_indexed_triangle_collision(
+            StridedSpan<const Vec3> vertices,
+            std::span<const uint32_t> indices,
+            const Line&
+        ) const;
 
         // `AABB` `BVH`es
         //
         // `prim.id()` will refer to the index of the `AABB`
         void build_from_aabbs(std::span<const AABB>);
 
+        // updates an `AABB` `BVH` so that it bounds the given `AABB`s
+        //
+        // if the `BVH` was built from the same number of `AABB`s, and the same ones are
+        // points, then this refits the existing tree's bounds in-place (which is much cheaper
+        // than rebuilding it), unless refitting would make the tree significantly looser than
+        // a fresh build (e.g. because the `AABB`s moved a long way); otherwise, it behaves
+        // like `build_from_aabbs`
+        //
+        // handy for scenes where only a few things move between frames
+        void update_from_aabbs(std::span<const AABB>);
+
         // calls the callback with each collision between the line and an `AABB` in
         // the `BVH`
         void for_each_ray_aabb_collision(const Line&, const std::function<void(BVHCollision)>&) const;
 
+        // calls the callback with each collision between the line and an `AABB` in the
+        // `BVH` in order of increasing distance along the line
+        //
+        // the callback should return the distance to the closest hit that it has found so far
+        // (e.g. with the triangles inside the `AABB`), or `std::numeric_limits<float>::max()`
+        // if it hasn't found one, so that the traversal can stop as soon as the remaining
+        // `AABB`s are further away than that
+        void for_each_ray_aabb_collision_nearest_first(const Line&, const std::function<float(const BVHCollision&)>&) const;
+
         // returns `true` if the `BVH` contains no `BVHNode`s
         [[nodiscard]] bool empty() const;
 
@@ -79,5 +121,12 @@ namespace osc
 
         // primitives (triangles, `AABB`s) that the nodes reference
         std::vector<BVHPrim> prims_;
+
+        // the number of `AABB`s that the `BVH` was built from (zero for triangle `BVH`es)
+        size_t num_aabbs_ = 0;
+
+        // the (surface area) cost of the tree when it was last built, so that refitting
+        // can detect when the tree has degraded enough to warrant a rebuild
+        float build_cost_ = 0.0f;
     };
 }
@@ -32,6 +32,11 @@ namespace osc
             return bounds_;
         }
 
+        void set_bounds(const AABB& bounds)
+        {
+            bounds_ = bounds;
+        }
+
         bool is_leaf() const
         {
             return (data_ & c_leaf_mask) > 0;
@@ -18,6 +18,7 @@ namespace osc
 
         ptrdiff_t id() const { return id_; }
         const AABB& bounds() const { return bounds_; }
+        void set_bounds(const AABB& bounds) { bounds_ = bounds; }
 
     private:
         ptrdiff_t id_{};
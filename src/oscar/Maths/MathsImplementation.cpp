@@ -16,6 +16,7 @@
 #include <memory>
 #include <numeric>
 #include <optional>
+#include <queue>
 #include <ranges>
 #include <span>
 #include <sstream>
@@ -152,11 +153,25 @@ namespace
         return lhs_hit or rhs_hit;
     }
 
+    // returns the sum of the (half) surface areas of the BVH's internal nodes, which is
+    // proportional to the expected cost of traversing them with a random ray
+    float bvh_surface_area_cost(std::span<const BVHNode> nodes)
+    {
+        float rv = 0.0f;
+        for (const BVHNode& node : nodes) {
+            if (node.is_node()) {
+                const Vec3 dims = dimensions_of(node.bounds());
+                rv += dims.x*dims.y + dims.y*dims.z + dims.z*dims.x;
+            }
+        }
+        return rv;
+    }
+
     template<std::unsigned_integral TIndex>
     std::optional<BVHCollision> bvh_get_closest_ray_indexed_triangle_collision_recursive(
         std::span<const BVHNode> nodes,
         std::span<const BVHPrim> prims,
-        std::span<const Vec3> vertices,
+        StridedSpan<const Vec3> vertices,
         std::span<const TIndex> indices,
         const Line& ray,
         float& closest,
@@ -222,7 +237,7 @@ namespace
     void bvh_build_from_indexed_triangles(
         std::vector<BVHNode>& nodes,
         std::vector<BVHPrim>& prims,
-        std::span<const Vec3> vertices,
+        StridedSpan<const Vec3> vertices,
         std::span<const TIndex> indices)
     {
         // clear out any old data
@@ -256,7 +271,7 @@ namespace
     std::optional<BVHCollision> bvh_get_closest_ray_indexed_triangle_collision(
         std::span<const BVHNode> nodes,
         std::span<const BVHPrim> prims,
-        std::span<const Vec3> vertices,
+        StridedSpan<const Vec3> vertices,
         std::span<const TIndex> indices,
         const Line& ray)
     {
@@ -293,10 +308,23 @@ void osc::BVH::clear()
 {
     nodes_.clear();
     prims_.clear();
+    num_aabbs_ = 0;
+    build_cost_ = 0.0f;
 }
 
 void osc::BVH::build_from_indexed_triangles(std::span<const Vec3> vertices, std::span<const uint16_t> indices)
 {
+    build_from_indexed_triangles(StridedSpan<const Vec3>{vertices}, indices);
+}
+
+void osc::BVH::build_from_indexed_triangles(std::span<const Vec3> vertices, std::span<const uint32_t> indices)
+{
+    build_from_indexed_triangles(StridedSpan<const Vec3>{vertices}, indices);
+}
+
+void osc::BVH::build_from_indexed_triangles(StridedSpan<const Vec3> vertices, std::span<const uint16_t> indices)
+{
+    clear();
     bvh_build_from_indexed_triangles<uint16_t>(
         nodes_,
         prims_,
@@ -305,8 +333,9 @@ void osc::BVH::build_from_indexed_triangles(std::span<const Vec3> vertices, std:
     );
 }
 
-void osc::BVH::build_from_indexed_triangles(std::span<const Vec3> vertices, std::span<const uint32_t> indices)
+void osc::BVH::build_from_indexed_triangles(StridedSpan<const Vec3> vertices, std::span<const uint32_t> indices)
 {
+    clear();
     bvh_build_from_indexed_triangles<uint32_t>(
         nodes_,
         prims_,
@@ -319,6 +348,22 @@ std::optional<BVHCollision> osc::BVH::closest_ray_indexed_triangle_collision(
     std::span<const Vec3> vertices,
     std::span<const uint16_t> indices,
     const Line& line) const
+{
+    return closest_ray_indexed_triangle_collision(StridedSpan<const Vec3>{vertices}, indices, line);
+}
+
+std::optional<BVHCollision> osc::BVH::closest_ray_indexed_triangle_collision(
+    std::span<const Vec3> vertices,
+    std::span<const uint32_t> indices,
+    const Line& line) const
+{
+    return closest_ray_indexed_triangle_collision(StridedSpan<const Vec3>{vertices}, indices, line);
+}
+
+std::optional<BVHCollision> osc::BVH::closest_ray_indexed_triangle_collision(
+    StridedSpan<const Vec3> vertices,
+    std::span<const uint16_t> indices,
+    const Line& line) const
 {
     return bvh_get_closest_ray_indexed_triangle_collision<uint16_t>(
         nodes_,
@@ -330,7 +375,7 @@ std::optional<BVHCollision> osc::BVH::closest_ray_indexed_triangle_collision(
 }
 
 std::optional<BVHCollision> osc::BVH::closest_ray_indexed_triangle_collision(
-    std::span<const Vec3> vertices,
+    StridedSpan<const Vec3> vertices,
     std::span<const uint32_t> indices,
     const Line& line) const
 {
@@ -363,6 +408,53 @@ void osc::BVH::build_from_aabbs(std::span<const AABB> aabbs)
 
     prims_.shrink_to_fit();
     nodes_.shrink_to_fit();
+
+    num_aabbs_ = aabbs.size();
+    build_cost_ = bvh_surface_area_cost(nodes_);
+}
+
+void osc::BVH::update_from_aabbs(std::span<const AABB> aabbs)
+{
+    // refitting can make the tree this much more expensive to traverse than a fresh build before
+    // it's rebuilt
+    constexpr float c_max_refit_cost_ratio = 2.0f;
+
+    if (aabbs.size() != num_aabbs_ or nodes_.empty()) {
+        build_from_aabbs(aabbs);  // the tree was built from different data
+        return;
+    }
+
+    // the existing prims must map onto exactly the same (non-point) `AABB`s
+    if (rgs::count_if(aabbs, [](const AABB& aabb) { return not is_point(aabb); }) != ssize(prims_)) {
+        build_from_aabbs(aabbs);
+        return;
+    }
+    for (BVHPrim& prim : prims_) {
+        const AABB& aabb = aabbs[prim.id()];
+        if (is_point(aabb)) {
+            build_from_aabbs(aabbs);
+            return;
+        }
+        prim.set_bounds(aabb);
+    }
+
+    // nodes are laid out depth-first, with children after their parent, so iterating
+    // backwards refits each child before its parent
+    for (ptrdiff_t i = ssize(nodes_) - 1; i >= 0; --i) {
+        BVHNode& node = nodes_[i];
+        if (node.is_leaf()) {
+            node.set_bounds(prims_[node.first_prim_offset()].bounds());
+        }
+        else {
+            const BVHNode& lhs = nodes_[i + 1];
+            const BVHNode& rhs = nodes_[i + node.num_lhs_nodes() + 1];
+            node.set_bounds(bounding_aabb_of(lhs.bounds(), rhs.bounds()));
+        }
+    }
+
+    if (bvh_surface_area_cost(nodes_) > c_max_refit_cost_ratio * build_cost_) {
+        build_from_aabbs(aabbs);
+    }
 }
 
 void osc::BVH::for_each_ray_aabb_collision(
@@ -382,6 +474,51 @@ void osc::BVH::for_each_ray_aabb_collision(
     );
 }
 
+void osc::BVH::for_each_ray_aabb_collision_nearest_first(
+    const Line& ray,
+    const std::function<float(const BVHCollision&)>& callback) const
+{
+    if (nodes_.empty() or prims_.empty()) {
+        return;
+    }
+
+    // nodes that the ray hits, ordered such that the nearest one is on top
+    struct HitNode final {
+        float distance;
+        size_t nodeidx;
+    };
+    const auto is_further = [](const HitNode& lhs, const HitNode& rhs) { return lhs.distance > rhs.distance; };
+    std::priority_queue<HitNode, std::vector<HitNode>, decltype(is_further)> queue{is_further};
+
+    if (const auto root_collision = find_collision(ray, nodes_.front().bounds())) {
+        queue.push(HitNode{root_collision->distance, 0});
+    }
+
+    float closest = std::numeric_limits<float>::max();
+    while (not queue.empty() and queue.top().distance <= closest) {
+        const HitNode hit = queue.top();
+        queue.pop();
+
+        const BVHNode& node = nodes_[hit.nodeidx];
+        if (node.is_leaf()) {
+            closest = min(closest, callback(BVHCollision{
+                hit.distance,
+                ray.origin + hit.distance*ray.direction,
+                prims_[node.first_prim_offset()].id(),
+            }));
+            continue;
+        }
+
+        // else: it's an internal node, so enqueue whichever children the ray hits
+        for (const size_t child : {hit.nodeidx + 1, hit.nodeidx + node.num_lhs_nodes() + 1}) {
+            const std::optional<RayCollision> collision = find_collision(ray, nodes_[child].bounds());
+            if (collision and collision->distance <= closest) {
+                queue.push(HitNode{collision->distance, child});
+            }
+        }
+    }
+}
+
 bool osc::BVH::empty() const
 {
     return nodes_.empty();
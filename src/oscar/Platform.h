@@ -7,6 +7,7 @@
 #include <oscar/Platform/AppSettings.h>
 #include <oscar/Platform/AppSettingValue.h>
 #include <oscar/Platform/AppSettingValueType.h>
+#include <oscar/Platform/FileWatch.h>
 #include <oscar/Platform/FilesystemResourceLoader.h>
 #include <oscar/Platform/ILogSink.h>
 #include <oscar/Platform/IResourceLoader.h>
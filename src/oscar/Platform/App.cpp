@@ -332,6 +332,16 @@ public:
         return graphics_context_.backend_shading_language_version_string();
     }
 
+    GraphicsStreamingStats graphics_streaming_stats() const
+    {
+        return graphics_context_.streaming_stats();
+    }
+
+    void reset_graphics_streaming_stats()
+    {
+        graphics_context_.reset_streaming_stats();
+    }
+
     size_t num_frames_drawn() const
     {
         return frame_counter_;
@@ -916,6 +926,16 @@ std::string osc::App::graphics_backend_shading_language_version_string() const
     return impl_->graphics_backend_shading_language_version_string();
 }
 
+GraphicsStreamingStats osc::App::graphics_streaming_stats() const
+{
+    return impl_->graphics_streaming_stats();
+}
+
+void osc::App::reset_graphics_streaming_stats()
+{
+    impl_->reset_graphics_streaming_stats();
+}
+
 size_t osc::App::num_frames_drawn() const
 {
     return impl_->num_frames_drawn();
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <oscar/Graphics/AntiAliasingLevel.h>
+#include <oscar/Graphics/GraphicsStreamingStats.h>
 #include <oscar/Maths/Vec2.h>
 #include <oscar/Platform/AppClock.h>
 #include <oscar/Platform/ResourceLoader.h>
@@ -192,6 +193,10 @@ namespace osc
         std::string graphics_backend_version_string() const;
         std::string graphics_backend_shading_language_version_string() const;
 
+        // returns counters for the data that the graphics backend streamed to the GPU (e.g. instance data)
+        GraphicsStreamingStats graphics_streaming_stats() const;
+        void reset_graphics_streaming_stats();
+
         // returns the number of times this `App` has drawn a frame to the screen
         size_t num_frames_drawn() const;
 
@@ -0,0 +1,482 @@
+#include "FileWatch.h"
+
+#include <oscar/Platform/Log.h>
+#include <oscar/Platform/os.h>
+#include <oscar/Shims/Cpp20/stop_token.h>
+#include <oscar/Shims/Cpp20/thread.h>
+#include <oscar/Utils/UID.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+using namespace osc;
+namespace rgs = std::ranges;
+
+namespace
+{
+    // how often the service thread wakes up (to check for stop requests, settled changes, etc.)
+    constexpr std::chrono::milliseconds c_tick_interval{50};
+
+    // how often files are `stat`ed when `inotify` isn't available
+    constexpr std::chrono::milliseconds c_polling_interval{1000};
+
+    std::filesystem::path normalize(const std::filesystem::path& p)
+    {
+        std::error_code ec;
+        std::filesystem::path rv = std::filesystem::weakly_canonical(p, ec);
+        return ec ? p.lexically_normal() : rv;
+    }
+
+    // returns the last write time of `p`, or `std::nullopt` if it doesn't exist
+    std::optional<std::filesystem::file_time_type> try_get_last_write_time(const std::filesystem::path& p)
+    {
+        std::error_code ec;
+        const auto t = std::filesystem::last_write_time(p, ec);
+        return ec ? std::nullopt : std::optional{t};
+    }
+
+    struct PathHasher final {
+        size_t operator()(const std::filesystem::path& p) const
+        {
+            return std::filesystem::hash_value(p);
+        }
+    };
+
+    using PathSet = std::unordered_set<std::filesystem::path, PathHasher>;
+
+    using WriteTimes = std::unordered_map<std::filesystem::path, std::optional<std::filesystem::file_time_type>, PathHasher>;
+
+    struct WatchState final {
+        PathSet paths;
+        WriteTimes polled_write_times;
+        std::chrono::milliseconds settle_interval = FileWatch::default_settle_interval;
+        PathSet unsettled_changes;
+        std::chrono::steady_clock::time_point last_change_time;
+        PathSet settled_changes;
+    };
+
+#ifdef __linux__
+    // owns an `inotify` instance (if one could be initialized)
+    class InotifyHandle final {
+    public:
+        InotifyHandle() :
+            fd_{inotify_init1(IN_NONBLOCK | IN_CLOEXEC)}
+        {
+            if (fd_ == -1) {
+                log_warn("could not initialize inotify (%s): falling back to polling for file changes", errno_to_string_threadsafe().c_str());
+            }
+        }
+        InotifyHandle(const InotifyHandle&) = delete;
+        InotifyHandle(InotifyHandle&&) noexcept = delete;
+        InotifyHandle& operator=(const InotifyHandle&) = delete;
+        InotifyHandle& operator=(InotifyHandle&&) noexcept = delete;
+        ~InotifyHandle() noexcept
+        {
+            if (fd_ != -1) {
+                close(fd_);
+            }
+        }
+
+        int get() const { return fd_; }
+        bool is_valid() const { return fd_ != -1; }
+
+    private:
+        int fd_;
+    };
+#endif
+}
+
+class osc::FileWatch::Service final {
+public:
+    // returns the process-wide service, starting it if no other handle is using it
+    static std::shared_ptr<Service> get()
+    {
+        static std::mutex s_mutex;
+        static std::weak_ptr<Service> s_service;
+
+        std::lock_guard lock{s_mutex};
+        std::shared_ptr<Service> rv = s_service.lock();
+        if (not rv) {
+            rv = std::make_shared<Service>();
+            s_service = rv;
+        }
+        return rv;
+    }
+
+    Service() = default;
+    Service(const Service&) = delete;
+    Service(Service&&) noexcept = delete;
+    Service& operator=(const Service&) = delete;
+    Service& operator=(Service&&) noexcept = delete;
+    ~Service() noexcept = default;  // `thread_` stops + joins
+
+    void set_paths(UID id, const std::vector<std::filesystem::path>& paths, std::chrono::milliseconds settle_interval)
+    {
+        // do the filesystem work before locking, so that the service thread isn't blocked by it
+        PathSet normalized;
+        for (const auto& p : paths) {
+            normalized.insert(normalize(p));
+        }
+        WriteTimes write_times;
+        if (is_polling()) {
+            for (const auto& p : normalized) {
+                write_times.try_emplace(p, try_get_last_write_time(p));
+            }
+        }
+
+        {
+            std::lock_guard lock{mutex_};
+            WatchState& watch = watches_[id];
+            std::erase_if(watch.unsettled_changes, [&normalized](const auto& p) { return not normalized.contains(p); });
+            std::erase_if(watch.settled_changes, [&normalized](const auto& p) { return not normalized.contains(p); });
+            watch.polled_write_times = std::move(write_times);
+            watch.settle_interval = settle_interval;
+            watch.paths = std::move(normalized);
+        }
+
+#ifdef __linux__
+        // watch the new directories before returning, so that a change that the caller makes
+        // right after this call returns isn't missed
+        if (inotify_.is_valid()) {
+            update_watched_directories();
+        }
+#endif
+    }
+
+    void remove(UID id)
+    {
+        std::lock_guard lock{mutex_};
+        watches_.erase(id);
+        watches_changed_ = true;  // (unused directories are unwatched on the service thread)
+    }
+
+    std::vector<std::filesystem::path> take_changes(UID id)
+    {
+        std::lock_guard lock{mutex_};
+        const auto it = watches_.find(id);
+        if (it == watches_.end() or it->second.settled_changes.empty()) {
+            return {};
+        }
+        std::vector<std::filesystem::path> rv(it->second.settled_changes.begin(), it->second.settled_changes.end());
+        it->second.settled_changes.clear();
+        rgs::sort(rv);
+        return rv;
+    }
+
+private:
+    bool is_polling() const
+    {
+#ifdef __linux__
+        return not inotify_.is_valid();
+#else
+        return true;
+#endif
+    }
+
+    void run(const cpp20::stop_token& stop_token)
+    {
+#ifdef __linux__
+        if (inotify_.is_valid()) {
+            run_inotify(stop_token);
+            return;
+        }
+#endif
+        run_polling(stop_token);
+    }
+
+#ifdef __linux__
+    void run_inotify(const cpp20::stop_token& stop_token)
+    {
+        alignas(inotify_event) std::array<char, 8192> buffer{};
+
+        while (not stop_token.stop_requested()) {
+
+            // (also re-arms directories that couldn't be watched, e.g. because they were deleted)
+            if (watches_changed_.exchange(false) or has_unwatched_directories_) {
+                update_watched_directories();
+            }
+
+            pollfd pfd{.fd = inotify_.get(), .events = POLLIN, .revents = 0};
+            if (poll(&pfd, 1, static_cast<int>(c_tick_interval.count())) > 0 and (pfd.revents & POLLIN)) {
+                for (ssize_t len; (len = read(inotify_.get(), buffer.data(), buffer.size())) > 0;) {
+                    for (ssize_t offset = 0; offset < len;) {
+                        const auto* event = reinterpret_cast<const inotify_event*>(buffer.data() + offset);
+                        offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+                        handle_inotify_event(*event);
+                    }
+                }
+            }
+
+            settle_changes();
+        }
+    }
+
+    void handle_inotify_event(const inotify_event& event)
+    {
+        if (event.mask & IN_Q_OVERFLOW) {
+            mark_all_changed();  // events were dropped, so assume the worst
+            return;
+        }
+
+        std::optional<std::filesystem::path> changed;
+        {
+            std::lock_guard lock{directories_mutex_};
+            const auto it = directories_.find(event.wd);
+            if (it == directories_.end()) {
+                return;
+            }
+            if (event.mask & IN_IGNORED) {
+                // the watch was removed (e.g. because the directory was deleted): try to re-arm
+                // it on the next tick, in case the directory is recreated
+                unwatched_directories_.insert(it->second);
+                has_unwatched_directories_ = true;
+                directories_.erase(it);
+            }
+            else if (event.len > 0) {
+                changed = it->second / event.name;
+            }
+        }
+        if (changed) {
+            mark_changed(*changed);
+        }
+    }
+
+    // adds/removes `inotify` watches so that they match the directories that the watched files are in
+    //
+    // can be called from any thread
+    void update_watched_directories()
+    {
+        std::vector<std::filesystem::path> rearmed;
+        {
+            // (the required directories are read while holding `directories_mutex_`, so that
+            // concurrent updates can't apply an older set of directories after a newer one)
+            std::lock_guard lock{directories_mutex_};
+
+            PathSet required;
+            {
+                std::lock_guard watches_lock{mutex_};
+                for (const auto& [_, watch] : watches_) {
+                    for (const auto& p : watch.paths) {
+                        required.insert(p.parent_path());
+                    }
+                }
+            }
+
+            std::erase_if(directories_, [this, &required](const auto& kv)
+            {
+                if (required.contains(kv.second)) {
+                    return false;
+                }
+                inotify_rm_watch(inotify_.get(), kv.first);
+                return true;
+            });
+            std::erase_if(unwatched_directories_, [&required](const auto& dir) { return not required.contains(dir); });
+
+            for (const auto& dir : required) {
+                if (rgs::any_of(directories_, [&dir](const auto& kv) { return kv.second == dir; })) {
+                    continue;  // already watched
+                }
+                constexpr uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE | IN_DELETE | IN_ATTRIB;
+                const int wd = inotify_add_watch(inotify_.get(), dir.c_str(), mask);
+                if (wd != -1) {
+                    directories_.insert_or_assign(wd, dir);
+                    if (unwatched_directories_.erase(dir) > 0) {
+                        rearmed.push_back(dir);
+                    }
+                }
+                else if (unwatched_directories_.insert(dir).second) {
+                    // (only logged once: it's retried every tick until it succeeds)
+                    log_debug("cannot watch %s for changes: %s", dir.string().c_str(), errno_to_string_threadsafe().c_str());
+                }
+            }
+            has_unwatched_directories_ = not unwatched_directories_.empty();
+        }
+
+        // files may have been (re)created in a re-armed directory while it was unwatched
+        for (const auto& dir : rearmed) {
+            mark_all_changed_in(dir);
+        }
+    }
+#endif
+
+    void run_polling(const cpp20::stop_token& stop_token)
+    {
+        auto next_poll = std::chrono::steady_clock::now();
+        while (not stop_token.stop_requested()) {
+            if (std::chrono::steady_clock::now() >= next_poll) {
+                poll_write_times();
+                next_poll = std::chrono::steady_clock::now() + c_polling_interval;
+            }
+            settle_changes();
+            std::this_thread::sleep_for(c_tick_interval);
+        }
+    }
+
+    void poll_write_times()
+    {
+        // copy the paths out, so that the filesystem isn't hit while holding the lock
+        std::vector<std::filesystem::path> paths;
+        {
+            std::lock_guard lock{mutex_};
+            for (const auto& [_, watch] : watches_) {
+                paths.insert(paths.end(), watch.paths.begin(), watch.paths.end());
+            }
+        }
+        rgs::sort(paths);
+        const auto [new_end, _] = rgs::unique(paths);
+        paths.erase(new_end, paths.end());
+
+        std::vector<std::pair<std::filesystem::path, std::optional<std::filesystem::file_time_type>>> write_times;
+        write_times.reserve(paths.size());
+        for (auto& p : paths) {
+            auto t = try_get_last_write_time(p);
+            write_times.emplace_back(std::move(p), t);
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        std::lock_guard lock{mutex_};
+        for (auto& [_, watch] : watches_) {
+            for (const auto& [path, t] : write_times) {
+                const auto it = watch.polled_write_times.find(path);
+                if (it != watch.polled_write_times.end() and it->second != t) {
+                    it->second = t;
+                    watch.unsettled_changes.insert(path);
+                    watch.last_change_time = now;
+                }
+            }
+        }
+    }
+
+    void mark_changed(const std::filesystem::path& path)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        std::lock_guard lock{mutex_};
+        for (auto& [_, watch] : watches_) {
+            if (watch.paths.contains(path)) {
+                watch.unsettled_changes.insert(path);
+                watch.last_change_time = now;
+            }
+        }
+    }
+
+    void mark_all_changed_in(const std::filesystem::path& directory)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        std::lock_guard lock{mutex_};
+        for (auto& [_, watch] : watches_) {
+            for (const auto& p : watch.paths) {
+                if (p.parent_path() == directory) {
+                    watch.unsettled_changes.insert(p);
+                    watch.last_change_time = now;
+                }
+            }
+        }
+    }
+
+    void mark_all_changed()
+    {
+        const auto now = std::chrono::steady_clock::now();
+        std::lock_guard lock{mutex_};
+        for (auto& [_, watch] : watches_) {
+            watch.unsettled_changes.insert(watch.paths.begin(), watch.paths.end());
+            watch.last_change_time = now;
+        }
+    }
+
+    // moves changes that have been quiet for the watch's settle interval into the settled set
+    void settle_changes()
+    {
+        const auto now = std::chrono::steady_clock::now();
+        std::lock_guard lock{mutex_};
+        for (auto& [_, watch] : watches_) {
+            if (not watch.unsettled_changes.empty() and now - watch.last_change_time >= watch.settle_interval) {
+                watch.settled_changes.merge(watch.unsettled_changes);
+                watch.unsettled_changes.clear();
+            }
+        }
+    }
+
+    std::mutex mutex_;
+    std::unordered_map<UID, WatchState> watches_;
+    std::atomic<bool> watches_changed_ = false;
+
+#ifdef __linux__
+    InotifyHandle inotify_;
+
+    // watch descriptor --> directory (guarded separately from `mutex_`, so that adding
+    // watches doesn't block the bookkeeping of changes)
+    std::mutex directories_mutex_;
+    std::unordered_map<int, std::filesystem::path> directories_;
+    PathSet unwatched_directories_;  // required, but couldn't be watched (yet)
+    std::atomic<bool> has_unwatched_directories_ = false;
+#endif
+
+    // last, so that it's destroyed (i.e. stopped and joined) first
+    cpp20::jthread thread_{[this](const cpp20::stop_token& stop_token) { run(stop_token); }};
+};
+
+osc::FileWatch::FileWatch(
+    const std::vector<std::filesystem::path>& paths,
+    std::chrono::milliseconds settle_interval) :
+
+    service_{Service::get()},
+    settle_interval_{settle_interval}
+{
+    service_->set_paths(id_, paths, settle_interval_);
+}
+
+osc::FileWatch::FileWatch(FileWatch&&) noexcept = default;
+
+osc::FileWatch& osc::FileWatch::operator=(FileWatch&& tmp) noexcept
+{
+    if (this != &tmp) {
+        if (service_) {
+            service_->remove(id_);
+        }
+        service_ = std::move(tmp.service_);
+        id_ = tmp.id_;
+        settle_interval_ = tmp.settle_interval_;
+    }
+    return *this;
+}
+
+osc::FileWatch::~FileWatch() noexcept
+{
+    if (service_) {
+        service_->remove(id_);
+    }
+}
+
+void osc::FileWatch::set_paths(const std::vector<std::filesystem::path>& paths)
+{
+    if (not service_) {
+        service_ = Service::get();
+    }
+    service_->set_paths(id_, paths, settle_interval_);
+}
+
+std::vector<std::filesystem::path> osc::FileWatch::take_changes()
+{
+    return service_ ? service_->take_changes(id_) : std::vector<std::filesystem::path>{};
+}
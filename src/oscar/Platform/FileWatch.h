@@ -0,0 +1,58 @@
+#pragma once
+
+#include <oscar/Utils/UID.h>
+
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace osc
+{
+    // a handle to a set of files that a (process-wide) background service watches for changes
+    //
+    // - on Linux, changes are detected with `inotify` (on the files' parent directories, so
+    //   that editors that save by writing a temporary file and renaming it are handled); on
+    //   other platforms, or if `inotify` is unavailable, the files are polled
+    // - bursts of changes (e.g. an editor writing a file in several steps, or a tool rewriting
+    //   many of the watched files at once) are coalesced into one batch of changes, which is
+    //   handed out once the files have been quiet for the watch's settle interval
+    // - the watching happens on the service's thread, so `take_changes` doesn't touch the
+    //   filesystem and is cheap enough to call every frame from the UI thread
+    class FileWatch final {
+    public:
+        static constexpr std::chrono::milliseconds default_settle_interval{250};
+
+        // constructs a handle that doesn't watch anything
+        FileWatch() = default;
+
+        explicit FileWatch(
+            const std::vector<std::filesystem::path>& paths,
+            std::chrono::milliseconds settle_interval = default_settle_interval
+        );
+        FileWatch(const FileWatch&) = delete;
+        FileWatch(FileWatch&&) noexcept;
+        FileWatch& operator=(const FileWatch&) = delete;
+        FileWatch& operator=(FileWatch&&) noexcept;
+        ~FileWatch() noexcept;
+
+        // replaces the set of watched files (e.g. because a document's dependencies changed)
+        //
+        // changes to files that are in both the old and new set are retained, and changes that
+        // are made after this returns are reported
+        void set_paths(const std::vector<std::filesystem::path>& paths);
+
+        // returns the (normalized) paths of the watched files that changed (incl. being created or
+        // deleted) since the last call, and clears them
+        //
+        // changes are only returned once they have settled (i.e. once there have been no further
+        // changes to the watch's files for the settle interval)
+        std::vector<std::filesystem::path> take_changes();
+
+    private:
+        class Service;
+        std::shared_ptr<Service> service_;
+        UID id_;
+        std::chrono::milliseconds settle_interval_ = default_settle_interval;
+    };
+}
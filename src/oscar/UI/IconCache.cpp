@@ -4,6 +4,7 @@
 #include <oscar/Platform/ResourceLoader.h>
 #include <oscar/UI/Icon.h>
 #include <oscar/Utils/Algorithms.h>
+#include <oscar/Utils/SynchronizedValue.h>
 
 #include <memory>
 #include <stdexcept>
@@ -16,43 +17,47 @@ using osc::Icon;
 
 class osc::IconCache::Impl final {
 public:
-    Impl(ResourceLoader& loader_prefixed_at_dir_containing_svgs, float vertical_scale)
+    Impl(ResourceLoader& loader_prefixed_at_dir_containing_svgs, float vertical_scale) :
+        loader_{loader_prefixed_at_dir_containing_svgs},
+        vertical_scale_{vertical_scale}
     {
-        auto it = loader_prefixed_at_dir_containing_svgs.iterate_directory(".");
-
+        // only index the icons here: they're rasterized on first use, because a UI typically
+        // only uses a few of them and rasterizing all of them noticeably slows down startup
+        auto it = loader_.iterate_directory(".");
         for (auto el = it(); el; el = it()) {
             const ResourcePath& p = *el;
-
             if (p.has_extension(".svg")) {
-                Texture2D texture = load_texture2D_from_svg(
-                    loader_prefixed_at_dir_containing_svgs.open(p),
-                    vertical_scale
-                );
-                texture.set_filter_mode(TextureFilterMode::Nearest);
-
-                icons_by_name_.try_emplace(
-                    p.stem(),
-                    std::move(texture),
-                    Rect{{0.0f, 1.0f}, {1.0f, 0.0f}}
-                );
+                icon_paths_by_name_.try_emplace(p.stem(), p);
             }
         }
     }
 
     const Icon& find_or_throw(std::string_view icon_name) const
     {
-        if (const auto* icon = lookup_or_nullptr(icons_by_name_, std::string{icon_name})) {
+        const std::string key{icon_name};
+
+        auto icons = icons_by_name_.lock();
+        if (const auto* icon = lookup_or_nullptr(*icons, key)) {
             return *icon;
         }
-        else {
-            std::stringstream ss;
-            ss << "error finding icon: cannot find: " << icon_name;
-            throw std::runtime_error{std::move(ss).str()};
+        if (const auto* path = lookup_or_nullptr(icon_paths_by_name_, key)) {
+            Texture2D texture = load_texture2D_from_svg(loader_.open(*path), vertical_scale_);
+            texture.set_filter_mode(TextureFilterMode::Nearest);
+
+            // (references to `std::unordered_map` elements are stable, and icons are never removed)
+            return icons->try_emplace(key, std::move(texture), Rect{{0.0f, 1.0f}, {1.0f, 0.0f}}).first->second;
         }
+
+        std::stringstream ss;
+        ss << "error finding icon: cannot find: " << icon_name;
+        throw std::runtime_error{std::move(ss).str()};
     }
 
 private:
-    std::unordered_map<std::string, Icon> icons_by_name_;
+    mutable ResourceLoader loader_;
+    float vertical_scale_;
+    std::unordered_map<std::string, ResourcePath> icon_paths_by_name_;
+    mutable SynchronizedValue<std::unordered_map<std::string, Icon>> icons_by_name_;
 };
 
 
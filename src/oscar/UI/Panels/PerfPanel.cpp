@@ -1,13 +1,18 @@
 #include "PerfPanel.h"
 
+#include <oscar/Graphics/GraphicsStreamingStats.h>
 #include <oscar/Platform/App.h>
 #include <oscar/UI/oscimgui.h>
 #include <oscar/UI/Panels/StandardPanelImpl.h>
 #include <oscar/Utils/Perf.h>
+#include <oscar/Utils/PerfClock.h>
+#include <oscar/Utils/TaskGraph.h>
 
 #include <algorithm>
 #include <chrono>
+#include <cstddef>
 #include <cinttypes>
+#include <cstdint>
 #include <memory>
 #include <ranges>
 #include <string_view>
@@ -47,9 +52,14 @@ private:
         }
         if (ui::draw_button("clear measurements")) {
             clear_all_perf_measurements();
+            App::upd().reset_graphics_streaming_stats();
+            frames_at_reset_ = App::get().num_frames_drawn();
         }
         ui::draw_checkbox("pause", &is_paused_);
 
+        draw_startup_task_timings();
+        draw_graphics_streaming_stats();
+
         std::vector<PerfMeasurement> measurements;
         if (not is_paused_) {
             measurements = get_all_perf_measurements();
@@ -61,12 +71,13 @@ private:
             ImGuiTableFlags_Resizable |
             ImGuiTableFlags_BordersInner;
 
-        if (ui::begin_table("measurements", 6, flags)) {
+        if (ui::begin_table("measurements", 7, flags)) {
             ui::table_setup_column("Label");
             ui::table_setup_column("Source File");
             ui::table_setup_column("Num Calls");
             ui::table_setup_column("Last Duration");
             ui::table_setup_column("Average Duration");
+            ui::table_setup_column("p50 / p95 / p99 Duration");
             ui::table_setup_column("Total Duration");
             ui::table_headers_row();
 
@@ -89,6 +100,13 @@ private:
                 ui::table_set_column_index(column++);
                 ui::draw_text("%" PRId64 " us", static_cast<int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(measurement.average_duration()).count()));
                 ui::table_set_column_index(column++);
+                ui::draw_text(
+                    "%" PRId64 " / %" PRId64 " / %" PRId64 " us",
+                    static_cast<int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(measurement.percentile_duration(0.50)).count()),
+                    static_cast<int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(measurement.percentile_duration(0.95)).count()),
+                    static_cast<int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(measurement.percentile_duration(0.99)).count())
+                );
+                ui::table_set_column_index(column++);
                 ui::draw_text("%" PRId64 " us", static_cast<int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(measurement.total_duration()).count()));
             }
 
@@ -96,7 +114,79 @@ private:
         }
     }
 
+    void draw_graphics_streaming_stats()
+    {
+        if (not ui::draw_collapsing_header("GPU streaming")) {
+            return;
+        }
+
+        const GraphicsStreamingStats stats = App::get().graphics_streaming_stats();
+        ui::set_num_columns(2);
+        ui::draw_text_unformatted("uploads");
+        ui::next_column();
+        ui::draw_text("%zu", stats.num_uploads);
+        ui::next_column();
+        ui::draw_text_unformatted("bytes uploaded");
+        ui::next_column();
+        ui::draw_text("%zu", stats.num_bytes_uploaded);
+        ui::next_column();
+        ui::draw_text_unformatted("bytes per frame");
+        ui::next_column();
+        ui::draw_text("%zu", stats.num_bytes_uploaded / std::max<size_t>(App::get().num_frames_drawn() - frames_at_reset_, 1));
+        ui::next_column();
+        ui::draw_text_unformatted("reallocations");
+        ui::next_column();
+        ui::draw_text("%zu", stats.num_reallocations);
+        ui::next_column();
+        ui::draw_text_unformatted("fence waits");
+        ui::next_column();
+        ui::draw_text("%zu", stats.num_fence_waits);
+        ui::next_column();
+        ui::set_num_columns();
+    }
+
+    void draw_startup_task_timings()
+    {
+        const std::vector<TaskTiming> timings = get_startup_task_timings();
+        if (timings.empty() or not ui::draw_collapsing_header("startup")) {
+            return;
+        }
+
+        const PerfClock::time_point startup_start = rgs::min(timings, rgs::less{}, &TaskTiming::start).start;
+        const PerfClock::time_point startup_end = rgs::max(timings, rgs::less{}, &TaskTiming::end).end;
+        ui::draw_text("total: %" PRId64 " us", static_cast<int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(startup_end - startup_start).count()));
+
+        const ImGuiTableFlags flags =
+            ImGuiTableFlags_NoSavedSettings |
+            ImGuiTableFlags_Resizable |
+            ImGuiTableFlags_BordersInner;
+
+        if (ui::begin_table("startup task timings", 4, flags)) {
+            ui::table_setup_column("Task");
+            ui::table_setup_column("Thread");
+            ui::table_setup_column("Start");
+            ui::table_setup_column("Duration");
+            ui::table_headers_row();
+
+            for (const TaskTiming& timing : timings) {
+                int column = 0;
+                ui::table_next_row();
+                ui::table_set_column_index(column++);
+                ui::draw_text_unformatted(timing.label);
+                ui::table_set_column_index(column++);
+                ui::draw_text("%zu", timing.thread_index);
+                ui::table_set_column_index(column++);
+                ui::draw_text("+%" PRId64 " us", static_cast<int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(timing.start - startup_start).count()));
+                ui::table_set_column_index(column++);
+                ui::draw_text("%" PRId64 " us", static_cast<int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(timing.duration()).count()));
+            }
+
+            ui::end_table();
+        }
+    }
+
     bool is_paused_ = false;
+    size_t frames_at_reset_ = 0;
 };
 
 osc::PerfPanel::PerfPanel(std::string_view panel_name) :
@@ -15,6 +15,7 @@
 #include <oscar/Utils/CStringView.h>
 #include <oscar/Utils/UID.h>
 
+#include <concepts>
 #include <cstddef>
 #include <utility>
 
@@ -681,6 +682,21 @@ namespace osc::ui
         ImGui::SetNextItemOpen(is_open);
     }
 
+    // calls `draw_row(i)` for each `i` in `[0, num_rows)` that's visible in the current panel
+    // and skips the cursor over the rest, so that drawing a long list of same-height rows only
+    // costs as much as drawing the visible ones
+    template<std::invocable<int> RowDrawer>
+    void draw_clipped_rows(int num_rows, RowDrawer&& draw_row)
+    {
+        ImGuiListClipper clipper;
+        clipper.Begin(num_rows);
+        while (clipper.Step()) {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+                draw_row(i);
+            }
+        }
+    }
+
     inline void push_item_flag(ImGuiItemFlags option, bool enabled)
     {
         ImGui::PushItemFlag(option, enabled);
@@ -701,6 +717,11 @@ namespace osc::ui
         return ImGui::IsItemHovered(flags);
     }
 
+    inline bool is_item_toggled_open()
+    {
+        return ImGui::IsItemToggledOpen();
+    }
+
     inline bool is_item_deactivated_after_edit()
     {
         return ImGui::IsItemDeactivatedAfterEdit();
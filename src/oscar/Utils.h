@@ -24,13 +24,16 @@
 #include <oscar/Utils/PerfClock.h>
 #include <oscar/Utils/PerfMeasurement.h>
 #include <oscar/Utils/PerfMeasurementMetadata.h>
+#include <oscar/Utils/PersistentMap.h>
 #include <oscar/Utils/ScopeGuard.h>
 #include <oscar/Utils/Spsc.h>
 #include <oscar/Utils/StdVariantHelpers.h>
+#include <oscar/Utils/StridedSpan.h>
 #include <oscar/Utils/StringHelpers.h>
 #include <oscar/Utils/StringName.h>
 #include <oscar/Utils/SynchronizedValue.h>
 #include <oscar/Utils/SynchronizedValueGuard.h>
+#include <oscar/Utils/TaskGraph.h>
 #include <oscar/Utils/Typelist.h>
 #include <oscar/Utils/UID.h>
 #include <oscar/Utils/UndoRedo.h>
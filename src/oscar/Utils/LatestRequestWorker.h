@@ -0,0 +1,240 @@
+#pragma once
+
+#include <oscar/Platform/Log.h>
+#include <oscar/Shims/Cpp20/stop_token.h>
+#include <oscar/Shims/Cpp20/thread.h>
+#include <oscar/Utils/UID.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace osc
+{
+    // thrown by `LatestRequestCancellation::throw_if_cancelled` (and caught by the worker)
+    // when the request that's being processed has been superseded
+    struct LatestRequestCancelled final {};
+
+    // lets a `LatestRequestWorker`'s processing function check whether the request that
+    // it's processing has been superseded by a newer one
+    class LatestRequestCancellation final {
+    public:
+        LatestRequestCancellation(const std::atomic<UID>& latest_request_id, UID request_id) :
+            latest_request_id_{&latest_request_id},
+            request_id_{request_id}
+        {}
+
+        UID request_id() const { return request_id_; }
+
+        bool is_cancelled() const
+        {
+            return latest_request_id_->load(std::memory_order_relaxed) != request_id_;
+        }
+
+        void throw_if_cancelled() const
+        {
+            if (is_cancelled()) {
+                throw LatestRequestCancelled{};
+            }
+        }
+
+    private:
+        const std::atomic<UID>* latest_request_id_;
+        UID request_id_;
+    };
+
+    // a background worker thread that only cares about the latest of a stream of requests
+    //
+    // - `request`ing new work replaces any pending request and cancels any in-flight one
+    //   (the processing function cooperatively checks for cancellation)
+    // - `poll` (non-blocking) and `wait` (blocks until the latest request is processed)
+    //   return the most recently completed result, if there is one
+    // - `supersede` is for callers that sometimes handle a request themselves (e.g.
+    //   synchronously, because it's cheap): it cancels any pending/in-flight work and
+    //   drops results that are older than the caller's own
+    //
+    // the processing function runs on the worker thread. It returns `std::nullopt` if it
+    // couldn't produce a result (any exception that escapes it is logged and treated the
+    // same way)
+    template<typename Request, typename Result>
+    class LatestRequestWorker final {
+    public:
+        struct Completed final {
+            UID request_id;
+            Result result;
+        };
+
+        using ProcessFunction = std::function<std::optional<Result>(Request&, const LatestRequestCancellation&)>;
+
+        LatestRequestWorker(
+            std::string name,
+            ProcessFunction process,
+            std::function<void()> on_completed = []() {}) :
+
+            worker_{worker_main, shared_, std::move(name), std::move(process), std::move(on_completed)}
+        {}
+
+        LatestRequestWorker(const LatestRequestWorker&) = delete;
+        LatestRequestWorker(LatestRequestWorker&&) noexcept = delete;
+        LatestRequestWorker& operator=(const LatestRequestWorker&) = delete;
+        LatestRequestWorker& operator=(LatestRequestWorker&&) noexcept = delete;
+
+        ~LatestRequestWorker() noexcept
+        {
+            {
+                const std::lock_guard lock{shared_->mutex};
+                shared_->shutdown = true;
+                shared_->latest_request_id.store(UID::empty());  // cancels any in-flight work
+            }
+            shared_->condition.notify_all();
+            // `worker_` joins on destruction
+        }
+
+        // sends a request to the worker and returns its ID (which is newer than any previous ID)
+        UID request(Request request)
+        {
+            const UID id;
+            {
+                const std::lock_guard lock{shared_->mutex};
+                shared_->latest_request_id.store(id);  // cancels any in-flight work
+                shared_->pending.emplace(id, std::move(request));  // replaces any stale request
+            }
+            shared_->condition.notify_all();
+            return id;
+        }
+
+        // cancels any pending/in-flight work, drops any completed result, and returns a new
+        // request ID that's immediately marked as processed (i.e. the caller handled it)
+        UID supersede()
+        {
+            const UID id;
+            {
+                const std::lock_guard lock{shared_->mutex};
+                shared_->latest_request_id.store(id);
+                shared_->pending.reset();
+                shared_->completed.reset();
+                shared_->superseded_id = id;
+                shared_->last_processed_id = std::max(shared_->last_processed_id, id);
+            }
+            shared_->condition.notify_all();
+            return id;
+        }
+
+        // returns (and takes) the most recently completed result, if there is one
+        std::optional<Completed> poll()
+        {
+            const std::lock_guard lock{shared_->mutex};
+            std::optional<Completed> rv = std::move(shared_->completed);
+            shared_->completed.reset();
+            return rv;
+        }
+
+        // blocks until the latest request has been processed, then `poll`s
+        std::optional<Completed> wait()
+        {
+            {
+                std::unique_lock lock{shared_->mutex};
+                shared_->condition.wait(lock, [this]()
+                {
+                    return shared_->last_processed_id >= shared_->latest_request_id.load();
+                });
+            }
+            return poll();
+        }
+
+        // returns `true` if the worker is processing a request, or has a result that hasn't
+        // been `poll`ed yet
+        bool is_busy() const
+        {
+            const std::lock_guard lock{shared_->mutex};
+            return shared_->completed.has_value() or shared_->last_processed_id < shared_->latest_request_id.load();
+        }
+
+        UID latest_request_id() const
+        {
+            return shared_->latest_request_id.load();
+        }
+
+    private:
+        struct Pending final {
+            Pending(UID id_, Request&& request_) : id{id_}, request{std::move(request_)} {}
+
+            UID id;
+            Request request;
+        };
+
+        // state that is shared between the caller and the worker
+        struct SharedState final {
+            std::mutex mutex;
+            std::condition_variable condition;
+            std::optional<Pending> pending;
+            std::optional<Completed> completed;
+            UID last_processed_id = UID::empty();
+            UID superseded_id = UID::empty();
+            bool shutdown = false;
+
+            // written by the caller (while holding `mutex`), polled (lock-free) by the worker
+            std::atomic<UID> latest_request_id{UID::empty()};
+        };
+
+        // top-level "main" function that the worker thread executes
+        static void worker_main(
+            const cpp20::stop_token&,
+            std::shared_ptr<SharedState> shared,
+            std::string name,
+            ProcessFunction process,
+            std::function<void()> on_completed)
+        {
+            while (true) {
+                std::optional<Pending> pending;
+                {
+                    std::unique_lock lock{shared->mutex};
+                    shared->condition.wait(lock, [&shared]() { return shared->pending or shared->shutdown; });
+
+                    if (shared->shutdown) {
+                        return;
+                    }
+
+                    pending = std::move(shared->pending);
+                    shared->pending.reset();
+                }
+
+                std::optional<Result> result;
+                try {
+                    result = process(pending->request, LatestRequestCancellation{shared->latest_request_id, pending->id});
+                }
+                catch (const LatestRequestCancelled&) {
+                    // a newer request superseded this one: drop it
+                }
+                catch (const std::exception& ex) {
+                    log_error("%s: error processing request: %s", name.c_str(), ex.what());
+                }
+
+                bool published = false;
+                {
+                    const std::lock_guard lock{shared->mutex};
+                    if (result and pending->id > shared->superseded_id) {
+                        shared->completed = Completed{pending->id, std::move(*result)};
+                        published = true;
+                    }
+                    shared->last_processed_id = std::max(shared->last_processed_id, pending->id);
+                }
+                shared->condition.notify_all();
+
+                if (published) {
+                    on_completed();
+                }
+            }
+        }
+
+        std::shared_ptr<SharedState> shared_ = std::make_shared<SharedState>();
+        cpp20::jthread worker_;  // joined on destruction, so must be declared last
+    };
+}
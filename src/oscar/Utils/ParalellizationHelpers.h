@@ -1,25 +1,24 @@
 #pragma once
 
 #include <oscar/Utils/Algorithms.h>
+#include <oscar/Utils/StridedSpan.h>
 
 #include <concepts>
 #include <cstddef>
 #include <future>
 #include <span>
 #include <thread>
+#include <utility>
 #include <vector>
 
-namespace osc
+namespace osc::detail
 {
-    // perform a parallelized and "Chunked" ForEach, where each thread receives an
-    // independent chunk of data to process
-    //
-    // this is a poor-man's `std::execution::par_unseq`, because C++17's <execution>
-    // isn't fully integrated into MacOS/Ubuntu20
-    template<typename T, std::invocable<T&> UnaryFunction>
+    // implementation of `for_each_parallel_unsequenced` for any cheaply-copyable view
+    // type that supports `size()` and `operator[]` (e.g. `std::span`, `StridedSpan`)
+    template<typename View, typename UnaryFunction>
     void for_each_parallel_unsequenced(
         size_t min_chunk_size,
-        std::span<T> values,
+        View values,
         UnaryFunction mutator)
     {
         const size_t chunk_size = max(min_chunk_size, values.size()/std::thread::hardware_concurrency());
@@ -58,9 +57,35 @@ namespace osc
         }
         else {
             // chunks would be too small if parallelized: just do it sequentially
-            for (T& value : values) {
+            for (auto& value : values) {
                 mutator(value);
             }
         }
     }
 }
+
+namespace osc
+{
+    // perform a parallelized and "Chunked" ForEach, where each thread receives an
+    // independent chunk of data to process
+    //
+    // this is a poor-man's `std::execution::par_unseq`, because C++17's <execution>
+    // isn't fully integrated into MacOS/Ubuntu20
+    template<typename T, std::invocable<T&> UnaryFunction>
+    void for_each_parallel_unsequenced(
+        size_t min_chunk_size,
+        std::span<T> values,
+        UnaryFunction mutator)
+    {
+        detail::for_each_parallel_unsequenced(min_chunk_size, values, std::move(mutator));
+    }
+
+    template<typename T, std::invocable<T&> UnaryFunction>
+    void for_each_parallel_unsequenced(
+        size_t min_chunk_size,
+        StridedSpan<T> values,
+        UnaryFunction mutator)
+    {
+        detail::for_each_parallel_unsequenced(min_chunk_size, values, std::move(mutator));
+    }
+}
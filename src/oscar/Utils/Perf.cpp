@@ -3,6 +3,7 @@
 #include <oscar/Utils/HashHelpers.h>
 #include <oscar/Utils/SynchronizedValue.h>
 
+#include <span>
 #include <unordered_map>
 #include <string>
 #include <string_view>
@@ -27,6 +28,12 @@ namespace
         static SynchronizedValue<std::unordered_map<size_t, PerfMeasurement>> s_measurement_storage;
         return s_measurement_storage;
     }
+
+    SynchronizedValue<std::vector<TaskTiming>>& get_global_startup_task_timings_storage()
+    {
+        static SynchronizedValue<std::vector<TaskTiming>> s_startup_task_timings;
+        return s_startup_task_timings;
+    }
 }
 
 size_t osc::detail::allocate_perf_mesurement_id(std::string_view label, std::string_view filename, unsigned int line)
@@ -68,3 +75,14 @@ std::vector<PerfMeasurement> osc::get_all_perf_measurements()
     }
     return rv;
 }
+
+void osc::submit_startup_task_timings(std::span<const TaskTiming> timings)
+{
+    auto guard = get_global_startup_task_timings_storage().lock();
+    guard->insert(guard->end(), timings.begin(), timings.end());
+}
+
+std::vector<TaskTiming> osc::get_startup_task_timings()
+{
+    return *get_global_startup_task_timings_storage().lock();
+}
@@ -3,8 +3,10 @@
 #include <oscar/Utils/FilenameExtractor.h>
 #include <oscar/Utils/PerfClock.h>
 #include <oscar/Utils/PerfMeasurement.h>
+#include <oscar/Utils/TaskGraph.h>
 
 #include <cstdint>
+#include <span>
 #include <string_view>
 #include <vector>
 
@@ -13,6 +15,11 @@ namespace osc
     void clear_all_perf_measurements();
     std::vector<PerfMeasurement> get_all_perf_measurements();
 
+    // globally records the timings of tasks that ran while the application was starting up, so
+    // that they can be shown to the user (e.g. in a perf panel)
+    void submit_startup_task_timings(std::span<const TaskTiming>);
+    std::vector<TaskTiming> get_startup_task_timings();
+
     // internal details needed for `OSC_PERF` to work
     namespace detail
     {
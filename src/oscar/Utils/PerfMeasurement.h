@@ -4,7 +4,10 @@
 #include <oscar/Utils/PerfClock.h>
 #include <oscar/Utils/PerfMeasurementMetadata.h>
 
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <cmath>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -37,10 +40,25 @@ namespace osc
 
         PerfClock::duration total_duration() const { return total_duration_; }
 
+        // returns the `p`th percentile (0.0 to 1.0) of the most recent durations
+        PerfClock::duration percentile_duration(double p) const
+        {
+            const size_t n = std::min(call_count_, recent_durations_.size());
+            if (n == 0) {
+                return PerfClock::duration{0};
+            }
+
+            std::array<PerfClock::duration, num_recent_durations> sorted = recent_durations_;
+            const auto nth = sorted.begin() + static_cast<ptrdiff_t>(std::lround(std::clamp(p, 0.0, 1.0) * static_cast<double>(n - 1)));
+            std::nth_element(sorted.begin(), nth, sorted.begin() + static_cast<ptrdiff_t>(n));
+            return *nth;
+        }
+
         void submit(PerfClock::time_point start, PerfClock::time_point end)
         {
             last_duration_ = end - start;
             total_duration_ += last_duration_;
+            recent_durations_[call_count_ % recent_durations_.size()] = last_duration_;
             call_count_++;
         }
 
@@ -52,9 +70,12 @@ namespace osc
         }
 
     private:
+        static constexpr size_t num_recent_durations = 128;
+
         std::shared_ptr<const PerfMeasurementMetadata> metadata_;
         size_t call_count_ = 0;
         PerfClock::duration total_duration_{0};
         PerfClock::duration last_duration_{0};
+        std::array<PerfClock::duration, num_recent_durations> recent_durations_{};  // ring buffer
     };
 }
@@ -0,0 +1,371 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace osc
+{
+    // an ordered associative container with value semantics, where copies share their internal
+    // structure with each other (i.e. a "persistent" datastructure)
+    //
+    // - copying the map is O(1): the copy shares the original's tree nodes
+    // - mutating the map only copies the (shared) nodes along the path to the mutated element,
+    //   which is O(log N), so copies never observe each other's mutations
+    // - elements are iterated in key order, like `std::map`
+    //
+    // implemented as a copy-on-write B+ tree. Erasure doesn't rebalance the tree (it only removes
+    // empty nodes), which is fine for the typical use-case of many small edits to a long-lived map
+    //
+    // like `CopyOnUpdPtr`, a node is considered to be shared if its `std::shared_ptr` has more
+    // than one owner, so copies of the same map shouldn't be concurrently mutated on different
+    // threads without external synchronization
+    template<typename Key, typename T>
+    class PersistentMap final {
+    public:
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = std::pair<Key, T>;
+        using size_type = size_t;
+
+    private:
+        static constexpr size_t c_max_node_size = 32;
+
+        // a node is only split when it overflows, and splits produce half-full nodes, so a tree that's
+        // this deep would need to have been fed (far) more than 2^60 elements
+        static constexpr size_t c_max_depth = 16;
+
+        struct Node final {
+            bool is_leaf() const { return children.empty(); }
+
+            // leaf nodes: the elements, ordered by key
+            std::vector<value_type> elements;
+
+            // inner nodes: the children, where `child_keys[i]` is a lower bound of every key in `children[i]`
+            // (the first child's key is ignored, so that elements can be inserted before it)
+            std::vector<Key> child_keys;
+            std::vector<std::shared_ptr<Node>> children;
+        };
+
+        // a split-off (right-hand) sibling of a node that overflowed during insertion
+        struct Split final {
+            Key first_key;
+            std::shared_ptr<Node> node;
+        };
+
+    public:
+        class const_iterator final {
+        public:
+            using difference_type = ptrdiff_t;
+            using value_type = PersistentMap::value_type;
+            using pointer = const value_type*;
+            using reference = const value_type&;
+            using iterator_category = std::forward_iterator_tag;
+
+            const_iterator() = default;
+
+            reference operator*() const { return leaf_element(); }
+            pointer operator->() const { return &leaf_element(); }
+
+            const_iterator& operator++()
+            {
+                auto& [leaf, index] = path_[depth_ - 1];
+                if (++index < leaf->elements.size()) {
+                    return *this;
+                }
+
+                // move up to the first ancestor that has a next child, then down to its leftmost leaf
+                --depth_;
+                while (depth_ > 0) {
+                    auto& [parent, child_index] = path_[depth_ - 1];
+                    if (++child_index < parent->children.size()) {
+                        push_leftmost_path(parent->children[child_index].get());
+                        return *this;
+                    }
+                    --depth_;
+                }
+                return *this;  // reached the end
+            }
+
+            const_iterator operator++(int)
+            {
+                const_iterator copy{*this};
+                ++(*this);
+                return copy;
+            }
+
+            friend bool operator==(const const_iterator& lhs, const const_iterator& rhs)
+            {
+                if (lhs.depth_ == 0 or rhs.depth_ == 0) {
+                    return lhs.depth_ == rhs.depth_;
+                }
+                return lhs.path_[lhs.depth_ - 1] == rhs.path_[rhs.depth_ - 1];
+            }
+
+        private:
+            friend class PersistentMap;
+
+            const value_type& leaf_element() const
+            {
+                const auto& [leaf, index] = path_[depth_ - 1];
+                return leaf->elements[index];
+            }
+
+            void push(const Node* node, size_t index)
+            {
+                path_[depth_++] = {node, index};
+            }
+
+            void push_leftmost_path(const Node* node)
+            {
+                while (not node->is_leaf()) {
+                    push(node, 0);
+                    node = node->children.front().get();
+                }
+                push(node, 0);
+            }
+
+            // the path from the root to the current element (`depth_ == 0` means "end")
+            std::array<std::pair<const Node*, size_t>, c_max_depth> path_{};
+            size_t depth_ = 0;
+        };
+        using iterator = const_iterator;
+
+        PersistentMap() = default;
+
+        PersistentMap(std::initializer_list<value_type> elements)
+        {
+            for (const auto& [key, value] : elements) {
+                try_emplace(key, value);
+            }
+        }
+
+        const_iterator begin() const
+        {
+            const_iterator rv;
+            if (not empty()) {
+                rv.push_leftmost_path(root_.get());
+            }
+            return rv;
+        }
+
+        const_iterator end() const { return const_iterator{}; }
+
+        [[nodiscard]] bool empty() const { return size_ == 0; }
+        size_type size() const { return size_; }
+
+        const_iterator find(const Key& key) const
+        {
+            if (empty()) {
+                return end();
+            }
+
+            const_iterator rv;
+            const Node* node = root_.get();
+            while (not node->is_leaf()) {
+                const size_t child_index = index_of_child_containing(*node, key);
+                rv.push(node, child_index);
+                node = node->children[child_index].get();
+            }
+
+            const auto it = lower_bound_of(*node, key);
+            if (it == node->elements.end() or it->first != key) {
+                return end();
+            }
+            rv.push(node, static_cast<size_t>(std::distance(node->elements.begin(), it)));
+            return rv;
+        }
+
+        bool contains(const Key& key) const
+        {
+            return find(key) != end();
+        }
+
+        // returns a pointer to the value associated with `key`, or `nullptr` if there is no such value
+        const T* try_get(const Key& key) const
+        {
+            const auto it = find(key);
+            return it != end() ? &it->second : nullptr;
+        }
+
+        // returns a mutable pointer to the value associated with `key`, or `nullptr` if there is no such value
+        //
+        // un-shares the path to the value (if necessary), so the returned pointer is only valid until
+        // the map is next mutated or copied
+        T* try_upd(const Key& key)
+        {
+            if (not contains(key)) {
+                return nullptr;  // don't copy any nodes if there's nothing to update
+            }
+
+            Node* node = upd_unshared(root_);
+            while (not node->is_leaf()) {
+                node = upd_unshared(node->children[index_of_child_containing(*node, key)]);
+            }
+            return &lower_bound_of(*node, key)->second;
+        }
+
+        // inserts a value constructed from `args` if the map doesn't contain `key`
+        //
+        // returns a mutable pointer to the (new or existing) value, which has the same lifetime
+        // as a pointer returned by `try_upd`, and `true` if the value was inserted
+        template<typename... Args>
+        std::pair<T*, bool> try_emplace(const Key& key, Args&&... args)
+        {
+            if (T* existing = try_upd(key)) {
+                return {existing, false};
+            }
+
+            if (not root_) {
+                root_ = std::make_shared<Node>();
+            }
+
+            T* inserted = nullptr;
+            if (auto split = emplace_recursive(root_, key, inserted, std::forward<Args>(args)...)) {
+                // the root overflowed: grow the tree by one level
+                auto new_root = std::make_shared<Node>();
+                new_root->child_keys = {key, std::move(split->first_key)};
+                new_root->children = {std::move(root_), std::move(split->node)};
+                root_ = std::move(new_root);
+            }
+            ++size_;
+            return {inserted, true};
+        }
+
+        // removes the value associated with `key` (if any) and returns the number of removed values (0 or 1)
+        size_type erase(const Key& key)
+        {
+            if (not contains(key)) {
+                return 0;
+            }
+
+            erase_recursive(root_, key);
+            --size_;
+
+            // shrink the tree if the root is left with only one child
+            while (not root_->is_leaf() and root_->children.size() == 1) {
+                root_ = std::move(root_->children.front());
+            }
+            return 1;
+        }
+
+        void clear()
+        {
+            root_.reset();
+            size_ = 0;
+        }
+
+    private:
+        static size_t index_of_child_containing(const Node& node, const Key& key)
+        {
+            const auto it = std::upper_bound(node.child_keys.begin() + 1, node.child_keys.end(), key);
+            return static_cast<size_t>(std::distance(node.child_keys.begin(), it)) - 1;
+        }
+
+        template<typename TNode>
+        static auto lower_bound_of(TNode& leaf, const Key& key)
+        {
+            return std::lower_bound(leaf.elements.begin(), leaf.elements.end(), key, [](const value_type& el, const Key& k)
+            {
+                return el.first < k;
+            });
+        }
+
+        // returns a pointer to a node that's only owned by `ptr`, copying the node if necessary
+        static Node* upd_unshared(std::shared_ptr<Node>& ptr)
+        {
+            if (ptr.use_count() > 1) {
+                ptr = std::make_shared<Node>(*ptr);
+            }
+            return ptr.get();
+        }
+
+        template<typename... Args>
+        static std::optional<Split> emplace_recursive(std::shared_ptr<Node>& ptr, const Key& key, T*& inserted, Args&&... args)
+        {
+            Node* node = upd_unshared(ptr);
+
+            if (node->is_leaf()) {
+                auto it = node->elements.emplace(
+                    lower_bound_of(*node, key),
+                    std::piecewise_construct,
+                    std::forward_as_tuple(key),
+                    std::forward_as_tuple(std::forward<Args>(args)...)
+                );
+                inserted = &it->second;
+
+                if (node->elements.size() <= c_max_node_size) {
+                    return std::nullopt;
+                }
+
+                // else: overflowed, so split the leaf in half
+                const auto mid = node->elements.begin() + static_cast<ptrdiff_t>(node->elements.size()/2);
+                const bool inserted_into_rhs = it >= mid;
+                const size_t inserted_index = static_cast<size_t>(std::distance(inserted_into_rhs ? mid : node->elements.begin(), it));
+
+                auto rhs = std::make_shared<Node>();
+                rhs->elements.assign(std::make_move_iterator(mid), std::make_move_iterator(node->elements.end()));
+                node->elements.erase(mid, node->elements.end());
+                inserted = &(inserted_into_rhs ? rhs->elements : node->elements)[inserted_index].second;
+
+                Key first_key = rhs->elements.front().first;
+                return Split{std::move(first_key), std::move(rhs)};
+            }
+
+            // else: inner node, so insert into the relevant child
+            const size_t child_index = index_of_child_containing(*node, key);
+            auto child_split = emplace_recursive(node->children[child_index], key, inserted, std::forward<Args>(args)...);
+            if (not child_split) {
+                return std::nullopt;
+            }
+
+            const auto offset = static_cast<ptrdiff_t>(child_index + 1);
+            node->child_keys.insert(node->child_keys.begin() + offset, std::move(child_split->first_key));
+            node->children.insert(node->children.begin() + offset, std::move(child_split->node));
+
+            if (node->children.size() <= c_max_node_size) {
+                return std::nullopt;
+            }
+
+            // else: overflowed, so split the inner node in half
+            const auto mid = static_cast<ptrdiff_t>(node->children.size()/2);
+            auto rhs = std::make_shared<Node>();
+            rhs->child_keys.assign(std::make_move_iterator(node->child_keys.begin() + mid), std::make_move_iterator(node->child_keys.end()));
+            rhs->children.assign(std::make_move_iterator(node->children.begin() + mid), std::make_move_iterator(node->children.end()));
+            node->child_keys.erase(node->child_keys.begin() + mid, node->child_keys.end());
+            node->children.erase(node->children.begin() + mid, node->children.end());
+
+            Key first_key = rhs->child_keys.front();
+            return Split{std::move(first_key), std::move(rhs)};
+        }
+
+        // erases `key`, which must be in the tree, and returns `true` if the node is left empty
+        static bool erase_recursive(std::shared_ptr<Node>& ptr, const Key& key)
+        {
+            Node* node = upd_unshared(ptr);
+
+            if (node->is_leaf()) {
+                node->elements.erase(lower_bound_of(*node, key));
+                return node->elements.empty();
+            }
+
+            const size_t child_index = index_of_child_containing(*node, key);
+            if (erase_recursive(node->children[child_index], key)) {
+                const auto offset = static_cast<ptrdiff_t>(child_index);
+                node->child_keys.erase(node->child_keys.begin() + offset);
+                node->children.erase(node->children.begin() + offset);
+            }
+            return node->children.empty();
+        }
+
+        std::shared_ptr<Node> root_;
+        size_type size_ = 0;
+    };
+}
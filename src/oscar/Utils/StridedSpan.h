@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+namespace osc
+{
+    // a non-owning view of `size` elements of type `T` that are `stride` bytes apart
+    //
+    // handy for viewing one member of an interleaved buffer (e.g. the positions in a
+    // vertex buffer that also contains normals, colors, etc.) without copying it out
+    template<typename T>
+    class StridedSpan final {
+    public:
+        using element_type = T;
+        using value_type = std::remove_cv_t<T>;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+        using Byte = std::conditional_t<std::is_const_v<T>, const std::byte, std::byte>;
+
+        class Iterator final {
+        public:
+            using difference_type = ptrdiff_t;
+            using value_type = std::remove_cv_t<T>;
+            using pointer = T*;
+            using reference = T&;
+            using iterator_category = std::random_access_iterator_tag;
+
+            constexpr Iterator() = default;
+
+            constexpr Iterator(Byte* ptr, size_t stride) :
+                ptr_{ptr},
+                stride_{stride}
+            {}
+
+            reference operator*() const { return *reinterpret_cast<pointer>(ptr_); }
+            pointer operator->() const { return reinterpret_cast<pointer>(ptr_); }
+            reference operator[](difference_type n) const { return *(*this + n); }
+
+            constexpr Iterator& operator++() { ptr_ += stride_; return *this; }
+            constexpr Iterator operator++(int) { Iterator copy{*this}; ++(*this); return copy; }
+            constexpr Iterator& operator--() { ptr_ -= stride_; return *this; }
+            constexpr Iterator operator--(int) { Iterator copy{*this}; --(*this); return copy; }
+
+            constexpr Iterator& operator+=(difference_type n)
+            {
+                ptr_ += n * static_cast<difference_type>(stride_);
+                return *this;
+            }
+            constexpr Iterator& operator-=(difference_type n) { return *this += -n; }
+
+            friend constexpr Iterator operator+(Iterator it, difference_type n) { return it += n; }
+            friend constexpr Iterator operator+(difference_type n, Iterator it) { return it += n; }
+            friend constexpr Iterator operator-(Iterator it, difference_type n) { return it -= n; }
+            friend constexpr difference_type operator-(const Iterator& lhs, const Iterator& rhs)
+            {
+                return (lhs.ptr_ - rhs.ptr_) / static_cast<difference_type>(lhs.stride_);
+            }
+
+            friend constexpr bool operator==(const Iterator& lhs, const Iterator& rhs) { return lhs.ptr_ == rhs.ptr_; }
+            friend constexpr auto operator<=>(const Iterator& lhs, const Iterator& rhs) { return lhs.ptr_ <=> rhs.ptr_; }
+
+        private:
+            Byte* ptr_ = nullptr;
+            size_t stride_ = sizeof(T);
+        };
+
+        using iterator = Iterator;
+
+        constexpr StridedSpan() = default;
+
+        // views a contiguous span of elements (i.e. `stride == sizeof(T)`)
+        StridedSpan(std::span<T> elements) :
+            data_{reinterpret_cast<Byte*>(elements.data())},
+            size_{elements.size()}
+        {}
+
+        // views `size` elements, where the first element starts at `data` and each
+        // subsequent element starts `stride` bytes after the previous one
+        //
+        // the caller must ensure that `data` (+ each offset of `stride`) is suitably
+        // aligned for `T`
+        constexpr StridedSpan(Byte* data, size_t size, size_t stride) :
+            data_{data},
+            size_{size},
+            stride_{stride}
+        {}
+
+        // implicit conversion from a mutable view to a read-only one
+        constexpr operator StridedSpan<const T>() const
+            requires (not std::is_const_v<T>)
+        {
+            return StridedSpan<const T>{data_, size_, stride_};
+        }
+
+        constexpr size_t size() const { return size_; }
+        constexpr bool empty() const { return size_ == 0; }
+        constexpr size_t stride() const { return stride_; }
+
+        // returns `true` if the elements are tightly packed (i.e. `as_span` is valid)
+        constexpr bool is_contiguous() const { return stride_ == sizeof(T); }
+
+        // returns the elements as a contiguous span
+        //
+        // throws if the elements aren't contiguous (see: `is_contiguous`)
+        std::span<T> as_span() const
+        {
+            if (not is_contiguous()) {
+                throw std::runtime_error{"cannot view a non-contiguous strided span as a std::span"};
+            }
+            return {reinterpret_cast<pointer>(data_), size_};
+        }
+
+        constexpr iterator begin() const { return Iterator{data_, stride_}; }
+        constexpr iterator end() const { return Iterator{data_ + size_*stride_, stride_}; }
+
+        reference operator[](size_t pos) const
+        {
+            return *reinterpret_cast<pointer>(data_ + pos*stride_);
+        }
+
+        reference at(size_t pos) const
+        {
+            if (pos >= size_) {
+                throw std::out_of_range{"attempted to access an out-of-bounds element of a strided span"};
+            }
+            return (*this)[pos];
+        }
+
+        reference front() const { return (*this)[0]; }
+        reference back() const { return (*this)[size_ - 1]; }
+
+    private:
+        Byte* data_ = nullptr;
+        size_t size_ = 0;
+        size_t stride_ = sizeof(T);
+    };
+}
+
+// a `StridedSpan` doesn't own its elements, so iterators into it can outlive it
+template<typename T>
+inline constexpr bool std::ranges::enable_borrowed_range<osc::StridedSpan<T>> = true;
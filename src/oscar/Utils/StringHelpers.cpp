@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <array>
+#include <charconv>
 #include <cstddef>
 #include <limits>
 #include <optional>
@@ -12,6 +13,7 @@
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <system_error>
 #include <type_traits>
 
 using namespace osc;
@@ -23,16 +25,16 @@ namespace
     {
         '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'
     });
+}
 
-    std::string to_lowercase(std::string_view sv)
+std::string osc::to_lowercase(std::string_view sv)
+{
+    std::string cpy{sv};
+    rgs::transform(cpy, cpy.begin(), [](std::string::value_type c)
     {
-        std::string cpy{sv};
-        rgs::transform(cpy, cpy.begin(), [](std::string::value_type c)
-        {
-            return static_cast<std::string::value_type>(std::tolower(c));
-        });
-        return cpy;
-    }
+        return static_cast<std::string::value_type>(std::tolower(c));
+    });
+    return cpy;
 }
 
 bool osc::contains(std::string_view sv, std::string_view substr)
@@ -132,6 +134,29 @@ std::optional<float> osc::from_chars_strip_whitespace(std::string_view sv)
         return std::nullopt;
     }
 
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    // `std::from_chars` doesn't accept a leading plus symbol, or a `0x` prefix for hex
+    // values, but `std::strtof` does
+    const bool negative = sv.front() == '-';
+    if (sv.front() == '+' or sv.front() == '-') {
+        sv.remove_prefix(1);
+    }
+    std::chars_format format = std::chars_format::general;
+    if (sv.size() > 2 and sv[0] == '0' and (sv[1] == 'x' or sv[1] == 'X')) {
+        sv.remove_prefix(2);
+        format = std::chars_format::hex;
+    }
+    if (sv.empty() or sv.front() == '+' or sv.front() == '-') {
+        return std::nullopt;
+    }
+
+    float fpv = 0.0f;
+    const auto [ptr, ec] = std::from_chars(sv.data(), sv.data() + sv.size(), fpv, format);
+    if (ec != std::errc{} or ptr != sv.data() + sv.size()) {
+        return std::nullopt;  // invalid, out of range, or has trailing characters
+    }
+    return negative ? -fpv : fpv;
+#else
     size_t i = 0;
     float fpv = 0.0f;
 
@@ -147,9 +172,8 @@ std::optional<float> osc::from_chars_strip_whitespace(std::string_view sv)
         return std::nullopt;
     }
 
-    // else: it m
-
     return i == sv.size() ? std::optional<float>{fpv} : std::optional<float>{};
+#endif
 }
 
 std::string osc::truncate_with_ellipsis(std::string_view v, size_t max_length)
@@ -17,6 +17,9 @@ namespace osc
     // returns true if `sv` contains `c`
     bool contains(std::string_view sv, std::string_view::value_type c);
 
+    // returns a copy of `sv` where each character is converted to lowercase (via `std::tolower`)
+    std::string to_lowercase(std::string_view sv);
+
     // returns true if `sv` contains `substr` (case-insensitive)
     bool contains_case_insensitive(std::string_view sv, std::string_view substr);
 
@@ -43,15 +46,19 @@ namespace osc
     //
     // - strips leading and trailing whitespace
     //
-    // - parses the remaining characters as a locale-dependent floating point
-    //   number, internally using something like `std::strtof` (which depends
-    //   on C locale - careful)
+    // - parses the remaining characters as a floating point number (incl. a
+    //   leading plus symbol, like `std::strtof`)
     //
     // returns the resulting float if sucessful, or `std::nullopt` if it fails
     //
-    // the reason this function exists is because, at time of writing, C++'s
-    // <charconv> `std::from_chars` function isn't implemented in Mac OSX
-    // or Ubuntu20. When they are, feel free to nuke this from orbit.
+    // internally, this uses <charconv>'s (locale-independent, non-allocating)
+    // `std::from_chars` where the standard library supports it for floating
+    // point values, and falls back to `std::strtof`-like parsing (which depends
+    // on C locale - careful) where it doesn't (e.g. Mac OSX, Ubuntu20)
+    //
+    // either way, it accepts the same inputs as `std::strtof` (e.g. a leading `+`, hex values,
+    // `inf`, `nan`), but returns `std::nullopt` if the value is out of range or if there are
+    // any trailing (non-whitespace) characters
     //
     // see the unittest suite for some of the more unusual things to consider
     std::optional<float> from_chars_strip_whitespace(std::string_view sv);
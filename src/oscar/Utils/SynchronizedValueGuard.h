@@ -16,6 +16,12 @@ namespace osc
             value_ptr_{&value_ref}
         {}
 
+        // adopts a `mutex` that the calling thread has already locked
+        SynchronizedValueGuard(std::mutex& mutex, std::adopt_lock_t, T& value_ref) :
+            mutex_guard_{mutex, std::adopt_lock},
+            value_ptr_{&value_ref}
+        {}
+
         T& operator*() & { return *value_ptr_; }
         const T& operator*() const & { return *value_ptr_; }
         T* operator->() { return value_ptr_; }
@@ -0,0 +1,166 @@
+#include "TaskGraph.h"
+
+#include <oscar/Shims/Cpp20/stop_token.h>
+#include <oscar/Shims/Cpp20/thread.h>
+#include <oscar/Utils/Assertions.h>
+#include <oscar/Utils/PerfClock.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace osc;
+
+osc::TaskGraph::TaskID osc::TaskGraph::add(
+    std::string label,
+    std::function<void()> task,
+    std::initializer_list<TaskID> dependencies,
+    TaskFlags flags)
+{
+    const TaskID id = tasks_.size();
+    for (TaskID dependency : dependencies) {
+        OSC_ASSERT_ALWAYS(dependency < id && "a task can only depend on tasks that were previously added to the graph");
+    }
+    tasks_.push_back({std::move(label), std::move(task), std::vector<TaskID>(dependencies), flags});
+    return id;
+}
+
+std::vector<TaskTiming> osc::TaskGraph::run()
+{
+    if (tasks_.empty()) {
+        return {};
+    }
+
+    // precompute the graph's edges in the "forward" direction
+    std::vector<std::vector<TaskID>> dependents(tasks_.size());
+    std::vector<size_t> num_unfinished_dependencies(tasks_.size());
+    for (TaskID id = 0; id < tasks_.size(); ++id) {
+        num_unfinished_dependencies[id] = tasks_[id].dependencies.size();
+        for (TaskID dependency : tasks_[id].dependencies) {
+            dependents[dependency].push_back(id);
+        }
+    }
+
+    // shared scheduling state (guarded by `mutex`)
+    std::mutex mutex;
+    std::condition_variable state_changed;
+    std::deque<TaskID> ready_tasks;
+    std::deque<TaskID> ready_calling_thread_tasks;
+    size_t num_finished = 0;
+    std::exception_ptr first_exception;
+    std::vector<std::optional<TaskTiming>> timings(tasks_.size());
+
+    const auto push_ready = [this, &ready_tasks, &ready_calling_thread_tasks](TaskID id)
+    {
+        if (tasks_[id].flags & TaskFlags::RunOnCallingThread) {
+            ready_calling_thread_tasks.push_back(id);
+        }
+        else {
+            ready_tasks.push_back(id);
+        }
+    };
+
+    for (TaskID id = 0; id < tasks_.size(); ++id) {
+        if (num_unfinished_dependencies[id] == 0) {
+            push_ready(id);
+        }
+    }
+
+    // runs the given task (unless a previous task threw), then schedules its dependents
+    const auto execute = [&](std::unique_lock<std::mutex>& lock, TaskID id, size_t thread_index)
+    {
+        if (not first_exception) {
+            lock.unlock();
+            TaskTiming timing{.label = tasks_[id].label, .start = PerfClock::now(), .end = {}, .thread_index = thread_index};
+            std::exception_ptr exception;
+            try {
+                tasks_[id].function();
+            }
+            catch (...) {
+                exception = std::current_exception();
+            }
+            timing.end = PerfClock::now();
+            lock.lock();
+
+            timings[id] = std::move(timing);
+            if (exception and not first_exception) {
+                first_exception = exception;
+            }
+        }
+
+        // (skipped tasks still "finish", so that the skipping propagates through the graph)
+        ++num_finished;
+        for (TaskID dependent : dependents[id]) {
+            if (--num_unfinished_dependencies[dependent] == 0) {
+                push_ready(dependent);
+            }
+        }
+        state_changed.notify_all();
+    };
+
+    // spin up workers for the tasks that can run on any thread
+    const auto num_worker_tasks = static_cast<size_t>(std::count_if(tasks_.begin(), tasks_.end(), [](const Task& task)
+    {
+        return not (task.flags & TaskFlags::RunOnCallingThread);
+    }));
+    const size_t num_workers = std::min(num_worker_tasks, static_cast<size_t>(std::max(std::thread::hardware_concurrency(), 2u) - 1));
+
+    std::vector<cpp20::jthread> workers;
+    workers.reserve(num_workers);
+    for (size_t i = 0; i < num_workers; ++i) {
+        workers.emplace_back([&, thread_index = i+1](const cpp20::stop_token&)
+        {
+            std::unique_lock lock{mutex};
+            while (true) {
+                state_changed.wait(lock, [&]() { return not ready_tasks.empty() or num_finished == tasks_.size(); });
+                if (ready_tasks.empty()) {
+                    return;  // all tasks have finished
+                }
+                const TaskID id = ready_tasks.front();
+                ready_tasks.pop_front();
+                execute(lock, id, thread_index);
+            }
+        });
+    }
+
+    // the calling thread runs the tasks that must run on it, and helps out with the others
+    {
+        std::unique_lock lock{mutex};
+        while (num_finished < tasks_.size()) {
+            state_changed.wait(lock, [&]()
+            {
+                return not ready_calling_thread_tasks.empty() or not ready_tasks.empty() or num_finished == tasks_.size();
+            });
+
+            std::deque<TaskID>& queue = not ready_calling_thread_tasks.empty() ? ready_calling_thread_tasks : ready_tasks;
+            if (queue.empty()) {
+                continue;
+            }
+            const TaskID id = queue.front();
+            queue.pop_front();
+            execute(lock, id, 0);
+        }
+    }
+    workers.clear();  // join
+
+    if (first_exception) {
+        std::rethrow_exception(first_exception);
+    }
+
+    std::vector<TaskTiming> rv;
+    rv.reserve(timings.size());
+    for (auto& timing : timings) {
+        rv.push_back(std::move(timing).value());
+    }
+    return rv;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <oscar/Shims/Cpp23/utility.h>
+#include <oscar/Utils/PerfClock.h>
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+namespace osc
+{
+    enum class TaskFlags {
+        None               = 0,
+        RunOnCallingThread = 1<<0,  // e.g. because the task uses thread-affine APIs (OpenGL, SDL, etc.)
+    };
+
+    constexpr bool operator&(TaskFlags lhs, TaskFlags rhs)
+    {
+        return cpp23::to_underlying(lhs) & cpp23::to_underlying(rhs);
+    }
+
+    // timing information about one task that was ran by a `TaskGraph`
+    struct TaskTiming final {
+
+        PerfClock::duration duration() const { return end - start; }
+
+        std::string label;
+        PerfClock::time_point start;
+        PerfClock::time_point end;
+        size_t thread_index = 0;  // 0 == the thread that called `TaskGraph::run`
+    };
+
+    // a graph of labelled tasks, where each task may depend on (i.e. must run after) other
+    // tasks in the graph
+    //
+    // `run` runs independent tasks concurrently, which is handy for (e.g.) application
+    // initialization, where there are many independent initializers that may be slow
+    class TaskGraph final {
+    public:
+        using TaskID = size_t;
+
+        // adds a task to the graph and returns its ID
+        //
+        // `dependencies` must be IDs of tasks that were previously added to this graph (so
+        // the graph can't contain cycles)
+        TaskID add(
+            std::string label,
+            std::function<void()> task,
+            std::initializer_list<TaskID> dependencies = {},
+            TaskFlags = TaskFlags::None
+        );
+
+        size_t size() const { return tasks_.size(); }
+        [[nodiscard]] bool empty() const { return tasks_.empty(); }
+
+        // runs all tasks in the graph and blocks until they have finished, returning their
+        // timings in the order that they were added to the graph
+        //
+        // if a task throws an exception, the tasks that haven't started yet are skipped and
+        // the (first) exception is rethrown once the running tasks have finished
+        std::vector<TaskTiming> run();
+
+    private:
+        struct Task final {
+            std::string label;
+            std::function<void()> function;
+            std::vector<TaskID> dependencies;
+            TaskFlags flags;
+        };
+
+        std::vector<Task> tasks_;
+    };
+}
@@ -0,0 +1,54 @@
+#include "TemporaryDirectory.h"
+
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+using namespace osc;
+
+namespace
+{
+    std::string generate_random_suffix(std::mt19937_64& rng)
+    {
+        constexpr std::string_view c_chars = "0123456789abcdefghijklmnopqrstuvwxyz";
+        std::uniform_int_distribution<size_t> dist{0, c_chars.size() - 1};
+
+        std::string rv(12, '\0');
+        for (char& c : rv) {
+            c = c_chars[dist(rng)];
+        }
+        return rv;
+    }
+
+    std::filesystem::path create_unique_temporary_directory(std::string_view prefix)
+    {
+        const std::filesystem::path temp_dir = std::filesystem::temp_directory_path();
+
+        std::random_device rd;
+        std::mt19937_64 rng{(static_cast<std::mt19937_64::result_type>(rd()) << 32) ^ rd()};
+
+        constexpr int c_max_attempts = 100;
+        for (int i = 0; i < c_max_attempts; ++i) {
+            std::filesystem::path candidate = temp_dir / (std::string{prefix} + generate_random_suffix(rng));
+            if (std::filesystem::create_directory(candidate)) {
+                return candidate;  // it didn't exist before, so it's ours
+            }
+        }
+        throw std::runtime_error{"failed to create a uniquely-named temporary directory"};
+    }
+}
+
+osc::TemporaryDirectory::TemporaryDirectory(std::string_view prefix) :
+    path_{create_unique_temporary_directory(prefix)}
+{}
+
+osc::TemporaryDirectory::~TemporaryDirectory() noexcept
+{
+    std::error_code ec;
+    std::filesystem::remove_all(path_, ec);
+}
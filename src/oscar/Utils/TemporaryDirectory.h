@@ -0,0 +1,27 @@
+#pragma once
+
+#include <filesystem>
+#include <string_view>
+
+namespace osc
+{
+    // a uniquely-named directory in the system's temporary directory that is (recursively)
+    // deleted when it goes out of scope
+    //
+    // the directory's name is `prefix` followed by a random suffix, so that concurrently
+    // running processes (e.g. parallel test runs) don't collide
+    class TemporaryDirectory final {
+    public:
+        explicit TemporaryDirectory(std::string_view prefix = "oscar_");
+        TemporaryDirectory(const TemporaryDirectory&) = delete;
+        TemporaryDirectory(TemporaryDirectory&&) noexcept = delete;
+        TemporaryDirectory& operator=(const TemporaryDirectory&) = delete;
+        TemporaryDirectory& operator=(TemporaryDirectory&&) noexcept = delete;
+        ~TemporaryDirectory() noexcept;
+
+        const std::filesystem::path& path() const { return path_; }
+
+    private:
+        std::filesystem::path path_;
+    };
+}
@@ -0,0 +1,173 @@
+#include <OpenSimCreator/Documents/MeshWarper/BatchMeshWarper.h>
+
+#include <TestOpenSimCreator/TestOpenSimCreatorConfig.h>
+
+#include <OpenSimCreator/Documents/Landmarks/LandmarkHelpers.h>
+#include <OpenSimCreator/Documents/MeshWarper/TPSDocument.h>
+#include <OpenSimCreator/Documents/MeshWarper/TPSDocumentHelpers.h>
+#include <OpenSimCreator/Documents/MeshWarper/TPSDocumentInputIdentifier.h>
+#include <OpenSimCreator/Graphics/SimTKMeshLoader.h>
+#include <OpenSimCreator/Utils/TPS3D.h>
+#include <gtest/gtest.h>
+#include <oscar/Graphics/Mesh.h>
+#include <oscar/Maths/GeometricFunctions.h>
+#include <oscar/Maths/Vec3.h>
+#include <oscar/Utils/TemporaryDirectory.h>
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    std::filesystem::path const c_FixturesDirectory = std::filesystem::path{OSC_TESTING_RESOURCES_DIR} / "Document/ModelWarper/PofPaired";
+    std::filesystem::path const c_SourceLandmarksCSV = c_FixturesDirectory / "Geometry/sphere.landmarks.csv";
+    std::filesystem::path const c_DestinationLandmarksCSV = c_FixturesDirectory / "DestinationGeometry/sphere.landmarks.csv";
+    std::filesystem::path const c_SourceMesh = c_FixturesDirectory / "Geometry/sphere.obj";
+
+    // returns the expected (exact) warp of the given mesh, as computed via the mesh warper's document model
+    Mesh CalcExpectedWarpedMesh(Mesh const& mesh)
+    {
+        TPSDocument doc;
+        for (auto const& [which, csvPath] : {std::pair{TPSDocumentInputIdentifier::Source, c_SourceLandmarksCSV}, std::pair{TPSDocumentInputIdentifier::Destination, c_DestinationLandmarksCSV}})
+        {
+            std::ifstream fin{csvPath};
+            lm::ReadLandmarksFromCSV(fin, [&doc, which](auto&& landmark)
+            {
+                AddLandmarkToInput(doc, which, landmark.position, std::move(landmark.maybeName));
+            });
+        }
+        TPSCoefficients3D const coefs = CalcCoefficients(TPSCoefficientSolverInputs3D{GetLandmarkPairs(doc)});
+        return ApplyThinPlateWarpToMesh(coefs, mesh, 1.0f);
+    }
+}
+
+TEST(FindMeshFilesForBatchWarping, ReturnsMeshFilesInADirectory)
+{
+    std::vector<std::filesystem::path> const expected = {c_SourceMesh};
+    ASSERT_EQ(FindMeshFilesForBatchWarping(c_FixturesDirectory / "Geometry"), expected);
+}
+
+TEST(FindMeshFilesForBatchWarping, ReturnsMeshFilesThatMatchAWildcardPattern)
+{
+    std::vector<std::filesystem::path> const expected = {c_SourceMesh};
+    ASSERT_EQ(FindMeshFilesForBatchWarping(c_FixturesDirectory / "Geometry/sph*.obj"), expected);
+    ASSERT_EQ(FindMeshFilesForBatchWarping(c_FixturesDirectory / "Geometry/?phere.*"), expected);
+    ASSERT_TRUE(FindMeshFilesForBatchWarping(c_FixturesDirectory / "Geometry/cube*").empty());
+}
+
+TEST(FindMeshFilesForBatchWarping, ThrowsIfAPatternsDirectoryDoesNotExist)
+{
+    ASSERT_THROW({ FindMeshFilesForBatchWarping(c_FixturesDirectory / "doesnt-exist/*.obj"); }, std::exception);
+}
+
+TEST(WarpMeshesInBatch, WritesTheSameWarpAsTheMeshWarper)
+{
+    TemporaryDirectory const outputDirectory;
+
+    BatchMeshWarperParams params;
+    params.sourceLandmarksCSV = c_SourceLandmarksCSV;
+    params.destinationLandmarksCSV = c_DestinationLandmarksCSV;
+    params.inputMeshes = {c_SourceMesh};
+    params.outputDirectory = outputDirectory.path();
+
+    BatchMeshWarperReport const report = WarpMeshesInBatch(params);
+
+    ASSERT_EQ(report.numMeshesWritten, 1);
+    ASSERT_GT(report.numLandmarkPairs, 0);
+    ASSERT_EQ(report.loading.numMeshes, 1);
+    ASSERT_EQ(report.warping.numMeshes, 1);
+    ASSERT_EQ(report.writing.numMeshes, 1);
+
+    Mesh const input = LoadMeshViaSimTK(c_SourceMesh);
+    Mesh const expected = CalcExpectedWarpedMesh(input);
+    Mesh const written = LoadMeshViaSimTK(outputDirectory.path() / "sphere.obj");
+
+    ASSERT_EQ(written.num_vertices(), expected.num_vertices());
+    std::vector<Vec3> const expectedVertices = expected.vertices();
+    std::vector<Vec3> const writtenVertices = written.vertices();
+    for (size_t i = 0; i < expectedVertices.size(); ++i)
+    {
+        ASSERT_LT(length(writtenVertices[i] - expectedVertices[i]), 1e-4f);  // (OBJ files are text)
+    }
+}
+
+TEST(WarpMeshesInBatch, WritesAWarpWithinTheErrorToleranceIfOneIsProvided)
+{
+    TemporaryDirectory const outputDirectory;
+
+    BatchMeshWarperParams params;
+    params.sourceLandmarksCSV = c_SourceLandmarksCSV;
+    params.destinationLandmarksCSV = c_DestinationLandmarksCSV;
+    params.inputMeshes = {c_SourceMesh};
+    params.outputDirectory = outputDirectory.path();
+    params.errorTolerance = 1e-3f;
+
+    BatchMeshWarperReport const report = WarpMeshesInBatch(params);
+    ASSERT_EQ(report.numMeshesWritten, 1);
+
+    Mesh const input = LoadMeshViaSimTK(c_SourceMesh);
+    Mesh const expected = CalcExpectedWarpedMesh(input);
+    Mesh const written = LoadMeshViaSimTK(outputDirectory.path() / "sphere.obj");
+
+    ASSERT_EQ(written.num_vertices(), expected.num_vertices());
+    std::vector<Vec3> const expectedVertices = expected.vertices();
+    std::vector<Vec3> const writtenVertices = written.vertices();
+    for (size_t i = 0; i < expectedVertices.size(); ++i)
+    {
+        ASSERT_LT(length(writtenVertices[i] - expectedVertices[i]), *params.errorTolerance + 1e-4f);  // (OBJ files are text)
+    }
+}
+
+TEST(WarpMeshesInBatch, ThrowsIfTwoInputsWouldBeWrittenToTheSameFile)
+{
+    TemporaryDirectory const outputDirectory;
+
+    BatchMeshWarperParams params;
+    params.sourceLandmarksCSV = c_SourceLandmarksCSV;
+    params.destinationLandmarksCSV = c_DestinationLandmarksCSV;
+    params.inputMeshes = {c_SourceMesh, c_FixturesDirectory / "DestinationGeometry/sphere.obj"};
+    params.outputDirectory = outputDirectory.path();
+
+    ASSERT_THROW({ WarpMeshesInBatch(params); }, std::exception);
+}
+
+TEST(WarpMeshesInBatch, ThrowsIfAnInputMeshDoesNotExist)
+{
+    TemporaryDirectory const outputDirectory;
+
+    BatchMeshWarperParams params;
+    params.sourceLandmarksCSV = c_SourceLandmarksCSV;
+    params.destinationLandmarksCSV = c_DestinationLandmarksCSV;
+    params.inputMeshes = {c_SourceMesh, c_FixturesDirectory / "Geometry/doesnt-exist.obj"};
+    params.outputDirectory = outputDirectory.path();
+
+    ASSERT_THROW({ WarpMeshesInBatch(params); }, std::exception);
+}
+
+TEST(BatchMeshWarperStageStats, PerThreadThroughputIsTheAverageThreadsThroughput)
+{
+    // two threads that were each busy for 1 s (i.e. 2 s of summed busy time) warping 10 meshes
+    // between them achieved 5 meshes/s each
+    BatchMeshWarperStageStats stats;
+    stats.numThreads = 2;
+    stats.numMeshes = 10;
+    stats.numVertices = 1000;
+    stats.busyTime = std::chrono::duration<double>{2.0};
+
+    ASSERT_DOUBLE_EQ(stats.meshesPerSecondPerThread(), 5.0);
+    ASSERT_DOUBLE_EQ(stats.verticesPerSecondPerThread(), 500.0);
+}
+
+TEST(BatchMeshWarperStageStats, PerThreadThroughputIsZeroIfTheStageWasNeverBusy)
+{
+    BatchMeshWarperStageStats const stats;
+    ASSERT_EQ(stats.meshesPerSecondPerThread(), 0.0);
+    ASSERT_EQ(stats.verticesPerSecondPerThread(), 0.0);
+}
@@ -0,0 +1,100 @@
+#include <OpenSimCreator/Documents/MeshWarper/TPSWarpResultCache.h>
+
+#include <OpenSimCreator/Documents/MeshWarper/TPSDocument.h>
+#include <OpenSimCreator/Documents/MeshWarper/TPSDocumentHelpers.h>
+#include <OpenSimCreator/Documents/MeshWarper/TPSDocumentInputIdentifier.h>
+#include <OpenSimCreator/Utils/TPS3D.h>
+#include <gtest/gtest.h>
+#include <oscar/Graphics/Geometries/SphereGeometry.h>
+#include <oscar/Graphics/Mesh.h>
+#include <oscar/Maths/Vec3.h>
+
+#include <cstddef>
+
+using namespace osc;
+
+namespace
+{
+    // returns a document that warps a sphere with the given number of segments
+    TPSDocument GenerateSphereWarpingDocument(size_t numSegments)
+    {
+        TPSDocument doc;
+        doc.sourceMesh = SphereGeometry{1.0f, numSegments, numSegments};
+        for (Vec3 const& p : {Vec3{1.0f, 0.0f, 0.0f}, Vec3{0.0f, 1.0f, 0.0f}, Vec3{0.0f, 0.0f, 1.0f}, Vec3{-1.0f, 0.0f, 0.0f}, Vec3{0.0f, -1.0f, 0.0f}})
+        {
+            AddLandmarkToInput(doc, TPSDocumentInputIdentifier::Source, p);
+            AddLandmarkToInput(doc, TPSDocumentInputIdentifier::Destination, 1.5f*p);
+        }
+        return doc;
+    }
+
+    // returns the expected (synchronously-computed) warp of the document's source mesh
+    Mesh CalcExpectedWarpedMesh(TPSDocument const& doc)
+    {
+        TPSCoefficients3D const coefs = CalcCoefficients(TPSCoefficientSolverInputs3D{GetLandmarkPairs(doc)});
+        return ApplyThinPlateWarpToMesh(coefs, doc.sourceMesh, doc.blendingFactor);
+    }
+}
+
+TEST(TPSResultCache, WarpsSmallMeshesSynchronously)
+{
+    TPSDocument const doc = GenerateSphereWarpingDocument(16);
+    TPSResultCache cache;
+
+    Mesh const& warped = cache.getWarpedMesh(doc);
+    ASSERT_FALSE(cache.isWarpedMeshAPreview());
+    ASSERT_EQ(warped.vertices(), CalcExpectedWarpedMesh(doc).vertices());
+}
+
+TEST(TPSResultCache, WarpsLargeMeshesProgressively)
+{
+    TPSDocument const doc = GenerateSphereWarpingDocument(64);
+    TPSResultCache cache{64};
+
+    // the first result is either a (decimated) preview or, if the background worker was quick, the full result
+    {
+        Mesh const& warped = cache.getWarpedMesh(doc);
+        if (cache.isWarpedMeshAPreview())
+        {
+            ASSERT_LE(warped.num_vertices(), 64);
+        }
+        else
+        {
+            ASSERT_EQ(warped.num_vertices(), doc.sourceMesh.num_vertices());
+        }
+    }
+
+    // but the full-resolution result should eventually be available
+    Mesh const expected = CalcExpectedWarpedMesh(doc);
+    ASSERT_EQ(cache.getFullResolutionWarpedMesh(doc).vertices(), expected.vertices());
+    ASSERT_FALSE(cache.isWarpedMeshAPreview());
+
+    // and it should be cached
+    ASSERT_EQ(cache.getWarpedMesh(doc).vertices(), expected.vertices());
+    ASSERT_FALSE(cache.isWarpedMeshAPreview());
+}
+
+TEST(TPSResultCache, FullResolutionResultReflectsLatestDocumentAfterManyEdits)
+{
+    TPSDocument doc = GenerateSphereWarpingDocument(64);
+    TPSResultCache cache{64};
+
+    // e.g. the user is dragging a destination landmark around, which should cancel stale warps
+    for (int i = 0; i < 10; ++i)
+    {
+        UpdLocation(doc.landmarkPairs.front(), TPSDocumentInputIdentifier::Destination) = Vec3{1.5f + 0.1f*static_cast<float>(i), 0.0f, 0.0f};
+        cache.getWarpedMesh(doc);
+    }
+
+    ASSERT_EQ(cache.getFullResolutionWarpedMesh(doc).vertices(), CalcExpectedWarpedMesh(doc).vertices());
+    ASSERT_FALSE(cache.isWarpedMeshAPreview());
+}
+
+TEST(TPSResultCache, CanBeDestroyedWhileWarpingInTheBackground)
+{
+    TPSDocument const doc = GenerateSphereWarpingDocument(256);
+    {
+        TPSResultCache cache{64};
+        cache.getWarpedMesh(doc);
+    }  // shouldn't hang or crash
+}
@@ -0,0 +1,75 @@
+#include <OpenSimCreator/Documents/Model/StagedOsimLoader.h>
+
+#include <TestOpenSimCreator/TestOpenSimCreatorConfig.h>
+
+#include <gtest/gtest.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSimCreator/Documents/Model/UndoableModelStatePair.h>
+#include <OpenSimCreator/Platform/OpenSimCreatorApp.h>
+#include <oscar/Graphics/Scene/SceneCache.h>
+#include <oscar/Shims/Cpp20/stop_token.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    std::filesystem::path GetArm26Path()
+    {
+        return std::filesystem::path{OSC_RESOURCES_DIR} / "models" / "Arm26" / "arm26.osim";
+    }
+}
+
+TEST(LoadOsimInStages, LoadsTheSameModelAsLoadingItDirectly)
+{
+    GlobalInitOpenSim();
+    SceneCache meshCache;
+    cpp20::stop_source stopSource;
+
+    StagedOsimLoadingResult const loaded = LoadOsimInStages(GetArm26Path(), meshCache, stopSource.get_token());
+    UndoableModelStatePair const direct{GetArm26Path()};
+
+    ASSERT_TRUE(loaded.model);
+    ASSERT_EQ(loaded.model->getModel().getNumComponents(), direct.getModel().getNumComponents());
+    ASSERT_EQ(loaded.model->getFilesystemPath(), direct.getFilesystemPath());
+    ASSERT_TRUE(loaded.model->isUpToDateWithFilesystem());
+}
+
+TEST(LoadOsimInStages, ReportsProgressAndTimingsForEachStage)
+{
+    GlobalInitOpenSim();
+    SceneCache meshCache;
+    cpp20::stop_source stopSource;
+
+    std::vector<OsimLoadingProgress> reports;
+    StagedOsimLoadingResult const loaded = LoadOsimInStages(GetArm26Path(), meshCache, stopSource.get_token(), [&reports](OsimLoadingProgress const& p)
+    {
+        reports.push_back(p);
+    });
+
+    ASSERT_FALSE(reports.empty());
+    for (size_t i = 1; i < reports.size(); ++i)
+    {
+        ASSERT_LE(reports[i-1].fractionCompleted, reports[i].fractionCompleted);
+    }
+    ASSERT_EQ(reports.back().fractionCompleted, 1.0f);
+
+    for (OsimLoadingStage const stage : GetAllOsimLoadingStages())
+    {
+        ASSERT_TRUE(std::ranges::any_of(loaded.timings, [stage](auto const& t) { return t.stage == stage; })) << GetOsimLoadingStageString(stage).c_str();
+    }
+}
+
+TEST(LoadOsimInStages, ThrowsCancelledIfStopIsRequested)
+{
+    GlobalInitOpenSim();
+    SceneCache meshCache;
+    cpp20::stop_source stopSource;
+    stopSource.request_stop();
+
+    ASSERT_THROW({ LoadOsimInStages(GetArm26Path(), meshCache, stopSource.get_token()); }, OsimLoadingCancelled);
+}
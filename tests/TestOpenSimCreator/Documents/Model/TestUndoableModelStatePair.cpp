@@ -1,9 +1,13 @@
 #include <OpenSimCreator/Documents/Model/UndoableModelStatePair.h>
 
+#include <OpenSimCreator/Documents/Model/ModelStateCommit.h>
+
 #include <TestOpenSimCreator/TestOpenSimCreatorConfig.h>
 
 #include <gtest/gtest.h>
 #include <OpenSim/Common/Component.h>
+#include <OpenSim/Common/ComponentPath.h>
+#include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSimCreator/Graphics/OpenSimDecorationGenerator.h>
 #include <OpenSimCreator/Graphics/OpenSimDecorationOptions.h>
 #include <OpenSimCreator/Platform/OpenSimCreatorApp.h>
@@ -12,10 +16,12 @@
 #include <oscar/Graphics/Scene/SceneCache.h>
 #include <oscar/Graphics/Scene/SceneDecoration.h>
 #include <oscar/Utils/NullOStream.h>
+#include <oscar/Utils/UID.h>
 
 #include <filesystem>
 #include <functional>
 #include <sstream>
+#include <string>
 
 using namespace osc;
 
@@ -78,3 +84,183 @@ TEST(UndoableModelStatePair, CanLoadAndRenderAllUserFacingExampleFiles)
     }
     ASSERT_GT(nExamplesTested, 10);  // sanity check: remove this if you want <10 examples
 }
+
+TEST(UndoableModelStatePair, UndoAndRedoRestoreTheCommittedModels)
+{
+    GlobalInitOpenSim();
+
+    UndoableModelStatePair p;
+    p.updModel().setName("first");
+    p.commit("renamed model");
+    p.updModel().setName("second");
+    p.commit("renamed model again");
+
+    ASSERT_TRUE(p.canUndo());
+    p.doUndo();
+    ASSERT_EQ(p.getModel().getName(), "first");
+
+    ASSERT_TRUE(p.canRedo());
+    p.doRedo();
+    ASSERT_EQ(p.getModel().getName(), "second");
+}
+
+TEST(UndoableModelStatePair, SmallEditsAreStoredAsDeltasThatAreMuchSmallerThanAKeyframe)
+{
+    GlobalInitOpenSim();
+
+    std::filesystem::path const modelPath = std::filesystem::path{OSC_RESOURCES_DIR} / "models" / "Arm26" / "arm26.osim";
+    UndoableModelStatePair p{modelPath};
+
+    ModelStateCommit const keyframe = p.getLatestCommit();
+    ASSERT_TRUE(keyframe.isKeyframe());
+
+    p.updModel().setName("renamed");
+    p.commit("renamed model");
+
+    ModelStateCommit const& delta = p.getLatestCommit();
+    delta.compactStorage();  // usually happens on a background thread
+    ASSERT_FALSE(delta.isKeyframe());
+    ASSERT_LT(10*delta.getStorageSizeInBytes(), keyframe.getStorageSizeInBytes());
+
+    // and the delta can be rebuilt into the edited model
+    ASSERT_EQ(delta.getModel()->getName(), "renamed");
+    ASSERT_EQ(delta.instantiateModel()->getInputFileName(), modelPath.string());
+}
+
+TEST(UndoableModelStatePair, CheckedOutModelsAreIndependentOfTheCommitsPreparedModel)
+{
+    GlobalInitOpenSim();
+
+    UndoableModelStatePair p;
+    p.updModel().setName("first");
+    p.commit("renamed model");
+    p.updModel().setName("second");
+    p.commit("renamed model again");
+
+    p.getLatestCommit().prepareModel();  // usually happens on a background thread
+    p.doUndo();
+    p.doRedo();  // checks out the (maybe) prepared model
+
+    p.updModel().setName("third");
+    ASSERT_EQ(p.getLatestCommit().getModel()->getName(), "second");
+}
+
+TEST(UndoableModelStatePair, FindComponentTracksRenamesAcrossCommitsAndUndo)
+{
+    GlobalInitOpenSim();
+
+    UndoableModelStatePair p{std::filesystem::path{OSC_RESOURCES_DIR} / "models" / "Arm26" / "arm26.osim"};
+    OpenSim::ComponentPath const oldPath{"/forceset/TRIlong"};
+    OpenSim::ComponentPath const newPath{"/forceset/renamed"};
+
+    ASSERT_NE(p.findComponent(oldPath), nullptr);
+    ASSERT_EQ(p.findComponent(oldPath), FindComponent(p.getModel(), oldPath));
+    ASSERT_EQ(p.findComponent(OpenSim::ComponentPath{"/forceset/doesnotexist"}), nullptr);
+
+    OpenSim::Model& model = p.updModel();
+    FindComponentMut(model, oldPath)->setName("renamed");
+    InitializeModel(model);
+    InitializeState(model);
+
+    // mid-edit (i.e. before committing) lookups still see the latest model
+    ASSERT_EQ(p.findComponent(oldPath), nullptr);
+    ASSERT_EQ(p.findComponent(newPath), FindComponent(p.getModel(), newPath));
+
+    p.commit("renamed muscle");
+    ASSERT_EQ(p.findComponent(oldPath), nullptr);
+    ASSERT_NE(p.findComponent(newPath), nullptr);
+    ASSERT_EQ(p.findComponent(newPath), FindComponent(p.getModel(), newPath));
+
+    p.doUndo();
+    ASSERT_EQ(p.findComponent(newPath), nullptr);
+    ASSERT_NE(p.findComponent(oldPath), nullptr);
+    ASSERT_EQ(p.findComponent(oldPath), FindComponent(p.getModel(), oldPath));
+}
+
+TEST(UndoableModelStatePair, UndoAndRedoLeaveTheModelAsIsIfACommitCannotBeRebuilt)
+{
+    GlobalInitOpenSim();
+
+    UndoableModelStatePair p{std::filesystem::path{OSC_RESOURCES_DIR} / "models" / "Arm26" / "arm26.osim"};
+    OpenSim::ComponentPath const jointPath{"/jointset/r_shoulder"};
+    std::string const originalParent = FindComponent(p.getModel(), jointPath)->getSocket("parent_frame").getConnecteePath();
+
+    // commits aren't validated, so a commit of a broken model (here: a joint that's connected
+    // to a frame that doesn't exist) only fails once something tries to rebuild it
+    FindComponentMut(p.updModel(), jointPath)->updSocket("parent_frame").setConnecteePath("/bodyset/doesnt_exist");
+    p.commit("broke the model");
+    ModelStateCommit const brokenCommit = p.getLatestCommit();
+
+    p.doUndo();
+    ModelStateCommit const goodCommit = p.getLatestCommit();
+    ASSERT_NE(goodCommit.getID(), brokenCommit.getID());
+    ASSERT_EQ(FindComponent(p.getModel(), jointPath)->getSocket("parent_frame").getConnecteePath(), originalParent);
+
+    ASSERT_TRUE(p.canRedo());
+    ASSERT_NO_THROW({ p.doRedo(); });
+    ASSERT_EQ(p.getLatestCommit().getID(), goodCommit.getID());
+    ASSERT_EQ(FindComponent(p.getModel(), jointPath)->getSocket("parent_frame").getConnecteePath(), originalParent);
+    ASSERT_TRUE(p.canRedo());
+
+    ASSERT_NO_THROW({ p.tryCheckout(brokenCommit); });
+    ASSERT_EQ(FindComponent(p.getModel(), jointPath)->getSocket("parent_frame").getConnecteePath(), originalParent);
+}
+
+TEST(UndoableModelStatePair, TryCheckoutReturnsFalseIfTheCommitCannotBeRebuilt)
+{
+    GlobalInitOpenSim();
+
+    UndoableModelStatePair p{std::filesystem::path{OSC_RESOURCES_DIR} / "models" / "Arm26" / "arm26.osim"};
+    OpenSim::ComponentPath const jointPath{"/jointset/r_shoulder"};
+    std::string const originalParent = FindComponent(p.getModel(), jointPath)->getSocket("parent_frame").getConnecteePath();
+    ModelStateCommit const goodCommit = p.getLatestCommit();
+
+    // the broken commit's XML is stored as-is, but fails to load (the joint's parent doesn't exist)
+    FindComponentMut(p.updModel(), jointPath)->updSocket("parent_frame").setConnecteePath("/bodyset/doesnt_exist");
+    p.commit("broke the model");
+    ModelStateCommit const brokenCommit = p.getLatestCommit();
+    p.doUndo();
+    ASSERT_EQ(p.getLatestCommit().getID(), goodCommit.getID());
+
+    ASSERT_FALSE(p.tryCheckout(brokenCommit));
+    ASSERT_EQ(p.getLatestCommit().getID(), goodCommit.getID()) << "a failed checkout shouldn't move the head";
+    ASSERT_EQ(FindComponent(p.getModel(), jointPath)->getSocket("parent_frame").getConnecteePath(), originalParent);
+
+    ASSERT_TRUE(p.tryCheckout(goodCommit));
+    ASSERT_EQ(p.getLatestCommit().getID(), goodCommit.getID());
+}
+
+TEST(UndoableModelStatePair, TryCheckoutReturnsFalseForACommitFromAnotherModel)
+{
+    GlobalInitOpenSim();
+
+    UndoableModelStatePair p;
+    UndoableModelStatePair const other;
+    UID const head = p.getLatestCommit().getID();
+
+    ASSERT_FALSE(p.tryCheckout(other.getLatestCommit()));
+    ASSERT_EQ(p.getLatestCommit().getID(), head);
+}
+
+TEST(UndoableModelStatePair, DoesNotPrepareTheCurrentCommitsModelInTheBackground)
+{
+    GlobalInitOpenSim();
+
+    UndoableModelStatePair p;
+    ModelStateCommit const initialCommit = p.getLatestCommit();
+    p.updModel().setName("first");
+    p.commit("renamed model");
+    ModelStateCommit const firstCommit = p.getLatestCommit();
+    p.updModel().setName("second");
+    p.commit("renamed model again");
+    ModelStateCommit const secondCommit = p.getLatestCommit();
+    p.doUndo();
+    ASSERT_EQ(p.getLatestCommit().getID(), firstCommit.getID());
+
+    // the scratch space already holds the current commit's model, so the background
+    // worker should only ever prepare the undo/redo targets
+    p.waitForBackgroundWork();
+    ASSERT_TRUE(initialCommit.hasPreparedModel()) << "undo target";
+    ASSERT_TRUE(secondCommit.hasPreparedModel()) << "redo target";
+    ASSERT_FALSE(firstCommit.hasPreparedModel()) << "current commit";
+}
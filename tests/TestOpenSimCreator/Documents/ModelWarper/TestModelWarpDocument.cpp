@@ -5,6 +5,7 @@
 #include <gtest/gtest.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <oscar/Maths/Constants.h>
+#include <oscar/Shims/Cpp23/ranges.h>
 
 #include <cctype>
 #include <filesystem>
@@ -140,3 +141,26 @@ TEST(ModelWarpingDocument, WarpBlendingFactorClampedBetweenZeroAndOne)
     doc.setWarpBlendingFactor(1.0f);
     ASSERT_EQ(doc.getWarpBlendingFactor(), 1.0f);
 }
+
+TEST(ModelWarpingDocument, DefaultConstructedHasNoFilesystemDependencies)
+{
+    ASSERT_TRUE(ModelWarpDocument{}.filesystemDependencies().empty());
+}
+
+TEST(ModelWarpingDocument, FilesystemDependenciesContainsEverythingTheDocumentIsLoadedFrom)
+{
+    std::filesystem::path const dir = GetFixturesDir() / "Paired";
+    ModelWarpDocument const doc{dir / "model.osim"};
+    auto const deps = doc.filesystemDependencies();
+    auto const contains = [&deps](std::filesystem::path const& p)
+    {
+        return cpp23::contains(deps, std::filesystem::weakly_canonical(p));
+    };
+
+    ASSERT_TRUE(contains(dir / "model.osim"));
+    ASSERT_TRUE(contains(dir / "model.warpconfig.toml"));  // even though it doesn't exist (yet)
+    ASSERT_TRUE(contains(dir / "Geometry" / "sphere.obj"));
+    ASSERT_TRUE(contains(dir / "Geometry" / "sphere.landmarks.csv"));
+    ASSERT_TRUE(contains(dir / "DestinationGeometry" / "sphere.obj"));
+    ASSERT_TRUE(contains(dir / "DestinationGeometry" / "sphere.landmarks.csv"));
+}
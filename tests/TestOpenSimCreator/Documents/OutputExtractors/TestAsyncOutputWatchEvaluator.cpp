@@ -0,0 +1,176 @@
+#include <OpenSimCreator/Documents/OutputExtractors/AsyncOutputWatchEvaluator.h>
+
+#include <TestOpenSimCreator/TestOpenSimCreatorConfig.h>
+
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/Model/Muscle.h>
+#include <OpenSim/Simulation/SimbodyEngine/Coordinate.h>
+#include <OpenSimCreator/Documents/Model/UndoableModelStatePair.h>
+#include <OpenSimCreator/Documents/OutputExtractors/ComponentOutputExtractor.h>
+#include <OpenSimCreator/Documents/OutputExtractors/OutputExtractor.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
+#include <OpenSimCreator/Platform/OpenSimCreatorApp.h>
+#include <OpenSimCreator/Utils/OpenSimHelpers.h>
+#include <gtest/gtest.h>
+#include <oscar/Platform/App.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    // the worker asks the `App` to redraw whenever it publishes values, so the suite shares one `App`
+    std::unique_ptr<App> g_App;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+    class AsyncOutputWatchEvaluatorFixture : public testing::Test {
+    protected:
+        static void SetUpTestSuite()
+        {
+            g_App = std::make_unique<App>();
+            GlobalInitOpenSim();
+        }
+
+        static void TearDownTestSuite()
+        {
+            g_App.reset();
+        }
+
+        static UndoableModelStatePair LoadArm26()
+        {
+            return UndoableModelStatePair{std::filesystem::path{OSC_RESOURCES_DIR} / "models" / "Arm26" / "arm26.osim"};
+        }
+
+        // returns enough outputs (coordinate values, muscle lengths, etc.) that a worker would be
+        // tempted to split them up
+        static std::vector<OutputExtractor> GetOutputs(OpenSim::Model const& model)
+        {
+            std::vector<OutputExtractor> rv;
+            for (OpenSim::Coordinate const& coordinate : model.getComponentList<OpenSim::Coordinate>()) {
+                rv.emplace_back(ComponentOutputExtractor{coordinate.getOutput("value")});
+                rv.emplace_back(ComponentOutputExtractor{coordinate.getOutput("speed")});
+            }
+            for (OpenSim::Muscle const& muscle : model.getComponentList<OpenSim::Muscle>()) {
+                rv.emplace_back(ComponentOutputExtractor{muscle.getOutput("length")});
+                rv.emplace_back(ComponentOutputExtractor{muscle.getOutput("fiber_length")});
+                rv.emplace_back(ComponentOutputExtractor{muscle.getOutput("tendon_length")});
+                rv.emplace_back(ComponentOutputExtractor{muscle.getOutput("active_fiber_force")});
+            }
+            return rv;
+        }
+
+        // returns the outputs' values, evaluated on the calling thread against the caller's model
+        static std::vector<std::string> EvaluateOnCallingThread(
+            UndoableModelStatePair const& msp,
+            std::vector<OutputExtractor> const& outputs)
+        {
+            SimTK::State state = msp.getState();
+            msp.getModel().realizeReport(state);
+            SimulationReport const report{std::move(state)};
+
+            std::vector<std::string> rv;
+            rv.reserve(outputs.size());
+            for (OutputExtractor const& output : outputs) {
+                rv.push_back(output.getValueString(msp.getModel(), report));
+            }
+            return rv;
+        }
+    };
+}
+
+TEST_F(AsyncOutputWatchEvaluatorFixture, InitiallyHasNoValues)
+{
+    AsyncOutputWatchEvaluator evaluator;
+    ASSERT_FALSE(evaluator.poll());
+    ASSERT_TRUE(evaluator.getValues().outputs.empty());
+    ASSERT_TRUE(evaluator.getValues().values.empty());
+}
+
+TEST_F(AsyncOutputWatchEvaluatorFixture, EvaluatesTheSameValuesAsTheCallingThreadWould)
+{
+    UndoableModelStatePair const msp = LoadArm26();
+    std::vector<OutputExtractor> const outputs = GetOutputs(msp.getModel());
+    ASSERT_GT(outputs.size(), 16);
+
+    AsyncOutputWatchEvaluator evaluator;
+    evaluator.request(msp, outputs);
+    ASSERT_TRUE(evaluator.wait());
+
+    OutputWatchValues const& values = evaluator.getValues();
+    ASSERT_EQ(values.modelVersion, msp.getModelVersion());
+    ASSERT_EQ(values.stateVersion, msp.getStateVersion());
+    ASSERT_EQ(values.outputs, outputs);
+    ASSERT_EQ(values.values, EvaluateOnCallingThread(msp, outputs));
+    for (size_t i = 0; i < outputs.size(); ++i) {
+        ASSERT_EQ(values.find(outputs[i]), values.values[i]);
+    }
+}
+
+TEST_F(AsyncOutputWatchEvaluatorFixture, RepeatedlyEvaluatingTheSameRequestGivesTheSameValues)
+{
+    UndoableModelStatePair const msp = LoadArm26();
+    std::vector<OutputExtractor> const outputs = GetOutputs(msp.getModel());
+    std::vector<std::string> const expected = EvaluateOnCallingThread(msp, outputs);
+
+    // each evaluator has its own worker (and model), so this also checks that evaluations
+    // don't depend on whatever the worker's model was previously used for
+    for (int i = 0; i < 8; ++i) {
+        AsyncOutputWatchEvaluator evaluator;
+        evaluator.request(msp, outputs);
+        ASSERT_TRUE(evaluator.wait());
+        ASSERT_EQ(evaluator.getValues().values, expected);
+    }
+}
+
+TEST_F(AsyncOutputWatchEvaluatorFixture, RequestingTheSameThingAgainIsANoOp)
+{
+    UndoableModelStatePair const msp = LoadArm26();
+    std::vector<OutputExtractor> const outputs = GetOutputs(msp.getModel());
+
+    AsyncOutputWatchEvaluator evaluator;
+    evaluator.request(msp, outputs);
+    ASSERT_TRUE(evaluator.wait());
+
+    evaluator.request(msp, outputs);
+    ASSERT_FALSE(evaluator.wait());
+    ASSERT_EQ(evaluator.getValues().outputs, outputs);
+}
+
+TEST_F(AsyncOutputWatchEvaluatorFixture, ChangingTheWatchListCausesAReevaluation)
+{
+    UndoableModelStatePair const msp = LoadArm26();
+    std::vector<OutputExtractor> outputs = GetOutputs(msp.getModel());
+
+    AsyncOutputWatchEvaluator evaluator;
+    evaluator.request(msp, outputs);
+    ASSERT_TRUE(evaluator.wait());
+
+    outputs.pop_back();
+    evaluator.request(msp, outputs);
+    ASSERT_TRUE(evaluator.wait());
+    ASSERT_EQ(evaluator.getValues().outputs, outputs);
+    ASSERT_EQ(evaluator.getValues().values, EvaluateOnCallingThread(msp, outputs));
+}
+
+TEST_F(AsyncOutputWatchEvaluatorFixture, EvaluatesUncommittedModelsOnTheCallingThread)
+{
+    UndoableModelStatePair msp = LoadArm26();
+    std::vector<OutputExtractor> const outputs = GetOutputs(msp.getModel());
+
+    // edit (but don't commit) the model, so there's no commit that the worker could rebuild it from
+    OpenSim::Model& model = msp.updModel();
+    model.setName("edited");
+    InitializeModel(model);
+    InitializeState(model);
+    ASSERT_NE(msp.getLatestCommit().getModelVersion(), msp.getModelVersion());
+
+    AsyncOutputWatchEvaluator evaluator;
+    evaluator.request(msp, outputs);
+    ASSERT_TRUE(evaluator.poll()) << "should be available without waiting on the worker";
+    ASSERT_EQ(evaluator.getValues().modelVersion, msp.getModelVersion());
+    ASSERT_EQ(evaluator.getValues().values, EvaluateOnCallingThread(msp, outputs));
+}
@@ -0,0 +1,57 @@
+#include "OpenSimCreator/Documents/OutputExtractors/ConcatenatingOutputExtractor.h"
+
+#include <OpenSimCreator/Documents/OutputExtractors/ConstantOutputExtractor.h>
+#include <OpenSimCreator/Documents/OutputExtractors/IntegratorOutputExtractor.h>
+#include <OpenSimCreator/Documents/OutputExtractors/OutputExtractor.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
+#include <OpenSim/Simulation/Model/Station.h>
+#include <SimTKcommon.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+using namespace osc;
+
+TEST(ConcatenatingOutputExtractor, HasTypeVec2WhenConcatenatingTwoFloats)
+{
+    ConcatenatingOutputExtractor const coe{
+        OutputExtractor{ConstantOutputExtractor{"a", 1.0f}},
+        OutputExtractor{ConstantOutputExtractor{"b", 2.0f}},
+    };
+    ASSERT_EQ(coe.getOutputType(), OutputExtractorDataType::Vec2);
+}
+
+TEST(ConcatenatingOutputExtractor, BatchExtractionMatchesPerReportExtraction)
+{
+    IntegratorOutputExtractor const& integratorOutput = GetIntegratorOutputExtractor(0);
+    ConcatenatingOutputExtractor const coe{
+        GetIntegratorOutputExtractorDynamic(0),
+        OutputExtractor{ConstantOutputExtractor{"b", 2.0f}},
+    };
+
+    std::vector<SimulationReport> reports;
+    for (int i = 0; i < 5; ++i) {
+        reports.emplace_back(SimTK::State{}, std::unordered_map<UID, float>{{integratorOutput.getAuxiliaryDataID(), static_cast<float>(i)}});
+    }
+    reports.emplace_back();  // has no auxiliary value, so the integrator output should emit NaN
+    OpenSim::Station component;
+
+    std::vector<Vec2> batched(reports.size());
+    coe.getValuesVec2(component, reports, batched);
+
+    for (size_t i = 0; i < reports.size(); ++i) {
+        Vec2 const expected = coe.getValueVec2(component, reports[i]);
+        if (std::isnan(expected.x)) {
+            ASSERT_TRUE(std::isnan(batched[i].x));
+        }
+        else {
+            ASSERT_EQ(batched[i].x, expected.x);
+        }
+        ASSERT_EQ(batched[i].y, expected.y);
+    }
+    ASSERT_TRUE(std::isnan(batched.back().x));
+}
@@ -5,6 +5,8 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 using namespace osc;
 
 TEST(ConstantOutputExtractor, ReturnsProvidedName)
@@ -39,3 +41,15 @@ TEST(ConstantOutputExtractor, ReturnsAnExectactorThatEmitsVec2sWhenProviedVec2s)
 
     ASSERT_EQ(coe.getValueVec2(component, report), Vec2(2.0f, 3.0f));
 }
+
+TEST(ConstantOutputExtractor, BatchExtractionEmitsTheProvidedValueForEachReport)
+{
+    ConstantOutputExtractor coe("extractor", 1337.0f);
+    std::vector<SimulationReport> const reports(3);
+    OpenSim::Station component;
+
+    std::vector<float> out(reports.size());
+    coe.getValuesFloat(component, reports, out);
+
+    ASSERT_EQ(out, std::vector<float>(reports.size(), 1337.0f));
+}
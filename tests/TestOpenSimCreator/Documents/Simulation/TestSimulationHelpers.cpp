@@ -7,12 +7,18 @@
 #include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
 #include <OpenSimCreator/Utils/OpenSimHelpers.h>
 
+#include <oscar/Formats/BinaryColumns.h>
 #include <oscar/Formats/CSV.h>
+#include <oscar/Maths/Vec2.h>
 #include <oscar/Utils/Algorithms.h>
 #include <oscar/Utils/StringHelpers.h>
 
 #include <array>
+#include <cstddef>
 #include <sstream>
+#include <utility>
+#include <variant>
+#include <vector>
 
 using namespace osc;
 
@@ -71,3 +77,44 @@ TEST(SimulationHelpers, WriteOutputsAsCSVWritesVec2DataCorrectly)
     const std::vector<std::string> row1Expected = { stream_to_string(0.0), stream_to_string(3.0f), stream_to_string(2.0f) };
     ASSERT_EQ(row1, row1Expected);
 }
+
+TEST(SimulationHelpers, WriteOutputsAsBinaryColumnsWritesTheSameColumnsAsCSV)
+{
+    OpenSim::Model model;
+    InitializeModel(model);
+    InitializeState(model);
+
+    const auto extractors = std::to_array({
+        make_output_extractor<ConstantOutputExtractor>("float", 1337.0f),
+        make_output_extractor<ConstantOutputExtractor>("vec2", Vec2{3.0f, 2.0f}),
+    });
+
+    std::vector<SimulationReport> reports;
+    for (int i = 0; i < 5000; ++i) {  // more than one chunk
+        SimTK::State state = model.getWorkingState();
+        state.setTime(0.01 * i);
+        reports.emplace_back(std::move(state));
+    }
+
+    std::stringstream out;
+    WriteOutputsAsBinaryColumns(model, extractors, reports, out);
+    const std::vector<BinaryColumn> columns = read_binary_columns(out);
+
+    ASSERT_EQ(columns.size(), 3);
+    ASSERT_EQ(columns[0].name, "time");
+    ASSERT_EQ(type_of(columns[0]), BinaryColumnType::Double);
+    ASSERT_EQ(columns[1].name, "float");
+    ASSERT_EQ(type_of(columns[1]), BinaryColumnType::Float);
+    ASSERT_EQ(columns[2].name, "vec2");
+    ASSERT_EQ(type_of(columns[2]), BinaryColumnType::Vec2);
+
+    const auto& times = std::get<std::vector<double>>(columns[0].data);
+    const auto& floats = std::get<std::vector<float>>(columns[1].data);
+    const auto& vec2s = std::get<std::vector<Vec2>>(columns[2].data);
+    ASSERT_EQ(times.size(), reports.size());
+    for (size_t i = 0; i < reports.size(); ++i) {
+        ASSERT_EQ(times[i], reports[i].getState().getTime());
+        ASSERT_EQ(floats[i], 1337.0f);
+        ASSERT_EQ(vec2s[i], (Vec2{3.0f, 2.0f}));
+    }
+}
@@ -0,0 +1,195 @@
+#include <OpenSimCreator/Graphics/AsyncModelDecorationGenerator.h>
+
+#include <TestOpenSimCreator/TestOpenSimCreatorConfig.h>
+
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/SimbodyEngine/Coordinate.h>
+#include <OpenSimCreator/Documents/Model/IConstModelStatePair.h>
+#include <OpenSimCreator/Graphics/OpenSimDecorationOptions.h>
+#include <OpenSimCreator/Graphics/OverlayDecorationOptions.h>
+#include <OpenSimCreator/Platform/OpenSimCreatorApp.h>
+#include <OpenSimCreator/Utils/OpenSimHelpers.h>
+#include <gtest/gtest.h>
+#include <oscar/Graphics/Scene/SceneCache.h>
+#include <oscar/Graphics/Scene/SceneDecoration.h>
+#include <oscar/Platform/App.h>
+#include <oscar/Utils/UID.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    // the worker asks the `App` to redraw whenever it publishes decorations, so the suite shares one `App`
+    std::unique_ptr<App> g_App;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+    constexpr char const* c_ElbowCoordinatePath = "/jointset/r_elbow/r_elbow_flex";
+
+    // a model + state pair where the caller controls when the model/state versions change
+    class VersionedModelStatePair final : public IConstModelStatePair {
+    public:
+        VersionedModelStatePair() :
+            m_Model{std::make_unique<OpenSim::Model>((std::filesystem::path{OSC_RESOURCES_DIR} / "models" / "Arm26" / "arm26.osim").string())}
+        {
+            InitializeModel(*m_Model);
+            m_State = InitializeState(*m_Model);
+        }
+
+        // changes the state (only), which is what (e.g.) scrubbing through a simulation does
+        void setElbowFlexion(double value)
+        {
+            m_Model->getComponent<OpenSim::Coordinate>(c_ElbowCoordinatePath).setValue(m_State, value);
+            m_Model->realizeReport(m_State);
+            m_StateVersion = UID{};
+        }
+
+        // changes the model, which is what (e.g.) editing the model does
+        void renameModel(std::string const& newName)
+        {
+            m_Model->setName(newName);
+            InitializeModel(*m_Model);
+            m_State = InitializeState(*m_Model);
+            m_ModelVersion = UID{};
+            m_StateVersion = UID{};
+        }
+
+    private:
+        OpenSim::Model const& implGetModel() const final { return *m_Model; }
+        UID implGetModelVersion() const final { return m_ModelVersion; }
+        SimTK::State const& implGetState() const final { return m_State; }
+        UID implGetStateVersion() const final { return m_StateVersion; }
+
+        std::unique_ptr<OpenSim::Model> m_Model;
+        SimTK::State m_State;
+        UID m_ModelVersion;
+        UID m_StateVersion;
+    };
+
+    class AsyncModelDecorationGeneratorFixture : public testing::Test {
+    protected:
+        static void SetUpTestSuite()
+        {
+            g_App = std::make_unique<App>();
+            GlobalInitOpenSim();
+        }
+
+        static void TearDownTestSuite()
+        {
+            g_App.reset();
+        }
+
+        // returns the decorations that a fresh generator (i.e. one that generates the
+        // decorations synchronously) generates for the given model + state
+        std::vector<SceneDecoration> GenerateSynchronously(IConstModelStatePair const& msp)
+        {
+            AsyncModelDecorationGenerator generator{m_SceneCache};
+            generator.request(msp, m_DecorationOptions, m_OverlayOptions);
+            std::span<SceneDecoration const> const drawlist = generator.getDrawlist();
+            return {drawlist.begin(), drawlist.end()};
+        }
+
+        static void AssertSameDecorations(std::span<SceneDecoration const> actual, std::span<SceneDecoration const> expected)
+        {
+            ASSERT_EQ(actual.size(), expected.size());
+            for (size_t i = 0; i < actual.size(); ++i) {
+                ASSERT_EQ(actual[i].transform, expected[i].transform) << "decoration " << i;
+                ASSERT_EQ(actual[i].color, expected[i].color) << "decoration " << i;
+            }
+        }
+
+        std::shared_ptr<SceneCache> m_SceneCache = std::make_shared<SceneCache>();
+        OpenSimDecorationOptions m_DecorationOptions;
+        OverlayDecorationOptions m_OverlayOptions;
+    };
+}
+
+TEST_F(AsyncModelDecorationGeneratorFixture, FirstRequestForAModelIsGeneratedSynchronously)
+{
+    VersionedModelStatePair const msp;
+    AsyncModelDecorationGenerator generator{m_SceneCache};
+    ASSERT_TRUE(generator.getDrawlist().empty());
+
+    generator.request(msp, m_DecorationOptions, m_OverlayOptions);
+
+    // (no `wait`ing: the decorations should be available as soon as `request` returns)
+    ASSERT_FALSE(generator.getDrawlist().empty());
+    ASSERT_TRUE(generator.getAABB());
+    ASSERT_FALSE(generator.isBusy());
+    ASSERT_TRUE(generator.poll()) << "the front buffer changed since the last poll";
+    ASSERT_FALSE(generator.poll());
+}
+
+TEST_F(AsyncModelDecorationGeneratorFixture, ModelChangesAreAlsoGeneratedSynchronously)
+{
+    VersionedModelStatePair msp;
+    AsyncModelDecorationGenerator generator{m_SceneCache};
+    generator.request(msp, m_DecorationOptions, m_OverlayOptions);
+    msp.setElbowFlexion(1.0);
+    generator.request(msp, m_DecorationOptions, m_OverlayOptions);  // (sent to the worker)
+    generator.wait();
+
+    msp.renameModel("edited");
+    generator.request(msp, m_DecorationOptions, m_OverlayOptions);
+    ASSERT_FALSE(generator.isBusy());
+    AssertSameDecorations(generator.getDrawlist(), GenerateSynchronously(msp));
+}
+
+TEST_F(AsyncModelDecorationGeneratorFixture, StateChangesAreGeneratedFromACopyOfTheModel)
+{
+    auto msp = std::make_unique<VersionedModelStatePair>();
+    AsyncModelDecorationGenerator generator{m_SceneCache};
+    generator.request(*msp, m_DecorationOptions, m_OverlayOptions);
+
+    msp->setElbowFlexion(1.0);
+    std::vector<SceneDecoration> const expected = GenerateSynchronously(*msp);
+    ASSERT_NE(expected.size(), 0);
+
+    // a state-only change is handed to the worker, which requires that the generator deep-copied
+    // the caller's model (on the calling thread) because the caller may do anything with its model
+    // after `request` returns, e.g. destroy it
+    generator.request(*msp, m_DecorationOptions, m_OverlayOptions);
+    msp.reset();
+
+    generator.wait();
+    ASSERT_FALSE(generator.isBusy());
+    AssertSameDecorations(generator.getDrawlist(), expected);
+}
+
+TEST_F(AsyncModelDecorationGeneratorFixture, StaleRequestsAreSupersededByTheLatestOne)
+{
+    VersionedModelStatePair msp;
+    AsyncModelDecorationGenerator generator{m_SceneCache};
+    generator.request(msp, m_DecorationOptions, m_OverlayOptions);
+
+    // quickly "scrub" through many states without waiting for the worker
+    for (int i = 1; i <= 16; ++i) {
+        msp.setElbowFlexion(0.1 * i);
+        generator.request(msp, m_DecorationOptions, m_OverlayOptions);
+    }
+
+    generator.wait();
+    AssertSameDecorations(generator.getDrawlist(), GenerateSynchronously(msp));
+
+    // once the latest request is done, no stale result can arrive later
+    ASSERT_FALSE(generator.isBusy());
+    ASSERT_FALSE(generator.poll());
+    AssertSameDecorations(generator.getDrawlist(), GenerateSynchronously(msp));
+}
+
+TEST_F(AsyncModelDecorationGeneratorFixture, CanBeDestroyedWhileARequestIsInFlight)
+{
+    VersionedModelStatePair msp;
+    for (int i = 0; i < 8; ++i) {
+        AsyncModelDecorationGenerator generator{m_SceneCache};
+        generator.request(msp, m_DecorationOptions, m_OverlayOptions);
+        msp.setElbowFlexion(0.1 * i);
+        generator.request(msp, m_DecorationOptions, m_OverlayOptions);  // (sent to the worker)
+        // (the generator is destroyed here, which should cancel + join the worker, rather than hang/crash)
+    }
+}
@@ -0,0 +1,142 @@
+#include <OpenSimCreator/Graphics/SimulationFrameRenderer.h>
+
+#include <TestOpenSimCreator/TestOpenSimCreatorConfig.h>
+
+#include <OpenSimCreator/Documents/Model/BasicModelStatePair.h>
+#include <OpenSimCreator/Documents/Simulation/ForwardDynamicSimulation.h>
+#include <OpenSimCreator/Documents/Simulation/ForwardDynamicSimulatorParams.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationStatus.h>
+#include <gtest/gtest.h>
+#include <oscar/Platform/App.h>
+#include <oscar/Utils/TemporaryDirectory.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    std::vector<char> SlurpFile(std::filesystem::path const& path)
+    {
+        std::ifstream fin{path, std::ios_base::binary};
+        if (not fin) {
+            throw std::runtime_error{path.string() + ": cannot open for reading"};
+        }
+        return {std::istreambuf_iterator<char>{fin}, std::istreambuf_iterator<char>{}};
+    }
+
+    // the renderer needs a graphics context, so the suite shares one `App`
+    std::unique_ptr<App> g_App;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+    std::unique_ptr<ForwardDynamicSimulation> g_Simulation;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+    class SimulationFrameRendererFixture : public testing::Test {
+    protected:
+        static void SetUpTestSuite()
+        {
+            using namespace std::literals;
+
+            g_App = std::make_unique<App>();
+
+            // a short simulation of a (moving) double pendulum, so that each frame differs
+            BasicModelStatePair const modelState{std::filesystem::path{OSC_RESOURCES_DIR} / "models" / "DoublePendulum" / "double_pendulum.osim"};
+            ForwardDynamicSimulatorParams params;
+            params.finalTime = SimulationClock::start() + 1s;
+            params.reportingInterval = 250ms;
+            g_Simulation = std::make_unique<ForwardDynamicSimulation>(modelState, params);
+            g_Simulation->join();
+        }
+
+        static void TearDownTestSuite()
+        {
+            g_Simulation.reset();
+            g_App.reset();
+        }
+
+        static SimulationFrameRendererParams MakeParams(std::filesystem::path const& outputDirectory)
+        {
+            SimulationFrameRendererParams rv;
+            rv.outputDirectory = outputDirectory;
+            rv.dimensions = {64, 48};
+            rv.antiAliasingLevel = AntiAliasingLevel{1};
+            return rv;
+        }
+    };
+}
+
+TEST_F(SimulationFrameRendererFixture, WritesOneNumberedPNGPerReport)
+{
+    ASSERT_EQ(g_Simulation->getStatus(), SimulationStatus::Completed);
+    size_t const numReports = g_Simulation->getNumReports();
+    ASSERT_EQ(numReports, 5);
+
+    TemporaryDirectory const outputDirectory;
+    SimulationFrameRendererReport const report = RenderSimulationFramesToPNGs(*g_Simulation, MakeParams(outputDirectory.path()));
+
+    ASSERT_EQ(report.numFramesWritten, numReports);
+    ASSERT_EQ(report.decoration.numFrames, numReports);
+    ASSERT_EQ(report.rendering.numFrames, numReports);
+    ASSERT_EQ(report.encoding.numFrames, numReports);
+
+    size_t numFiles = 0;
+    for ([[maybe_unused]] auto const& entry : std::filesystem::directory_iterator{outputDirectory.path()}) {
+        ++numFiles;
+    }
+    ASSERT_EQ(numFiles, numReports);
+    for (std::string const filename : {"frame_000000.png", "frame_000001.png", "frame_000002.png", "frame_000003.png", "frame_000004.png"}) {
+        ASSERT_TRUE(std::filesystem::exists(outputDirectory.path() / filename)) << filename;
+    }
+}
+
+TEST_F(SimulationFrameRendererFixture, WritesTheSameFramesRegardlessOfHowManyDecorationThreadsThereAre)
+{
+    // frames are decorated out-of-order by multiple threads, but each frame should still be
+    // written to the file that corresponds to its report
+    TemporaryDirectory const serialDirectory;
+    SimulationFrameRendererParams serialParams = MakeParams(serialDirectory.path());
+    serialParams.numDecorationThreads = 1;
+    serialParams.maxFramesInFlight = 1;
+    RenderSimulationFramesToPNGs(*g_Simulation, serialParams);
+
+    TemporaryDirectory const parallelDirectory;
+    SimulationFrameRendererParams parallelParams = MakeParams(parallelDirectory.path());
+    parallelParams.numDecorationThreads = 4;
+    parallelParams.maxFramesInFlight = 3;
+    RenderSimulationFramesToPNGs(*g_Simulation, parallelParams);
+
+    std::vector<char> previousFrame;
+    for (std::string const filename : {"frame_000000.png", "frame_000001.png", "frame_000002.png", "frame_000003.png", "frame_000004.png"}) {
+        std::vector<char> const serialFrame = SlurpFile(serialDirectory.path() / filename);
+        ASSERT_EQ(SlurpFile(parallelDirectory.path() / filename), serialFrame) << filename;
+        ASSERT_NE(serialFrame, previousFrame) << filename << ": is the same as the previous frame (the pendulum should be moving)";
+        previousFrame = serialFrame;
+    }
+}
+
+TEST_F(SimulationFrameRendererFixture, RethrowsEncodingFailuresOnTheCallingThread)
+{
+    TemporaryDirectory const outputDirectory;
+
+    // a directory that has the same name as a frame can't be opened for writing
+    std::filesystem::create_directory(outputDirectory.path() / "frame_000002.png");
+
+    ASSERT_THROW({ RenderSimulationFramesToPNGs(*g_Simulation, MakeParams(outputDirectory.path())); }, std::exception);
+}
+
+TEST_F(SimulationFrameRendererFixture, CanBeCalledAgainAfterAFailure)
+{
+    {
+        TemporaryDirectory const failingDirectory;
+        std::filesystem::create_directory(failingDirectory.path() / "frame_000000.png");
+        ASSERT_THROW({ RenderSimulationFramesToPNGs(*g_Simulation, MakeParams(failingDirectory.path())); }, std::exception);
+    }
+
+    TemporaryDirectory const outputDirectory;
+    ASSERT_EQ(RenderSimulationFramesToPNGs(*g_Simulation, MakeParams(outputDirectory.path())).numFramesWritten, g_Simulation->getNumReports());
+}
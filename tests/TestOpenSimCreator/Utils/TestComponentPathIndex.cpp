@@ -0,0 +1,114 @@
+#include <OpenSimCreator/Utils/ComponentPathIndex.h>
+
+#include <TestOpenSimCreator/TestOpenSimCreatorConfig.h>
+
+#include <OpenSim/Common/Component.h>
+#include <OpenSim/Common/ComponentPath.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSimCreator/Platform/OpenSimCreatorApp.h>
+#include <OpenSimCreator/Utils/OpenSimHelpers.h>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <memory>
+
+using namespace osc;
+
+namespace
+{
+    std::unique_ptr<OpenSim::Model> LoadArm26()
+    {
+        GlobalInitOpenSim();
+
+        auto rv = std::make_unique<OpenSim::Model>((std::filesystem::path{OSC_RESOURCES_DIR} / "models" / "Arm26" / "arm26.osim").string());
+        InitializeModel(*rv);
+        return rv;
+    }
+}
+
+TEST(ComponentPathIndex, DefaultConstructedIndexFindsNothing)
+{
+    ComponentPathIndex const index;
+    ASSERT_TRUE(index.empty());
+    ASSERT_EQ(index.find(OpenSim::ComponentPath{"/"}), nullptr);
+    ASSERT_EQ(index.find(OpenSim::ComponentPath{"/bodyset"}), nullptr);
+}
+
+TEST(ComponentPathIndex, FindsTheSameComponentsAsFindComponent)
+{
+    auto const model = LoadArm26();
+    ComponentPathIndex const index{*model};
+
+    ASSERT_TRUE(index.isIndexOf(*model));
+    ASSERT_FALSE(index.empty());
+
+    ASSERT_EQ(index.find(GetAbsolutePath(*model)), model.get());
+    for (OpenSim::Component const& c : model->getComponentList())
+    {
+        OpenSim::ComponentPath const path = GetAbsolutePath(c);
+        ASSERT_NE(index.find(path), nullptr) << path.toString();
+        ASSERT_EQ(index.find(path), FindComponent(*model, path)) << path.toString();
+    }
+}
+
+TEST(ComponentPathIndex, ReturnsNullptrForPathsThatDoNotResolve)
+{
+    auto const model = LoadArm26();
+    ComponentPathIndex const index{*model};
+
+    for (char const* path : {
+        "/doesnt_exist",
+        "/bodyset/doesnt_exist",
+        "/bodyset/r_humerus/doesnt_exist",
+        "/r_humerus",                       // a known name, but not a child of the root
+        "/forceset/TRIlong/bodyset",        // as above, but deeper
+        "/bodyset/r_humerus/r_humerus",
+    })
+    {
+        ASSERT_EQ(index.find(OpenSim::ComponentPath{path}), nullptr) << path;
+        ASSERT_EQ(FindComponent(*model, OpenSim::ComponentPath{path}), nullptr) << path;
+    }
+    ASSERT_EQ(index.find(OpenSim::ComponentPath{}), nullptr);
+}
+
+TEST(ComponentPathIndex, ResolvesRelativeElementsAndRelativePathsLikeFindComponent)
+{
+    auto const model = LoadArm26();
+    ComponentPathIndex const index{*model};
+
+    for (char const* path : {
+        "/bodyset/r_humerus/../r_ulna_radius_hand",
+        "/bodyset/./r_humerus",
+        "/bodyset/doesnt_exist/../r_humerus",
+        "bodyset/r_humerus",
+    })
+    {
+        OpenSim::ComponentPath const cp{path};
+        ASSERT_EQ(index.find(cp), FindComponent(*model, cp)) << path;
+    }
+    ASSERT_NE(index.find(OpenSim::ComponentPath{"/bodyset/r_humerus/../r_ulna_radius_hand"}), nullptr);
+}
+
+TEST(ComponentPathIndex, RebuildingTheIndexPicksUpChangesToTheModel)
+{
+    auto const model = LoadArm26();
+    OpenSim::ComponentPath const oldPath{"/forceset/TRIlong"};
+    OpenSim::ComponentPath const newPath{"/forceset/renamed"};
+
+    ComponentPathIndex index{*model};
+    ASSERT_NE(index.find(oldPath), nullptr);
+    ASSERT_EQ(index.find(newPath), nullptr);
+
+    FindComponentMut(*model, oldPath)->setName("renamed");
+    InitializeModel(*model);
+
+    index = ComponentPathIndex{*model};
+    ASSERT_TRUE(index.isIndexOf(*model));
+    ASSERT_EQ(index.find(oldPath), nullptr);
+    ASSERT_NE(index.find(newPath), nullptr);
+    ASSERT_EQ(index.find(newPath), FindComponent(*model, newPath));
+
+    // an index of a different model isn't an index of this one
+    auto const otherModel = LoadArm26();
+    ASSERT_FALSE(ComponentPathIndex{*otherModel}.isIndexOf(*model));
+}
@@ -211,3 +211,114 @@ TEST(FitEllipsoid, DISABLED_ThrowsErrorIfGivenLessThan9Points)
     generateMeshWithNPoints(9);
     generateMeshWithNPoints(10);
 }
+
+// regression: the streaming fitters should produce the same answers as the reference
+//             (dense, indexed-vertex) implementations when weighting by index count
+TEST(ShapeFitters, StreamingFittersProduceTheSameAnswersAsReferenceImplementationsForFemoralHead)
+{
+    constexpr float c_MaximumAbsoluteError = 0.0001f;
+
+    auto const objPath =
+        std::filesystem::path{OSC_TESTING_RESOURCES_DIR} / "Utils/ShapeFitting/Femoral_head.obj";
+    Mesh const mesh = LoadMeshViaSimTK(objPath);
+
+    {
+        Sphere const expected = FitSphereReference(mesh);
+        Sphere const got = FitSphere(mesh, ShapeFitWeighting::IndexCount);
+        ASSERT_TRUE(all_of(equal_within_absdiff(got.origin, expected.origin, c_MaximumAbsoluteError)));
+        ASSERT_TRUE(equal_within_absdiff(got.radius, expected.radius, c_MaximumAbsoluteError));
+    }
+    {
+        Plane const expected = FitPlaneReference(mesh);
+        Plane const got = FitPlane(mesh, ShapeFitWeighting::IndexCount);
+        ASSERT_TRUE(all_of(equal_within_absdiff(got.origin, expected.origin, c_MaximumAbsoluteError)));
+        ASSERT_TRUE(all_of(equal_within_absdiff(got.normal, expected.normal, c_MaximumAbsoluteError)));
+    }
+    {
+        Ellipsoid const expected = FitEllipsoidReference(mesh);
+        Ellipsoid const got = FitEllipsoid(mesh, ShapeFitWeighting::IndexCount);
+        ASSERT_TRUE(all_of(equal_within_absdiff(got.origin, expected.origin, c_MaximumAbsoluteError)));
+        ASSERT_TRUE(all_of(equal_within_absdiff(got.radii, expected.radii, c_MaximumAbsoluteError)));
+        auto const expectedDirections = axis_directions_of(expected);
+        auto const gotDirections = axis_directions_of(got);
+        for (size_t i = 0; i < 3; ++i)
+        {
+            ASSERT_TRUE(all_of(equal_within_absdiff(gotDirections[i], expectedDirections[i], c_MaximumAbsoluteError)));
+        }
+    }
+}
+
+TEST(ShapeFitters, AllWeightingsFitATransformedSphereMesh)
+{
+    Transform t;
+    t.position = {7.0f, 3.0f, 1.5f};
+    t.scale = {3.25f, 3.25f, 3.25f};
+
+    Mesh sphereMesh = SphereGeometry{1.0f, 16, 16};
+    sphereMesh.transform_vertices(t);
+
+    for (ShapeFitWeighting weighting : {ShapeFitWeighting::IndexCount, ShapeFitWeighting::Uniform, ShapeFitWeighting::Area})
+    {
+        Sphere const sphereFit = FitSphere(sphereMesh, weighting);
+        ASSERT_TRUE(all_of(equal_within_absdiff(sphereFit.origin, t.position, 0.0001f)));
+        ASSERT_TRUE(equal_within_reldiff(sphereFit.radius, t.scale.x, 0.0001f));
+
+        Ellipsoid const ellipsoidFit = FitEllipsoid(sphereMesh, weighting);
+        ASSERT_TRUE(all_of(equal_within_absdiff(ellipsoidFit.origin, t.position, 0.0001f)));
+        ASSERT_TRUE(all_of(equal_within_reldiff(ellipsoidFit.radii, t.scale, 0.0001f)));
+    }
+}
+
+TEST(ShapeFitters, AreaWeightedFitPlaneHandlesNonUniformlyTessellatedMeshes)
+{
+    // a symmetric "roof" (y = slope*|x|, spanning -1 <= x,z <= 1) that's bent along the Z axis, where
+    // the +X half is (much) more densely tessellated than the -X half
+    //
+    // by symmetry, the best-fitting plane through the surface has a normal of +Y. A fit that weights
+    // each vertex by how many triangles index it (rather than by area) is instead dominated by the
+    // densely tessellated half, so its normal tilts towards that half's normal
+    constexpr float slope = 0.5f;
+    std::vector<Vec3> vertices;
+    std::vector<uint32_t> indices;
+    auto const addRoofVertex = [&vertices](float x, float z)
+    {
+        vertices.emplace_back(x, slope*abs(x), z);
+        return static_cast<uint32_t>(vertices.size() - 1);
+    };
+    auto const addHalfOfRoof = [&indices, &addRoofVertex](float xBegin, float xEnd, size_t numRows)
+    {
+        // each quad is fanned around a vertex in its middle, so that the triangulation of each half
+        // is mirror-symmetric (a diagonal split would bias the area-weighted fit towards one corner)
+        for (size_t row = 0; row < numRows; ++row)
+        {
+            float const zBegin = -1.0f + 2.0f * static_cast<float>(row)/static_cast<float>(numRows);
+            float const zEnd = -1.0f + 2.0f * static_cast<float>(row+1)/static_cast<float>(numRows);
+            std::array<uint32_t, 4> const corners = {
+                addRoofVertex(xBegin, zBegin),
+                addRoofVertex(xEnd, zBegin),
+                addRoofVertex(xEnd, zEnd),
+                addRoofVertex(xBegin, zEnd),
+            };
+            uint32_t const middle = addRoofVertex(0.5f*(xBegin + xEnd), 0.5f*(zBegin + zEnd));
+            for (size_t i = 0; i < corners.size(); ++i)
+            {
+                indices.insert(indices.end(), {corners[i], middle, corners[(i+1) % corners.size()]});
+            }
+        }
+    };
+    addHalfOfRoof(-1.0f, 0.0f, 1);   // sparse half
+    addHalfOfRoof(0.0f, 1.0f, 32);   // dense half
+
+    Mesh mesh;
+    mesh.set_vertices(vertices);
+    mesh.set_indices(indices);
+
+    Plane const areaWeighted = FitPlane(mesh, ShapeFitWeighting::Area);
+    ASSERT_TRUE(all_of(equal_within_absdiff(abs(areaWeighted.normal), Vec3(0.0f, 1.0f, 0.0f), 0.0001f)));
+    ASSERT_NEAR(areaWeighted.origin.x, 0.0f, 0.0001f);
+    ASSERT_NEAR(areaWeighted.origin.z, 0.0f, 0.0001f);
+
+    // (and the mesh is tessellated unevenly enough that the weighting matters)
+    Plane const indexCountWeighted = FitPlane(mesh, ShapeFitWeighting::IndexCount);
+    ASSERT_GT(abs(indexCountWeighted.normal.x), 0.1f);
+}
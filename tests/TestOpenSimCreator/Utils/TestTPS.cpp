@@ -0,0 +1,379 @@
+#include <OpenSimCreator/Utils/TPS.h>
+
+#include <OpenSimCreator/Utils/LandmarkPair3D.h>
+#include <OpenSimCreator/Utils/TPS3D.h>
+#include <Simbody.h>
+#include <gtest/gtest.h>
+#include <oscar/Graphics/Geometries/PlaneGeometry.h>
+#include <oscar/Graphics/Mesh.h>
+#include <oscar/Maths/CommonFunctions.h>
+#include <oscar/Maths/GeometricFunctions.h>
+#include <oscar/Maths/Vec2.h>
+#include <oscar/Maths/Vec3.h>
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    // a (deliberately unoptimized) copy of the 2D TPS implementation that `TPS2DTab` used to
+    // have, which is used to ensure that the generic implementation is numerically equivalent
+    struct ReferenceCoefficients2D final {
+        Vec2 a1;
+        Vec2 a2;
+        Vec2 a3;
+        std::vector<Vec2> weights;
+        std::vector<Vec2> controlPoints;
+    };
+
+    float ReferenceRadialBasisFunction2D(Vec2 controlPoint, Vec2 p)
+    {
+        Vec2 const diff = controlPoint - p;
+        float const r2 = dot(diff, diff);
+        return r2 == 0.0f ? std::numeric_limits<float>::min() : r2 * std::log(r2);
+    }
+
+    ReferenceCoefficients2D ReferenceCalcCoefficients2D(std::span<TPSLandmarkPair<2> const> pairs)
+    {
+        int const numPairs = static_cast<int>(pairs.size());
+
+        SimTK::Matrix L(numPairs + 3, numPairs + 3);
+        for (int row = 0; row < numPairs; ++row)
+        {
+            for (int col = 0; col < numPairs; ++col)
+            {
+                L(row, col) = ReferenceRadialBasisFunction2D(pairs[row].source, pairs[col].source);
+            }
+        }
+        for (int i = 0; i < numPairs; ++i)
+        {
+            L(i, numPairs)     = 1.0;
+            L(i, numPairs + 1) = pairs[i].source.x;
+            L(i, numPairs + 2) = pairs[i].source.y;
+            L(numPairs, i)     = 1.0;
+            L(numPairs + 1, i) = pairs[i].source.x;
+            L(numPairs + 2, i) = pairs[i].source.y;
+        }
+        for (int row = 0; row < 3; ++row)
+        {
+            for (int col = 0; col < 3; ++col)
+            {
+                L(numPairs + row, numPairs + col) = 0.0;
+            }
+        }
+
+        SimTK::Vector Vx(numPairs + 3, 0.0);
+        SimTK::Vector Vy(numPairs + 3, 0.0);
+        for (int row = 0; row < numPairs; ++row)
+        {
+            Vx[row] = pairs[row].destination.x;
+            Vy[row] = pairs[row].destination.y;
+        }
+
+        SimTK::Vector Cx(numPairs + 3, 0.0);
+        SimTK::Vector Cy(numPairs + 3, 0.0);
+        SimTK::FactorQTZ F(L);
+        F.solve(Vx, Cx);
+        F.solve(Vy, Cy);
+
+        ReferenceCoefficients2D rv;
+        rv.a1 = {Cx[numPairs],   Cy[numPairs]  };
+        rv.a2 = {Cx[numPairs+1], Cy[numPairs+1]};
+        rv.a3 = {Cx[numPairs+2], Cy[numPairs+2]};
+        for (int i = 0; i < numPairs; ++i)
+        {
+            rv.weights.emplace_back(Cx[i], Cy[i]);
+            rv.controlPoints.push_back(pairs[i].source);
+        }
+        return rv;
+    }
+
+    Vec2 ReferenceEvaluate2D(ReferenceCoefficients2D const& coefs, Vec2 p)
+    {
+        Vec2 rv = coefs.a1 + coefs.a2*p.x + coefs.a3*p.y;
+        for (size_t i = 0; i < coefs.weights.size(); ++i)
+        {
+            rv += coefs.weights[i] * ReferenceRadialBasisFunction2D(coefs.controlPoints[i], p);
+        }
+        return rv;
+    }
+
+    // a (deliberately unoptimized) copy of the original 3D TPS implementation (`TPS3D.cpp`),
+    // which is used to ensure that the `TPS3D` functions, which now wrap the generic
+    // implementation, are numerically equivalent to it
+    struct ReferenceCoefficients3D final {
+        Vec3 a1;
+        Vec3 a2;
+        Vec3 a3;
+        Vec3 a4;
+        std::vector<Vec3> weights;
+        std::vector<Vec3> controlPoints;
+    };
+
+    float ReferenceRadialBasisFunction3D(Vec3 controlPoint, Vec3 p)
+    {
+        return length(controlPoint - p);
+    }
+
+    ReferenceCoefficients3D ReferenceCalcCoefficients3D(std::span<TPSLandmarkPair<3> const> pairs)
+    {
+        int const numPairs = static_cast<int>(pairs.size());
+
+        SimTK::Matrix L(numPairs + 4, numPairs + 4);
+        for (int row = 0; row < numPairs; ++row)
+        {
+            for (int col = 0; col < numPairs; ++col)
+            {
+                L(row, col) = ReferenceRadialBasisFunction3D(pairs[row].source, pairs[col].source);
+            }
+        }
+        for (int i = 0; i < numPairs; ++i)
+        {
+            L(i, numPairs)     = 1.0;
+            L(i, numPairs + 1) = pairs[i].source.x;
+            L(i, numPairs + 2) = pairs[i].source.y;
+            L(i, numPairs + 3) = pairs[i].source.z;
+            L(numPairs, i)     = 1.0;
+            L(numPairs + 1, i) = pairs[i].source.x;
+            L(numPairs + 2, i) = pairs[i].source.y;
+            L(numPairs + 3, i) = pairs[i].source.z;
+        }
+        for (int row = 0; row < 4; ++row)
+        {
+            for (int col = 0; col < 4; ++col)
+            {
+                L(numPairs + row, numPairs + col) = 0.0;
+            }
+        }
+
+        SimTK::Vector Vx(numPairs + 4, 0.0);
+        SimTK::Vector Vy(numPairs + 4, 0.0);
+        SimTK::Vector Vz(numPairs + 4, 0.0);
+        for (int row = 0; row < numPairs; ++row)
+        {
+            Vx[row] = pairs[row].destination.x;
+            Vy[row] = pairs[row].destination.y;
+            Vz[row] = pairs[row].destination.z;
+        }
+
+        SimTK::Vector Cx(numPairs + 4, 0.0);
+        SimTK::Vector Cy(numPairs + 4, 0.0);
+        SimTK::Vector Cz(numPairs + 4, 0.0);
+        SimTK::FactorQTZ F(L);
+        F.solve(Vx, Cx);
+        F.solve(Vy, Cy);
+        F.solve(Vz, Cz);
+
+        ReferenceCoefficients3D rv;
+        rv.a1 = {Cx[numPairs],   Cy[numPairs],   Cz[numPairs]  };
+        rv.a2 = {Cx[numPairs+1], Cy[numPairs+1], Cz[numPairs+1]};
+        rv.a3 = {Cx[numPairs+2], Cy[numPairs+2], Cz[numPairs+2]};
+        rv.a4 = {Cx[numPairs+3], Cy[numPairs+3], Cz[numPairs+3]};
+        for (int i = 0; i < numPairs; ++i)
+        {
+            rv.weights.emplace_back(Cx[i], Cy[i], Cz[i]);
+            rv.controlPoints.push_back(pairs[i].source);
+        }
+        return rv;
+    }
+
+    Vec3 ReferenceEvaluate3D(ReferenceCoefficients3D const& coefs, Vec3 p)
+    {
+        Vec3d rv = Vec3d{coefs.a1} + Vec3d{coefs.a2*p.x} + Vec3d{coefs.a3*p.y} + Vec3d{coefs.a4*p.z};
+        for (size_t i = 0; i < coefs.weights.size(); ++i)
+        {
+            rv += coefs.weights[i] * ReferenceRadialBasisFunction3D(coefs.controlPoints[i], p);
+        }
+        return rv;
+    }
+
+    // returns some (deterministic) landmark pairs that roughly look like what a user might place
+    template<size_t N>
+    std::vector<TPSLandmarkPair<N>> GenerateLandmarkPairs(size_t n)
+    {
+        std::vector<TPSLandmarkPair<N>> rv;
+        for (size_t i = 0; i < n; ++i)
+        {
+            TPSLandmarkPair<N>& pair = rv.emplace_back();
+            for (size_t dim = 0; dim < N; ++dim)
+            {
+                float const phase = static_cast<float>(i) + 0.37f*static_cast<float>(dim);
+                pair.source[dim] = std::sin(1.7f*phase);
+                pair.destination[dim] = pair.source[dim] + 0.1f*std::cos(2.3f*phase);
+            }
+        }
+        return rv;
+    }
+
+    // returns some (deterministic) points that the TPS equation can be evaluated at
+    template<size_t N>
+    std::vector<Vec<N, float>> GenerateTestPoints(size_t n)
+    {
+        std::vector<Vec<N, float>> rv;
+        for (size_t i = 0; i < n; ++i)
+        {
+            Vec<N, float>& p = rv.emplace_back();
+            for (size_t dim = 0; dim < N; ++dim)
+            {
+                p[dim] = std::cos(0.9f*static_cast<float>(i) + 1.3f*static_cast<float>(dim));
+            }
+        }
+        return rv;
+    }
+}
+
+TEST(TPS, CalcTPSCoefficientsReturnsIdentityWarpWhenGivenNoLandmarks)
+{
+    ASSERT_EQ(CalcTPSCoefficients<2>({}), TPSCoefficients<2>{});
+    ASSERT_EQ(CalcTPSCoefficients<3>({}), TPSCoefficients<3>{});
+
+    Vec3 const p = {1.0f, -2.0f, 3.0f};
+    ASSERT_EQ(EvaluateTPSEquation(TPSCoefficients<3>{}, p), p);
+}
+
+TEST(TPS, SolverIsNumericallyEquivalentToOriginal2DImplementation)
+{
+    auto const pairs = GenerateLandmarkPairs<2>(12);
+
+    TPSCoefficients<2> const coefs = CalcTPSCoefficients<2>(pairs);
+    ReferenceCoefficients2D const reference = ReferenceCalcCoefficients2D(pairs);
+
+    ASSERT_EQ(coefs.a1, reference.a1);
+    ASSERT_EQ(coefs.linear[0], reference.a2);
+    ASSERT_EQ(coefs.linear[1], reference.a3);
+    ASSERT_EQ(coefs.nonAffineTerms.size(), reference.weights.size());
+    for (size_t i = 0; i < reference.weights.size(); ++i)
+    {
+        ASSERT_EQ(coefs.nonAffineTerms[i].weight, reference.weights[i]);
+        ASSERT_EQ(coefs.nonAffineTerms[i].controlPoint, reference.controlPoints[i]);
+    }
+
+    // (the generic evaluator accumulates in double precision, the original accumulated in float)
+    for (Vec2 const& p : GenerateTestPoints<2>(100))
+    {
+        ASSERT_TRUE(all_of(equal_within_absdiff(EvaluateTPSEquation(coefs, p), ReferenceEvaluate2D(reference, p), 1e-5f)));
+    }
+}
+
+TEST(TPS, TPS3DFunctionsAreNumericallyEquivalentToOriginal3DImplementation)
+{
+    auto const pairs = GenerateLandmarkPairs<3>(12);
+
+    TPSCoefficientSolverInputs3D inputs;
+    for (TPSLandmarkPair<3> const& pair : pairs)
+    {
+        inputs.landmarks.push_back(LandmarkPair3D{pair.source, pair.destination});
+    }
+
+    TPSCoefficients3D const coefs = CalcCoefficients(inputs);
+    ReferenceCoefficients3D const reference = ReferenceCalcCoefficients3D(pairs);
+
+    ASSERT_EQ(coefs.a1, reference.a1);
+    ASSERT_EQ(coefs.a2, reference.a2);
+    ASSERT_EQ(coefs.a3, reference.a3);
+    ASSERT_EQ(coefs.a4, reference.a4);
+    ASSERT_EQ(coefs.nonAffineTerms.size(), reference.weights.size());
+    for (size_t i = 0; i < reference.weights.size(); ++i)
+    {
+        ASSERT_EQ(coefs.nonAffineTerms[i].weight, reference.weights[i]);
+        ASSERT_EQ(coefs.nonAffineTerms[i].controlPoint, reference.controlPoints[i]);
+    }
+
+    for (Vec3 const& p : GenerateTestPoints<3>(100))
+    {
+        ASSERT_TRUE(all_of(equal_within_absdiff(EvaluateTPSEquation(coefs, p), ReferenceEvaluate3D(reference, p), 1e-5f)));
+    }
+}
+
+TEST(TPSCoefficientSolver, DoesNotRefactorizeWhenOnlyDestinationsChange)
+{
+    auto pairs = GenerateLandmarkPairs<3>(8);
+
+    TPSCoefficientSolver<3> solver;
+    ASSERT_EQ(solver.getNumFactorizations(), 0);
+    solver.solve(pairs);
+    ASSERT_EQ(solver.getNumFactorizations(), 1);
+
+    // e.g. the user is dragging a destination landmark around
+    for (int i = 0; i < 5; ++i)
+    {
+        pairs.front().destination += Vec3{0.01f, -0.02f, 0.03f};
+        TPSCoefficients<3> const cached = solver.solve(pairs);
+        ASSERT_EQ(solver.getNumFactorizations(), 1);
+        ASSERT_EQ(cached, CalcTPSCoefficients<3>(pairs)) << "solving with a cached factorization should give the same answer as a fresh solve";
+    }
+}
+
+TEST(TPSCoefficientSolver, RefactorizesWhenSourcesChange)
+{
+    auto pairs = GenerateLandmarkPairs<2>(8);
+
+    TPSCoefficientSolver<2> solver;
+    solver.solve(pairs);
+    ASSERT_EQ(solver.getNumFactorizations(), 1);
+
+    pairs.back().source += Vec2{0.05f, 0.05f};
+    ASSERT_EQ(solver.solve(pairs), CalcTPSCoefficients<2>(pairs));
+    ASSERT_EQ(solver.getNumFactorizations(), 2);
+
+    pairs.push_back({Vec2{0.5f, 0.25f}, Vec2{0.55f, 0.2f}});
+    ASSERT_EQ(solver.solve(pairs), CalcTPSCoefficients<2>(pairs));
+    ASSERT_EQ(solver.getNumFactorizations(), 3);
+}
+
+TEST(TPS, ApplyTPSWarpToPointsInPlaceIsEquivalentToEvaluatingEachPoint)
+{
+    TPSCoefficients<3> const coefs = CalcTPSCoefficients<3>(GenerateLandmarkPairs<3>(10));
+
+    std::vector<Vec3> const points = GenerateTestPoints<3>(20000);  // (enough to be parallelized)
+    std::vector<Vec3> warped = points;
+    ApplyTPSWarpToPointsInPlace(coefs, warped, 0.5f);
+
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        ASSERT_EQ(warped[i], lerp(points[i], EvaluateTPSEquation(coefs, points[i]), 0.5f));
+    }
+}
+
+TEST(TPS, ApplyTPSWarpToMeshIn2DWarpsXYAndLeavesZUntouched)
+{
+    TPSCoefficients<2> const coefs = CalcTPSCoefficients<2>(GenerateLandmarkPairs<2>(6));
+
+    Mesh input = PlaneGeometry{2.0f, 2.0f, 10, 10};
+    input.transform_vertices([](Vec3 v) { return Vec3{v.x, v.y, 0.5f}; });
+    Mesh const output = ApplyTPSWarpToMesh(coefs, input, 1.0f);
+
+    auto const inputVerts = input.vertices();
+    auto const outputVerts = output.vertices();
+    ASSERT_EQ(inputVerts.size(), outputVerts.size());
+    for (size_t i = 0; i < inputVerts.size(); ++i)
+    {
+        ASSERT_EQ(Vec2{outputVerts[i]}, EvaluateTPSEquation(coefs, Vec2{inputVerts[i]}));
+        ASSERT_EQ(outputVerts[i].z, 0.5f);
+    }
+}
+
+TEST(TPSCoefficientSolver, CanBeUsedToCalculateTPS3DCoefficients)
+{
+    TPSCoefficientSolverInputs3D inputs;
+    for (TPSLandmarkPair<3> const& pair : GenerateLandmarkPairs<3>(8))
+    {
+        inputs.landmarks.push_back(LandmarkPair3D{pair.source, pair.destination});
+    }
+
+    TPSCoefficientSolver<3> solver;
+    ASSERT_EQ(CalcCoefficients(inputs, solver), CalcCoefficients(inputs));
+
+    inputs.landmarks.front().destination += Vec3{0.1f, 0.0f, 0.0f};
+    ASSERT_EQ(CalcCoefficients(inputs, solver), CalcCoefficients(inputs));
+    ASSERT_EQ(solver.getNumFactorizations(), 1);
+
+    inputs.landmarks.front().source += Vec3{0.1f, 0.0f, 0.0f};
+    ASSERT_EQ(CalcCoefficients(inputs, solver), CalcCoefficients(inputs));
+    ASSERT_EQ(solver.getNumFactorizations(), 2);
+}
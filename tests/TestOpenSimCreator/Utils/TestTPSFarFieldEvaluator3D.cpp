@@ -0,0 +1,262 @@
+#include <OpenSimCreator/Utils/TPSFarFieldEvaluator3D.h>
+
+#include <OpenSimCreator/Utils/TPS3D.h>
+#include <gtest/gtest.h>
+#include <oscar/Maths/CommonFunctions.h>
+#include <oscar/Maths/GeometricFunctions.h>
+#include <oscar/Maths/Vec3.h>
+
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    // returns (deterministic) coefficients with `n` non-affine terms, which roughly resemble
+    // the coefficients of a dense (e.g. semi-landmark) warp
+    //
+    // (the coefficients don't have to come from a solve: the evaluator only cares about the equation)
+    TPSCoefficients3D GenerateCoefficients(size_t n)
+    {
+        std::default_random_engine rng{42};
+        std::uniform_real_distribution<float> controlPointDist{-1.0f, 1.0f};
+        std::uniform_real_distribution<float> weightDist{-0.01f, 0.01f};
+
+        TPSCoefficients3D rv;
+        rv.a1 = {0.1f, -0.2f, 0.05f};
+        rv.a2 = {1.1f, 0.0f, 0.1f};
+        rv.a4 = {0.0f, -0.1f, 0.9f};
+        rv.nonAffineTerms.reserve(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            Vec3 const weight = {weightDist(rng), weightDist(rng), weightDist(rng)};
+            Vec3 const controlPoint = {controlPointDist(rng), controlPointDist(rng), controlPointDist(rng)};
+            rv.nonAffineTerms.emplace_back(weight, controlPoint);
+        }
+        return rv;
+    }
+
+    // returns (deterministic) points that are both within, and outside of, the control points' volume
+    std::vector<Vec3> GenerateEvaluationPoints(size_t n)
+    {
+        std::default_random_engine rng{7};
+        std::uniform_real_distribution<float> dist{-2.0f, 2.0f};
+
+        std::vector<Vec3> rv;
+        rv.reserve(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            rv.emplace_back(dist(rng), dist(rng), dist(rng));
+        }
+        return rv;
+    }
+
+    struct ErrorMeasurements final {
+        float maxError = 0.0f;
+        float rmsError = 0.0f;
+    };
+
+    ErrorMeasurements MeasureError(TPSCoefficients3D const& coefs, TPSFarFieldEvaluator3D const& evaluator, std::vector<Vec3> const& points)
+    {
+        ErrorMeasurements rv;
+        double sumOfSquaredErrors = 0.0;
+        for (Vec3 const& p : points)
+        {
+            float const error = length(evaluator.evaluate(p) - EvaluateTPSEquation(coefs, p));
+            rv.maxError = max(rv.maxError, error);
+            sumOfSquaredErrors += static_cast<double>(error) * static_cast<double>(error);
+        }
+        rv.rmsError = static_cast<float>(std::sqrt(sumOfSquaredErrors / static_cast<double>(points.size())));
+        return rv;
+    }
+}
+
+TEST(TPSFarFieldEvaluator3D, EvaluatesCoefficientsWithoutNonAffineTermsExactly)
+{
+    TPSCoefficients3D coefs;
+    coefs.a1 = {1.0f, 2.0f, 3.0f};
+    coefs.a3 = {0.0f, 2.0f, 0.0f};
+
+    TPSFarFieldEvaluator3D const evaluator{coefs, 0.01f};
+
+    ASSERT_EQ(evaluator.getNumClusters(), 0);
+    for (Vec3 const& p : GenerateEvaluationPoints(100))
+    {
+        ASSERT_EQ(evaluator.evaluate(p), EvaluateTPSEquation(coefs, p));
+    }
+}
+
+TEST(TPSFarFieldEvaluator3D, ClustersControlPoints)
+{
+    TPSFarFieldEvaluator3D const evaluator{GenerateCoefficients(2000), 0.01f};
+    ASSERT_GT(evaluator.getNumClusters(), 1);
+}
+
+TEST(TPSFarFieldEvaluator3D, MeasuredMaxErrorIsWithinTheErrorTolerance)
+{
+    TPSCoefficients3D const coefs = GenerateCoefficients(2000);
+    std::vector<Vec3> const points = GenerateEvaluationPoints(2000);
+
+    for (float const errorTolerance : {1e-2f, 1e-3f, 1e-4f})
+    {
+        TPSFarFieldEvaluator3D const evaluator{coefs, errorTolerance};
+        ErrorMeasurements const errors = MeasureError(coefs, evaluator, points);
+
+        std::string const suffix = std::to_string(errorTolerance);
+        RecordProperty("maxError@" + suffix, std::to_string(errors.maxError));
+        RecordProperty("rmsError@" + suffix, std::to_string(errors.rmsError));
+
+        // (allow for floating-point rounding in the exact path)
+        ASSERT_LE(errors.maxError, 1.01f*errorTolerance + 1e-5f) << "errorTolerance = " << errorTolerance;
+        ASSERT_LE(errors.rmsError, errors.maxError);
+    }
+}
+
+TEST(TPSFarFieldEvaluator3D, UsesTheRootSumSquareErrorBudgetByDefault)
+{
+    TPSFarFieldEvaluator3D const evaluator{GenerateCoefficients(100), 0.01f};
+    ASSERT_EQ(evaluator.getErrorBudget(), TPSFarFieldErrorBudget::RootSumSquare);
+}
+
+TEST(TPSFarFieldEvaluator3D, StrictErrorBudgetMaxErrorIsAlwaysWithinTheErrorTolerance)
+{
+    // (also try weights that all point in the same direction, so that the clusters' errors can't cancel)
+    TPSCoefficients3D const coefs = GenerateCoefficients(2000);
+    TPSCoefficients3D alignedCoefs = coefs;
+    for (TPSNonAffineTerm3D& term : alignedCoefs.nonAffineTerms)
+    {
+        term.weight = abs(term.weight);
+    }
+    std::vector<Vec3> const points = GenerateEvaluationPoints(2000);
+
+    for (TPSCoefficients3D const& c : {coefs, alignedCoefs})
+    {
+        for (float const errorTolerance : {1e-2f, 1e-3f, 1e-4f})
+        {
+            TPSFarFieldEvaluator3D const evaluator{c, errorTolerance, TPSFarFieldErrorBudget::Strict};
+            ASSERT_EQ(evaluator.getErrorBudget(), TPSFarFieldErrorBudget::Strict);
+
+            // (allow for floating-point rounding in the exact path)
+            ErrorMeasurements const errors = MeasureError(c, evaluator, points);
+            ASSERT_LE(errors.maxError, errorTolerance + 1e-5f) << "errorTolerance = " << errorTolerance;
+        }
+    }
+}
+
+TEST(TPSFarFieldEvaluator3D, StrictErrorBudgetEvaluatesMoreTermsExactly)
+{
+    TPSCoefficients3D const coefs = GenerateCoefficients(2000);
+    TPSFarFieldEvaluator3D const rootSumSquare{coefs, 1e-3f, TPSFarFieldErrorBudget::RootSumSquare};
+    TPSFarFieldEvaluator3D const strict{coefs, 1e-3f, TPSFarFieldErrorBudget::Strict};
+
+    std::vector<Vec3> const points = GenerateEvaluationPoints(500);
+    size_t numExactWithRootSumSquare = 0;
+    size_t numExactWithStrict = 0;
+    for (Vec3 const& p : points)
+    {
+        numExactWithRootSumSquare += rootSumSquare.calcEvaluationStats(p).numExactlyEvaluatedTerms;
+        numExactWithStrict += strict.calcEvaluationStats(p).numExactlyEvaluatedTerms;
+    }
+    ASSERT_GT(numExactWithStrict, numExactWithRootSumSquare) << "a stricter bound should approximate fewer clusters";
+    ASSERT_LT(numExactWithStrict, points.size() * coefs.nonAffineTerms.size()) << "but it should still approximate some";
+}
+
+TEST(TPSFarFieldEvaluator3D, ZeroErrorToleranceIsEffectivelyExact)
+{
+    TPSCoefficients3D const coefs = GenerateCoefficients(500);
+    TPSFarFieldEvaluator3D const evaluator{coefs, 0.0f};
+
+    ErrorMeasurements const errors = MeasureError(coefs, evaluator, GenerateEvaluationPoints(500));
+    ASSERT_LE(errors.maxError, 1e-5f);
+}
+
+TEST(TPSFarFieldEvaluator3D, ApproximatesClustersThatAreFarAway)
+{
+    TPSCoefficients3D const coefs = GenerateCoefficients(2000);
+    TPSFarFieldEvaluator3D const evaluator{coefs, 1e-3f};
+
+    // all control points are within [-1, 1], so a point this far away shouldn't need many exact evaluations
+    TPSFarFieldEvaluator3D::EvaluationStats const stats = evaluator.calcEvaluationStats({10.0f, 10.0f, 10.0f});
+    ASSERT_GT(stats.numApproximatedClusters, 0);
+    ASSERT_LT(stats.numExactlyEvaluatedTerms, coefs.nonAffineTerms.size());
+}
+
+TEST(TPSFarFieldEvaluator3D, EvaluatesFewerTermsExactlyAsTheErrorToleranceIncreases)
+{
+    TPSCoefficients3D const coefs = GenerateCoefficients(2000);
+    std::vector<Vec3> const points = GenerateEvaluationPoints(500);
+
+    auto const countExactlyEvaluatedTerms = [&coefs, &points](float errorTolerance)
+    {
+        TPSFarFieldEvaluator3D const evaluator{coefs, errorTolerance};
+        size_t rv = 0;
+        for (Vec3 const& p : points)
+        {
+            rv += evaluator.calcEvaluationStats(p).numExactlyEvaluatedTerms;
+        }
+        return rv;
+    };
+
+    size_t const numTermsInExactEvaluation = points.size() * coefs.nonAffineTerms.size();
+    size_t const atZero = countExactlyEvaluatedTerms(0.0f);
+    size_t const at1em4 = countExactlyEvaluatedTerms(1e-4f);
+    size_t const at1em2 = countExactlyEvaluatedTerms(1e-2f);
+
+    RecordProperty("exactFraction@0", std::to_string(static_cast<double>(atZero)/static_cast<double>(numTermsInExactEvaluation)));
+    RecordProperty("exactFraction@1e-4", std::to_string(static_cast<double>(at1em4)/static_cast<double>(numTermsInExactEvaluation)));
+    RecordProperty("exactFraction@1e-2", std::to_string(static_cast<double>(at1em2)/static_cast<double>(numTermsInExactEvaluation)));
+
+    ASSERT_LE(atZero, numTermsInExactEvaluation);
+    ASSERT_LT(at1em4, atZero);
+    ASSERT_LT(at1em2, at1em4);
+    ASSERT_LT(at1em2, numTermsInExactEvaluation/2) << "a loose tolerance should skip most exact evaluations";
+}
+
+TEST(TPSFarFieldEvaluator3D, ZeroErrorToleranceOnlyApproximatesSingularClusters)
+{
+    // a zero tolerance only approximates clusters where the expansion is exact (i.e. clusters of
+    // coincident control points), and the generated control points are distinct, so each approximated
+    // cluster contains exactly one term
+    TPSCoefficients3D const coefs = GenerateCoefficients(500);
+    TPSFarFieldEvaluator3D const evaluator{coefs, 0.0f};
+
+    for (Vec3 const& p : GenerateEvaluationPoints(100))
+    {
+        TPSFarFieldEvaluator3D::EvaluationStats const stats = evaluator.calcEvaluationStats(p);
+        ASSERT_EQ(stats.numExactlyEvaluatedTerms + stats.numApproximatedClusters, coefs.nonAffineTerms.size());
+    }
+}
+
+TEST(TPSFarFieldEvaluator3D, HandlesCoincidentControlPoints)
+{
+    TPSCoefficients3D coefs = GenerateCoefficients(100);
+    for (size_t i = 0; i < 100; ++i)
+    {
+        coefs.nonAffineTerms.emplace_back(Vec3{0.001f, -0.002f, 0.0f}, Vec3{0.5f, 0.5f, 0.5f});
+    }
+    TPSFarFieldEvaluator3D const evaluator{coefs, 1e-3f};
+
+    ErrorMeasurements const errors = MeasureError(coefs, evaluator, GenerateEvaluationPoints(500));
+    ASSERT_LE(errors.maxError, 1.01e-3f + 1e-5f);
+}
+
+TEST(TPSFarFieldEvaluator3D, ApplyWarpToPointsInPlaceBlendsLikeTheExactImplementation)
+{
+    TPSCoefficients3D const coefs = GenerateCoefficients(1000);
+    TPSFarFieldEvaluator3D const evaluator{coefs, 1e-3f};
+
+    std::vector<Vec3> approximate = GenerateEvaluationPoints(1000);
+    std::vector<Vec3> exact = approximate;
+    evaluator.applyWarpToPointsInPlace(approximate, 0.5f);
+    ApplyThinPlateWarpToPointsInPlace(coefs, exact, 0.5f);
+
+    for (size_t i = 0; i < exact.size(); ++i)
+    {
+        ASSERT_LE(length(approximate[i] - exact[i]), 0.5f*1.01e-3f + 1e-5f);
+    }
+}
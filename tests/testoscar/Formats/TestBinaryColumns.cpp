@@ -0,0 +1,200 @@
+#include <oscar/Formats/BinaryColumns.h>
+
+#include <gtest/gtest.h>
+#include <oscar/Maths/Vec2.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    const auto c_columns = std::to_array<BinaryColumnDescription>({
+        {"time", BinaryColumnType::Double},
+        {"smooth", BinaryColumnType::Float},
+        {"point", BinaryColumnType::Vec2},
+    });
+
+    struct ExampleData final {
+        std::vector<double> times;
+        std::vector<float> smooth;
+        std::vector<Vec2> points;
+    };
+
+    ExampleData generate_example_data(size_t num_rows)
+    {
+        ExampleData rv;
+        for (size_t i = 0; i < num_rows; ++i) {
+            rv.times.push_back(0.001 * static_cast<double>(i));
+            rv.smooth.push_back(std::sin(0.001f * static_cast<float>(i)));
+            rv.points.emplace_back(static_cast<float>(i % 7), -1.0f);
+        }
+        return rv;
+    }
+
+    // writes `data` in chunks of (at most) `chunk_size` rows
+    std::string write_example_data(const ExampleData& data, size_t chunk_size, BinaryColumnsWriterFlags flags)
+    {
+        std::stringstream out;
+        BinaryColumnsWriter writer{out, c_columns, flags};
+        for (size_t begin = 0; begin < data.times.size(); begin += chunk_size) {
+            const size_t n = std::min(chunk_size, data.times.size() - begin);
+            writer.begin_chunk(n);
+            writer.write_column(std::span{data.times}.subspan(begin, n));
+            writer.write_column(std::span{data.smooth}.subspan(begin, n));
+            writer.write_column(std::span{data.points}.subspan(begin, n));
+        }
+        writer.finish();
+        return std::move(out).str();
+    }
+
+    template<std::unsigned_integral T>
+    void append_le(std::string& out, T v)
+    {
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            out.push_back(static_cast<char>((v >> (8*i)) & 0xff));
+        }
+    }
+
+    // returns the header of a file that contains one `Double` column, followed by the start of a chunk
+    // that claims to contain `num_rows` rows, and is encoded with `encoding`, with a payload of `payload_size`
+    std::string header_of_chunk_with_untrusted_sizes(uint32_t num_rows, uint8_t encoding, uint64_t payload_size)
+    {
+        std::stringstream out;
+        {
+            const auto columns = std::to_array<BinaryColumnDescription>({{"values", BinaryColumnType::Double}});
+            BinaryColumnsWriter writer{out, columns};
+        }
+        std::string rv = std::move(out).str();
+        append_le<uint32_t>(rv, num_rows);
+        append_le<uint8_t>(rv, encoding);
+        append_le<uint64_t>(rv, payload_size);
+        return rv;
+    }
+}
+
+TEST(BinaryColumns, RoundTripsColumnsWithoutCompression)
+{
+    const ExampleData data = generate_example_data(1000);
+    std::stringstream in{write_example_data(data, 300, BinaryColumnsWriterFlags::None)};
+
+    const std::vector<BinaryColumn> columns = read_binary_columns(in);
+
+    ASSERT_EQ(columns.size(), 3);
+    ASSERT_EQ(columns[0].name, "time");
+    ASSERT_EQ(type_of(columns[0]), BinaryColumnType::Double);
+    ASSERT_EQ(std::get<std::vector<double>>(columns[0].data), data.times);
+    ASSERT_EQ(columns[1].name, "smooth");
+    ASSERT_EQ(std::get<std::vector<float>>(columns[1].data), data.smooth);
+    ASSERT_EQ(columns[2].name, "point");
+    ASSERT_EQ(std::get<std::vector<Vec2>>(columns[2].data), data.points);
+}
+
+TEST(BinaryColumns, RoundTripsColumnsWithCompression)
+{
+    const ExampleData data = generate_example_data(10000);
+    std::stringstream in{write_example_data(data, 4096, BinaryColumnsWriterFlags::Compress)};
+
+    const std::vector<BinaryColumn> columns = read_binary_columns(in);
+
+    ASSERT_EQ(columns.size(), 3);
+    ASSERT_EQ(std::get<std::vector<double>>(columns[0].data), data.times);
+    ASSERT_EQ(std::get<std::vector<float>>(columns[1].data), data.smooth);
+    ASSERT_EQ(std::get<std::vector<Vec2>>(columns[2].data), data.points);
+}
+
+TEST(BinaryColumns, CompressionMakesSmoothlyVaryingDataSmaller)
+{
+    const ExampleData data = generate_example_data(10000);
+    ASSERT_LT(
+        write_example_data(data, 4096, BinaryColumnsWriterFlags::Compress).size(),
+        write_example_data(data, 4096, BinaryColumnsWriterFlags::None).size()
+    );
+}
+
+TEST(BinaryColumns, RoundTripsSpecialFloatingPointValues)
+{
+    const auto values = std::to_array({0.0f, -0.0f, std::numeric_limits<float>::infinity(), std::numeric_limits<float>::denorm_min(), std::numeric_limits<float>::max()});
+
+    std::stringstream out;
+    {
+        const auto columns = std::to_array<BinaryColumnDescription>({{"values", BinaryColumnType::Float}});
+        BinaryColumnsWriter writer{out, columns};
+        writer.begin_chunk(values.size());
+        writer.write_column(values);
+        writer.finish();
+    }
+
+    const std::vector<BinaryColumn> columns = read_binary_columns(out);
+    ASSERT_EQ(columns.size(), 1);
+    const auto& read = std::get<std::vector<float>>(columns[0].data);
+    ASSERT_EQ(read.size(), values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        ASSERT_EQ(read[i], values[i]);
+        ASSERT_EQ(std::signbit(read[i]), std::signbit(values[i]));
+    }
+}
+
+TEST(BinaryColumns, ReadsColumnsWithNoRows)
+{
+    std::stringstream out;
+    {
+        BinaryColumnsWriter writer{out, c_columns};
+        writer.finish();
+    }
+
+    const std::vector<BinaryColumn> columns = read_binary_columns(out);
+    ASSERT_EQ(columns.size(), 3);
+    for (const BinaryColumn& column : columns) {
+        ASSERT_TRUE(std::visit([](const auto& data) { return data.empty(); }, column.data));
+    }
+}
+
+TEST(BinaryColumns, ThrowsIfTheDataIsNotInTheBinaryColumnsFormat)
+{
+    std::stringstream in{"time,value\n0,1\n"};
+    ASSERT_ANY_THROW({ read_binary_columns(in); });
+}
+
+TEST(BinaryColumns, ThrowsIfTheDataIsTruncated)
+{
+    const std::string content = write_example_data(generate_example_data(100), 64, BinaryColumnsWriterFlags::Default);
+    std::stringstream in{content.substr(0, content.size() - 10)};
+    ASSERT_ANY_THROW({ read_binary_columns(in); });
+}
+
+TEST(BinaryColumns, ThrowsWithoutAllocatingTheClaimedSizeIfARawChunkHeaderIsMalformed)
+{
+    // claims that the chunk contains ~4 billion rows (~32 GiB), but it only has a few bytes of data
+    constexpr uint32_t num_rows = std::numeric_limits<uint32_t>::max();
+    std::string content = header_of_chunk_with_untrusted_sizes(num_rows, 0, uint64_t{num_rows} * sizeof(double));
+    content += "12345678";
+
+    std::stringstream in{content};
+    ASSERT_THROW({ read_binary_columns(in); }, std::runtime_error);
+}
+
+TEST(BinaryColumns, ThrowsIfACompressedChunkClaimsToDecodeToMoreThanPossible)
+{
+    // a 2-byte run-length-encoded payload can't decode to ~32 GiB
+    constexpr uint32_t num_rows = std::numeric_limits<uint32_t>::max();
+    std::string content = header_of_chunk_with_untrusted_sizes(num_rows, 1, 2);
+    content += "\xff\x00";
+    append_le<uint32_t>(content, 0);
+
+    std::stringstream in{content};
+    ASSERT_THROW({ read_binary_columns(in); }, std::runtime_error);
+}
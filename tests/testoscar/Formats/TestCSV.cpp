@@ -1,11 +1,66 @@
 #include <oscar/Formats/CSV.h>
 
 #include <gtest/gtest.h>
+#include <oscar/Utils/TemporaryDirectory.h>
 
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <optional>
 #include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 using namespace osc;
 
+namespace
+{
+    // inputs that exercise the edge-cases of the CSV tokenizer
+    constexpr auto c_tokenizer_edge_cases = std::to_array<std::string_view>({
+        "",
+        " ",
+        ",,",
+        "col1,col2,col3",
+        "col1,col2,col3\na,b,c\nd,e,f\n",
+        R"("""quoted text""",col2)",
+        R"(a,b"c"d,e)",
+        R"(a,"bc"d,e)",
+        R"(John,Doe,120 any st.,"Anytown, WW",08123)",
+        R"(1,"","")",
+        "1,\"\",\"\"\r\n",
+        R"(1,"ha ""ha"" ha")",
+        R"(1,"{""type"": ""Point"", ""coordinates"": [102.0, 0.5]}")",
+        "\"Once upon \na time\",5,6",
+        "\"Once upon \r\na time\",5,6",
+        "a,b,c\r\n1,2,3",
+        "a\rb,c\r",
+        "\"unterminated,quote\nrow",
+        R"(a""b,"",""""")",
+    });
+
+    std::vector<std::vector<std::string>> read_all_rows_with_read_csv_row(std::string_view content)
+    {
+        std::istringstream input{std::string{content}};
+        std::vector<std::vector<std::string>> rv;
+        while (auto row = read_csv_row(input)) {
+            rv.push_back(std::move(row).value());
+        }
+        return rv;
+    }
+
+    std::vector<std::vector<std::string>> read_all_rows(CSVReader& reader)
+    {
+        std::vector<std::vector<std::string>> rv;
+        while (auto row = reader.next_row()) {
+            rv.emplace_back(row->begin(), row->end());
+        }
+        return rv;
+    }
+}
+
 TEST(read_csv_row, ReadingAnEmptyStreamReturnsASingleEmptyColumn)
 {
     std::istringstream input;
@@ -268,3 +323,146 @@ TEST(write_csv_row, EdgeCase1)
 
     ASSERT_EQ(output.str(), expected_output);
 }
+
+TEST(CSVReader, YieldsTheSameRowsAsReadCSVRowForEdgeCases)
+{
+    for (const std::string_view input : c_tokenizer_edge_cases) {
+        CSVReader reader{input};
+        ASSERT_EQ(read_all_rows(reader), read_all_rows_with_read_csv_row(input)) << input;
+    }
+}
+
+TEST(CSVReader, YieldsTheSameRowsAsReadCSVRowForEdgeCasesWhenReadingFromAStream)
+{
+    for (const std::string_view input : c_tokenizer_edge_cases) {
+        std::istringstream stream{std::string{input}};
+        CSVReader reader{stream};
+        ASSERT_EQ(read_all_rows(reader), read_all_rows_with_read_csv_row(input)) << input;
+    }
+}
+
+TEST(CSVReader, HandlesRowsThatSpanMultipleChunksOfAStream)
+{
+    // the rows are large enough (and oddly-sized enough) that some of them must span
+    // whichever chunk boundaries the reader uses internally
+    std::string content;
+    for (size_t row = 0; row < 2000; ++row) {
+        content += "row" + std::to_string(row) + ",\"quoted, \"\"escaped\"\"\r\n content\"," + std::string(row % 97, 'x') + "\r\n";
+    }
+
+    std::istringstream stream{content};
+    CSVReader reader{stream};
+    ASSERT_EQ(read_all_rows(reader), read_all_rows_with_read_csv_row(content));
+}
+
+TEST(CSVReader, ReturnsNulloptAfterTheLastRow)
+{
+    CSVReader reader{std::string_view{"a,b"}};
+    ASSERT_TRUE(reader.next_row());
+    ASSERT_FALSE(reader.next_row());
+    ASSERT_FALSE(reader.next_row());
+}
+
+TEST(CSVReader, CanReadFilesWithOrWithoutMemoryMapping)
+{
+    const TemporaryDirectory dir;
+    const std::filesystem::path path = dir.path() / "file.csv";
+    const std::string_view content = "name,x\r\n\"a, b\",1.5\nc,2\n";
+    {
+        std::ofstream out{path, std::ios::binary};
+        out << content;
+    }
+
+    for (const CSVReaderFlags flags : {CSVReaderFlags::None, CSVReaderFlags::MemoryMap}) {
+        CSVReader reader{path, flags};
+        ASSERT_EQ(read_all_rows(reader), read_all_rows_with_read_csv_row(content));
+    }
+}
+
+TEST(CSVReader, ThrowsIfTheFileCannotBeOpened)
+{
+    ASSERT_ANY_THROW({ CSVReader reader{std::filesystem::path{"/this/path/doesnt/exist.csv"}}; });
+}
+
+TEST(CSVWriter, WritesRowsInTheExpectedFormat)
+{
+    struct TestCase final {
+        std::vector<std::string> row;
+        std::string_view expected;
+    };
+    const auto test_cases = std::to_array<TestCase>({
+        {{"a", "b", "c"}, "a,b,c\n"},
+        {{" leading", "trailing ", "in side"}, " leading,trailing ,in side\n"},  // (whitespace isn't quoted)
+        {{"a, b", "c"}, "\"a, b\",c\n"},
+        {{"say \"hi\""}, "\"say \"\"hi\"\"\"\n"},
+        {{"\""}, "\"\"\"\"\n"},
+        {{"line1\nline2", "x"}, "\"line1\nline2\",x\n"},
+        {{"crlf\r\n"}, "\"crlf\r\n\"\n"},
+        {{"", "", ""}, ",,\n"},
+        {{"", "b", ""}, ",b,\n"},
+        {{""}, "\n"},
+        {{}, "\n"},
+    });
+
+    for (const TestCase& c : test_cases) {
+        std::stringstream writer_output;
+        {
+            CSVWriter writer{writer_output};
+            writer.write_row(c.row);
+        }
+        ASSERT_EQ(writer_output.str(), c.expected);
+
+        std::stringstream write_csv_row_output;
+        write_csv_row(write_csv_row_output, c.row);
+        ASSERT_EQ(write_csv_row_output.str(), c.expected);
+    }
+}
+
+TEST(CSVWriter, WritesMultipleRowsAndMixedCellTypes)
+{
+    std::stringstream output;
+    {
+        CSVWriter writer{output};
+        writer.write_cell("time");
+        writer.write_cell("label, with comma");
+        writer.end_row();
+        writer.write_cell(0.5f);
+        writer.write_cell("x");
+        writer.end_row();
+        writer.write_cell(-2.25);
+        writer.write_cell("");
+        writer.end_row();
+    }
+    ASSERT_EQ(output.str(), "time,\"label, with comma\"\n0.5,x\n-2.25,\n");
+}
+
+TEST(CSVWriter, OnlyWritesBufferedContentWhenFlushedOrDestroyed)
+{
+    std::stringstream output;
+    CSVWriter writer{output};
+    writer.write_row(std::to_array<std::string_view>({"a", "b"}));
+    ASSERT_EQ(output.str(), "") << "small writes should be buffered";
+    writer.flush();
+    ASSERT_EQ(output.str(), "a,b\n");
+}
+
+TEST(CSVWriter, WritesFloatingPointCellsThatReadBackAsTheSameValue)
+{
+    const auto values = std::to_array({0.0f, 1337.0f, -1.0f, 0.1f, 1.0f/3.0f, 1e-20f, 3.4e38f});
+
+    std::stringstream output;
+    {
+        CSVWriter writer{output};
+        for (float v : values) {
+            writer.write_cell(v);
+        }
+        writer.end_row();
+    }
+
+    const std::optional<std::vector<std::string>> row = read_csv_row(output);
+    ASSERT_TRUE(row);
+    ASSERT_EQ(row->size(), values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        ASSERT_EQ(std::stof(row->at(i)), values[i]) << row->at(i);
+    }
+}
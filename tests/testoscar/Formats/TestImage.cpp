@@ -3,6 +3,8 @@
 #include <testoscar/testoscarconfig.h>
 
 #include <gtest/gtest.h>
+#include <oscar/Formats/ImageLoadingFlags.h>
+#include <oscar/Graphics/Color32.h>
 #include <oscar/Graphics/ColorSpace.h>
 #include <oscar/Graphics/Texture2D.h>
 #include <oscar/Platform/AppConfig.h>
@@ -10,7 +12,11 @@
 #include <oscar/Utils/NullOStream.h>
 
 #include <array>
+#include <cstddef>
 #include <filesystem>
+#include <future>
+#include <sstream>
+#include <vector>
 
 using namespace osc;
 
@@ -39,3 +45,57 @@ TEST(Image, CanLoadAndThenWriteImage)
     ASSERT_NO_THROW({ write_to_png(loaded_texture, out); });
     ASSERT_TRUE(out.was_written_to());
 }
+
+TEST(Image, LoadTexture2DFromImageFlipsRowsWhenFlipVerticallyIsSet)
+{
+    const auto path = std::filesystem::path{OSC_TESTING_RESOURCES_DIR} / "awesomeface.png";
+    const Texture2D texture = load_texture2D_from_image(ResourceStream{path}, ColorSpace::sRGB);
+    const Texture2D flipped = load_texture2D_from_image(ResourceStream{path}, ColorSpace::sRGB, ImageLoadingFlags::FlipVertically);
+
+    ASSERT_EQ(flipped.dimensions(), texture.dimensions());
+
+    const auto width = static_cast<size_t>(texture.dimensions().x);
+    const auto height = static_cast<size_t>(texture.dimensions().y);
+    const std::vector<Color32> pixels = texture.pixels32();
+    const std::vector<Color32> flipped_pixels = flipped.pixels32();
+    for (size_t row = 0; row < height; ++row) {
+        for (size_t col = 0; col < width; ++col) {
+            ASSERT_EQ(flipped_pixels[row*width + col], pixels[(height - row - 1)*width + col]);
+        }
+    }
+}
+
+TEST(Image, WriteToPNGThenLoadingTheResultRoundTrips)
+{
+    const auto path = std::filesystem::path{OSC_TESTING_RESOURCES_DIR} / "awesomeface.png";
+    const Texture2D texture = load_texture2D_from_image(ResourceStream{path}, ColorSpace::sRGB);
+
+    std::stringstream png;
+    write_to_png(texture, png);
+    const Texture2D reloaded = load_texture2D_from_image(png, "in-memory.png", ColorSpace::sRGB);
+
+    ASSERT_EQ(reloaded.dimensions(), texture.dimensions());
+    ASSERT_EQ(reloaded.pixels32(), texture.pixels32());
+}
+
+TEST(Image, LoadTexture2DFromImageAsyncCanLoadManyImagesInParallel)
+{
+    const auto path = std::filesystem::path{OSC_TESTING_RESOURCES_DIR} / "awesomeface.png";
+    const std::vector<Color32> expected = load_texture2D_from_image(ResourceStream{path}, ColorSpace::sRGB, ImageLoadingFlags::FlipVertically).pixels32();
+
+    std::vector<std::future<Texture2D>> loaders;
+    for (size_t i = 0; i < 8; ++i) {
+        const ImageLoadingFlags flags = i % 2 == 0 ? ImageLoadingFlags::FlipVertically : ImageLoadingFlags::None;
+        loaders.push_back(load_texture2D_from_image_async(ResourceStream{path}, ColorSpace::sRGB, flags));
+    }
+
+    for (size_t i = 0; i < loaders.size(); ++i) {
+        const Texture2D texture = loaders[i].get();
+        if (i % 2 == 0) {
+            ASSERT_EQ(texture.pixels32(), expected);
+        }
+        else {
+            ASSERT_NE(texture.pixels32(), expected);
+        }
+    }
+}
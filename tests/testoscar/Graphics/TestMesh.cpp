@@ -22,6 +22,8 @@
 #include <oscar/Maths/Vec2.h>
 #include <oscar/Maths/Vec3.h>
 #include <oscar/Maths/Vec4.h>
+#include <oscar/Utils/StridedSpan.h>
+#include <oscar/Utils/UID.h>
 
 #include <algorithm>
 #include <array>
@@ -452,6 +454,208 @@ TEST(Mesh, TransformVertsWithMat4CausesTransformedMeshToNotBeEqualToInitialMesh)
     ASSERT_NE(m, copy) << "should be non-equal because mesh equality is reference-based (if it becomes value-based, delete this test)";
 }
 
+TEST(Mesh, TryViewVerticesReturnsEmptyViewForDefaultConstructedMesh)
+{
+    const Mesh m;
+    const auto view = m.try_view_vertices();
+    ASSERT_FALSE(view.has_value());  // there's no `Position` attribute to view
+}
+
+TEST(Mesh, TryViewVerticesReturnsViewOfVertices)
+{
+    const auto verts = GenerateVertices(12);
+
+    Mesh m;
+    m.set_vertices(verts);
+    m.set_normals(GenerateNormals(12));  // i.e. the vertex buffer is interleaved
+
+    const auto view = m.try_view_vertices();
+    ASSERT_TRUE(view.has_value());
+    ASSERT_FALSE(view->is_contiguous());
+    ASSERT_TRUE(std::equal(view->begin(), view->end(), verts.begin(), verts.end()));
+}
+
+TEST(Mesh, TryViewVerticesReturnsNulloptIfVerticesAreEncodedDifferently)
+{
+    Mesh m;
+    m.set_vertex_buffer_params(3, {
+        {VertexAttribute::Position, VertexAttributeFormat::Unorm8x4},
+    });
+    ASSERT_FALSE(m.try_view_vertices().has_value());
+}
+
+TEST(Mesh, ModifyVerticesModifiesVerticesInPlace)
+{
+    const auto verts = GenerateVertices(12);
+    const auto expected = MapToVector(verts, [](const Vec3& v) { return v + 1.0f; });
+
+    Mesh m;
+    m.set_vertices(verts);
+    m.set_normals(GenerateNormals(12));
+    m.modify_vertices([](StridedSpan<Vec3> vs)
+    {
+        for (Vec3& v : vs) {
+            v += 1.0f;
+        }
+    });
+
+    ASSERT_EQ(m.vertices(), expected);
+}
+
+TEST(Mesh, ModifyVerticesRecalculatesBounds)
+{
+    Mesh m;
+    m.set_vertices({{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}});
+    m.set_indices({0, 1, 2});
+    const AABB originalBounds = {{0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 0.0f}};
+    ASSERT_EQ(m.bounds(), originalBounds);
+
+    m.modify_vertices([](StridedSpan<Vec3> vs)
+    {
+        for (Vec3& v : vs) {
+            v *= 2.0f;
+        }
+    });
+
+    const AABB expectedBounds = {{0.0f, 0.0f, 0.0f}, {2.0f, 2.0f, 0.0f}};
+    ASSERT_EQ(m.bounds(), expectedBounds);
+}
+
+TEST(Mesh, ModifyVerticesCausesModifiedMeshToNotBeEqualToInitialMesh)
+{
+    Mesh m;
+    m.set_vertices(GenerateVertices(6));
+    const Mesh copy{m};
+    ASSERT_EQ(m, copy);
+
+    m.modify_vertices([](StridedSpan<Vec3>) {});  // noop modification also triggers this (meshes aren't value-comparable)
+
+    ASSERT_NE(m, copy);
+}
+
+TEST(Mesh, ModifyVerticesDoesNotAffectCopiesOfTheMesh)
+{
+    const auto verts = GenerateVertices(6);
+
+    Mesh m;
+    m.set_vertices(verts);
+    const Mesh copy{m};
+
+    m.modify_vertices([](StridedSpan<Vec3> vs) { vs.front() = Vec3{-1.0f}; });
+
+    ASSERT_EQ(copy.vertices(), verts);
+    ASSERT_EQ(m.vertices().front(), Vec3{-1.0f});
+}
+
+TEST(Mesh, VersionChangesWhenVerticesAreModifiedInPlaceWithoutChangingTheBounds)
+{
+    Mesh m;
+    m.set_vertices({{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.5f, 0.5f, 0.0f}});
+    m.set_indices({0, 1, 3, 1, 2, 3});
+    const AABB bounds = m.bounds();
+    const UID version = m.version();
+
+    m.modify_vertices([](StridedSpan<Vec3> vs) { vs[3] = Vec3{0.25f, 0.25f, 0.0f}; });
+
+    ASSERT_EQ(m.bounds(), bounds);
+    ASSERT_NE(m.version(), version);
+}
+
+TEST(Mesh, VersionDoesNotChangeWhenTheMeshIsOnlyRead)
+{
+    Mesh m;
+    m.set_vertices(GenerateVertices(6));
+    const UID version = m.version();
+
+    [[maybe_unused]] const auto vertices = m.vertices();
+    [[maybe_unused]] const auto& bounds = m.bounds();
+    const Mesh copy{m};
+
+    ASSERT_EQ(m.version(), version);
+    ASSERT_EQ(copy.version(), version) << "an unmodified copy has the same content, so it has the same version";
+}
+
+TEST(Mesh, VersionChangesWhenAnyDataIsModified)
+{
+    Mesh m;
+    m.set_vertices(GenerateVertices(6));
+    m.set_normals(GenerateNormals(6));
+    m.set_indices({0, 1, 2, 3, 4, 5});
+
+    const auto assertModificationChangesVersion = [&m](const auto& modification)
+    {
+        const UID before = m.version();
+        modification();
+        ASSERT_NE(m.version(), before);
+    };
+
+    assertModificationChangesVersion([&m]() { m.set_topology(MeshTopology::Lines); });
+    assertModificationChangesVersion([&m]() { m.set_topology(MeshTopology::Triangles); });
+    assertModificationChangesVersion([&m]() { m.transform_vertices([](Vec3 v) { return 2.0f*v; }); });
+    assertModificationChangesVersion([&m]() { m.set_colors(std::vector<Color>(6, Color::red())); });
+    assertModificationChangesVersion([&m]() { m.set_indices({5, 4, 3, 2, 1, 0}); });
+    assertModificationChangesVersion([&m]() { m.recalculate_normals(); });
+    assertModificationChangesVersion([&m]() { m.push_submesh_descriptor({0, 3, MeshTopology::Triangles}); });
+    assertModificationChangesVersion([&m]() { m.clear_submesh_descriptors(); });
+    assertModificationChangesVersion([&m]() { m.clear(); });
+}
+
+TEST(Mesh, ModifyVerticesWorksWhenVerticesAreEncodedDifferently)
+{
+    Mesh m;
+    m.set_vertex_buffer_params(3, {
+        {VertexAttribute::Position, VertexAttributeFormat::Unorm8x4},
+    });
+
+    // falls back to decoding + re-encoding the data
+    m.modify_vertices([](StridedSpan<Vec3> vs)
+    {
+        ASSERT_EQ(vs.size(), 3);
+        vs[1] = Vec3{1.0f};
+    });
+
+    const std::vector<Vec3> expected = {Vec3{0.0f}, Vec3{1.0f}, Vec3{0.0f}};
+    ASSERT_EQ(m.vertices(), expected);
+}
+
+TEST(Mesh, ModifyNormalsModifiesNormalsInPlace)
+{
+    const auto normals = GenerateNormals(9);
+    const auto expected = MapToVector(normals, [](const Vec3& n) { return -n; });
+
+    Mesh m;
+    m.set_vertices(GenerateVertices(9));
+    m.set_normals(normals);
+    ASSERT_TRUE(m.try_view_normals().has_value());
+    m.modify_normals([](StridedSpan<Vec3> ns)
+    {
+        for (Vec3& n : ns) {
+            n = -n;
+        }
+    });
+
+    ASSERT_EQ(m.normals(), expected);
+}
+
+TEST(Mesh, ModifyTexCoordsModifiesTexCoordsInPlace)
+{
+    const auto coords = GenerateTexCoords(9);
+    const auto expected = MapToVector(coords, [](const Vec2& c) { return 0.5f*c; });
+
+    Mesh m;
+    m.set_vertices(GenerateVertices(9));
+    m.set_tex_coords(coords);
+    ASSERT_TRUE(m.try_view_tex_coords().has_value());
+    m.modify_tex_coords([](StridedSpan<Vec2> cs)
+    {
+        for (Vec2& c : cs) {
+            c *= 0.5f;
+        }
+    });
+
+    ASSERT_EQ(m.tex_coords(), expected);
+}
+
 TEST(Mesh, HasNormalsReturnsFalseForNewlyConstructedMesh)
 {
     ASSERT_FALSE(Mesh{}.has_normals());
@@ -0,0 +1,67 @@
+#include <oscar/Graphics/MeshFunctions.h>
+
+#include <gtest/gtest.h>
+#include <oscar/Graphics/Geometries/SphereGeometry.h>
+#include <oscar/Graphics/Mesh.h>
+#include <oscar/Graphics/MeshTopology.h>
+#include <oscar/Maths/AABB.h>
+#include <oscar/Maths/AABBFunctions.h>
+#include <oscar/Maths/CommonFunctions.h>
+#include <oscar/Maths/Vec3.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+using namespace osc;
+
+TEST(decimate_by_vertex_clustering, returns_mesh_as_is_if_it_already_has_few_enough_vertices)
+{
+    const Mesh mesh = SphereGeometry{1.0f, 8, 8};
+    ASSERT_EQ(decimate_by_vertex_clustering(mesh, mesh.num_vertices()), mesh);
+}
+
+TEST(decimate_by_vertex_clustering, returns_mesh_as_is_if_it_is_not_a_triangle_mesh)
+{
+    Mesh mesh;
+    mesh.set_topology(MeshTopology::Lines);
+    mesh.set_vertices({Vec3{0.0f}, Vec3{1.0f}, Vec3{2.0f}, Vec3{3.0f}});
+    mesh.set_indices({0, 1, 2, 3});
+    ASSERT_EQ(decimate_by_vertex_clustering(mesh, 2), mesh);
+}
+
+TEST(decimate_by_vertex_clustering, returns_mesh_with_no_more_than_max_vertices)
+{
+    const Mesh mesh = SphereGeometry{1.0f, 128, 128};
+    for (const size_t max_vertices : std::to_array<size_t>({16, 100, 1000, 4000})) {
+        const Mesh decimated = decimate_by_vertex_clustering(mesh, max_vertices);
+        ASSERT_LE(decimated.num_vertices(), max_vertices);
+        ASSERT_GT(decimated.num_vertices(), max_vertices/8) << "the decimation should use a reasonable amount of the vertex budget";
+    }
+}
+
+TEST(decimate_by_vertex_clustering, produces_valid_triangles_within_the_original_bounds)
+{
+    const Mesh mesh = SphereGeometry{1.0f, 64, 64};
+    const Mesh decimated = decimate_by_vertex_clustering(mesh, 500);
+
+    ASSERT_EQ(decimated.topology(), MeshTopology::Triangles);
+    ASSERT_EQ(decimated.num_indices() % 3, 0);
+    ASSERT_GT(decimated.num_indices(), 0);
+    for (uint32_t index : decimated.indices()) {
+        ASSERT_LT(index, decimated.num_vertices());
+    }
+    for (size_t i = 0; i < decimated.num_indices(); i += 3) {
+        ASSERT_NE(decimated.indices()[i], decimated.indices()[i+1]);
+        ASSERT_NE(decimated.indices()[i+1], decimated.indices()[i+2]);
+        ASSERT_NE(decimated.indices()[i], decimated.indices()[i+2]);
+    }
+
+    // (cluster averages always lie within the original mesh's bounds)
+    const AABB original_bounds = mesh.bounds();
+    for (const Vec3& vertex : decimated.vertices()) {
+        ASSERT_TRUE(all_of(elementwise_less_equal(original_bounds.min - 1e-5f, vertex)));
+        ASSERT_TRUE(all_of(elementwise_less_equal(vertex, original_bounds.max + 1e-5f)));
+    }
+    ASSERT_TRUE(decimated.has_normals()) << "normals should be recalculated, because the original mesh had them";
+}
@@ -1,12 +1,111 @@
 #include <oscar/Maths/BVH.h>
 
 #include <gtest/gtest.h>
+#include <oscar/Maths/AABB.h>
+#include <oscar/Maths/BVHCollision.h>
+#include <oscar/Maths/Line.h>
+#include <oscar/Maths/Vec3.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <vector>
 
 using namespace osc;
 
+namespace
+{
+    // returns a row of unit cubes along +X, with gaps between them
+    std::vector<AABB> generate_row_of_cubes(size_t n, float x_offset = 0.0f)
+    {
+        std::vector<AABB> rv;
+        for (size_t i = 0; i < n; ++i) {
+            const float x = x_offset + 2.0f*static_cast<float>(i);
+            rv.push_back(AABB{.min = {x, 0.0f, 0.0f}, .max = {x + 1.0f, 1.0f, 1.0f}});
+        }
+        return rv;
+    }
+
+    std::vector<ptrdiff_t> all_ray_aabb_collision_ids(const BVH& bvh, const Line& ray)
+    {
+        std::vector<ptrdiff_t> rv;
+        bvh.for_each_ray_aabb_collision(ray, [&rv](BVHCollision c) { rv.push_back(c.id); });
+        std::sort(rv.begin(), rv.end());
+        return rv;
+    }
+}
+
 TEST(BVH, GetMaxDepthReturns0OnDefaultConstruction)
 {
     BVH bvh;
 
     ASSERT_EQ(bvh.max_depth(), 0);
 }
+
+TEST(BVH, ForEachRayAABBCollisionNearestFirstEmitsCollisionsInDistanceOrder)
+{
+    BVH bvh;
+    bvh.build_from_aabbs(generate_row_of_cubes(16));
+
+    // shoot the ray from the far end of the row, so that the nearest cubes have the highest IDs
+    const Line ray{.origin = {100.0f, 0.5f, 0.5f}, .direction = {-1.0f, 0.0f, 0.0f}};
+
+    std::vector<ptrdiff_t> ids;
+    std::vector<float> distances;
+    bvh.for_each_ray_aabb_collision_nearest_first(ray, [&](const BVHCollision& c)
+    {
+        ids.push_back(c.id);
+        distances.push_back(c.distance);
+        return std::numeric_limits<float>::max();
+    });
+
+    ASSERT_EQ(ids.size(), 16);
+    ASSERT_TRUE(std::is_sorted(distances.begin(), distances.end()));
+    ASSERT_EQ(ids.front(), 15);
+    ASSERT_EQ(ids.back(), 0);
+}
+
+TEST(BVH, ForEachRayAABBCollisionNearestFirstStopsOnceTheRemainingAABBsAreFurtherThanTheReturnedDistance)
+{
+    BVH bvh;
+    bvh.build_from_aabbs(generate_row_of_cubes(16));
+
+    const Line ray{.origin = {-10.0f, 0.5f, 0.5f}, .direction = {1.0f, 0.0f, 0.0f}};
+
+    std::vector<ptrdiff_t> ids;
+    bvh.for_each_ray_aabb_collision_nearest_first(ray, [&ids](const BVHCollision& c)
+    {
+        ids.push_back(c.id);
+        return c.distance + 0.5f;  // i.e. "found something inside this AABB"
+    });
+
+    ASSERT_EQ(ids, std::vector<ptrdiff_t>{0});
+}
+
+TEST(BVH, UpdateFromAABBsProducesTheSameCollisionsAsRebuilding)
+{
+    BVH updated;
+    updated.build_from_aabbs(generate_row_of_cubes(16));
+
+    const Line ray{.origin = {0.5f, 0.5f, -10.0f}, .direction = {0.0f, 0.0f, 1.0f}};
+    for (const float offset : {0.25f, 0.5f, 1.0f, 2.0f, 50.0f}) {
+        const std::vector<AABB> moved = generate_row_of_cubes(16, offset);
+        updated.update_from_aabbs(moved);
+
+        BVH rebuilt;
+        rebuilt.build_from_aabbs(moved);
+
+        ASSERT_EQ(updated.bounds(), rebuilt.bounds());
+        ASSERT_EQ(all_ray_aabb_collision_ids(updated, ray), all_ray_aabb_collision_ids(rebuilt, ray));
+    }
+}
+
+TEST(BVH, UpdateFromAABBsHandlesTheNumberOfAABBsChanging)
+{
+    BVH bvh;
+    bvh.build_from_aabbs(generate_row_of_cubes(4));
+    bvh.update_from_aabbs(generate_row_of_cubes(8));
+
+    const Line ray{.origin = {14.5f, 0.5f, -10.0f}, .direction = {0.0f, 0.0f, 1.0f}};
+    ASSERT_EQ(all_ray_aabb_collision_ids(bvh, ray), std::vector<ptrdiff_t>{7});
+}
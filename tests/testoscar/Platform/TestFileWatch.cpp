@@ -0,0 +1,119 @@
+#include <oscar/Platform/FileWatch.h>
+
+#include <gtest/gtest.h>
+#include <oscar/Utils/TemporaryDirectory.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    // (short, so that the tests don't have to wait long for changes to settle)
+    constexpr std::chrono::milliseconds c_test_settle_interval{50};
+
+    void write_file(const std::filesystem::path& p, const char* content)
+    {
+        std::ofstream{p} << content;
+    }
+
+    // waits (up to a timeout) for the watch to report changes
+    std::vector<std::filesystem::path> wait_for_changes(FileWatch& watch)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+        while (std::chrono::steady_clock::now() < deadline) {
+            if (auto changes = watch.take_changes(); not changes.empty()) {
+                return changes;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds{20});
+        }
+        return {};
+    }
+}
+
+TEST(FileWatch, DefaultConstructedWatchReportsNoChanges)
+{
+    FileWatch watch;
+    ASSERT_TRUE(watch.take_changes().empty());
+}
+
+TEST(FileWatch, DoesNotThrowIfGivenPathsThatDoNotExist)
+{
+    ASSERT_NO_THROW({ FileWatch watch({"doesnt-exist", "doesnt-exist-dir/doesnt-exist"}); });
+}
+
+TEST(FileWatch, ReportsABurstOfChangesToSeveralFilesAsOneBatch)
+{
+    const TemporaryDirectory dir;
+    const auto a = dir.path() / "a.osim";
+    const auto b = dir.path() / "b.vtp";
+    const auto unwatched = dir.path() / "c.txt";
+    write_file(a, "a");
+    write_file(b, "b");
+
+    FileWatch watch({a, b}, c_test_settle_interval);
+
+    write_file(a, "changed a");
+    write_file(b, "changed b");
+    write_file(unwatched, "c");
+
+    const auto changes = wait_for_changes(watch);
+    ASSERT_EQ(changes.size(), 2);
+    ASSERT_EQ(changes.at(0).filename(), "a.osim");
+    ASSERT_EQ(changes.at(1).filename(), "b.vtp");
+
+    // and the changes are only reported once
+    ASSERT_TRUE(watch.take_changes().empty());
+}
+
+TEST(FileWatch, ReportsFilesThatAreCreatedAfterTheWatchStarted)
+{
+    const TemporaryDirectory dir;
+    const auto p = dir.path() / "model.warpconfig.toml";
+
+    FileWatch watch({p}, c_test_settle_interval);
+
+    write_file(p, "[global_settings]");
+
+    const auto changes = wait_for_changes(watch);
+    ASSERT_EQ(changes.size(), 1);
+    ASSERT_EQ(changes.front().filename(), p.filename());
+}
+
+TEST(FileWatch, KeepsWatchingADirectoryThatIsDeletedAndRecreated)
+{
+    const TemporaryDirectory dir;
+    const auto subdir = dir.path() / "subdir";
+    const auto p = subdir / "model.osim";
+    std::filesystem::create_directory(subdir);
+    write_file(p, "original");
+
+    FileWatch watch({p}, c_test_settle_interval);
+
+    std::filesystem::remove_all(subdir);
+    ASSERT_EQ(wait_for_changes(watch).size(), 1) << "deleting the file is a change";
+
+    std::filesystem::create_directory(subdir);
+    write_file(p, "recreated");
+    const auto changes = wait_for_changes(watch);
+    ASSERT_EQ(changes.size(), 1) << "the recreated directory should be watched again";
+    ASSERT_EQ(changes.front().filename(), p.filename());
+}
+
+TEST(FileWatch, OnlyReportsChangesOnceTheyHaveSettled)
+{
+    const TemporaryDirectory dir;
+    const auto p = dir.path() / "model.osim";
+    write_file(p, "original");
+
+    FileWatch watch({p}, std::chrono::seconds{60});
+    write_file(p, "changed");
+
+    // (the change is detected, but the watch's files haven't been quiet for the settle interval)
+    std::this_thread::sleep_for(std::chrono::milliseconds{200});
+    ASSERT_TRUE(watch.take_changes().empty());
+}
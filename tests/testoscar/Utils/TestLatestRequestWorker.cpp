@@ -0,0 +1,198 @@
+#include <oscar/Utils/LatestRequestWorker.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    // a one-shot signal that one thread can raise and another can wait on
+    class Signal final {
+    public:
+        void raise() { promise_.set_value(); }
+        void wait() { future_.wait(); }
+    private:
+        std::promise<void> promise_;
+        std::shared_future<void> future_ = promise_.get_future().share();
+    };
+
+    void SpinUntilCancelled(const LatestRequestCancellation& cancellation)
+    {
+        while (not cancellation.is_cancelled()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+TEST(LatestRequestWorker, PollAndWaitReturnNothingIfNothingWasRequested)
+{
+    LatestRequestWorker<int, int> worker{"test", [](int& v, const LatestRequestCancellation&) { return v; }};
+    ASSERT_FALSE(worker.poll());
+    ASSERT_FALSE(worker.wait());
+    ASSERT_FALSE(worker.is_busy());
+}
+
+TEST(LatestRequestWorker, WaitReturnsTheResultOfTheLatestRequest)
+{
+    LatestRequestWorker<int, int> worker{"test", [](int& v, const LatestRequestCancellation&) { return 2*v; }};
+
+    const UID id = worker.request(21);
+    ASSERT_EQ(worker.latest_request_id(), id);
+
+    const auto completed = worker.wait();
+    ASSERT_TRUE(completed);
+    ASSERT_EQ(completed->request_id, id);
+    ASSERT_EQ(completed->result, 42);
+    ASSERT_FALSE(worker.poll()) << "the result should've been taken by `wait`";
+    ASSERT_FALSE(worker.is_busy());
+}
+
+TEST(LatestRequestWorker, NewerRequestsCancelTheInFlightRequest)
+{
+    Signal started;
+    std::atomic<bool> first_was_cancelled = false;
+    LatestRequestWorker<int, int> worker{"test", [&](int& v, const LatestRequestCancellation& cancellation)
+    {
+        if (v == 1) {
+            started.raise();
+            SpinUntilCancelled(cancellation);
+            first_was_cancelled = true;
+            cancellation.throw_if_cancelled();
+        }
+        return v;
+    }};
+
+    worker.request(1);
+    started.wait();
+    const UID second = worker.request(2);
+
+    const auto completed = worker.wait();
+    ASSERT_TRUE(completed);
+    ASSERT_EQ(completed->request_id, second);
+    ASSERT_EQ(completed->result, 2);
+    ASSERT_TRUE(first_was_cancelled);
+}
+
+TEST(LatestRequestWorker, PendingRequestsAreReplacedByNewerOnes)
+{
+    Signal started;
+    Signal release;
+    std::mutex mutex;
+    std::vector<int> processed;
+    LatestRequestWorker<int, int> worker{"test", [&](int& v, const LatestRequestCancellation& cancellation)
+    {
+        {
+            const std::lock_guard lock{mutex};
+            processed.push_back(v);
+        }
+        if (v == 1) {
+            started.raise();
+            release.wait();
+            cancellation.throw_if_cancelled();
+        }
+        return v;
+    }};
+
+    worker.request(1);
+    started.wait();
+    worker.request(2);
+    worker.request(3);  // replaces 2 before the worker gets a chance to pick it up
+    release.raise();
+
+    const auto completed = worker.wait();
+    ASSERT_TRUE(completed);
+    ASSERT_EQ(completed->result, 3);
+
+    const std::lock_guard lock{mutex};
+    ASSERT_EQ(processed, (std::vector<int>{1, 3}));
+}
+
+TEST(LatestRequestWorker, SupersedeDropsResultsOfOlderRequests)
+{
+    Signal started;
+    Signal release;
+    LatestRequestWorker<int, int> worker{"test", [&](int& v, const LatestRequestCancellation&)
+    {
+        started.raise();
+        release.wait();
+        return v;  // (deliberately ignores cancellation)
+    }};
+
+    worker.request(1);
+    started.wait();
+    const UID superseding = worker.supersede();
+    ASSERT_EQ(worker.latest_request_id(), superseding);
+    release.raise();
+
+    ASSERT_FALSE(worker.wait()) << "the caller handled a newer request, so the worker's result is stale";
+    ASSERT_FALSE(worker.poll());
+}
+
+TEST(LatestRequestWorker, ExceptionsAreTreatedAsNoResult)
+{
+    LatestRequestWorker<int, int> worker{"test", [](int& v, const LatestRequestCancellation&) -> std::optional<int>
+    {
+        if (v < 0) {
+            throw std::runtime_error{"negative"};
+        }
+        return v;
+    }};
+
+    worker.request(-1);
+    ASSERT_FALSE(worker.wait());
+
+    // the worker should still be usable afterwards
+    worker.request(7);
+    const auto completed = worker.wait();
+    ASSERT_TRUE(completed);
+    ASSERT_EQ(completed->result, 7);
+}
+
+TEST(LatestRequestWorker, CallsOnCompletedWhenAResultIsPublished)
+{
+    std::atomic<int> num_calls = 0;
+    LatestRequestWorker<int, int> worker{
+        "test",
+        [](int& v, const LatestRequestCancellation&) -> std::optional<int> { return v > 0 ? std::optional<int>{v} : std::nullopt; },
+        [&num_calls]() { ++num_calls; },
+    };
+
+    worker.request(0);  // produces no result
+    worker.wait();
+    worker.request(1);
+    worker.wait();
+
+    // (`on_completed` is called after the result is published, so it may lag `wait` slightly)
+    while (num_calls == 0) {
+        std::this_thread::yield();
+    }
+    ASSERT_EQ(num_calls, 1);
+}
+
+TEST(LatestRequestWorker, DestructorCancelsTheInFlightRequest)
+{
+    Signal started;
+    auto was_cancelled = std::make_shared<std::atomic<bool>>(false);
+    {
+        LatestRequestWorker<int, int> worker{"test", [&started, was_cancelled](int& v, const LatestRequestCancellation& cancellation)
+        {
+            started.raise();
+            SpinUntilCancelled(cancellation);
+            *was_cancelled = true;
+            return v;
+        }};
+        worker.request(1);
+        started.wait();
+        ASSERT_TRUE(worker.is_busy());
+    }  // joins the worker (would hang if the in-flight request isn't cancelled)
+    ASSERT_TRUE(*was_cancelled);
+}
@@ -0,0 +1,51 @@
+#include <oscar/Utils/PerfMeasurement.h>
+
+#include <gtest/gtest.h>
+#include <oscar/Utils/PerfClock.h>
+#include <oscar/Utils/PerfMeasurementMetadata.h>
+
+#include <chrono>
+#include <memory>
+
+using namespace osc;
+
+namespace
+{
+    PerfMeasurement make_measurement()
+    {
+        return PerfMeasurement{std::make_shared<const PerfMeasurementMetadata>(0, "label", "file.cpp", 1)};
+    }
+}
+
+TEST(PerfMeasurement, PercentileDurationReturnsZeroWhenNothingWasSubmitted)
+{
+    ASSERT_EQ(make_measurement().percentile_duration(0.5), PerfClock::duration{0});
+}
+
+TEST(PerfMeasurement, PercentileDurationReturnsExpectedPercentilesOfSubmittedDurations)
+{
+    PerfMeasurement measurement = make_measurement();
+    const PerfClock::time_point start{};
+    for (int i = 1; i <= 101; ++i) {
+        measurement.submit(start, start + std::chrono::milliseconds{i});
+    }
+
+    ASSERT_EQ(measurement.percentile_duration(0.0), std::chrono::milliseconds{1});
+    ASSERT_EQ(measurement.percentile_duration(0.5), std::chrono::milliseconds{51});
+    ASSERT_EQ(measurement.percentile_duration(0.99), std::chrono::milliseconds{100});
+    ASSERT_EQ(measurement.percentile_duration(1.0), std::chrono::milliseconds{101});
+}
+
+TEST(PerfMeasurement, PercentileDurationOnlyConsidersRecentDurations)
+{
+    PerfMeasurement measurement = make_measurement();
+    const PerfClock::time_point start{};
+    for (int i = 0; i < 1000; ++i) {
+        measurement.submit(start, start + std::chrono::seconds{1});  // old, slow, calls
+    }
+    for (int i = 0; i < 1000; ++i) {
+        measurement.submit(start, start + std::chrono::milliseconds{1});
+    }
+
+    ASSERT_EQ(measurement.percentile_duration(1.0), std::chrono::milliseconds{1});
+}
@@ -0,0 +1,147 @@
+#include <oscar/Utils/PersistentMap.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    template<typename Key, typename T>
+    std::vector<std::pair<Key, T>> elements_of(const PersistentMap<Key, T>& map)
+    {
+        return {map.begin(), map.end()};
+    }
+
+    template<typename Key, typename T>
+    std::vector<std::pair<Key, T>> elements_of(const std::map<Key, T>& map)
+    {
+        return {map.begin(), map.end()};
+    }
+}
+
+TEST(PersistentMap, DefaultConstructedIsEmpty)
+{
+    const PersistentMap<int, int> map;
+
+    ASSERT_TRUE(map.empty());
+    ASSERT_EQ(map.size(), 0);
+    ASSERT_EQ(map.begin(), map.end());
+    ASSERT_EQ(map.find(1), map.end());
+}
+
+TEST(PersistentMap, TryEmplaceDoesNotOverwriteExistingValues)
+{
+    PersistentMap<int, std::string> map;
+
+    ASSERT_TRUE(map.try_emplace(1, "first").second);
+    const auto [value, inserted] = map.try_emplace(1, "second");
+
+    ASSERT_FALSE(inserted);
+    ASSERT_EQ(*value, "first");
+    ASSERT_EQ(map.size(), 1);
+}
+
+TEST(PersistentMap, IteratesInKeyOrder)
+{
+    PersistentMap<int, int> map;
+    std::vector<int> keys(1000);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        keys[i] = static_cast<int>(i);
+    }
+    std::shuffle(keys.begin(), keys.end(), std::default_random_engine{});
+    for (int key : keys) {
+        map.try_emplace(key, -key);
+    }
+
+    int expected = 0;
+    for (const auto& [key, value] : map) {
+        ASSERT_EQ(key, expected);
+        ASSERT_EQ(value, -expected);
+        ++expected;
+    }
+    ASSERT_EQ(expected, 1000);
+}
+
+TEST(PersistentMap, BehavesLikeStdMapForRandomInsertionsAndErasures)
+{
+    std::default_random_engine rng{1337};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    std::uniform_int_distribution<int> key_dist{0, 2000};
+
+    PersistentMap<int, int> map;
+    std::map<int, int> expected;
+    for (int i = 0; i < 20000; ++i) {
+        const int key = key_dist(rng);
+        if (i % 3 == 0) {
+            ASSERT_EQ(map.erase(key), expected.erase(key));
+        }
+        else {
+            ASSERT_EQ(map.try_emplace(key, i).second, expected.try_emplace(key, i).second);
+        }
+        ASSERT_EQ(map.size(), expected.size());
+    }
+
+    ASSERT_EQ(elements_of(map), elements_of(expected));
+    for (int key = 0; key <= 2000; ++key) {
+        ASSERT_EQ(map.contains(key), expected.contains(key));
+    }
+}
+
+TEST(PersistentMap, CopiesDoNotObserveEachOthersMutations)
+{
+    PersistentMap<int, int> original;
+    for (int i = 0; i < 500; ++i) {
+        original.try_emplace(i, i);
+    }
+    const auto original_elements = elements_of(original);
+
+    PersistentMap<int, int> copy = original;
+    *copy.try_upd(100) = -1;
+    copy.erase(200);
+    copy.try_emplace(1000, 1000);
+
+    ASSERT_EQ(elements_of(original), original_elements);
+    ASSERT_EQ(*copy.try_get(100), -1);
+    ASSERT_FALSE(copy.contains(200));
+    ASSERT_TRUE(copy.contains(1000));
+    ASSERT_EQ(*original.try_get(100), 100);
+    ASSERT_TRUE(original.contains(200));
+    ASSERT_FALSE(original.contains(1000));
+}
+
+TEST(PersistentMap, UpdatingACopyOnlyCopiesNodesOnThePathToTheUpdatedValue)
+{
+    // the values are `shared_ptr`s, so the use count shows how many nodes share each value
+    PersistentMap<int, std::shared_ptr<int>> original;
+    for (int i = 0; i < 10000; ++i) {
+        original.try_emplace(i, std::make_shared<int>(i));
+    }
+
+    PersistentMap<int, std::shared_ptr<int>> copy = original;
+    copy.try_upd(5000);
+
+    size_t num_copied_values = 0;
+    for (const auto& [key, value] : original) {
+        if (value.use_count() > 1) {
+            ++num_copied_values;
+        }
+    }
+    ASSERT_GT(num_copied_values, 0);
+    ASSERT_LE(num_copied_values, 32);  // i.e. only the updated value's leaf was copied
+}
+
+TEST(PersistentMap, TryUpdReturnsNullptrForMissingKeys)
+{
+    PersistentMap<int, int> map{{1, 1}, {2, 2}};
+
+    ASSERT_EQ(map.try_upd(3), nullptr);
+    ASSERT_NE(map.try_upd(2), nullptr);
+}
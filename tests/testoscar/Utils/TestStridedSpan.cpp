@@ -0,0 +1,119 @@
+#include <oscar/Utils/StridedSpan.h>
+
+#include <gtest/gtest.h>
+#include <oscar/Maths/Vec3.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    // an interleaved struct, similar to what you'd find in a vertex buffer
+    struct Vertex final {
+        Vec3 position;
+        Vec3 normal;
+    };
+}
+
+TEST(StridedSpan, IsARandomAccessRange)
+{
+    static_assert(std::ranges::random_access_range<StridedSpan<Vec3>>);
+    static_assert(std::ranges::random_access_range<StridedSpan<const Vec3>>);
+    static_assert(std::ranges::sized_range<StridedSpan<Vec3>>);
+    static_assert(std::ranges::borrowed_range<StridedSpan<Vec3>>);
+}
+
+TEST(StridedSpan, DefaultConstructedIsEmpty)
+{
+    const StridedSpan<Vec3> span;
+    ASSERT_TRUE(span.empty());
+    ASSERT_EQ(span.size(), 0);
+    ASSERT_EQ(span.begin(), span.end());
+}
+
+TEST(StridedSpan, CanBeConstructedFromContiguousSpan)
+{
+    std::vector<Vec3> vs = {Vec3{1.0f}, Vec3{2.0f}, Vec3{3.0f}};
+    const StridedSpan<Vec3> span{std::span<Vec3>{vs}};
+
+    ASSERT_EQ(span.size(), vs.size());
+    ASSERT_TRUE(span.is_contiguous());
+    ASSERT_TRUE(std::ranges::equal(span, vs));
+}
+
+TEST(StridedSpan, CanViewOneMemberOfAnInterleavedBuffer)
+{
+    std::array<Vertex, 3> vertices = {{
+        {Vec3{1.0f}, Vec3{-1.0f}},
+        {Vec3{2.0f}, Vec3{-2.0f}},
+        {Vec3{3.0f}, Vec3{-3.0f}},
+    }};
+    auto* base = reinterpret_cast<std::byte*>(vertices.data());
+    const StridedSpan<Vec3> normals{base + offsetof(Vertex, normal), vertices.size(), sizeof(Vertex)};
+
+    ASSERT_FALSE(normals.is_contiguous());
+    ASSERT_EQ(normals.size(), 3);
+    ASSERT_EQ(normals[0], Vec3{-1.0f});
+    ASSERT_EQ(normals[1], Vec3{-2.0f});
+    ASSERT_EQ(normals[2], Vec3{-3.0f});
+    ASSERT_EQ(std::distance(normals.begin(), normals.end()), 3);
+}
+
+TEST(StridedSpan, WritingThroughTheSpanWritesToTheUnderlyingBuffer)
+{
+    std::array<Vertex, 2> vertices{};
+    auto* base = reinterpret_cast<std::byte*>(vertices.data());
+    const StridedSpan<Vec3> positions{base + offsetof(Vertex, position), vertices.size(), sizeof(Vertex)};
+
+    std::ranges::fill(positions, Vec3{7.0f});
+
+    ASSERT_EQ(vertices[0].position, Vec3{7.0f});
+    ASSERT_EQ(vertices[1].position, Vec3{7.0f});
+    ASSERT_EQ(vertices[0].normal, Vec3{});  // untouched
+    ASSERT_EQ(vertices[1].normal, Vec3{});  // untouched
+}
+
+TEST(StridedSpan, CanBeImplicitlyConvertedToReadOnlySpan)
+{
+    std::vector<Vec3> vs = {Vec3{1.0f}, Vec3{2.0f}};
+    const StridedSpan<Vec3> span{std::span<Vec3>{vs}};
+    const StridedSpan<const Vec3> readonly = span;
+
+    ASSERT_EQ(readonly.size(), span.size());
+    ASSERT_EQ(readonly.stride(), span.stride());
+    ASSERT_EQ(&readonly[1], &span[1]);
+}
+
+TEST(StridedSpan, AsSpanReturnsContiguousSpanWhenContiguous)
+{
+    std::vector<Vec3> vs = {Vec3{1.0f}, Vec3{2.0f}};
+    const StridedSpan<Vec3> span{std::span<Vec3>{vs}};
+
+    ASSERT_EQ(span.as_span().data(), vs.data());
+    ASSERT_EQ(span.as_span().size(), vs.size());
+}
+
+TEST(StridedSpan, AsSpanThrowsWhenNotContiguous)
+{
+    std::array<Vertex, 2> vertices{};
+    const StridedSpan<Vec3> positions{reinterpret_cast<std::byte*>(vertices.data()), vertices.size(), sizeof(Vertex)};
+
+    ASSERT_ANY_THROW({ [[maybe_unused]] auto s = positions.as_span(); });
+}
+
+TEST(StridedSpan, AtThrowsIfOutOfBounds)
+{
+    std::vector<Vec3> vs(2);
+    const StridedSpan<Vec3> span{std::span<Vec3>{vs}};
+
+    ASSERT_NO_THROW({ span.at(1); });
+    ASSERT_THROW({ span.at(2); }, std::out_of_range);
+}
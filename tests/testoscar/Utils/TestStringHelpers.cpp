@@ -5,7 +5,9 @@
 #include <algorithm>
 #include <array>
 #include <cctype>
+#include <cmath>
 #include <cstdint>
+#include <limits>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -16,6 +18,7 @@ using osc::strip_whitespace;
 using osc::to_hex_chars;
 using osc::is_valid_identifier;
 using osc::join;
+using osc::to_lowercase;
 
 TEST(Algorithms, TrimLeadingAndTrailingWhitespaceWorksAsExpected)
 {
@@ -165,6 +168,41 @@ namespace
         // care: std::from_chars won't do this
         {"+0", 0.0f},
         {" +1", 1.0f},
+
+        // it rejects repeated signs
+        {"++1", std::nullopt},
+        {"+-1", std::nullopt},
+        {"--1", std::nullopt},
+        {"+", std::nullopt},
+        {"-", std::nullopt},
+
+        // it rejects values that are out of the range of a float
+        {"1e39", std::nullopt},
+        {"-1e39", std::nullopt},
+        {"3.5e38", std::nullopt},
+        {"1e999999", std::nullopt},
+
+        // it parses hex values (like `std::strtof`)
+        {"0x10", 16.0f},
+        {"0X1p3", 8.0f},
+        {"-0x1.8", -1.5f},
+        {" +0xa ", 10.0f},
+        {"0x", std::nullopt},
+        {"0xg", std::nullopt},
+
+        // it parses infinities (like `std::strtof`)
+        {"inf", std::numeric_limits<float>::infinity()},
+        {"-inf", -std::numeric_limits<float>::infinity()},
+        {" +INFINITY ", std::numeric_limits<float>::infinity()},
+
+        // it rejects trailing garbage (other than whitespace)
+        {"1.5f", std::nullopt},
+        {"1,5", std::nullopt},
+        {"1.2.3", std::nullopt},
+        {"1e", std::nullopt},
+        {"1 2", std::nullopt},
+        {"infx", std::nullopt},
+        {"nan(", std::nullopt},
     });
 
     // see: googletest/docs/advanced.md "How to write value-parameterized tests"
@@ -184,6 +222,15 @@ TEST_P(FromCharsStripWhitespace, Check)
     std::optional<float> rv = osc::from_chars_strip_whitespace(c.input);
     ASSERT_EQ(rv, c.expectedOutput);
 }
+
+TEST(from_chars_strip_whitespace, ParsesNaNs)
+{
+    for (const char* input : {"nan", "NaN", " -nan ", "+NAN"}) {
+        const std::optional<float> rv = osc::from_chars_strip_whitespace(input);
+        ASSERT_TRUE(rv) << input;
+        ASSERT_TRUE(std::isnan(*rv)) << input;
+    }
+}
 TEST(to_hex_chars, ReturnsExpectedResultsWhenComparedToAlternateImplementation)
 {
     // test by comparing with
@@ -363,3 +410,10 @@ TEST(StringHelpers, joinWorksForThreeElements)
 {
     ASSERT_EQ(join(std::to_array({5, 4, 3}), ", "), "5, 4, 3");
 }
+
+TEST(StringHelpers, to_lowercaseConvertsUppercaseCharactersAndLeavesOthersAlone)
+{
+    ASSERT_EQ(to_lowercase(""), "");
+    ASSERT_EQ(to_lowercase("r_Humerus_2"), "r_humerus_2");
+    ASSERT_EQ(to_lowercase("ALLCAPS"), "allcaps");
+}
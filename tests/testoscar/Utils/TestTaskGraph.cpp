@@ -0,0 +1,120 @@
+#include <oscar/Utils/TaskGraph.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace osc;
+
+TEST(TaskGraph, RunOnEmptyGraphReturnsNoTimings)
+{
+    TaskGraph graph;
+    ASSERT_TRUE(graph.empty());
+    ASSERT_TRUE(graph.run().empty());
+}
+
+TEST(TaskGraph, RunsEachTaskExactlyOnceAndReturnsTimingsInAddOrder)
+{
+    std::atomic<size_t> num_calls = 0;
+    TaskGraph graph;
+    graph.add("a", [&num_calls]() { ++num_calls; });
+    graph.add("b", [&num_calls]() { ++num_calls; });
+    graph.add("c", [&num_calls]() { ++num_calls; });
+
+    const std::vector<TaskTiming> timings = graph.run();
+
+    ASSERT_EQ(num_calls, 3);
+    ASSERT_EQ(timings.size(), 3);
+    ASSERT_EQ(timings[0].label, "a");
+    ASSERT_EQ(timings[1].label, "b");
+    ASSERT_EQ(timings[2].label, "c");
+    for (const TaskTiming& timing : timings) {
+        ASSERT_LE(timing.start, timing.end);
+    }
+}
+
+TEST(TaskGraph, RunsTasksAfterTheirDependencies)
+{
+    std::mutex mutex;
+    std::vector<TaskGraph::TaskID> order;
+    const auto record = [&mutex, &order](TaskGraph::TaskID id)
+    {
+        return [&mutex, &order, id]()
+        {
+            const std::lock_guard lock{mutex};
+            order.push_back(id);
+        };
+    };
+
+    TaskGraph graph;
+    const auto a = graph.add("a", record(0));
+    const auto b = graph.add("b", record(1), {a});
+    const auto c = graph.add("c", record(2), {a});
+    graph.add("d", record(3), {b, c});
+
+    graph.run();
+
+    ASSERT_EQ(order.size(), 4);
+    ASSERT_EQ(order.front(), 0);
+    ASSERT_EQ(order.back(), 3);
+}
+
+TEST(TaskGraph, RunsIndependentTasksConcurrently)
+{
+    // both tasks wait for each other, so the graph can only finish if they run concurrently
+    std::atomic<size_t> num_started = 0;
+    const auto wait_for_other = [&num_started]()
+    {
+        ++num_started;
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+        while (num_started < 2 and std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+    };
+
+    TaskGraph graph;
+    graph.add("a", wait_for_other);
+    graph.add("b", wait_for_other);
+    const std::vector<TaskTiming> timings = graph.run();
+
+    ASSERT_EQ(num_started, 2);
+    ASSERT_NE(timings[0].thread_index, timings[1].thread_index);
+}
+
+TEST(TaskGraph, RunsRunOnCallingThreadTasksOnTheCallingThread)
+{
+    const std::thread::id calling_thread = std::this_thread::get_id();
+    std::thread::id task_thread;
+
+    TaskGraph graph;
+    const auto a = graph.add("a", []() {});
+    graph.add("b", [&task_thread]() { task_thread = std::this_thread::get_id(); }, {a}, TaskFlags::RunOnCallingThread);
+    const std::vector<TaskTiming> timings = graph.run();
+
+    ASSERT_EQ(task_thread, calling_thread);
+    ASSERT_EQ(timings[1].thread_index, 0);
+}
+
+TEST(TaskGraph, RethrowsExceptionsAndSkipsDependentTasks)
+{
+    bool dependent_ran = false;
+
+    TaskGraph graph;
+    const auto a = graph.add("a", []() { throw std::runtime_error{"failed"}; });
+    graph.add("b", [&dependent_ran]() { dependent_ran = true; }, {a});
+
+    ASSERT_THROW({ graph.run(); }, std::runtime_error);
+    ASSERT_FALSE(dependent_ran);
+}
+
+TEST(TaskGraph, AddThrowsIfADependencyIsNotInTheGraph)
+{
+    TaskGraph graph;
+    ASSERT_ANY_THROW({ graph.add("a", []() {}, {0}); });
+}
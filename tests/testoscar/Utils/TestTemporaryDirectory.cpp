@@ -0,0 +1,41 @@
+#include <oscar/Utils/TemporaryDirectory.h>
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+using namespace osc;
+
+TEST(TemporaryDirectory, CreatesAnEmptyDirectoryInTheSystemTemporaryDirectory)
+{
+    const TemporaryDirectory dir;
+    ASSERT_TRUE(std::filesystem::is_directory(dir.path()));
+    ASSERT_TRUE(std::filesystem::is_empty(dir.path()));
+    ASSERT_TRUE(std::filesystem::equivalent(dir.path().parent_path(), std::filesystem::temp_directory_path()));
+}
+
+TEST(TemporaryDirectory, NameStartsWithTheGivenPrefix)
+{
+    const TemporaryDirectory dir{"oscar_tempdirtest_"};
+    ASSERT_TRUE(dir.path().filename().string().starts_with("oscar_tempdirtest_"));
+}
+
+TEST(TemporaryDirectory, ConcurrentlyExistingDirectoriesHaveDifferentPaths)
+{
+    const TemporaryDirectory a{"oscar_tempdirtest_"};
+    const TemporaryDirectory b{"oscar_tempdirtest_"};
+    ASSERT_NE(a.path(), b.path());
+}
+
+TEST(TemporaryDirectory, DestructorRecursivelyDeletesTheDirectory)
+{
+    std::filesystem::path path;
+    {
+        const TemporaryDirectory dir;
+        path = dir.path();
+        std::filesystem::create_directory(path / "subdir");
+        std::ofstream{path / "subdir" / "file.txt"} << "content";
+    }
+    ASSERT_FALSE(std::filesystem::exists(path));
+}